@@ -0,0 +1,8 @@
+#ifndef ALLOCCOUNTER_H
+#define ALLOCCOUNTER_H
+
+// Operator new/delete global diganti supaya setiap alokasi heap lewat C++ ikut
+// terhitung. Dipakai untuk memastikan frame steady-state tidak mengalokasi.
+unsigned long long allocationCount();
+
+#endif // ALLOCCOUNTER_H
@@ -1,10 +1,21 @@
 #include "arena.h"
+#include "simmath.h"
 #include "globals.h" 
 #include "utils.h"   
+#include "arenacull.h"
+#include "arenalod.h"
+#include "profiler.h"
 #include <cmath>     
-#include <GL/glut.h>
 #include <cstdio>    
 #include <vector>    
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <cstring>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define ARENA_BATCH_SSE 1
+#endif
 
 
 
@@ -26,139 +37,179 @@ static const char testRampAxis = 'z';
 
 // Definisi array global arenaHeights 
 float arenaHeights[GRID_SIZE][GRID_SIZE] = {0};
-
-struct ArenaCube {
-    float x, y, z, sizeX, sizeY, sizeZ;
-};
-struct ArenaRamp {
-    float x, y, z, sizeX, sizeY, sizeZ; char axis;
-};
-struct ArenaBush {
-    float x, y, z, radius;
-};
-struct ArenaTree {
-    float x, y, z;
-    float trunkHeight, trunkRadius;
-    float foliageRadius;
-};
-struct ArenaRock {
-    float x, y, z;
-    float scale;
-};
+float arenaOriginX = 0.0f, arenaOriginZ = 0.0f;
+// Naik tiap kali cube/ramp/arenaHeights berubah, lihat arenaSolidVersion
+static unsigned arenaSolidVersionCounter = 0;
+static unsigned arenaCoinVersionCounter = 0;
 
 std::vector<ArenaCube> cubes;
 std::vector<ArenaRamp> ramps;
 std::vector<ArenaBush> bushes;
 std::vector<ArenaTree> trees;
 std::vector<ArenaRock> rocks;
-
-#include <vector>
-struct Coin {
-    float x, y, z;
-    bool collected;
-};
 std::vector<Coin> coins;
+std::vector<ArenaBounds> cubeBounds, rampBounds, bushBounds, treeBounds, rockBounds;
+
+// Handle cube/ramp: index di list bergeser kalau hot reload menyisipkan/menghapus
+// baris, handle tetap ikut primitive yang sama. Cell grid broadphase dan list
+// primitive cell heightfield menyimpan handle (urut index), jadi cell yang tidak
+// disentuh reload tidak perlu ditulis ulang. Handle primitive yang dihapus dipakai lagi.
+struct ArenaHandles {
+    std::vector<int> handleOf; // Per index
+    std::vector<int> indexOf;  // Per handle, -1 = bebas
+    std::vector<int> free;
+};
+static ArenaHandles arenaCubeHandles, arenaRampHandles;
+
+// List diisi di luar API edit (Create*, level.cpp): mulai lagi dari handle = index
+static void syncArenaHandles(ArenaHandles& h, int count) {
+    if ((int)h.handleOf.size() == count) return;
+    h.handleOf.resize(count);
+    for (int k = 0; k < count; ++k) h.handleOf[k] = k;
+    h.indexOf = h.handleOf;
+    h.free.clear();
+}
+
+static int allocArenaHandle(ArenaHandles& h, int index) {
+    int handle = (int)h.indexOf.size();
+    if (!h.free.empty()) {
+        handle = h.free.back();
+        h.free.pop_back();
+    } else {
+        h.indexOf.push_back(-1);
+    }
+    h.indexOf[handle] = index;
+    return handle;
+}
+
+static void releaseArenaHandle(ArenaHandles& h, int handle) {
+    h.indexOf[handle] = -1;
+    h.free.push_back(handle);
+}
 
 void addCoin(float x, float z) {
     float groundH, nx, ny, nz;
     getArenaHeightAndNormal(x, z, groundH, nx, ny, nz);
     coins.push_back({x, groundH + 0.5f, z, false});
+    ++arenaCoinVersionCounter;
 }
 
-float coinSpinAngle = 0.0f;
-float coinBounceTime = 0.0f;
-
-void updateCoinAnimation(float deltaTime) {
-    coinSpinAngle += 120.0f * deltaTime; // 120 derajat per detik
-    if (coinSpinAngle > 360.0f) coinSpinAngle -= 360.0f;
-    coinBounceTime += deltaTime;
-}
-
-void drawCoins() {
-    for (const Coin& coin : coins) {
-        if (coin.collected) continue;
-        glPushMatrix();
-        // Animasi naik turun
-        float bounce = 0.2f * sinf(coinBounceTime * 2.5f + coin.x + coin.z);
-        glTranslatef(coin.x, coin.y + bounce, coin.z);
-        // Animasi rotasi
-        glRotatef(coinSpinAngle, 0, 1, 0);
-        // Material: Emas (gold)
-        GLfloat gold_ambient[4] = {0.24725f, 0.1995f, 0.0745f, 1.0f};
-        GLfloat gold_diffuse[4] = {0.75164f, 0.60648f, 0.22648f, 1.0f};
-        GLfloat gold_specular[4] = {0.628281f, 0.555802f, 0.366065f, 1.0f};
-        GLfloat gold_shininess = 51.2f;
-        glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, gold_ambient);
-        glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, gold_diffuse);
-        glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, gold_specular);
-        glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, gold_shininess);
-        glColor3f(1.0f, 0.84f, 0.0f); // Gold color
-        GLUquadric* quad = gluNewQuadric();
-        if (quad) {
-            gluDisk(quad, 0.0, 0.4, 32, 1); // Sisi atas
-            glTranslatef(0, 0.08f, 0);
-            gluDisk(quad, 0.0, 0.4, 32, 1); // Sisi bawah
-            glTranslatef(0, -0.04f, 0);
-            gluCylinder(quad, 0.4, 0.4, 0.08, 32, 1); // Sisi samping
-            gluDeleteQuadric(quad);
-        }
-        glPopMatrix();
-    }
+void clearCoins() {
+    coins.clear();
+    ++arenaCoinVersionCounter;
 }
 
-void CreateCube(float x, float y, float z, float sizeX, float sizeY, float sizeZ) {
-    cubes.push_back({x, y, z, sizeX, sizeY, sizeZ});
+unsigned arenaCoinVersion() {
+    return arenaCoinVersionCounter;
+}
+
+// Region [i0..i1] x [j0..j1] (inklusif) dalam index titik grid arenaHeights atau
+// cell heightfield (cell (i, j) = kotak antara titik (i, j) dan (i + 1, j + 1))
+struct HeightfieldRegion {
+    int i0, i1, j0, j1;
+};
+
+// Rasterisasi ke grid heights dengan max(): hanya titik grid yang benar-benar berada
+// di dalam footprint (ceil untuk awal), supaya heightfield bisa dipakai langsung
+// oleh query fast path. Posisi relatif ke origin grid (pusat jendela arena).
+struct GridOrigin {
+    float x, z;
+};
+
+// Origin lattice titik: origin jendela dibulatkan ke kelipatan langkah grid, jadi
+// titik jatuh di posisi dunia yang sama di semua jendela streaming dan geser
+// jendela = geser index titik bulat. Origin 0 (level biasa) tetap 0.
+static int heightLatticeIndex(float origin) {
+    return (int)lroundf(origin / ((2.0f * BOUNDS) / (GRID_SIZE - 1)));
+}
+
+static GridOrigin heightGridOrigin(float originX, float originZ) {
+    const float step = (2.0f * BOUNDS) / (GRID_SIZE - 1);
+    return {heightLatticeIndex(originX) * step, heightLatticeIndex(originZ) * step};
+}
+
+static void gridFootprint(const GridOrigin& o, float x, float z, float sizeX, float sizeZ, int& start_i, int& end_i, int& start_j, int& end_j) {
     float stepX = (2.0f * BOUNDS) / (GRID_SIZE - 1);
     float stepZ = (2.0f * BOUNDS) / (GRID_SIZE - 1);
-    int start_i = floor((x - sizeX / 2.0f + BOUNDS) / stepX);
-    int end_i   = floor((x + sizeX / 2.0f + BOUNDS) / stepX);
-    int start_j = floor((z - sizeZ / 2.0f + BOUNDS) / stepZ);
-    int end_j   = floor((z + sizeZ / 2.0f + BOUNDS) / stepZ);
-    start_i = clamp(start_i, 0, GRID_SIZE - 1);
-    end_i   = clamp(end_i,   0, GRID_SIZE - 1);
-    start_j = clamp(start_j, 0, GRID_SIZE - 1);
-    end_j   = clamp(end_j,   0, GRID_SIZE - 1);
-    float topSurfaceHeight = y + sizeY / 2.0f;
+    x -= o.x;
+    z -= o.z;
+    start_i = ceil((x - sizeX / 2.0f + BOUNDS) / stepX);
+    end_i   = floor((x + sizeX / 2.0f + BOUNDS) / stepX);
+    start_j = ceil((z - sizeZ / 2.0f + BOUNDS) / stepZ);
+    end_j   = floor((z + sizeZ / 2.0f + BOUNDS) / stepZ);
+    if (start_i < 0) start_i = 0;
+    if (end_i > GRID_SIZE - 1) end_i = GRID_SIZE - 1;
+    if (start_j < 0) start_j = 0;
+    if (end_j > GRID_SIZE - 1) end_j = GRID_SIZE - 1;
+}
+
+static void clipFootprint(const HeightfieldRegion* clip, int& start_i, int& end_i, int& start_j, int& end_j) {
+    if (!clip) return;
+    start_i = std::max(start_i, clip->i0); end_i = std::min(end_i, clip->i1);
+    start_j = std::max(start_j, clip->j0); end_j = std::min(end_j, clip->j1);
+}
+
+static void rasterizeCube(float heights[GRID_SIZE][GRID_SIZE], const GridOrigin& o, const ArenaCube& c,
+                          const HeightfieldRegion* clip = nullptr) {
+    int start_i, end_i, start_j, end_j;
+    gridFootprint(o, c.x, c.z, c.sizeX, c.sizeZ, start_i, end_i, start_j, end_j);
+    clipFootprint(clip, start_i, end_i, start_j, end_j);
+    float topSurfaceHeight = c.y + c.sizeY / 2.0f;
     for (int i = start_i; i <= end_i; ++i) {
         for (int j = start_j; j <= end_j; ++j) {
-            if (arenaHeights[i][j] < topSurfaceHeight) {
-                arenaHeights[i][j] = topSurfaceHeight;
+            if (heights[i][j] < topSurfaceHeight) {
+                heights[i][j] = topSurfaceHeight;
             }
         }
     }
 }
-void CreateRamp(float x, float y, float z, float sizeX, float sizeY, float sizeZ, char axis) {
-    ramps.push_back({x, y, z, sizeX, sizeY, sizeZ, axis});
+
+static void rasterizeRamp(float heights[GRID_SIZE][GRID_SIZE], const GridOrigin& o, const ArenaRamp& r,
+                          const HeightfieldRegion* clip = nullptr) {
     float stepX = (2.0f * BOUNDS) / (GRID_SIZE - 1);
     float stepZ = (2.0f * BOUNDS) / (GRID_SIZE - 1);
-    int start_i = floor((x - (axis=='x'?sizeX:sizeX)/2.0f + BOUNDS) / stepX);
-    int end_i   = floor((x + (axis=='x'?sizeX:sizeX)/2.0f + BOUNDS) / stepX);
-    int start_j = floor((z - (axis=='x'?sizeZ:sizeZ)/2.0f + BOUNDS) / stepZ);
-    int end_j   = floor((z + (axis=='x'?sizeZ:sizeZ)/2.0f + BOUNDS) / stepZ);
-    start_i = clamp(start_i, 0, GRID_SIZE - 1);
-    end_i   = clamp(end_i,   0, GRID_SIZE - 1);
-    start_j = clamp(start_j, 0, GRID_SIZE - 1);
-    end_j   = clamp(end_j,   0, GRID_SIZE - 1);
+    int start_i, end_i, start_j, end_j;
+    gridFootprint(o, r.x, r.z, r.sizeX, r.sizeZ, start_i, end_i, start_j, end_j);
+    clipFootprint(clip, start_i, end_i, start_j, end_j);
     for (int i = start_i; i <= end_i; ++i) {
         for (int j = start_j; j <= end_j; ++j) {
-            float world_x = -BOUNDS + i * stepX;
-            float world_z = -BOUNDS + j * stepZ;
+            float world_x = o.x + (-BOUNDS + i * stepX);
+            float world_z = o.z + (-BOUNDS + j * stepZ);
             float progress = 0.0f;
-            if (axis == 'x') {
-                progress = (world_x - (x - sizeX/2.0f)) / sizeX;
+            if (r.axis == 'x') {
+                progress = (world_x - (r.x - r.sizeX/2.0f)) / r.sizeX;
             } else {
-                progress = (world_z - (z - sizeZ/2.0f)) / sizeZ;
+                progress = (world_z - (r.z - r.sizeZ/2.0f)) / r.sizeZ;
             }
             progress = clamp(progress, 0.0f, 1.0f);
-            float rampBaseY = y - sizeY/2.0f;
-            float rampHeight = rampBaseY + progress * sizeY;
-            if (arenaHeights[i][j] < rampHeight) {
-                arenaHeights[i][j] = rampHeight;
+            float rampBaseY = r.y - r.sizeY/2.0f;
+            float rampHeight = rampBaseY + progress * r.sizeY;
+            if (heights[i][j] < rampHeight) {
+                heights[i][j] = rampHeight;
             }
         }
     }
 }
 
+void rasterizeArenaHeights(const std::vector<ArenaCube>& cubeList, const std::vector<ArenaRamp>& rampList,
+                           float heights[GRID_SIZE][GRID_SIZE], float originX, float originZ) {
+    GridOrigin o = heightGridOrigin(originX, originZ);
+    for (int i = 0; i < GRID_SIZE; ++i)
+        for (int j = 0; j < GRID_SIZE; ++j)
+            heights[i][j] = 0.0f;
+    for (const auto& c : cubeList) rasterizeCube(heights, o, c);
+    for (const auto& r : rampList) rasterizeRamp(heights, o, r);
+}
+
+void CreateCube(float x, float y, float z, float sizeX, float sizeY, float sizeZ) {
+    cubes.push_back({x, y, z, sizeX, sizeY, sizeZ});
+    rasterizeCube(arenaHeights, heightGridOrigin(arenaOriginX, arenaOriginZ), cubes.back());
+}
+void CreateRamp(float x, float y, float z, float sizeX, float sizeY, float sizeZ, char axis) {
+    ramps.push_back({x, y, z, sizeX, sizeY, sizeZ, axis});
+    rasterizeRamp(arenaHeights, heightGridOrigin(arenaOriginX, arenaOriginZ), ramps.back());
+}
+
 void CreateBush(float x, float y, float z, float radius) {
     bushes.push_back({x, y, z, radius});
 }
@@ -171,251 +222,73 @@ void CreateRock(float x, float y, float z, float scale) {
     rocks.push_back({x, y, z, scale});
 }
 
-void drawCube(float centerX, float centerY, float centerZ, float sizeX, float sizeY, float sizeZ) {
-    if (enableShadows) {
-        glPushMatrix();
-            GLfloat shadow_plane[4] = {0.0f, 1.0f, 0.0f, -0.01f}; 
-            GLfloat shadow_light[4] = {10.0f, 80.0f, 10.0f, 1.0f};
-            extern void glShadowProjection(const float*, const float*); 
-            glShadowProjection(shadow_light, shadow_plane);
-            glTranslatef(centerX, centerY, centerZ);
-            glScalef(sizeX, sizeY, sizeZ);
-            glEnable(GL_POLYGON_OFFSET_FILL);
-            glPolygonOffset(-2.0f, -2.0f);
-            glDepthMask(GL_FALSE);
-            glDisable(GL_LIGHTING);
-            glColor4f(0.1f, 0.1f, 0.1f, 0.5f);
-            glEnable(GL_BLEND);
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-            glutSolidCube(1.0);
-            glDisable(GL_BLEND);
-            glEnable(GL_LIGHTING);
-            glDepthMask(GL_TRUE);
-            glDisable(GL_POLYGON_OFFSET_FILL);
-        glPopMatrix();
-    }
-
-    glPushMatrix();
-    glTranslatef(centerX, centerY, centerZ);
-    glScalef(sizeX, sizeY, sizeZ);
-    glColor3f(0.7f, 0.6f, 0.5f); 
-    glutSolidCube(1.0);
-    glPopMatrix();
-}
-
-void drawRamp(float centerX, float centerY, float centerZ, float sizeX, float sizeY, float sizeZ, char axis) {
-    if (enableShadows) {
-        glPushMatrix();
-            GLfloat shadow_plane[4] = {0.0f, 1.0f, 0.0f, -0.01f};
-            GLfloat shadow_light[4] = {10.0f, 80.0f, 10.0f, 1.0f};
-            extern void glShadowProjection(const float*, const float*);
-            glShadowProjection(shadow_light, shadow_plane);
-            glTranslatef(centerX, centerY, centerZ);
-            
-            // Setengah ukuran untuk kemudahan perhitungan vertex
-            float hx = sizeX / 2.0f;
-            float hy = sizeY / 2.0f; 
-            float hz = sizeZ / 2.0f;
-              glEnable(GL_POLYGON_OFFSET_FILL);
-            glPolygonOffset(-2.0f, -2.0f);
-            glDepthMask(GL_FALSE);
-            glDisable(GL_LIGHTING);
-            glDisable(GL_TEXTURE_2D); // Disable any textures
-            glColor4f(0.0f, 0.0f, 0.0f, 0.4f); // Pure black shadow
-            glEnable(GL_BLEND);
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-            
-            if (axis == 'z') {
-                float v[6][3] = {
-                    {-hx, -hy, -hz}, { hx, -hy, -hz}, {-hx, -hy,  hz}, 
-                    { hx, -hy,  hz}, {-hx,  hy,  hz}, { hx,  hy,  hz}
-                };
-                glBegin(GL_QUADS);
-                glVertex3fv(v[0]); glVertex3fv(v[1]); glVertex3fv(v[5]); glVertex3fv(v[4]);
-                glEnd();
-                glBegin(GL_QUADS);
-                glVertex3fv(v[0]); glVertex3fv(v[2]); glVertex3fv(v[3]); glVertex3fv(v[1]);
-                glEnd();
-            } else if (axis == 'x') {
-                float v[6][3] = {
-                    {-hx, -hy, -hz}, {-hx, -hy,  hz}, { hx, -hy, -hz}, 
-                    { hx, -hy,  hz}, { hx,  hy, -hz}, { hx,  hy,  hz}
-                };
-                glBegin(GL_QUADS);
-                glVertex3fv(v[0]); glVertex3fv(v[1]); glVertex3fv(v[5]); glVertex3fv(v[4]);
-                glEnd();
-                glBegin(GL_QUADS);
-                glVertex3fv(v[0]); glVertex3fv(v[2]); glVertex3fv(v[3]); glVertex3fv(v[1]);
-                glEnd();
-            }
-              glDisable(GL_BLEND);
-            glEnable(GL_LIGHTING);
-            glDepthMask(GL_TRUE);
-            glDisable(GL_POLYGON_OFFSET_FILL);
-        glPopMatrix();
-    }
-
-    glPushMatrix();
-    glTranslatef(centerX, centerY, centerZ); // Pindahkan ke pusat ramp
-    
-    glColor3f(0.7f, 0.6f, 0.5f); 
-
-    // Setengah ukuran untuk kemudahan perhitungan vertex
-    // sizeY adalah tinggi total ramp. Puncak ramp akan di centerY + sizeY/2, dasar di centerY - sizeY/2
-    float hx = sizeX / 2.0f;
-    float hy = sizeY / 2.0f; 
-    float hz = sizeZ / 2.0f;
-
-    if (axis == 'z') { // Ramp miring sepanjang sumbu Z
-        
-        float v[6][3] = {
-            {-hx, -hy, -hz}, // v0 (depan-bawah-kiri, kaki ramp)
-            { hx, -hy, -hz}, // v1 (depan-bawah-kanan, kaki ramp)
-            {-hx, -hy,  hz}, // v2 (belakang-bawah-kiri, di dasar bagian vertikal)
-            { hx, -hy,  hz}, // v3 (belakang-bawah-kanan, di dasar bagian vertikal)
-            {-hx,  hy,  hz}, // v4 (belakang-atas-kiri, puncak ramp)
-            { hx,  hy,  hz}  // v5 (belakang-atas-kanan, puncak ramp)
-        };
+static ArenaBounds boundsAround(float x, float y, float z, float hx, float hy, float hz) {
+    return {x - hx, y - hy, z - hz, x + hx, y + hy, z + hz};
+}
 
-        
-        float norm_slope_x = 0;
-        float norm_slope_y = -sizeX * sizeZ; 
-        float norm_slope_z = sizeX * sizeY;
-        float len_slope = sqrt(norm_slope_x*norm_slope_x + norm_slope_y*norm_slope_y + norm_slope_z*norm_slope_z);
-        if (len_slope > 1e-6) {
-            norm_slope_x /= len_slope;
-            norm_slope_y /= len_slope;
-            norm_slope_z /= len_slope;
-        }
-      
-        norm_slope_x = 0;
-        norm_slope_y = sizeX * sizeZ;
-        norm_slope_z = -sizeX * sizeY;
-        len_slope = sqrt(norm_slope_y*norm_slope_y + norm_slope_z*norm_slope_z); 
-        if (len_slope > 1e-6) {
-            norm_slope_y /= len_slope;
-            norm_slope_z /= len_slope;
-        }
+template <typename Prim>
+static ArenaBounds solidBounds(const Prim& p) {
+    return boundsAround(p.x, p.y, p.z, p.sizeX / 2.0f, p.sizeY / 2.0f, p.sizeZ / 2.0f);
+}
 
+// Batas prop diambil dari geometri di arenadraw/arenamesh: bush = 7 bola sampai
+// 1.7 * radius dari pusat, tree = trunk + cabang 2.5 * trunkRadius + foliage sampai
+// 1.2 * foliageRadius, rock = vertex lokal dalam [-1.5, 1.5] x [0, 1.7] x [-1.5, 1.5] dikali scale
+static ArenaBounds propBounds(const ArenaBush& b) {
+    return boundsAround(b.x, b.y, b.z, 1.7f * b.radius, 1.7f * b.radius, 1.7f * b.radius);
+}
 
-        // 1. Permukaan miring (Top/Sloped face) - QUAD
-        glBegin(GL_QUADS);
-        glNormal3f(norm_slope_x, norm_slope_y, norm_slope_z);
-        glVertex3fv(v[0]); // depan-bawah-kiri (kaki ramp)
-        glVertex3fv(v[1]); // depan-bawah-kanan (kaki ramp)
-        glVertex3fv(v[5]); // belakang-atas-kanan (puncak ramp)
-        glVertex3fv(v[4]); // belakang-atas-kiri (puncak ramp)
-        glEnd();
-
-        // 2. Alas (Bottom face) - QUAD
-        glBegin(GL_QUADS);
-        glNormal3f(0.0f, -1.0f, 0.0f); // Menghadap ke bawah
-        glVertex3fv(v[0]); // depan-bawah-kiri
-        glVertex3fv(v[2]); // belakang-bawah-kiri
-        glVertex3fv(v[3]); // belakang-bawah-kanan
-        glVertex3fv(v[1]); // depan-bawah-kanan
-        glEnd();
-
-        // 3. Sisi belakang vertikal (Back face, di z = hz) - QUAD
-        glBegin(GL_QUADS);
-        glNormal3f(0.0f, 0.0f, 1.0f); // Menghadap ke +Z
-        glVertex3fv(v[2]); // belakang-bawah-kiri
-        glVertex3fv(v[3]); // belakang-bawah-kanan
-        glVertex3fv(v[5]); // belakang-atas-kanan
-        glVertex3fv(v[4]); // belakang-atas-kiri
-        glEnd();
-
-        // 4. Sisi kiri (Left triangle) - TRIANGLE
-        glBegin(GL_TRIANGLES);
-        glNormal3f(-1.0f, 0.0f, 0.0f); // Menghadap ke -X
-        glVertex3fv(v[0]); // depan-bawah-kiri
-        glVertex3fv(v[4]); // belakang-atas-kiri
-        glVertex3fv(v[2]); // belakang-bawah-kiri
-        glEnd();
-
-        // 5. Sisi kanan (Right triangle) - TRIANGLE
-        glBegin(GL_TRIANGLES);
-        glNormal3f(1.0f, 0.0f, 0.0f); // Menghadap ke +X
-        glVertex3fv(v[1]); // depan-bawah-kanan
-        glVertex3fv(v[3]); // belakang-bawah-kanan
-        glVertex3fv(v[5]); // belakang-atas-kanan
-        glEnd();
-
-    } else if (axis == 'x') { // Ramp miring sepanjang sumbu X
-       
-        float v[6][3] = {
-            {-hx, -hy, -hz}, // v0 (kiri-bawah-depan, kaki ramp)
-            {-hx, -hy,  hz}, // v1 (kiri-bawah-belakang, kaki ramp)
-            { hx, -hy, -hz}, // v2 (kanan-bawah-depan, di dasar bagian vertikal)
-            { hx, -hy,  hz}, // v3 (kanan-bawah-belakang, di dasar bagian vertikal)
-            { hx,  hy, -hz}, // v4 (kanan-atas-depan, puncak ramp)
-            { hx,  hy,  hz}  // v5 (kanan-atas-belakang, puncak ramp)
-        };
+static ArenaBounds propBounds(const ArenaTree& t) {
+    float reach = std::max(1.2f * t.foliageRadius, 2.5f * t.trunkRadius + 0.3f * t.foliageRadius);
+    float top = std::max(std::max(0.6f * t.trunkHeight + 1.2f * t.foliageRadius, 0.8f * t.trunkHeight + t.foliageRadius),
+                         std::max(t.trunkHeight + 0.7f * t.foliageRadius, 1.15f * t.trunkHeight + 0.4f * t.foliageRadius));
+    return {t.x - reach, t.y - t.trunkRadius, t.z - reach, t.x + reach, t.y + top, t.z + reach};
+}
 
-        
-        float norm_slope_x = sizeZ * sizeY;
-        float norm_slope_y = -sizeZ * sizeX;
-        float norm_slope_z = 0;
-        float len_slope = sqrt(norm_slope_x*norm_slope_x + norm_slope_y*norm_slope_y); 
-        if (len_slope > 1e-6) {
-            norm_slope_x /= len_slope;
-            norm_slope_y /= len_slope;
-        }
-        // Balik normal jika Y negatif (agar mengarah ke atas dari permukaan)
-        if (norm_slope_y < 0) {
-            norm_slope_x *= -1;
-            norm_slope_y *= -1;
-        }
+static ArenaBounds propBounds(const ArenaRock& r) {
+    return {r.x - 1.5f * r.scale, r.y, r.z - 1.5f * r.scale, r.x + 1.5f * r.scale, r.y + 1.7f * r.scale, r.z + 1.5f * r.scale};
+}
 
+void buildArenaBounds() {
+    rebuildArenaBounds((1u << CULL_KIND_COUNT) - 1);
+}
 
-        // 1. Permukaan miring (Top/Sloped face) - QUAD
-        glBegin(GL_QUADS);
-        glNormal3f(norm_slope_x, norm_slope_y, norm_slope_z);
-        glVertex3fv(v[0]); // kiri-bawah-depan (kaki ramp)
-        glVertex3fv(v[1]); // kiri-bawah-belakang (kaki ramp)
-        glVertex3fv(v[5]); // kanan-atas-belakang (puncak ramp)
-        glVertex3fv(v[4]); // kanan-atas-depan (puncak ramp)
-        glEnd();
-
-        // 2. Alas (Bottom face) - QUAD
-        glBegin(GL_QUADS);
-        glNormal3f(0.0f, -1.0f, 0.0f); // Menghadap ke bawah
-        glVertex3fv(v[0]); // kiri-bawah-depan
-        glVertex3fv(v[2]); // kanan-bawah-depan
-        glVertex3fv(v[3]); // kanan-bawah-belakang
-        glVertex3fv(v[1]); // kiri-bawah-belakang
-        glEnd();
-
-        // 3. Sisi "belakang" vertikal (di x = hx) (Right face) - QUAD
-        glBegin(GL_QUADS);
-        glNormal3f(1.0f, 0.0f, 0.0f); // Menghadap ke +X
-        glVertex3fv(v[2]); // kanan-bawah-depan
-        glVertex3fv(v[3]); // kanan-bawah-belakang
-        glVertex3fv(v[5]); // kanan-atas-belakang
-        glVertex3fv(v[4]); // kanan-atas-depan
-        glEnd();
-
-        // 4. Sisi "depan" (di -Z) (Front triangle) - TRIANGLE
-        glBegin(GL_TRIANGLES);
-        glNormal3f(0.0f, 0.0f, -1.0f); // Menghadap ke -Z
-        glVertex3fv(v[0]); // kiri-bawah-depan
-        glVertex3fv(v[4]); // kanan-atas-depan
-        glVertex3fv(v[2]); // kanan-bawah-depan
-        glEnd();
-
-        // 5. Sisi "belakang" (di +Z) (Back triangle) - TRIANGLE
-        glBegin(GL_TRIANGLES);
-        glNormal3f(0.0f, 0.0f, 1.0f); // Menghadap ke +Z
-        glVertex3fv(v[1]); // kiri-bawah-belakang
-        glVertex3fv(v[3]); // kanan-bawah-belakang
-        glVertex3fv(v[5]); // kanan-atas-belakang
-        glEnd();
-    }    glPopMatrix();
+void rebuildArenaBounds(unsigned changed) {
+    if (changed & (1u << CULL_CUBE)) {
+        cubeBounds.clear();
+        for (const auto& c : cubes) cubeBounds.push_back(solidBounds(c));
+    }
+    if (changed & (1u << CULL_RAMP)) {
+        rampBounds.clear();
+        for (const auto& r : ramps) rampBounds.push_back(solidBounds(r));
+    }
+    if (changed & (1u << CULL_BUSH)) {
+        bushBounds.clear();
+        for (const auto& b : bushes) bushBounds.push_back(propBounds(b));
+    }
+    if (changed & (1u << CULL_TREE)) {
+        treeBounds.clear();
+        for (const auto& t : trees) treeBounds.push_back(propBounds(t));
+    }
+    if (changed & (1u << CULL_ROCK)) {
+        rockBounds.clear();
+        for (const auto& r : rocks) rockBounds.push_back(propBounds(r));
+    }
 }
 
 
+void clearArenaGeometry() {
+    cubes.clear(); ramps.clear(); bushes.clear(); trees.clear(); rocks.clear();
+    syncArenaHandles(arenaCubeHandles, 0);
+    syncArenaHandles(arenaRampHandles, 0);
+    clearCoins();
+    for (int i = 0; i < GRID_SIZE; ++i)
+        for (int j = 0; j < GRID_SIZE; ++j)
+            arenaHeights[i][j] = 0.0f;
+}
+
 void setupArenaGeometry() {
-    cubes.clear(); ramps.clear(); bushes.clear(); trees.clear();
+    clearArenaGeometry();
     CreateRamp(1.0f, 1.0f, -3.0f, 2.0f, 2.0f, 1.0f, 'x'); 
     CreateCube(7.0f, 2.0f, -3.0f, 10.0f, 1.0f, 1.0f); 
     CreateCube(10.0f, 2.0f, -3.0f, 1.0f, 1.0f, 10.0f); 
@@ -471,12 +344,1301 @@ void setupArenaGeometry() {
     CreateRock(5.0f, 0.0f, -25.0f, 0.9f);    
     CreateRock(-29.91f, 0.50f, -16.21f, 1.3f);   
     CreateRock(-25.89f, 0.50f, 29.16f, 0.9f);    
+
+    finalizeArenaGeometry();
 }
 
+void finalizeArenaGeometry() {
+    buildArenaSpatialGrid();
+    buildArenaHeightfield();
+    buildArenaBounds();
+    buildArenaCullGrid();
+    buildArenaLod();
+}
+
+
+// ---------------------------------------------------------------------------
+// Broadphase: grid 2D seragam di atas area XZ (+-BOUNDS). Setiap cell menyimpan
+// handle cube dan ramp yang footprint-nya (diperlebar sedikit untuk pita epsilon
+// dinding) menyentuh cell tersebut, urut index naik supaya hasil query identik
+// dengan scan linear (urutan cube lalu ramp ikut menentukan tie-break).
+// Di samping handle, field primitive yang dipakai query (batas footprint, tinggi,
+// normal lereng) disimpan SoA per blok 4 slot, jadi query batch membaca kandidat cell
+// berurutan dan mengetes 4 kandidat per instruksi SIMD. Tiap cell punya blok slot
+// sendiri, kapasitas kelipatan 4; slot kosong berisi sentinel yang tidak pernah
+// valid, jadi sisa blok ikut dites tanpa mask. Edit menulis ulang blok cell yang
+// disentuh saja; blok yang penuh pindah ke ujung array.
+// ---------------------------------------------------------------------------
+static const float arenaGridMargin = 0.02f; // >= epsilon terbesar di fungsi query
+static const int arenaGridMinDim = 16;
+static const int arenaGridMaxDim = 256;
+static const int arenaGridLanes = 4;
+
+// Field SoA. LOW_Y = bawah cube / pangkal ramp, sisanya khusus ramp.
+enum {
+    GRID_MIN_X, GRID_MAX_X, GRID_MIN_Z, GRID_MAX_Z, GRID_TOP_Y, GRID_LOW_Y, GRID_CUBE_FIELDS,
+    GRID_SIZE_Y = GRID_CUBE_FIELDS, GRID_LENGTH, GRID_AXIS_Z, GRID_SLOPE_NX, GRID_SLOPE_NY, GRID_SLOPE_NZ,
+    GRID_RAMP_FIELDS
+};
+
+struct ArenaGridLayer {
+    std::vector<int> start, count, cap; // Per cell: blok [start, start + cap), count pertama terisi
+    std::vector<int> index;             // Handle per slot, -1 = kosong
+    std::vector<float> fields;          // Per 4 slot: numFields x 4 float, field per field
+    int numFields;
+    int used; // Slot terpakai termasuk blok lama yang ditinggal pindah
+    int live; // Jumlah entri semua cell
+};
+
+static bool arenaGridEnabled = true;
+static int arenaGridDim = 0;
+static float arenaGridCellSize = 1.0f;
+static ArenaGridLayer arenaGridCubes = {{}, {}, {}, {}, {}, GRID_CUBE_FIELDS, 0, 0};
+static ArenaGridLayer arenaGridRamps = {{}, {}, {}, {}, {}, GRID_RAMP_FIELDS, 0, 0};
+
+// Field f satu slot
+static inline const float* arenaGridField(const ArenaGridLayer& g, int slot, int f) {
+    return &g.fields[(size_t)(slot & ~(arenaGridLanes - 1)) * g.numFields + f * arenaGridLanes + (slot & (arenaGridLanes - 1))];
+}
+
+static inline float* arenaGridField(ArenaGridLayer& g, int slot, int f) {
+    return const_cast<float*>(arenaGridField((const ArenaGridLayer&)g, slot, f));
+}
+
+// Field f 4 slot blok yang mulai di slot s (kelipatan 4), satu load SIMD
+static inline const float* arenaGridBlock(const ArenaGridLayer& g, int s, int f) {
+    return &g.fields[(size_t)s * g.numFields + f * arenaGridLanes];
+}
+
+static int arenaGridCoord(float v) {
+    int c = (int)floor((v + BOUNDS) / arenaGridCellSize); // v relatif ke origin
+    if (c < 0) return 0;
+    if (c >= arenaGridDim) return arenaGridDim - 1;
+    return c;
+}
+
+static void arenaGridCellRange(float x, float z, float sizeX, float sizeZ, int& i0, int& i1, int& j0, int& j1) {
+    x -= arenaOriginX;
+    z -= arenaOriginZ;
+    i0 = arenaGridCoord(x - sizeX / 2.0f - arenaGridMargin);
+    i1 = arenaGridCoord(x + sizeX / 2.0f + arenaGridMargin);
+    j0 = arenaGridCoord(z - sizeZ / 2.0f - arenaGridMargin);
+    j1 = arenaGridCoord(z + sizeZ / 2.0f + arenaGridMargin);
+}
+
+static int arenaGridRoundUp(int n) {
+    return (n + arenaGridLanes - 1) / arenaGridLanes * arenaGridLanes;
+}
+
+// Field dihitung dengan ekspresi yang sama persis dengan getArenaHeightAndNormalAt
+static void arenaGridRow(const ArenaCube& c, float* row) {
+    row[GRID_MIN_X] = c.x - c.sizeX / 2.0f;
+    row[GRID_MAX_X] = c.x + c.sizeX / 2.0f;
+    row[GRID_MIN_Z] = c.z - c.sizeZ / 2.0f;
+    row[GRID_MAX_Z] = c.z + c.sizeZ / 2.0f;
+    row[GRID_TOP_Y] = c.y + c.sizeY / 2.0f;
+    row[GRID_LOW_Y] = c.y - c.sizeY / 2.0f;
+}
+
+static void arenaGridRow(const ArenaRamp& r, float* row) {
+    row[GRID_MIN_X] = r.x - r.sizeX / 2.0f;
+    row[GRID_MAX_X] = r.x + r.sizeX / 2.0f;
+    row[GRID_MIN_Z] = r.z - r.sizeZ / 2.0f;
+    row[GRID_MAX_Z] = r.z + r.sizeZ / 2.0f;
+    row[GRID_TOP_Y] = r.y + r.sizeY / 2.0f;
+    row[GRID_LOW_Y] = r.y - r.sizeY / 2.0f;
+    row[GRID_SIZE_Y] = r.sizeY;
+    row[GRID_LENGTH] = r.axis == 'z' ? r.sizeZ : r.sizeX;
+    row[GRID_AXIS_Z] = r.axis == 'z' ? 1.0f : 0.0f;
+    // Normal lereng konstan per ramp
+    float nx, ny, nz;
+    if (r.axis == 'z') {
+        nx = 0; ny = r.sizeZ; nz = -r.sizeY;
+    } else {
+        nx = -r.sizeY; ny = r.sizeX; nz = 0;
+    }
+    float len = sqrt(nx*nx + ny*ny + nz*nz);
+    if (len > 1e-6) { nx /= len; ny /= len; nz /= len; }
+    if (ny < 0) { nx *= -1; ny *= -1; nz *= -1; }
+    row[GRID_SLOPE_NX] = nx;
+    row[GRID_SLOPE_NY] = ny;
+    row[GRID_SLOPE_NZ] = nz;
+}
+
+static inline void arenaGridPut(ArenaGridLayer& g, int slot, int id, const float* row) {
+    g.index[slot] = id;
+    float* block = &g.fields[(size_t)(slot & ~(arenaGridLanes - 1)) * g.numFields + (slot & (arenaGridLanes - 1))];
+    for (int f = 0; f < g.numFields; ++f) block[f * arenaGridLanes] = row[f];
+}
+
+template <typename Prim>
+static void arenaGridWrite(ArenaGridLayer& g, int slot, int id, const Prim& p) {
+    float row[GRID_RAMP_FIELDS];
+    arenaGridRow(p, row);
+    arenaGridPut(g, slot, id, row);
+}
+
+// Sentinel: footprint terbalik di tak hingga, semua tes footprint gagal
+static void arenaGridClear(ArenaGridLayer& g, int slot) {
+    g.index[slot] = -1;
+    *arenaGridField(g, slot, GRID_MIN_X) = INFINITY;
+    *arenaGridField(g, slot, GRID_MAX_X) = -INFINITY;
+    *arenaGridField(g, slot, GRID_MIN_Z) = INFINITY;
+    *arenaGridField(g, slot, GRID_MAX_Z) = -INFINITY;
+    for (int f = GRID_TOP_Y; f < g.numFields; ++f) *arenaGridField(g, slot, f) = 0.0f;
+    if (g.numFields > GRID_LENGTH) *arenaGridField(g, slot, GRID_LENGTH) = 1.0f;
+}
+
+// Tambah slot kosong (sentinel) di ujung, return slot pertama
+static int arenaGridGrow(ArenaGridLayer& g, int slots) {
+    int first = g.used;
+    g.used += slots;
+    if ((int)g.index.size() < g.used) {
+        size_t size = arenaGridRoundUp(g.used + g.used / 4);
+        g.index.resize(size);
+        g.fields.resize(size * g.numFields);
+        for (int s = first; s < (int)size; ++s) arenaGridClear(g, s);
+    }
+    return first;
+}
+
+// Dua pass (hitung lalu isi): blok cell berurutan, kapasitas = count dibulatkan ke 4
+template <typename Prim>
+static void arenaGridFill(const std::vector<Prim>& prims, const ArenaHandles& handles, ArenaGridLayer& g) {
+    int numCells = arenaGridDim * arenaGridDim;
+    g.count.assign(numCells, 0);
+    for (const auto& p : prims) {
+        int i0, i1, j0, j1;
+        arenaGridCellRange(p.x, p.z, p.sizeX, p.sizeZ, i0, i1, j0, j1);
+        for (int j = j0; j <= j1; ++j)
+            for (int i = i0; i <= i1; ++i)
+                g.count[j * arenaGridDim + i]++;
+    }
+    g.start.resize(numCells);
+    g.cap.resize(numCells);
+    g.used = 0;
+    g.live = 0;
+    for (int c = 0; c < numCells; ++c) {
+        g.start[c] = g.used;
+        g.cap[c] = arenaGridRoundUp(g.count[c]);
+        g.used += g.cap[c];
+        g.live += g.count[c];
+    }
+    // Ruang di ujung untuk blok yang pindah waktu edit, supaya tidak realokasi
+    size_t size = arenaGridRoundUp(g.used + g.used / 8);
+    g.index.resize(size);
+    g.fields.resize(size * g.numFields);
+    std::vector<int> cursor(g.start);
+    for (int k = 0; k < (int)prims.size(); ++k) {
+        int i0, i1, j0, j1;
+        arenaGridCellRange(prims[k].x, prims[k].z, prims[k].sizeX, prims[k].sizeZ, i0, i1, j0, j1);
+        for (int j = j0; j <= j1; ++j)
+            for (int i = i0; i <= i1; ++i)
+                g.index[cursor[j * arenaGridDim + i]++] = k;
+    }
+    // Field ditulis per cell berurutan; menulis langsung dari loop primitive di
+    // atas melompat-lompat ke seluruh array dan hampir tiap tulisan cache miss.
+    // Satu primitive masuk banyak cell, jadi field-nya dihitung sekali dulu.
+    std::vector<float> rows(prims.size() * g.numFields);
+    for (size_t k = 0; k < prims.size(); ++k) arenaGridRow(prims[k], &rows[k * g.numFields]);
+    for (int c = 0; c < numCells; ++c) {
+        int s = g.start[c];
+        for (int end = s + g.count[c]; s < end; ++s) {
+            int k = g.index[s];
+            arenaGridPut(g, s, handles.handleOf[k], &rows[(size_t)k * g.numFields]);
+        }
+        for (int end = g.start[c] + g.cap[c]; s < end; ++s) arenaGridClear(g, s);
+    }
+    for (int s = g.used; s < (int)size; ++s) arenaGridClear(g, s);
+}
+
+// Resolusi mengikuti jumlah primitive: ~1 primitive per cell, dibatasi min/max.
+// Kelipatan 4, jadi geser jendela streaming satu chunk (seperempat arena) = geser
+// cell bulat (lihat shiftArenaWindow).
+static int arenaGridDimFor(int count) {
+    int dim = (int)ceil(sqrt((float)count));
+    dim = (dim + 3) / 4 * 4;
+    if (dim < arenaGridMinDim) dim = arenaGridMinDim;
+    if (dim > arenaGridMaxDim) dim = arenaGridMaxDim;
+    return dim;
+}
+
+struct ArenaGridRect {
+    int i0, i1, j0, j1;
+};
+
+template <typename Prim>
+static ArenaGridRect arenaGridRect(const Prim& p) {
+    ArenaGridRect r;
+    arenaGridCellRange(p.x, p.z, p.sizeX, p.sizeZ, r.i0, r.i1, r.j0, r.j1);
+    return r;
+}
+
+// Tambal grid untuk edit beberapa primitive: di cell dalam rect dirty (dan rect
+// handle di add), handle di drop dan handle yang sudah bebas dibuang, lalu handle
+// di add yang footprint-nya (posisi sekarang) menyentuh cell disisipkan urut index,
+// dan blok cell ditulis ulang dari prims. Cell lain tidak disentuh: index yang
+// bergeser karena reload tidak mengubah urutan maupun handle di sana. Kalau blok
+// lama yang ditinggal pindah sudah lebih banyak dari isinya, grid diisi ulang rapat.
+template <typename Prim>
+static void arenaGridPatch(const std::vector<Prim>& prims, const ArenaHandles& handles, ArenaGridLayer& g,
+                           const int* drop, int numDrop, const int* add, int numAdd,
+                           const ArenaGridRect* dirty, int numDirty) {
+    static std::vector<unsigned char> dirtyMark, dropMark;
+    static std::vector<int> dirtyCells, ids, addIds, addStart, addCursor, addCells;
+    const int* indexOf = handles.indexOf.data();
+    int numCells = arenaGridDim * arenaGridDim;
+    dirtyMark.assign(numCells, 0);
+    dirtyCells.clear();
+    auto markCell = [&](int c) {
+        if (!dirtyMark[c]) { dirtyMark[c] = 1; dirtyCells.push_back(c); }
+    };
+    for (int d = 0; d < numDirty; ++d)
+        for (int j = dirty[d].j0; j <= dirty[d].j1; ++j)
+            for (int i = dirty[d].i0; i <= dirty[d].i1; ++i)
+                markCell(j * arenaGridDim + i);
+    // Index yang ditambah per cell, urut index: counting sort per cell dari index
+    // yang sudah urut (add bisa ribuan waktu jendela streaming bergeser)
+    addIds.clear();
+    for (int a = 0; a < numAdd; ++a) addIds.push_back(indexOf[add[a]]);
+    std::sort(addIds.begin(), addIds.end());
+    addStart.assign(numCells + 1, 0);
+    for (int k : addIds) {
+        ArenaGridRect r = arenaGridRect(prims[k]);
+        for (int j = r.j0; j <= r.j1; ++j) {
+            for (int i = r.i0; i <= r.i1; ++i) {
+                markCell(j * arenaGridDim + i);
+                ++addStart[j * arenaGridDim + i + 1];
+            }
+        }
+    }
+    for (int c = 0; c < numCells; ++c) addStart[c + 1] += addStart[c];
+    addCells.resize(addStart[numCells]);
+    addCursor.assign(addStart.begin(), addStart.end() - 1);
+    for (int k : addIds) {
+        ArenaGridRect r = arenaGridRect(prims[k]);
+        for (int j = r.j0; j <= r.j1; ++j)
+            for (int i = r.i0; i <= r.i1; ++i)
+                addCells[addCursor[j * arenaGridDim + i]++] = k;
+    }
+    std::sort(dirtyCells.begin(), dirtyCells.end());
+    // Drop banyak (jendela streaming): cek per entri lewat tanda per handle
+    bool markDrop = numDrop > 16;
+    if (markDrop) {
+        dropMark.assign(handles.indexOf.size(), 0);
+        for (int d = 0; d < numDrop; ++d) dropMark[drop[d]] = 1;
+    }
+    auto dropped = [&](int handle) {
+        return markDrop ? dropMark[handle] != 0 : std::find(drop, drop + numDrop, handle) != drop + numDrop;
+    };
+
+    // ids di sini index (untuk urutan), ditulis kembali sebagai handle
+    for (int c : dirtyCells) {
+        ids.clear();
+        const int* first = g.index.data() + g.start[c];
+        for (const int* it = first; it != first + g.count[c]; ++it) {
+            if (indexOf[*it] < 0 || dropped(*it)) continue;
+            ids.push_back(indexOf[*it]);
+        }
+        size_t mid = ids.size();
+        ids.insert(ids.end(), addCells.begin() + addStart[c], addCells.begin() + addStart[c + 1]);
+        std::inplace_merge(ids.begin(), ids.begin() + mid, ids.end());
+
+        int n = (int)ids.size();
+        int oldCount = g.count[c];
+        if (n > g.cap[c]) {
+            // Blok penuh: pindah ke ujung dengan ruang tambah, blok lama jadi lubang
+            int cap = arenaGridRoundUp(n + n / 2);
+            g.start[c] = arenaGridGrow(g, cap);
+            g.cap[c] = cap;
+            oldCount = 0;
+        }
+        for (int s = 0; s < n; ++s) arenaGridWrite(g, g.start[c] + s, handles.handleOf[ids[s]], prims[ids[s]]);
+        for (int s = n; s < oldCount; ++s) arenaGridClear(g, g.start[c] + s);
+        g.live += n - g.count[c];
+        g.count[c] = n;
+    }
+    if (g.used > 2 * arenaGridRoundUp(g.live) + numCells * arenaGridLanes) arenaGridFill(prims, handles, g);
+}
+
+// Geser isi grid (gi, gj) cell: cell baru (i, j) = cell lama (i + gi, j + gj).
+// Cell yang sumbernya di luar grid lama kosong; bloknya diambil dari cell lama yang
+// jatuh keluar (dikosongkan, urut cell), jadi strip baru biasanya muat tanpa blok
+// baru di ujung dan grid tidak cepat berlubang.
+static void arenaGridShift(ArenaGridLayer& g, int gi, int gj) {
+    static std::vector<int> start, count, cap, freeCells;
+    static std::vector<unsigned char> kept;
+    int dim = arenaGridDim;
+    start.assign(dim * dim, 0);
+    count.assign(dim * dim, 0);
+    cap.assign(dim * dim, 0);
+    kept.assign(dim * dim, 0);
+    g.live = 0;
+    for (int j = std::max(0, -gj); j < std::min(dim, dim - gj); ++j) {
+        for (int i = std::max(0, -gi); i < std::min(dim, dim - gi); ++i) {
+            int from = (j + gj) * dim + i + gi;
+            start[j * dim + i] = g.start[from];
+            count[j * dim + i] = g.count[from];
+            cap[j * dim + i] = g.cap[from];
+            kept[from] = 1;
+            g.live += g.count[from];
+        }
+    }
+    freeCells.clear();
+    for (int c = 0; c < dim * dim; ++c) {
+        if (kept[c]) continue;
+        for (int s = g.start[c]; s < g.start[c] + g.count[c]; ++s) arenaGridClear(g, s);
+        freeCells.push_back(c);
+    }
+    size_t nextFree = 0;
+    for (int j = 0; j < dim; ++j) {
+        for (int i = 0; i < dim; ++i) {
+            bool inside = i + gi >= 0 && i + gi < dim && j + gj >= 0 && j + gj < dim;
+            if (inside || nextFree == freeCells.size()) continue;
+            int from = freeCells[nextFree++];
+            start[j * dim + i] = g.start[from];
+            cap[j * dim + i] = g.cap[from];
+        }
+    }
+    g.start.swap(start);
+    g.count.swap(count);
+    g.cap.swap(cap);
+}
+
+// Jendela streaming: resolusi lama dipakai terus selama jumlah primitive masih
+// dalam faktor 1.5 dari resolusi idealnya, supaya grid cukup digeser
+static bool arenaGridDimFits(int count) {
+    int ideal = arenaGridDimFor(count);
+    return arenaGridDim > 0 && 2 * ideal <= 3 * arenaGridDim && 2 * arenaGridDim <= 3 * ideal;
+}
+
+void buildArenaSpatialGrid() {
+    int dim = arenaGridDimFor((int)(cubes.size() + ramps.size()));
+    arenaGridDim = dim;
+    arenaGridCellSize = (2.0f * BOUNDS) / dim;
+    syncArenaHandles(arenaCubeHandles, (int)cubes.size());
+    syncArenaHandles(arenaRampHandles, (int)ramps.size());
+    arenaGridFill(cubes, arenaCubeHandles, arenaGridCubes);
+    arenaGridFill(ramps, arenaRampHandles, arenaGridRamps);
+    ++arenaSolidVersionCounter;
+}
+
+unsigned arenaSolidVersion() {
+    return arenaSolidVersionCounter;
+}
+
+void setArenaSpatialGridEnabled(bool enabled) {
+    arenaGridEnabled = enabled;
+}
+
+// Kandidat untuk titik (x, z) dalam bentuk handle. nullptr berarti "semua primitive"
+// (scan linear, langsung index).
+static void arenaCandidates(float x, float z, const int*& cubeIdx, int& numCubes, const int*& rampIdx, int& numRamps) {
+    if (!arenaGridEnabled || arenaGridDim == 0) {
+        cubeIdx = nullptr; numCubes = (int)cubes.size();
+        rampIdx = nullptr; numRamps = (int)ramps.size();
+        return;
+    }
+    int cell = arenaGridCoord(z - arenaOriginZ) * arenaGridDim + arenaGridCoord(x - arenaOriginX);
+    cubeIdx = arenaGridCubes.index.data() + arenaGridCubes.start[cell];
+    numCubes = arenaGridCubes.count[cell];
+    rampIdx = arenaGridRamps.index.data() + arenaGridRamps.start[cell];
+    numRamps = arenaGridRamps.count[cell];
+}
+
+// ---------------------------------------------------------------------------
+// Fast path heightfield: arenaHeights disampling bilinear, normal diambil dari
+// gradien per cell yang dihitung sekali. Query exact memilih permukaan yang
+// lebih tinggi > epsilon dari kandidat lain; tie-break (dinding, normal, tanah)
+// hanya berlaku di dalam epsilon. Kandidat cell diurutkan menurut batas atas
+// tingginya di cell. Kalau k teratas memuat permukaan yang menutup cell penuh
+// (atau tanah) dan batas bawah k itu lebih tinggi dari batas atas sisanya plus
+// margin (> epsilon), sisanya tidak pernah menang maupun ikut tie-break di titik
+// mana pun di cell. k = 1: cell cukup diinterpolasi. Selain itu (pita tepi/dinding,
+// permukaan berimpit) cell menyimpan primitive k itu dan query exact hanya
+// mengetes mereka, bukan seluruh kandidat cell grid.
+// ---------------------------------------------------------------------------
+static const int HF_CELLS = GRID_SIZE - 1;
+static const float arenaHeightfieldStep = (2.0f * BOUNDS) / (GRID_SIZE - 1);
+static const float arenaHeightfieldMargin = 0.02f; // >= epsilon dinding di query exact
+static const int HF_CELL_PRIMS = 7;
+
+static bool arenaHeightfieldEnabled = true;
+static bool arenaHeightfieldBuilt = false;
+// heightGridOrigin origin jendela saat heightfield dibangun/digeser
+static GridOrigin arenaHeightOrigin = {0.0f, 0.0f};
+// Satu cell = satu cache line setengah: bilinear h + dx*tx + dz*tz + dxz*tx*tz,
+// normal, dan mode cell, jadi sampling cukup satu load dari memori
+enum { HF_CELL_SAMPLE = 0, HF_CELL_LIST = 1 };
+struct alignas(32) ArenaHeightCell {
+    float h, dx, dz, dxz;
+    float nx, ny, nz;
+    int mode;
+};
+static ArenaHeightCell arenaCells[HF_CELLS][HF_CELLS];
+// Primitive cell HF_CELL_LIST: handle cube dulu lalu ramp, masing-masing urut index
+// naik (urutan yang sama dengan cell grid, jadi tie-break tidak berubah). Sampai
+// HF_CELL_PRIMS disimpan di ids, lebih dari itu di arenaCellLongPrims.
+struct alignas(32) ArenaCellPrims {
+    unsigned short numCubes, numRamps;
+    int ids[HF_CELL_PRIMS];
+};
+static ArenaCellPrims arenaCellPrims[HF_CELLS][HF_CELLS];
+static std::vector<int> arenaCellLongPrims[HF_CELLS][HF_CELLS];
+
+static int* heightCellIds(int i, int j) {
+    ArenaCellPrims& prims = arenaCellPrims[i][j];
+    return prims.numCubes + prims.numRamps <= HF_CELL_PRIMS ? prims.ids : arenaCellLongPrims[i][j].data();
+}
+
+// Sementara saat build: kandidat per cell urut turun menurut batas atas (inline
+// sampai HF_CELL_BUILD, lebih dari itu di arenaCellAll). covers = permukaan menutup
+// cell penuh (tanah juga); prefix* = gabungan kandidat 0..ini. arenaCellFirst =
+// posisi pertama yang prefix-nya menutup cell dan batas bawahnya (arenaCellReady)
+// di atas kandidat berikutnya plus margin. Primitive dicatat urut topY turun, jadi
+// begitu arenaCellReady juga di atas topY primitive berikutnya plus margin, cell
+// selesai: arenaCellFirst + 1 kandidat teratas, sisa primitive dilewati.
+enum { HF_GROUND, HF_CUBE, HF_RAMP };
+struct ArenaCellCandidate {
+    float low, high, prefixLow;
+    int id;
+    unsigned char kind;
+    bool covers, prefixCovers;
+};
+static const int HF_CELL_BUILD = 8;
+static ArenaCellCandidate arenaCellTop[HF_CELLS][HF_CELLS][HF_CELL_BUILD];
+static std::vector<ArenaCellCandidate> arenaCellAll[HF_CELLS][HF_CELLS];
+static unsigned short arenaCellCount[HF_CELLS][HF_CELLS];
+static unsigned short arenaCellFirst[HF_CELLS][HF_CELLS];
+static float arenaCellReady[HF_CELLS][HF_CELLS]; // prefixLow di arenaCellFirst
+
+static ArenaCellCandidate* cellCandidates(int i, int j) {
+    return arenaCellCount[i][j] <= HF_CELL_BUILD ? arenaCellTop[i][j] : arenaCellAll[i][j].data();
+}
+
+static void addCellCandidate(int i, int j, const ArenaCellCandidate& c) {
+    int n = arenaCellCount[i][j];
+    ArenaCellCandidate* top = arenaCellTop[i][j];
+    if (n >= HF_CELL_BUILD) {
+        std::vector<ArenaCellCandidate>& all = arenaCellAll[i][j];
+        if (n == HF_CELL_BUILD) all.assign(top, top + n);
+        all.push_back(c);
+        top = all.data();
+    }
+    int k = n;
+    while (k > 0 && c.high > top[k - 1].high) {
+        top[k] = top[k - 1];
+        --k;
+    }
+    top[k] = c;
+    arenaCellCount[i][j] = (unsigned short)++n;
+    for (int q = k; q < n; ++q) {
+        top[q].prefixLow = q > 0 ? std::min(top[q - 1].prefixLow, top[q].low) : top[q].low;
+        top[q].prefixCovers = top[q].covers || (q > 0 && top[q - 1].prefixCovers);
+    }
+    // Posisi sebelum k - 1 tidak berubah; yang terakhir selalu memenuhi (ada tanah)
+    if (arenaCellFirst[i][j] < k - 1) return;
+    int first = std::max(k - 1, 0);
+    while (!(top[first].prefixCovers &&
+             top[first].prefixLow > (first + 1 < n ? top[first + 1].high : -FLT_MAX) + arenaHeightfieldMargin))
+        ++first;
+    arenaCellFirst[i][j] = (unsigned short)first;
+    arenaCellReady[i][j] = top[first].prefixLow;
+}
+
+// Footprint [minX,maxX]x[minZ,maxZ] satu primitive untuk build heightfield.
+// Permukaan naik linear dari baseY ke topY sepanjang axis ('x'/'z', 0 = datar).
+struct HeightMark {
+    float minX, maxX, minZ, maxZ, baseY, topY;
+    int id;
+    unsigned char kind;
+    char axis;
+};
+
+static HeightMark heightMark(const ArenaCube& c, int id) {
+    float topY = c.y + c.sizeY / 2.0f;
+    return {c.x - c.sizeX / 2.0f, c.x + c.sizeX / 2.0f, c.z - c.sizeZ / 2.0f, c.z + c.sizeZ / 2.0f, topY, topY,
+            id, HF_CUBE, 0};
+}
+
+static HeightMark heightMark(const ArenaRamp& r, int id) {
+    return {r.x - r.sizeX / 2.0f, r.x + r.sizeX / 2.0f, r.z - r.sizeZ / 2.0f, r.z + r.sizeZ / 2.0f,
+            r.y - r.sizeY / 2.0f, r.y + r.sizeY / 2.0f, id, HF_RAMP, r.axis == 'x' ? 'x' : 'z'};
+}
+
+// Catat primitive di cell region yang disentuh footprint-nya. bound = topY tertinggi
+// primitive ini dan semua yang dicatat sesudahnya. Ramp dicatat dua bagian:
+// permukaan di rentang cell dan dinding setinggi topY (hanya kalau cell menyentuh
+// pita dinding), supaya rentangnya tidak menutup celah. mask (boleh nullptr)
+// membatasi ke cell region yang ditandai.
+typedef unsigned char HeightCellMask[HF_CELLS][HF_CELLS];
+
+static void markHeightfieldFootprint(const HeightfieldRegion& region, const HeightMark& p, float bound,
+                                     const HeightCellMask* mask) {
+    const float m = arenaHeightfieldMargin;
+    const float minX = p.minX, maxX = p.maxX, minZ = p.minZ, maxZ = p.maxZ;
+    const float baseY = p.baseY, topY = p.topY;
+    const char axis = p.axis;
+    int i0 = (int)floor((minX - arenaHeightOrigin.x - m + BOUNDS) / arenaHeightfieldStep);
+    int i1 = (int)floor((maxX - arenaHeightOrigin.x + m + BOUNDS) / arenaHeightfieldStep);
+    int j0 = (int)floor((minZ - arenaHeightOrigin.z - m + BOUNDS) / arenaHeightfieldStep);
+    int j1 = (int)floor((maxZ - arenaHeightOrigin.z + m + BOUNDS) / arenaHeightfieldStep);
+    if (i0 < region.i0) i0 = region.i0;
+    if (j0 < region.j0) j0 = region.j0;
+    if (i1 > region.i1) i1 = region.i1;
+    if (j1 > region.j1) j1 = region.j1;
+    for (int i = i0; i <= i1; ++i) {
+        float cx0 = arenaHeightOrigin.x + (-BOUNDS + i * arenaHeightfieldStep);
+        float cx1 = cx0 + arenaHeightfieldStep;
+        for (int j = j0; j <= j1; ++j) {
+            if (mask && !(*mask)[i][j]) continue;
+            if (arenaCellReady[i][j] > bound + m) continue;
+            float cz0 = arenaHeightOrigin.z + (-BOUNDS + j * arenaHeightfieldStep);
+            float cz1 = cz0 + arenaHeightfieldStep;
+            bool covers = cx0 >= minX + m && cx1 <= maxX - m && cz0 >= minZ + m && cz1 <= maxZ - m;
+            if (axis == 0) {
+                addCellCandidate(i, j, {topY, topY, 0.0f, p.id, p.kind, covers, false});
+                continue;
+            }
+            float a0 = axis == 'x' ? cx0 : cz0, a1 = axis == 'x' ? cx1 : cz1;
+            float lo = axis == 'x' ? minX : minZ, hi = axis == 'x' ? maxX : maxZ;
+            if (cx1 >= minX && cx0 <= maxX && cz1 >= minZ && cz0 <= maxZ) {
+                float s0 = baseY + clamp((a0 - lo) / (hi - lo), 0.0f, 1.0f) * (topY - baseY);
+                float s1 = baseY + clamp((a1 - lo) / (hi - lo), 0.0f, 1.0f) * (topY - baseY);
+                addCellCandidate(i, j, {s0, s1, 0.0f, p.id, p.kind, covers, false});
+            }
+            // Dinding ramp: dua sisi samping dan ujung atas
+            bool nearMinX = cx0 <= minX + m && cx1 >= minX - m, nearMaxX = cx0 <= maxX + m && cx1 >= maxX - m;
+            bool nearMinZ = cz0 <= minZ + m && cz1 >= minZ - m, nearMaxZ = cz0 <= maxZ + m && cz1 >= maxZ - m;
+            bool wall = axis == 'x' ? nearMinZ || nearMaxZ || nearMaxX : nearMinX || nearMaxX || nearMaxZ;
+            if (wall) addCellCandidate(i, j, {topY, topY, 0.0f, p.id, p.kind, false, false});
+        }
+    }
+}
+
+// Mode cell dari keep kandidat teratasnya; list mengisi arenaCellPrims
+static int setHeightCellPrims(int i, int j, const ArenaCellCandidate* top, int keep) {
+    static std::vector<int> ids;
+    if (keep == 1) return HF_CELL_SAMPLE;
+    ids.clear();
+    for (int k = 0; k < keep; ++k)
+        if (top[k].kind == HF_CUBE) ids.push_back(top[k].id);
+    int numCubes = (int)ids.size();
+    std::sort(ids.begin(), ids.end());
+    // Ramp bisa tercatat dua kali (permukaan dan dinding)
+    for (int k = 0; k < keep; ++k)
+        if (top[k].kind == HF_RAMP) ids.push_back(top[k].id);
+    std::sort(ids.begin() + numCubes, ids.end());
+    ids.erase(std::unique(ids.begin() + numCubes, ids.end()), ids.end());
+    for (int k = 0; k < (int)ids.size(); ++k)
+        ids[k] = (k < numCubes ? arenaCubeHandles : arenaRampHandles).handleOf[ids[k]];
+    ArenaCellPrims& prims = arenaCellPrims[i][j];
+    prims.numCubes = (unsigned short)numCubes;
+    prims.numRamps = (unsigned short)(ids.size() - numCubes);
+    if ((int)ids.size() <= HF_CELL_PRIMS) {
+        std::copy(ids.begin(), ids.end(), prims.ids);
+        arenaCellLongPrims[i][j].clear();
+    } else {
+        arenaCellLongPrims[i][j] = ids;
+    }
+    return HF_CELL_LIST;
+}
+
+// Catat primitive urut topY turun: counting sort ke HF_MARK_BUCKETS ember, bound
+// tiap ember = topY tertinggi di ember itu dan ember sesudahnya
+static const int HF_MARK_BUCKETS = 1024;
+
+static void markHeightCandidates(const HeightfieldRegion& region, const std::vector<int>* cubeIds,
+                                 const std::vector<int>* rampIds, const HeightCellMask* mask) {
+    static std::vector<HeightMark> marks, sorted;
+    static int bucketStart[HF_MARK_BUCKETS + 1];
+    static float bucketBound[HF_MARK_BUCKETS];
+    marks.clear();
+    if (cubeIds) {
+        for (int k : *cubeIds) marks.push_back(heightMark(cubes[k], k));
+    } else {
+        for (int k = 0; k < (int)cubes.size(); ++k) marks.push_back(heightMark(cubes[k], k));
+    }
+    if (rampIds) {
+        for (int k : *rampIds) marks.push_back(heightMark(ramps[k], k));
+    } else {
+        for (int k = 0; k < (int)ramps.size(); ++k) marks.push_back(heightMark(ramps[k], k));
+    }
+    if (marks.empty()) return;
+    float lo = FLT_MAX, hi = -FLT_MAX;
+    for (const HeightMark& p : marks) {
+        lo = std::min(lo, p.topY);
+        hi = std::max(hi, p.topY);
+    }
+    float scale = hi > lo ? (HF_MARK_BUCKETS - 1) / (hi - lo) : 0.0f;
+    auto bucketOf = [&](float topY) { return std::min(HF_MARK_BUCKETS - 1, std::max(0, (int)((hi - topY) * scale))); };
+    std::fill(bucketStart, bucketStart + HF_MARK_BUCKETS + 1, 0);
+    std::fill(bucketBound, bucketBound + HF_MARK_BUCKETS, -FLT_MAX);
+    for (const HeightMark& p : marks) {
+        int b = bucketOf(p.topY);
+        ++bucketStart[b + 1];
+        bucketBound[b] = std::max(bucketBound[b], p.topY);
+    }
+    for (int b = 0; b < HF_MARK_BUCKETS; ++b) bucketStart[b + 1] += bucketStart[b];
+    for (int b = HF_MARK_BUCKETS - 2; b >= 0; --b) bucketBound[b] = std::max(bucketBound[b], bucketBound[b + 1]);
+    sorted.resize(marks.size());
+    for (const HeightMark& p : marks) sorted[bucketStart[bucketOf(p.topY)]++] = p;
+    // bucketStart[b] sekarang awal ember b + 1
+    int b = 0;
+    for (int k = 0; k < (int)sorted.size(); ++k) {
+        while (k >= bucketStart[b]) ++b;
+        markHeightfieldFootprint(region, sorted[k], bucketBound[b], mask);
+    }
+}
+
+// Mode dan normal cell di region (hanya yang ditandai mask kalau ada). cubeIds/rampIds
+// = primitive yang mungkin menyentuh cell itu, nullptr = semua.
+static void buildHeightfieldRegion(const HeightfieldRegion& region, const std::vector<int>* cubeIds = nullptr,
+                                   const std::vector<int>* rampIds = nullptr, const HeightCellMask* mask = nullptr) {
+    // Tanah (tinggi 0) ikut sebagai kandidat yang menutup semua cell
+    for (int i = region.i0; i <= region.i1; ++i) {
+        for (int j = region.j0; j <= region.j1; ++j) {
+            if (mask && !(*mask)[i][j]) continue;
+            arenaCellTop[i][j][0] = {0.0f, 0.0f, 0.0f, -1, HF_GROUND, true, true};
+            arenaCellCount[i][j] = 1;
+            arenaCellFirst[i][j] = 0;
+            arenaCellReady[i][j] = 0.0f;
+        }
+    }
+    markHeightCandidates(region, cubeIds, rampIds, mask);
+    for (int i = region.i0; i <= region.i1; ++i) {
+        for (int j = region.j0; j <= region.j1; ++j) {
+            if (mask && !(*mask)[i][j]) continue;
+            ArenaHeightCell& cell = arenaCells[i][j];
+            const ArenaCellCandidate* top = cellCandidates(i, j);
+            cell.mode = setHeightCellPrims(i, j, top, arenaCellFirst[i][j] + 1);
+            cell.h = arenaHeights[i][j];
+            cell.dx = arenaHeights[i + 1][j] - arenaHeights[i][j];
+            cell.dz = arenaHeights[i][j + 1] - arenaHeights[i][j];
+            cell.dxz = (arenaHeights[i + 1][j + 1] - arenaHeights[i][j + 1]) - cell.dx;
+            // Gradien rata-rata dua sisi cell; untuk cell planar hasilnya eksak
+            float gx = ((arenaHeights[i + 1][j] - arenaHeights[i][j]) +
+                        (arenaHeights[i + 1][j + 1] - arenaHeights[i][j + 1])) / (2.0f * arenaHeightfieldStep);
+            float gz = ((arenaHeights[i][j + 1] - arenaHeights[i][j]) +
+                        (arenaHeights[i + 1][j + 1] - arenaHeights[i + 1][j])) / (2.0f * arenaHeightfieldStep);
+            float len = sqrt(gx * gx + 1.0f + gz * gz);
+            cell.nx = -gx / len;
+            cell.ny = 1.0f / len;
+            cell.nz = -gz / len;
+        }
+    }
+}
+
+// Kontributor heightfield: titik/cell dibagi ke tile 8 x 8, tiap tile mencatat
+// handle cube/ramp yang footprint-nya (plus margin dinding) menyentuh tile itu. Edit satu
+// primitive cukup menghitung ulang titik dan cell di footprint lama/barunya dari
+// kontributor tile di sana, bukan dari semua primitive. Entri tile ikut membawa
+// range titik primitive, jadi kontributor yang tidak menyentuh region disaring
+// tanpa membaca primitive-nya.
+static const int HF_TILE = 8;
+static const int HF_TILES = (GRID_SIZE + HF_TILE - 1) / HF_TILE;
+struct HeightTileEntry {
+    int handle;
+    HeightfieldRegion range;
+};
+static std::vector<HeightTileEntry> heightTileCubes[HF_TILES * HF_TILES];
+static std::vector<HeightTileEntry> heightTileRamps[HF_TILES * HF_TILES];
+static std::vector<unsigned> heightCubeStamp, heightRampStamp;
+static unsigned heightStamp = 0;
+
+// Titik grid (= index cell) yang bisa dipengaruhi primitive: titik rasterisasi
+// dan cell yang ditandai markHeightfieldFootprint
+template <typename Prim>
+static HeightfieldRegion primPointRange(const Prim& p) {
+    const float m = arenaHeightfieldMargin;
+    HeightfieldRegion r;
+    r.i0 = std::max(0, (int)floor((p.x - arenaHeightOrigin.x - p.sizeX / 2.0f - m + BOUNDS) / arenaHeightfieldStep));
+    r.i1 = std::min(GRID_SIZE - 1, (int)floor((p.x - arenaHeightOrigin.x + p.sizeX / 2.0f + m + BOUNDS) / arenaHeightfieldStep));
+    r.j0 = std::max(0, (int)floor((p.z - arenaHeightOrigin.z - p.sizeZ / 2.0f - m + BOUNDS) / arenaHeightfieldStep));
+    r.j1 = std::min(GRID_SIZE - 1, (int)floor((p.z - arenaHeightOrigin.z + p.sizeZ / 2.0f + m + BOUNDS) / arenaHeightfieldStep));
+    return r;
+}
+
+static void addToHeightTiles(std::vector<HeightTileEntry>* tiles, const HeightfieldRegion& r, int handle) {
+    if (r.i0 > r.i1 || r.j0 > r.j1) return;
+    for (int tj = r.j0 / HF_TILE; tj <= r.j1 / HF_TILE; ++tj)
+        for (int ti = r.i0 / HF_TILE; ti <= r.i1 / HF_TILE; ++ti)
+            tiles[tj * HF_TILES + ti].push_back({handle, r});
+}
+
+static void removeFromHeightTiles(std::vector<HeightTileEntry>* tiles, const HeightfieldRegion& r, int handle) {
+    if (r.i0 > r.i1 || r.j0 > r.j1) return;
+    for (int tj = r.j0 / HF_TILE; tj <= r.j1 / HF_TILE; ++tj) {
+        for (int ti = r.i0 / HF_TILE; ti <= r.i1 / HF_TILE; ++ti) {
+            std::vector<HeightTileEntry>& entries = tiles[tj * HF_TILES + ti];
+            auto it = std::find_if(entries.begin(), entries.end(),
+                                   [handle](const HeightTileEntry& e) { return e.handle == handle; });
+            if (it == entries.end()) continue;
+            *it = entries.back();
+            entries.pop_back();
+        }
+    }
+}
+
+static void buildHeightTiles() {
+    for (int t = 0; t < HF_TILES * HF_TILES; ++t) {
+        heightTileCubes[t].clear();
+        heightTileRamps[t].clear();
+    }
+    for (int k = 0; k < (int)cubes.size(); ++k)
+        addToHeightTiles(heightTileCubes, primPointRange(cubes[k]), arenaCubeHandles.handleOf[k]);
+    for (int k = 0; k < (int)ramps.size(); ++k)
+        addToHeightTiles(heightTileRamps, primPointRange(ramps[k]), arenaRampHandles.handleOf[k]);
+}
+
+// Kontributor (index) yang range-nya menyentuh region, tanpa duplikat. mask (boleh
+// nullptr) membatasi lagi ke primitive yang menyentuh cell bertanda; dicek O(1)
+// per entri lewat prefix sum 2D mask, tile tanpa cell bertanda dilewati.
+static void gatherHeightContributors(const HeightfieldRegion& r, std::vector<int>& cubeIds, std::vector<int>& rampIds,
+                                     const HeightCellMask* mask = nullptr) {
+    static int maskSum[HF_CELLS + 1][HF_CELLS + 1];
+    static unsigned char maskTiles[HF_TILES * HF_TILES];
+    cubeIds.clear();
+    rampIds.clear();
+    if (heightCubeStamp.size() < cubes.size()) heightCubeStamp.resize(cubes.size(), 0);
+    if (heightRampStamp.size() < ramps.size()) heightRampStamp.resize(ramps.size(), 0);
+    if (++heightStamp == 0) {
+        std::fill(heightCubeStamp.begin(), heightCubeStamp.end(), 0u);
+        std::fill(heightRampStamp.begin(), heightRampStamp.end(), 0u);
+        heightStamp = 1;
+    }
+    if (mask) {
+        memset(maskTiles, 0, sizeof(maskTiles));
+        for (int i = 0; i < HF_CELLS; ++i) {
+            for (int j = 0; j < HF_CELLS; ++j) {
+                maskSum[i + 1][j + 1] = maskSum[i][j + 1] + maskSum[i + 1][j] - maskSum[i][j] + (*mask)[i][j];
+                if ((*mask)[i][j]) maskTiles[(j / HF_TILE) * HF_TILES + i / HF_TILE] = 1;
+            }
+        }
+    }
+    auto touches = [&](const HeightfieldRegion& e) {
+        int i0 = std::max(e.i0, r.i0), i1 = std::min(e.i1, r.i1), j0 = std::max(e.j0, r.j0), j1 = std::min(e.j1, r.j1);
+        if (i0 > i1 || j0 > j1) return false;
+        if (!mask) return true;
+        i1 = std::min(i1, HF_CELLS - 1);
+        j1 = std::min(j1, HF_CELLS - 1);
+        return i0 <= i1 && j0 <= j1 && maskSum[i1 + 1][j1 + 1] - maskSum[i0][j1 + 1] - maskSum[i1 + 1][j0] + maskSum[i0][j0] > 0;
+    };
+    for (int tj = r.j0 / HF_TILE; tj <= r.j1 / HF_TILE; ++tj) {
+        for (int ti = r.i0 / HF_TILE; ti <= r.i1 / HF_TILE; ++ti) {
+            if (mask && !maskTiles[tj * HF_TILES + ti]) continue;
+            for (const HeightTileEntry& e : heightTileCubes[tj * HF_TILES + ti]) {
+                int k = arenaCubeHandles.indexOf[e.handle];
+                if (heightCubeStamp[k] == heightStamp || !touches(e.range)) continue;
+                heightCubeStamp[k] = heightStamp;
+                cubeIds.push_back(k);
+            }
+            for (const HeightTileEntry& e : heightTileRamps[tj * HF_TILES + ti]) {
+                int k = arenaRampHandles.indexOf[e.handle];
+                if (heightRampStamp[k] == heightStamp || !touches(e.range)) continue;
+                heightRampStamp[k] = heightStamp;
+                rampIds.push_back(k);
+            }
+        }
+    }
+}
+
+void buildArenaHeightfield() {
+    syncArenaHandles(arenaCubeHandles, (int)cubes.size());
+    syncArenaHandles(arenaRampHandles, (int)ramps.size());
+    arenaHeightOrigin = heightGridOrigin(arenaOriginX, arenaOriginZ);
+    buildHeightTiles();
+    buildHeightfieldRegion({0, HF_CELLS - 1, 0, HF_CELLS - 1});
+    arenaHeightfieldBuilt = true;
+}
+
+static bool samePrim(const ArenaCube& a, const ArenaCube& b) {
+    return a.x == b.x && a.y == b.y && a.z == b.z && a.sizeX == b.sizeX && a.sizeY == b.sizeY && a.sizeZ == b.sizeZ;
+}
+
+static bool samePrim(const ArenaRamp& a, const ArenaRamp& b) {
+    return a.x == b.x && a.y == b.y && a.z == b.z && a.sizeX == b.sizeX && a.sizeY == b.sizeY && a.sizeZ == b.sizeZ &&
+           a.axis == b.axis;
+}
+
+// Selisih simetris list lama dan baru dalam bentuk index: remap[lama] = index baru
+// atau -1 (hanya ada di list lama), added = index baru yang hanya ada di list baru.
+// Kedua list dijalani bersamaan; di baris yang beda dicari pasangan terdekat sampai
+// arenaMatchWindow ke depan (baris disisipkan/dihapus), kalau tidak ada dianggap
+// diganti. remap selalu naik, jadi cell grid broadphase tetap urut.
+static const int arenaMatchWindow = 64;
+
+template <typename Prim>
+static void matchSolids(const std::vector<Prim>& before, const std::vector<Prim>& after,
+                        std::vector<int>& remap, std::vector<int>& added) {
+    int n0 = (int)before.size(), n1 = (int)after.size();
+    remap.assign(n0, -1);
+    added.clear();
+    int i = 0, j = 0;
+    while (i < n0 && j < n1) {
+        if (samePrim(before[i], after[j])) {
+            remap[i++] = j++;
+            continue;
+        }
+        int skipNew = 0, skipOld = 0;
+        for (int d = 1; d <= arenaMatchWindow && skipNew == 0 && skipOld == 0; ++d) {
+            if (j + d < n1 && samePrim(before[i], after[j + d])) skipNew = d;
+            else if (i + d < n0 && samePrim(before[i + d], after[j])) skipOld = d;
+        }
+        if (skipNew > 0) {
+            for (int d = 0; d < skipNew; ++d) added.push_back(j++);
+        } else if (skipOld > 0) {
+            i += skipOld;
+        } else {
+            ++i;
+            added.push_back(j++);
+        }
+    }
+    while (j < n1) added.push_back(j++);
+}
+
+// Cell yang bisa berubah karena titik grid di range ini
+static HeightCellMask heightDirtyCells;
+
+static void markDirtyHeightCells(const HeightfieldRegion& points) {
+    if (points.i0 > points.i1 || points.j0 > points.j1) return;
+    // Titik (i, j) ikut menentukan cell (i - 1..i, j - 1..j)
+    int i0 = std::max(points.i0 - 1, 0), i1 = std::min(points.i1, HF_CELLS - 1);
+    int j0 = std::max(points.j0 - 1, 0), j1 = std::min(points.j1, HF_CELLS - 1);
+    for (int i = i0; i <= i1; ++i)
+        for (int j = j0; j <= j1; ++j)
+            heightDirtyCells[i][j] = 1;
+}
+
+// ---------------------------------------------------------------------------
+// Edit cube/ramp saat runtime. Titik arenaHeights di footprint lama/baru dihitung
+// ulang dari nol dengan kontributor tile (bukan max() yang hanya bisa naik), lalu
+// flag/normal cell di sekitarnya. Grid broadphase ditambal di cell footprint saja
+// (dibangun ulang penuh kalau resolusinya berubah), cull grid dibangun ulang.
+// ---------------------------------------------------------------------------
+static unsigned arenaPendingChanges = 0;
+static std::vector<int> editCubeIds, editRampIds;
+
+// Mode/normal cell yang ditentukan titik di range (juga list primitive-nya)
+static void rebuildHeightCells(const HeightfieldRegion& points) {
+    if (!arenaHeightfieldBuilt || points.i0 > points.i1 || points.j0 > points.j1) return;
+    // Titik (i, j) ikut menentukan cell (i - 1..i, j - 1..j)
+    HeightfieldRegion cells = {std::max(points.i0 - 1, 0), std::min(points.i1, HF_CELLS - 1),
+                               std::max(points.j0 - 1, 0), std::min(points.j1, HF_CELLS - 1)};
+    gatherHeightContributors(cells, editCubeIds, editRampIds);
+    buildHeightfieldRegion(cells, &editCubeIds, &editRampIds);
+}
+
+static void refreshHeightRegion(const HeightfieldRegion& points) {
+    if (points.i0 > points.i1 || points.j0 > points.j1) return;
+    for (int i = points.i0; i <= points.i1; ++i)
+        for (int j = points.j0; j <= points.j1; ++j)
+            arenaHeights[i][j] = 0.0f;
+    gatherHeightContributors(points, editCubeIds, editRampIds);
+    const GridOrigin& o = arenaHeightOrigin;
+    for (int k : editCubeIds) rasterizeCube(arenaHeights, o, cubes[k], &points);
+    for (int k : editRampIds) rasterizeRamp(arenaHeights, o, ramps[k], &points);
+    rebuildHeightCells(points);
+}
+
+// Satu jenis solid yang bisa diedit: array primitive plus struktur turunannya
+template <typename Prim>
+struct SolidEditTarget {
+    std::vector<Prim>& prims;
+    std::vector<ArenaBounds>& bounds;
+    std::vector<HeightTileEntry>* heightTiles;
+    ArenaHandles& handles;
+    ArenaGridLayer& grid;
+    ArenaCullKind kind;
+};
+
+template <typename Prim>
+static void finishSolidEdit(const SolidEditTarget<Prim>& t, const int* drop, int numDrop, const int* add, int numAdd,
+                            const ArenaGridRect* dirty, int numDirty) {
+    if (arenaGridDim == 0 || arenaGridDimFor((int)(cubes.size() + ramps.size())) != arenaGridDim) {
+        buildArenaSpatialGrid();
+    } else {
+        arenaGridPatch(t.prims, t.handles, t.grid, drop, numDrop, add, numAdd, dirty, numDirty);
+    }
+    rebuildArenaCullGrid(1u << t.kind);
+    arenaPendingChanges |= 1u << t.kind;
+    ++arenaSolidVersionCounter;
+}
+
+template <typename Prim>
+static int addSolid(const SolidEditTarget<Prim>& t, const Prim& prim) {
+    int index = (int)t.prims.size();
+    t.prims.push_back(prim);
+    t.bounds.push_back(solidBounds(prim));
+    int handle = allocArenaHandle(t.handles, index);
+    t.handles.handleOf.push_back(handle);
+    HeightfieldRegion range = primPointRange(prim);
+    addToHeightTiles(t.heightTiles, range, handle);
+    refreshHeightRegion(range);
+    ArenaGridRect dirty = arenaGridRect(prim);
+    finishSolidEdit(t, nullptr, 0, &handle, 1, &dirty, 1);
+    return index;
+}
+
+template <typename Prim>
+static void moveSolid(const SolidEditTarget<Prim>& t, int index, float x, float y, float z) {
+    Prim& prim = t.prims[index];
+    int handle = t.handles.handleOf[index];
+    HeightfieldRegion before = primPointRange(prim);
+    ArenaGridRect dirty[2] = {arenaGridRect(prim), {}};
+    removeFromHeightTiles(t.heightTiles, before, handle);
+    prim.x = x; prim.y = y; prim.z = z;
+    t.bounds[index] = solidBounds(prim);
+    HeightfieldRegion after = primPointRange(prim);
+    dirty[1] = arenaGridRect(prim);
+    addToHeightTiles(t.heightTiles, after, handle);
+    refreshHeightRegion(before);
+    refreshHeightRegion(after);
+    finishSolidEdit(t, &handle, 1, &handle, 1, dirty, 2);
+}
+
+template <typename Prim>
+static void removeSolid(const SolidEditTarget<Prim>& t, int index) {
+    HeightfieldRegion range = primPointRange(t.prims[index]);
+    ArenaGridRect dirty[2] = {arenaGridRect(t.prims[index]), {}};
+    int last = (int)t.prims.size() - 1;
+    int drop[2] = {t.handles.handleOf[index], t.handles.handleOf[last]};
+    removeFromHeightTiles(t.heightTiles, range, drop[0]);
+    releaseArenaHandle(t.handles, drop[0]);
+    if (index != last) {
+        dirty[1] = arenaGridRect(t.prims[last]);
+        t.prims[index] = t.prims[last];
+        t.bounds[index] = t.bounds[last];
+        t.handles.handleOf[index] = drop[1];
+        t.handles.indexOf[drop[1]] = index;
+    }
+    t.prims.pop_back();
+    t.bounds.pop_back();
+    t.handles.handleOf.pop_back();
+    refreshHeightRegion(range);
+    // Tinggi di footprint primitive terakhir tetap, hanya urutannya di list cell yang ganti
+    if (index != last) rebuildHeightCells(primPointRange(t.prims[index]));
+    if (index != last) finishSolidEdit(t, drop, 2, &drop[1], 1, dirty, 2);
+    else finishSolidEdit(t, drop, 1, nullptr, 0, dirty, 1);
+}
+
+static SolidEditTarget<ArenaCube> cubeEdits() {
+    return {cubes, cubeBounds, heightTileCubes, arenaCubeHandles, arenaGridCubes, CULL_CUBE};
+}
+
+static SolidEditTarget<ArenaRamp> rampEdits() {
+    return {ramps, rampBounds, heightTileRamps, arenaRampHandles, arenaGridRamps, CULL_RAMP};
+}
+
+// Ganti seluruh list satu jenis solid dengan jalur yang sama seperti edit runtime:
+// remap/added seperti matchSolids. Primitive yang dibuang dan yang ditambah menandai
+// cell heightfield di footprint-nya; handle-nya (drop/add) dan rect grid primitive
+// yang dibuang (dirty) untuk arenaGridPatch. Sisanya hanya pindah index dan membawa
+// handle-nya, jadi cell grid dan list cell heightfield di luar footprint itu tidak
+// disentuh. heightTiles nullptr = tile kontributor dibangun ulang pemanggil.
+// Return false kalau list tidak berubah.
+template <typename Prim>
+static bool swapSolids(const SolidEditTarget<Prim>& t, const std::vector<Prim>& newPrims,
+                       const std::vector<int>& remap, const std::vector<int>& added,
+                       std::vector<int>& drop, std::vector<int>& add, std::vector<ArenaGridRect>& dirty) {
+    static std::vector<int> newHandles;
+    static std::vector<ArenaBounds> newBounds;
+    drop.clear();
+    add.clear();
+    dirty.clear();
+    newHandles.resize(newPrims.size());
+    newBounds.resize(newPrims.size());
+    for (int k = 0; k < (int)t.prims.size(); ++k) {
+        int handle = t.handles.handleOf[k];
+        if (remap[k] >= 0) {
+            newHandles[remap[k]] = handle;
+            newBounds[remap[k]] = t.bounds[k];
+            continue;
+        }
+        HeightfieldRegion range = primPointRange(t.prims[k]);
+        markDirtyHeightCells(range);
+        if (t.heightTiles) removeFromHeightTiles(t.heightTiles, range, handle);
+        releaseArenaHandle(t.handles, handle);
+        drop.push_back(handle);
+        // Primitive chunk yang dilepas jendela streaming tidak ada di grid baru
+        const ArenaBounds& b = t.bounds[k];
+        if (b.maxX >= arenaOriginX - BOUNDS - arenaGridMargin && b.minX <= arenaOriginX + BOUNDS + arenaGridMargin &&
+            b.maxZ >= arenaOriginZ - BOUNDS - arenaGridMargin && b.minZ <= arenaOriginZ + BOUNDS + arenaGridMargin) {
+            dirty.push_back(arenaGridRect(t.prims[k]));
+        }
+    }
+    if (drop.empty() && added.empty()) return false;
+
+    t.prims = newPrims;
+    for (int k : added) {
+        newBounds[k] = solidBounds(t.prims[k]);
+        newHandles[k] = allocArenaHandle(t.handles, k);
+        add.push_back(newHandles[k]);
+        HeightfieldRegion range = primPointRange(t.prims[k]);
+        if (t.heightTiles) addToHeightTiles(t.heightTiles, range, newHandles[k]);
+        markDirtyHeightCells(range);
+    }
+    t.handles.handleOf.swap(newHandles);
+    for (int k = 0; k < (int)t.prims.size(); ++k) t.handles.indexOf[t.handles.handleOf[k]] = k;
+    t.bounds.swap(newBounds);
+    return true;
+}
+
+// Hot reload: selisih list lama dan baru dari matchSolids. Handle yang dilepas ikut
+// di-drop, jadi entri lamanya tidak terbawa kalau handle itu dipakai lagi primitive baru.
+template <typename Prim>
+static void replaceSolids(const SolidEditTarget<Prim>& t, const std::vector<Prim>& newPrims, bool rebuildGrid) {
+    static std::vector<int> remap, added, drop, add;
+    static std::vector<ArenaGridRect> dirty;
+    matchSolids(t.prims, newPrims, remap, added);
+    if (!swapSolids(t, newPrims, remap, added, drop, add, dirty)) return;
+    if (!rebuildGrid) {
+        arenaGridPatch(t.prims, t.handles, t.grid, drop.data(), (int)drop.size(), add.data(), (int)add.size(),
+                       dirty.data(), (int)dirty.size());
+    }
+    remapArenaCullKind(t.kind, remap, added);
+}
+
+// Bangun ulang cell heightDirtyCells dalam satu pass: kontributor dikumpulkan sekali
+// (primitive yang melintasi beberapa tile tidak diurutkan dan dicatat ulang per
+// tile), cell lain di kotak pembungkusnya dilewati lewat mask. Return jumlah cell.
+static int rebuildDirtyHeightCells() {
+    static std::vector<int> tileCubes, tileRamps;
+    HeightfieldRegion cells = {HF_CELLS, -1, HF_CELLS, -1};
+    int rebuilt = 0;
+    for (int i = 0; i < HF_CELLS; ++i) {
+        for (int j = 0; j < HF_CELLS; ++j) {
+            if (!heightDirtyCells[i][j]) continue;
+            cells.i0 = std::min(cells.i0, i); cells.i1 = std::max(cells.i1, i);
+            cells.j0 = std::min(cells.j0, j); cells.j1 = std::max(cells.j1, j);
+            ++rebuilt;
+        }
+    }
+    if (rebuilt == 0) return 0;
+    gatherHeightContributors(cells, tileCubes, tileRamps, &heightDirtyCells);
+    buildHeightfieldRegion(cells, &tileCubes, &tileRamps, &heightDirtyCells);
+    return rebuilt;
+}
+
+int replaceArenaSolids(const std::vector<ArenaCube>& newCubes, const std::vector<ArenaRamp>& newRamps,
+                       const float newHeights[GRID_SIZE][GRID_SIZE]) {
+    bool rebuildGrid = arenaGridDim == 0 || arenaGridDimFor((int)(newCubes.size() + newRamps.size())) != arenaGridDim;
+    memset(heightDirtyCells, 0, sizeof(heightDirtyCells));
+    syncArenaHandles(arenaCubeHandles, (int)cubes.size());
+    syncArenaHandles(arenaRampHandles, (int)ramps.size());
+    replaceSolids(cubeEdits(), newCubes, rebuildGrid);
+    replaceSolids(rampEdits(), newRamps, rebuildGrid);
+    for (int i = 0; i < GRID_SIZE; ++i) {
+        for (int j = 0; j < GRID_SIZE; ++j) {
+            if (arenaHeights[i][j] != newHeights[i][j]) markDirtyHeightCells({i, i, j, j});
+        }
+    }
+    memcpy(arenaHeights, newHeights, sizeof(arenaHeights));
+    if (rebuildGrid) buildArenaSpatialGrid();
+    else ++arenaSolidVersionCounter;
+
+    if (!arenaHeightfieldBuilt) {
+        buildArenaHeightfield();
+        return HF_CELLS * HF_CELLS;
+    }
+    return rebuildDirtyHeightCells();
+}
+
+// Geser array per cell heightfield: cell baru (i, j) = cell lama (i + di, j + dj).
+// Baris dijalani ke arah yang membaca sumber sebelum ditimpa; cell yang sumbernya
+// di luar array dibiarkan (pemanggil menandainya untuk dibangun ulang).
+template <typename T>
+static void shiftHeightCells(T (&cells)[HF_CELLS][HF_CELLS], int di, int dj) {
+    if (std::abs(di) >= HF_CELLS || std::abs(dj) >= HF_CELLS) return;
+    int j0 = std::max(0, -dj), j1 = std::min(HF_CELLS, HF_CELLS - dj);
+    for (int n = 0; n < HF_CELLS; ++n) {
+        int i = di >= 0 ? n : HF_CELLS - 1 - n;
+        if (i + di < 0 || i + di >= HF_CELLS) continue;
+        T* from = cells[i + di] + j0 + dj;
+        if (dj >= 0) std::move(from, from + (j1 - j0), cells[i] + j0);
+        else std::move_backward(from, from + (j1 - j0), cells[i] + j1);
+    }
+}
+
+// Primitive lama yang footprint-nya menyentuh strip grid baru: entrinya ditulis
+// ulang (drop + add) supaya cell strip terisi dan cell lain tidak dobel
+template <typename Prim>
+static void addStripSolids(const std::vector<Prim>& prims, const ArenaHandles& handles, const std::vector<int>& added,
+                           const ArenaGridRect* strips, int numStrips, std::vector<int>& drop, std::vector<int>& add) {
+    size_t nextAdded = 0;
+    for (int k = 0; k < (int)prims.size(); ++k) {
+        if (nextAdded < added.size() && added[nextAdded] == k) {
+            ++nextAdded;
+            continue;
+        }
+        ArenaGridRect r = arenaGridRect(prims[k]);
+        for (int s = 0; s < numStrips; ++s) {
+            if (r.i1 < strips[s].i0 || r.i0 > strips[s].i1 || r.j1 < strips[s].j0 || r.j0 > strips[s].j1) continue;
+            drop.push_back(handles.handleOf[k]);
+            add.push_back(handles.handleOf[k]);
+            break;
+        }
+    }
+}
+
+int shiftArenaWindow(float originX, float originZ,
+                     const std::vector<ArenaCube>& newCubes, const std::vector<int>& cubeRemap, const std::vector<int>& cubeAdded,
+                     const std::vector<ArenaRamp>& newRamps, const std::vector<int>& rampRemap, const std::vector<int>& rampAdded,
+                     const float newHeights[GRID_SIZE][GRID_SIZE]) {
+    static std::vector<int> dropCubes, addCubes, dropRamps, addRamps;
+    static std::vector<ArenaGridRect> dirtyCubes, dirtyRamps;
+    const unsigned solids = (1u << CULL_CUBE) | (1u << CULL_RAMP);
+    if (!arenaHeightfieldBuilt || arenaGridDim == 0) {
+        arenaOriginX = originX;
+        arenaOriginZ = originZ;
+        cubes = newCubes;
+        ramps = newRamps;
+        memcpy(arenaHeights, newHeights, sizeof(arenaHeights));
+        buildArenaSpatialGrid();
+        buildArenaHeightfield();
+        rebuildArenaBounds(solids);
+        rebuildArenaCullGrid(solids);
+        return HF_CELLS * HF_CELLS;
+    }
+    syncArenaHandles(arenaCubeHandles, (int)cubes.size());
+    syncArenaHandles(arenaRampHandles, (int)ramps.size());
+    int di = heightLatticeIndex(originX) - heightLatticeIndex(arenaOriginX);
+    int dj = heightLatticeIndex(originZ) - heightLatticeIndex(arenaOriginZ);
+    float cellsX = (originX - arenaOriginX) / arenaGridCellSize, cellsZ = (originZ - arenaOriginZ) / arenaGridCellSize;
+    int gi = (int)lroundf(cellsX), gj = (int)lroundf(cellsZ);
+    bool shiftGrid = fabsf(cellsX - gi) < 1e-3f && fabsf(cellsZ - gj) < 1e-3f &&
+                     arenaGridDimFits((int)(newCubes.size() + newRamps.size()));
+    arenaOriginX = originX;
+    arenaOriginZ = originZ;
+    arenaHeightOrigin = heightGridOrigin(originX, originZ);
+
+    // Heightfield: cell yang tetap di jendela pindah index, cell dan titik baru di
+    // strip ditandai, begitu juga cell yang titiknya beda dengan rasterisasi jendela baru
+    memset(heightDirtyCells, 0, sizeof(heightDirtyCells));
+    shiftHeightCells(arenaCells, di, dj);
+    shiftHeightCells(arenaCellPrims, di, dj);
+    shiftHeightCells(arenaCellLongPrims, di, dj);
+    for (int i = 0; i < GRID_SIZE; ++i) {
+        for (int j = 0; j < GRID_SIZE; ++j) {
+            int si = i + di, sj = j + dj;
+            bool kept = si >= 0 && si < GRID_SIZE && sj >= 0 && sj < GRID_SIZE;
+            // Cell yang sumbernya di luar array selalu punya titik sudut seperti ini
+            if (!kept || arenaHeights[si][sj] != newHeights[i][j]) markDirtyHeightCells({i, i, j, j});
+        }
+    }
+    memcpy(arenaHeights, newHeights, sizeof(arenaHeights));
+
+    // Grid: strip cell yang sumbernya di luar grid lama
+    ArenaGridRect strips[2];
+    int numStrips = 0;
+    if (shiftGrid) {
+        int dim = arenaGridDim;
+        arenaGridShift(arenaGridCubes, gi, gj);
+        arenaGridShift(arenaGridRamps, gi, gj);
+        if (gi != 0) strips[numStrips++] = gi > 0 ? ArenaGridRect{std::max(0, dim - gi), dim - 1, 0, dim - 1}
+                                                  : ArenaGridRect{0, std::min(dim, -gi) - 1, 0, dim - 1};
+        if (gj != 0) strips[numStrips++] = gj > 0 ? ArenaGridRect{0, dim - 1, std::max(0, dim - gj), dim - 1}
+                                                  : ArenaGridRect{0, dim - 1, 0, std::min(dim, -gj) - 1};
+    }
+    SolidEditTarget<ArenaCube> cubeTarget = {cubes, cubeBounds, nullptr, arenaCubeHandles, arenaGridCubes, CULL_CUBE};
+    SolidEditTarget<ArenaRamp> rampTarget = {ramps, rampBounds, nullptr, arenaRampHandles, arenaGridRamps, CULL_RAMP};
+    swapSolids(cubeTarget, newCubes, cubeRemap, cubeAdded, dropCubes, addCubes, dirtyCubes);
+    swapSolids(rampTarget, newRamps, rampRemap, rampAdded, dropRamps, addRamps, dirtyRamps);
+    if (shiftGrid) {
+        addStripSolids(cubes, arenaCubeHandles, cubeAdded, strips, numStrips, dropCubes, addCubes);
+        addStripSolids(ramps, arenaRampHandles, rampAdded, strips, numStrips, dropRamps, addRamps);
+        dirtyCubes.insert(dirtyCubes.end(), strips, strips + numStrips);
+        dirtyRamps.insert(dirtyRamps.end(), strips, strips + numStrips);
+        arenaGridPatch(cubes, arenaCubeHandles, arenaGridCubes, dropCubes.data(), (int)dropCubes.size(),
+                       addCubes.data(), (int)addCubes.size(), dirtyCubes.data(), (int)dirtyCubes.size());
+        arenaGridPatch(ramps, arenaRampHandles, arenaGridRamps, dropRamps.data(), (int)dropRamps.size(),
+                       addRamps.data(), (int)addRamps.size(), dirtyRamps.data(), (int)dirtyRamps.size());
+    } else {
+        buildArenaSpatialGrid();
+    }
+    rebuildArenaCullGrid(solids);
+    ++arenaSolidVersionCounter;
+
+    // Tile kontributor relatif ke lattice jendela, jadi dihitung ulang (O(primitive),
+    // tanpa rasterisasi); cell bertanda dibangun ulang dari kontributornya
+    buildHeightTiles();
+    return rebuildDirtyHeightCells();
+}
+
+int addArenaCube(const ArenaCube& cube) {
+    return addSolid(cubeEdits(), cube);
+}
+
+void moveArenaCube(int index, float x, float y, float z) {
+    moveSolid(cubeEdits(), index, x, y, z);
+}
+
+void removeArenaCube(int index) {
+    removeSolid(cubeEdits(), index);
+}
+
+int addArenaRamp(const ArenaRamp& ramp) {
+    return addSolid(rampEdits(), ramp);
+}
+
+void moveArenaRamp(int index, float x, float y, float z) {
+    moveSolid(rampEdits(), index, x, y, z);
+}
+
+void removeArenaRamp(int index) {
+    removeSolid(rampEdits(), index);
+}
+
+unsigned takeArenaChanges() {
+    unsigned changes = arenaPendingChanges;
+    arenaPendingChanges = 0;
+    return changes;
+}
+
+void setArenaHeightfieldFastPath(bool enabled) {
+    arenaHeightfieldEnabled = enabled;
+}
+
+// Return true kalau titik diinterpolasi dari heightfield. Selain itu kandidat
+// untuk tes per primitive: list pendek cell kalau ada, kalau tidak cell grid.
+static bool sampleArenaHeightfield(float x, float z, float& height, float& outNormalX, float& outNormalY, float& outNormalZ,
+                                   const int*& cubeIdx, int& numCubes, const int*& rampIdx, int& numRamps) {
+    if (!arenaHeightfieldEnabled || !arenaHeightfieldBuilt) {
+        arenaCandidates(x, z, cubeIdx, numCubes, rampIdx, numRamps);
+        return false;
+    }
+    const float invStep = 1.0f / arenaHeightfieldStep;
+    float fx = (x - arenaHeightOrigin.x + BOUNDS) * invStep;
+    float fz = (z - arenaHeightOrigin.z + BOUNDS) * invStep;
+    if (!(fx >= 0.0f && fz >= 0.0f && fx < (float)HF_CELLS && fz < (float)HF_CELLS)) {
+        arenaCandidates(x, z, cubeIdx, numCubes, rampIdx, numRamps);
+        return false;
+    }
+    int i = (int)fx;
+    int j = (int)fz;
+    const ArenaHeightCell& cell = arenaCells[i][j];
+    if (cell.mode == HF_CELL_LIST) {
+        const ArenaCellPrims& prims = arenaCellPrims[i][j];
+        cubeIdx = heightCellIds(i, j); numCubes = prims.numCubes;
+        rampIdx = cubeIdx + prims.numCubes; numRamps = prims.numRamps;
+        return false;
+    }
+    float tx = fx - i;
+    float tz = fz - j;
+    height = cell.h + cell.dx * tx + (cell.dz + cell.dxz * tx) * tz;
+    outNormalX = cell.nx;
+    outNormalY = cell.ny;
+    outNormalZ = cell.nz;
+    return true;
+}
 
 float getArenaHeight(float x, float z) {
+    float fastH, fastNX, fastNY, fastNZ;
+    const int *cubeIdx, *rampIdx; int numCubes, numRamps;
+    if (sampleArenaHeightfield(x, z, fastH, fastNX, fastNY, fastNZ, cubeIdx, numCubes, rampIdx, numRamps)) return fastH;
     float height = 0.0f; 
-    for (const auto& c : cubes) {
+    for (int k = 0; k < numCubes; ++k) {
+        const ArenaCube& c = cubes[cubeIdx ? arenaCubeHandles.indexOf[cubeIdx[k]] : k];
         float minX = c.x - c.sizeX / 2.0f;
         float maxX = c.x + c.sizeX / 2.0f;
         float minZ = c.z - c.sizeZ / 2.0f;
@@ -486,7 +1648,8 @@ float getArenaHeight(float x, float z) {
             if (topY > height) height = topY;
         }
     }
-    for (const auto& r : ramps) {
+    for (int k = 0; k < numRamps; ++k) {
+        const ArenaRamp& r = ramps[rampIdx ? arenaRampHandles.indexOf[rampIdx[k]] : k];
         if (r.axis == 'z') {
             float minX = r.x - r.sizeX / 2.0f;
             float maxX = r.x + r.sizeX / 2.0f;
@@ -517,6 +1680,8 @@ float getArenaHeight(float x, float z) {
 }
 
 void getArenaHeightAndNormal(float x, float z, float& height, float& outNormalX, float& outNormalY, float& outNormalZ) {
+    const int *cubeIdx, *rampIdx; int numCubes, numRamps;
+    if (sampleArenaHeightfield(x, z, height, outNormalX, outNormalY, outNormalZ, cubeIdx, numCubes, rampIdx, numRamps)) return;
     height = 0.0f;
     outNormalX = 0.0f; outNormalY = 1.0f; outNormalZ = 0.0f;
     const float epsilon = 0.015f;
@@ -524,7 +1689,8 @@ void getArenaHeightAndNormal(float x, float z, float& height, float& outNormalX,
     const float wall_like_threshold_Y = 0.5f;
     float current_best_h = height;
     float current_best_nx = outNormalX, current_best_ny = outNormalY, current_best_nz = outNormalZ;
-    for (const auto& c : cubes) {
+    for (int k = 0; k < numCubes; ++k) {
+        const ArenaCube& c = cubes[cubeIdx ? arenaCubeHandles.indexOf[cubeIdx[k]] : k];
         float minX = c.x - c.sizeX / 2.0f;
         float maxX = c.x + c.sizeX / 2.0f;
         float minZ = c.z - c.sizeZ / 2.0f;
@@ -575,7 +1741,8 @@ void getArenaHeightAndNormal(float x, float z, float& height, float& outNormalX,
             }
         }
     }
-    for (const auto& r : ramps) {
+    for (int k = 0; k < numRamps; ++k) {
+        const ArenaRamp& r = ramps[rampIdx ? arenaRampHandles.indexOf[rampIdx[k]] : k];
         float baseY = r.y - r.sizeY / 2.0f;
         float topY = r.y + r.sizeY / 2.0f;
         float minX = r.x - r.sizeX / 2.0f;
@@ -660,9 +1827,12 @@ void getArenaHeightAndNormal(float x, float z, float& height, float& outNormalX,
 }
 
 float getArenaHeightAt(float x, float y, float z) {
+    const int *cubeIdx, *rampIdx; int numCubes, numRamps;
+    arenaCandidates(x, z, cubeIdx, numCubes, rampIdx, numRamps);
     float height = 0.0f; 
     const float epsilon = 0.01f;
-    for (const auto& c : cubes) {
+    for (int k = 0; k < numCubes; ++k) {
+        const ArenaCube& c = cubes[cubeIdx ? arenaCubeHandles.indexOf[cubeIdx[k]] : k];
         float minX = c.x - c.sizeX / 2.0f;
         float maxX = c.x + c.sizeX / 2.0f;
         float minZ = c.z - c.sizeZ / 2.0f;
@@ -675,7 +1845,8 @@ float getArenaHeightAt(float x, float y, float z) {
             }
         }
     }
-    for (const auto& r : ramps) {
+    for (int k = 0; k < numRamps; ++k) {
+        const ArenaRamp& r = ramps[rampIdx ? arenaRampHandles.indexOf[rampIdx[k]] : k];
         float minX = r.x - r.sizeX / 2.0f;
         float maxX = r.x + r.sizeX / 2.0f;
         float minZ = r.z - r.sizeZ / 2.0f;
@@ -708,6 +1879,8 @@ float getArenaHeightAt(float x, float y, float z) {
 }
 
 void getArenaHeightAndNormalAt(float x, float y, float z, float& height, float& outNormalX, float& outNormalY, float& outNormalZ) {
+    const int *cubeIdx, *rampIdx; int numCubes, numRamps;
+    arenaCandidates(x, z, cubeIdx, numCubes, rampIdx, numRamps);
     height = 0.0f;
     outNormalX = 0.0f; outNormalY = 1.0f; outNormalZ = 0.0f;
     const float epsilon = 0.015f;
@@ -716,7 +1889,8 @@ void getArenaHeightAndNormalAt(float x, float y, float z, float& height, float&
         float current_best_h = height;
     float current_best_nx = outNormalX, current_best_ny = outNormalY, current_best_nz = outNormalZ;
     
-    for (const auto& c : cubes) {
+    for (int k = 0; k < numCubes; ++k) {
+        const ArenaCube& c = cubes[cubeIdx ? arenaCubeHandles.indexOf[cubeIdx[k]] : k];
         float minX = c.x - c.sizeX / 2.0f;
         float maxX = c.x + c.sizeX / 2.0f;
         float minZ = c.z - c.sizeZ / 2.0f;
@@ -768,7 +1942,8 @@ void getArenaHeightAndNormalAt(float x, float y, float z, float& height, float&
             }
         }
     }
-    for (const auto& r : ramps) {
+    for (int k = 0; k < numRamps; ++k) {
+        const ArenaRamp& r = ramps[rampIdx ? arenaRampHandles.indexOf[rampIdx[k]] : k];
         float baseY = r.y - r.sizeY / 2.0f;
         float topY = r.y + r.sizeY / 2.0f;
         float minX = r.x - r.sizeX / 2.0f;
@@ -856,362 +2031,256 @@ void getArenaHeightAndNormalAt(float x, float y, float z, float& height, float&
     outNormalX = current_best_nx; outNormalY = current_best_ny; outNormalZ = current_best_nz;
 }
 
+// Query batch (probe CCD). Satu probe, kandidat cell grid dites 4 sekaligus (satu
+// lane per kandidat) langsung dari blok field SoA cell itu. Lane yang valid dilipat
+// ke hasil probe satu per satu urut kandidat dengan aturan tie-break scalar, jadi
+// hasil identik dengan getArenaHeightAndNormalAt. Cell dengan < 4 kandidat (level
+// kecil) bloknya kebanyakan sentinel; di situ 4 probe berurutan yang jatuh di cell
+// yang sama dites sekaligus per kandidat (satu lane per probe).
+#ifdef ARENA_BATCH_SSE
+static inline __m128 arenaSelect(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
 
-void PrintMarblePositionForPlacement(float x, float y, float z) {
-    printf("~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\n");
-    printf("CreateCube(%.2ff, %.2ff, %.2ff, sizeX, sizeY, sizeZ);\n", x, y, z);
-    printf("CreateRamp(%.2ff, %.2ff, %.2ff, sizeX, sizeY, sizeZ, 'axis');\n", x, y, z);
-    printf("CreateBush(%.2ff, %.2ff, %.2ff, radius);\n", x, y, z);
-    printf("CreateTree(%.2ff, %.2ff, %.2ff, trunkHeight, trunkRadius, foliageRadius);\n", x, y, z);
-    printf("CreateRock(%.2ff, %.2ff, %.2ff, scale);\n", x, y, z);
-    printf("addCheckpoint(%.2ff, %.2ff, bonusMinutes);\n", x, z);
-    printf("~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\n");
+static inline __m128 arenaAbs(__m128 v) {
+    return _mm_andnot_ps(_mm_set1_ps(-0.0f), v);
 }
 
-void drawGround() {
-    GLfloat ground_ambient[] = {0.1f, 0.4f, 0.1f, 1.0f};
-    GLfloat ground_diffuse[] = {0.2f, 0.8f, 0.2f, 1.0f};
-    GLfloat ground_specular[] = {0.1f, 0.2f, 0.1f, 1.0f};
-    GLfloat ground_shininess = 8.0f;
-
-    glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, ground_ambient);
-    glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, ground_diffuse);
-    glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, ground_specular);
-    glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, ground_shininess);
-    glColor3f(0.2f, 0.8f, 0.2f); 
-
-    // Gambar ground sebagai sebuah quad besar
-    glBegin(GL_QUADS);
-    glNormal3f(0.0f, 1.0f, 0.0f); // Normal mengarah ke atas
-    glVertex3f(-BOUNDS, 0.0f, -BOUNDS);
-    glVertex3f( BOUNDS, 0.0f, -BOUNDS);
-    glVertex3f( BOUNDS, 0.0f,  BOUNDS);
-    glVertex3f(-BOUNDS, 0.0f,  BOUNDS);
-    glEnd();
-
-    // Material untuk kubus
-    GLfloat cube_ambient[] = {0.5f, 0.4f, 0.3f, 1.0f};
-    GLfloat cube_diffuse[] = {0.7f, 0.6f, 0.5f, 1.0f};
-    GLfloat cube_specular[] = {0.2f, 0.2f, 0.1f, 1.0f};
-    GLfloat cube_shininess = 10.0f;
-    glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, cube_ambient);
-    glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, cube_diffuse);
-    glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, cube_specular);
-    glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, cube_shininess);
-    glColor3f(0.7f, 0.6f, 0.5f); // Warna kubus
-    for (const auto& c : cubes) {
-        drawCube(c.x, c.y, c.z, c.sizeX, c.sizeY, c.sizeZ);
-    }
-
-    // Material untuk ramp
-    GLfloat ramp_ambient[] = {0.3f, 0.3f, 0.5f, 1.0f};
-    GLfloat ramp_diffuse[] = {0.5f, 0.5f, 0.7f, 1.0f};
-    GLfloat ramp_specular[] = {0.1f, 0.1f, 0.2f, 1.0f};
-    GLfloat ramp_shininess = 8.0f;
-    glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, ramp_ambient);
-    glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, ramp_diffuse);
-    glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, ramp_specular);
-    glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, ramp_shininess);
-    glColor3f(0.5f, 0.5f, 0.7f); // Warna ramp
-    for (const auto& r : ramps) {
-        drawRamp(r.x, r.y, r.z, r.sizeX, r.sizeY, r.sizeZ, r.axis);
-    }
-
-    for (const auto& b : bushes) {
-        drawBush(b.x, b.y, b.z, b.radius);
-    }
-    for (const auto& t : trees) {
-        drawTree(t.x, t.y, t.z, t.trunkHeight, t.trunkRadius, t.foliageRadius);
-    }
-    
-    for (const auto& rock : rocks) {
-        drawRock(rock.x, rock.y, rock.z, rock.scale);
+// Permukaan kandidat per lane, h = -1 kalau tidak ada
+struct ArenaLanes {
+    __m128 h, nx, ny, nz;
+};
+
+// Cube per lane, field dari load(GRID_*). Dinding dalam pita y menang atas atap;
+// dengan satu dinding normalnya +-1, di sudut (>= 2 dinding) jumlah normal dinding
+// dinormalisasi seperti versi scalar (bagi 1 tidak mengubah nilai).
+// false = tidak ada lane yang kena.
+template <typename Load>
+static inline bool arenaCubeLanes(__m128 X, __m128 Y, __m128 Z, Load load, ArenaLanes& out) {
+    const __m128 eps = _mm_set1_ps(0.015f);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 minusOne = _mm_set1_ps(-1.0f);
+    __m128 vMinX = load(GRID_MIN_X), vMaxX = load(GRID_MAX_X);
+    __m128 vMinZ = load(GRID_MIN_Z), vMaxZ = load(GRID_MAX_Z);
+    __m128 top = load(GRID_TOP_Y);
+    __m128 zIn = _mm_and_ps(_mm_cmpge_ps(Z, _mm_sub_ps(vMinZ, eps)), _mm_cmple_ps(Z, _mm_add_ps(vMaxZ, eps)));
+    __m128 xIn = _mm_and_ps(_mm_cmpge_ps(X, _mm_sub_ps(vMinX, eps)), _mm_cmple_ps(X, _mm_add_ps(vMaxX, eps)));
+    __m128 onXMin = _mm_and_ps(_mm_cmplt_ps(arenaAbs(_mm_sub_ps(X, vMinX)), eps), zIn);
+    __m128 onXMax = _mm_and_ps(_mm_cmplt_ps(arenaAbs(_mm_sub_ps(X, vMaxX)), eps), zIn);
+    __m128 onZMin = _mm_and_ps(_mm_cmplt_ps(arenaAbs(_mm_sub_ps(Z, vMinZ)), eps), xIn);
+    __m128 onZMax = _mm_and_ps(_mm_cmplt_ps(arenaAbs(_mm_sub_ps(Z, vMaxZ)), eps), xIn);
+    __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(X, vMinX), _mm_cmple_ps(X, vMaxX)),
+                               _mm_and_ps(_mm_cmpge_ps(Z, vMinZ), _mm_cmple_ps(Z, vMaxZ)));
+    inside = _mm_and_ps(inside, _mm_cmpge_ps(Y, _mm_sub_ps(top, eps)));
+    __m128 anyWall = _mm_or_ps(_mm_or_ps(onXMin, onXMax), _mm_or_ps(onZMin, onZMax));
+    if (_mm_movemask_ps(_mm_or_ps(anyWall, inside)) == 0) return false;
+
+    __m128 bottom = load(GRID_LOW_Y);
+    __m128 yBand = _mm_and_ps(_mm_cmpge_ps(Y, _mm_sub_ps(bottom, eps)), _mm_cmple_ps(Y, _mm_add_ps(top, eps)));
+    __m128 wall = _mm_and_ps(anyWall, yBand);
+    out.h = arenaSelect(_mm_or_ps(wall, inside), top, minusOne);
+    out.ny = _mm_and_ps(_mm_andnot_ps(wall, inside), one);
+    out.nx = _mm_and_ps(yBand, _mm_add_ps(_mm_and_ps(onXMin, minusOne), _mm_and_ps(onXMax, one)));
+    out.nz = _mm_and_ps(yBand, _mm_add_ps(_mm_and_ps(onZMin, minusOne), _mm_and_ps(onZMax, one)));
+    __m128i wallCount = _mm_sub_epi32(_mm_sub_epi32(_mm_setzero_si128(), _mm_castps_si128(onXMin)), _mm_castps_si128(onXMax));
+    wallCount = _mm_sub_epi32(_mm_sub_epi32(wallCount, _mm_castps_si128(onZMin)), _mm_castps_si128(onZMax));
+    __m128 corner = _mm_and_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(wallCount, _mm_set1_epi32(1))), yBand);
+    if (_mm_movemask_ps(corner) != 0) {
+        __m128 len = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(out.nx, out.nx), _mm_mul_ps(out.nz, out.nz)));
+        __m128 norm = _mm_and_ps(corner, _mm_cmpgt_ps(len, _mm_set1_ps(1e-6f)));
+        out.nx = arenaSelect(norm, _mm_div_ps(out.nx, len), out.nx);
+        out.nz = arenaSelect(norm, _mm_div_ps(out.nz, len), out.nz);
     }
+    return true;
+}
 
-    drawCoins();
+// Ramp per lane. Ramp sumbu x dan z bisa bercampur dalam satu blok, jadi dinding
+// dan progress lereng dipilih per lane lewat GRID_AXIS_Z.
+template <typename Load>
+static inline bool arenaRampLanes(__m128 X, __m128 Y, __m128 Z, Load load, ArenaLanes& out) {
+    const __m128 eps = _mm_set1_ps(0.015f);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 minusOne = _mm_set1_ps(-1.0f);
+    __m128 vMinX = load(GRID_MIN_X), vMaxX = load(GRID_MAX_X);
+    __m128 vMinZ = load(GRID_MIN_Z), vMaxZ = load(GRID_MAX_Z);
+    __m128 xIn = _mm_and_ps(_mm_cmpge_ps(X, _mm_sub_ps(vMinX, eps)), _mm_cmple_ps(X, _mm_add_ps(vMaxX, eps)));
+    __m128 zIn = _mm_and_ps(_mm_cmpge_ps(Z, _mm_sub_ps(vMinZ, eps)), _mm_cmple_ps(Z, _mm_add_ps(vMaxZ, eps)));
+    __m128 broad = _mm_and_ps(xIn, zIn);
+    if (_mm_movemask_ps(broad) == 0) return false;
+
+    __m128 axisZ = _mm_cmpgt_ps(load(GRID_AXIS_Z), _mm_set1_ps(0.5f));
+    __m128 strict = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(X, vMinX), _mm_cmple_ps(X, vMaxX)),
+                               _mm_and_ps(_mm_cmpge_ps(Z, vMinZ), _mm_cmple_ps(Z, vMaxZ)));
+    __m128 along = arenaSelect(axisZ, _mm_sub_ps(Z, vMinZ), _mm_sub_ps(X, vMinX));
+    __m128 progress = _mm_div_ps(along, load(GRID_LENGTH));
+    __m128 slopeH = _mm_add_ps(load(GRID_LOW_Y), _mm_mul_ps(progress, load(GRID_SIZE_Y)));
+    __m128 onSlope = _mm_and_ps(strict, _mm_cmpge_ps(Y, _mm_sub_ps(slopeH, eps)));
+
+    // Tiga dinding per sumbu, yang pertama kena dipakai:
+    // sumbu z: x = minX (-x), x = maxX (+x), z = maxZ (+z)
+    // sumbu x: z = minZ (-z), z = maxZ (+z), x = maxX (+x)
+    // Normal dinding 1 dan 2 searah sumbu ramp (along), dinding 3 di sumbu lain (across)
+    __m128 edge = _mm_andnot_ps(strict, broad);
+    __m128 onXMin = _mm_and_ps(_mm_cmplt_ps(arenaAbs(_mm_sub_ps(X, vMinX)), eps), zIn);
+    __m128 onXMax = _mm_and_ps(_mm_cmplt_ps(arenaAbs(_mm_sub_ps(X, vMaxX)), eps), zIn);
+    __m128 onZMin = _mm_and_ps(_mm_cmplt_ps(arenaAbs(_mm_sub_ps(Z, vMinZ)), eps), xIn);
+    __m128 onZMax = _mm_and_ps(_mm_cmplt_ps(arenaAbs(_mm_sub_ps(Z, vMaxZ)), eps), xIn);
+    __m128 w1 = _mm_and_ps(edge, arenaSelect(axisZ, onXMin, onZMin));
+    __m128 w2 = _mm_andnot_ps(w1, _mm_and_ps(edge, arenaSelect(axisZ, onXMax, onZMax)));
+    __m128 w3 = _mm_andnot_ps(_mm_or_ps(w1, w2), _mm_and_ps(edge, arenaSelect(axisZ, onZMax, onXMax)));
+    __m128 alongN = _mm_or_ps(_mm_and_ps(w1, minusOne), _mm_and_ps(w2, one));
+    __m128 acrossN = _mm_and_ps(w3, one);
+    __m128 wall = _mm_or_ps(_mm_or_ps(w1, w2), w3);
+    out.h = arenaSelect(onSlope, slopeH, arenaSelect(wall, load(GRID_TOP_Y), minusOne));
+    out.nx = arenaSelect(onSlope, load(GRID_SLOPE_NX), arenaSelect(axisZ, alongN, acrossN));
+    out.ny = _mm_and_ps(onSlope, load(GRID_SLOPE_NY));
+    out.nz = arenaSelect(onSlope, load(GRID_SLOPE_NZ), arenaSelect(axisZ, acrossN, alongN));
+    return true;
 }
 
+// Hasil permukaan terbaik satu probe
+struct ArenaSurface {
+    float h, nx, ny, nz;
+};
 
-void drawTree(float x, float y, float z, float trunkHeight, float trunkRadius, float foliageRadius) {
-    GLfloat trunk_ambient[] = {0.2f, 0.1f, 0.05f, 1.0f};
-    GLfloat trunk_diffuse[] = {0.5f, 0.3f, 0.1f, 1.0f};
-    GLfloat trunk_specular[] = {0.1f, 0.05f, 0.02f, 1.0f};
-    GLfloat trunk_shininess = 8.0f;
-    
-    glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, trunk_ambient);
-    glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, trunk_diffuse);
-    glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, trunk_specular);
-    glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, trunk_shininess);
-
-    glColor3f(0.5f, 0.3f, 0.1f);
-    glPushMatrix();
-    glTranslatef(x, y, z);
-    glRotatef(-90, 1, 0, 0);
-    GLUquadric *quad = gluNewQuadric();
-    gluCylinder(quad, trunkRadius, trunkRadius * 0.8f, trunkHeight * 0.7f, 12, 8);
-    gluDeleteQuadric(quad);
-    glPopMatrix();
-
-    glPushMatrix();
-    glTranslatef(x, y + trunkHeight * 0.7f, z);
-    glRotatef(-90, 1, 0, 0);
-    quad = gluNewQuadric();
-    gluCylinder(quad, trunkRadius * 0.8f, trunkRadius * 0.6f, trunkHeight * 0.3f, 12, 6);
-    gluDeleteQuadric(quad);
-    glPopMatrix();
-
-    float branchHeight = y + trunkHeight * 0.75f;
-    float branchLength = trunkRadius * 2.5f;
-    float branchRadius = trunkRadius * 0.3f;
-    
-    float branchAngles[] = {30.0f, 120.0f, 210.0f, 300.0f};
-    float branchTilts[] = {15.0f, -10.0f, 20.0f, -15.0f};
-    
-    glColor3f(0.4f, 0.25f, 0.1f); 
-    
-    for (int i = 0; i < 4; i++) {
-        glPushMatrix();
-        glTranslatef(x, branchHeight + (i * trunkHeight * 0.05f), z);
-        glRotatef(branchAngles[i], 0, 1, 0);
-        glRotatef(branchTilts[i], 0, 0, 1); 
-        glRotatef(-90, 1, 0, 0);
-        
-        quad = gluNewQuadric();
-        gluCylinder(quad, branchRadius, branchRadius * 0.5f, branchLength, 8, 4);
-        gluDeleteQuadric(quad);
-        glPopMatrix();
-    }
-
-    GLfloat foliage_ambient[] = {0.05f, 0.2f, 0.05f, 1.0f};
-    GLfloat foliage_diffuse[] = {0.1f, 0.6f, 0.1f, 1.0f};
-    GLfloat foliage_specular[] = {0.02f, 0.1f, 0.02f, 1.0f};
-    GLfloat foliage_shininess = 3.0f;
-    
-    glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, foliage_ambient);
-    glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, foliage_diffuse);
-    glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, foliage_specular);
-    glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, foliage_shininess);
+// Aturan pilih permukaan yang sama dengan getArenaHeightAndNormalAt:
+// lebih tinggi menang; kalau setinggi, permukaan datar menang atas dinding,
+// dinding menimpa dinding, dan permukaan datar yang lebih tegak menimpa yang miring
+static inline void arenaTake(float h, float nx, float ny, float nz, ArenaSurface& best) {
+    const float epsilon = 0.015f;
+    bool take = h > best.h + epsilon;
+    if (!take && fabs(h - best.h) < epsilon) {
+        bool curWall = best.ny < 0.5f && best.ny > -0.5f;
+        bool newWall = ny < 0.5f && ny > -0.5f;
+        take = curWall || (!newWall && ny > best.ny + 0.05f);
+    }
+    if (take) {
+        best.h = h; best.nx = nx; best.ny = ny; best.nz = nz;
+    }
+}
 
-    struct FoliageLayer {
-        float heightOffset, radiusScale, colorVariation;
-    };
-    
-    FoliageLayer layers[] = {
-        {trunkHeight * 0.6f, 1.2f, 0.8f},
-        {trunkHeight * 0.8f, 1.0f, 0.9f},
-        {trunkHeight *  1.0f, 0.7f, 1.0f},
-        {trunkHeight * 1.15f, 0.4f, 1.1f}
-    };
-    
-    for (int i = 0; i < 4; i++) {
-        glPushMatrix();
-        glTranslatef(x, y + layers[i].heightOffset, z);
-        
-        float greenVar = layers[i].colorVariation;
-        glColor3f(0.1f * greenVar, 0.6f * greenVar, 0.1f * greenVar);
-        
-        glutSolidSphere(foliageRadius * layers[i].radiusScale, 14, 14);
-        glPopMatrix();
-    }
-
-    glColor3f(0.15f, 0.5f, 0.15f); 
-    for (int i = 0; i < 4; i++) {
-        float branchEndX = x + cos(branchAngles[i] * M_PI /  180.0f) * branchLength * 0.7f;
-        float branchEndZ = z + sin(branchAngles[i] * M_PI / 180.0f) * branchLength * 0.7f;
-        float branchEndY = branchHeight + (i * trunkHeight * 0.05f) + branchLength * sin(branchTilts[i] * M_PI / 180.0f) * 0.5f;
-        
-        glPushMatrix();
-        glTranslatef(branchEndX, branchEndY, branchEndZ);
-        glutSolidSphere(foliageRadius * 0.3f, 10, 10);
-        glPopMatrix();
-    }
-}
-
-
-void drawBush(float centerX, float centerY, float centerZ, float radius) {
-    GLfloat bush_ambient[] = {0.1f, 0.3f, 0.1f, 1.0f};  
-    GLfloat bush_diffuse[] = {0.2f, 0.6f, 0.2f, 1.0f};  
-    GLfloat bush_specular[] = {0.05f, 0.1f, 0.05f, 1.0f};
-    GLfloat bush_shininess = 5.0f;                   
-    
-    glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, bush_ambient);
-    glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, bush_diffuse);
-    glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, bush_specular);
-    glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, bush_shininess);
-    glColor3f(0.2f, 0.6f, 0.2f); 
-    
-    struct SphereOffset {
-        float x, y, z, scale;
-    };    
-    SphereOffset spheres[] = {
-        {0.0f, 0.0f, 0.0f, 1.3f},
-        
-        {1.0f, -0.2f, -0.7f, 0.7f},
-        {-0.9f, -0.25f, 0.8f, 0.65f},
-        {0.5f, -0.25f, 1.1f, 0.6f},
-        
-        {0.9f, -0.3f, 0.3f, 0.5f},
-        {-1.0f, -0.4f, -0.2f, 0.55f},
-        {0.3f, -0.5f, -1.0f, 0.45f}
-    };
-    
-    int numSpheres = sizeof(spheres) / sizeof(SphereOffset);
-    
-    for (int i = 0; i < numSpheres; i++) {
-        glPushMatrix();
-            glTranslatef(centerX + spheres[i].x * radius, 
-                        centerY + spheres[i].y * radius, 
-                        centerZ + spheres[i].z * radius);
-            
-            float colorVariation = 0.8f + (i % 3) * 0.1f; // Slight variation
-            glColor3f(0.2f * colorVariation, 0.6f * colorVariation, 0.2f * colorVariation);
-            glutSolidSphere(radius * spheres[i].scale, 12, 12);
-        glPopMatrix();
+// Lane = kandidat: lane dengan permukaan (h > -0.5) dilipat urut lane. Tiap
+// pengambilan menurunkan best.h < epsilon, jadi lane dengan h <= best.h - 4 epsilon
+// (diukur di awal blok) pasti tidak diambil dan tidak perlu dilipat.
+static inline void arenaTakeCandidates(const ArenaLanes& obj, ArenaSurface& best) {
+    __m128 reach = _mm_max_ps(_mm_set1_ps(-0.5f), _mm_set1_ps(best.h - 4.0f * 0.015f));
+    int valid = _mm_movemask_ps(_mm_cmpgt_ps(obj.h, reach));
+    if (valid == 0) return;
+    alignas(16) float h[4], nx[4], ny[4], nz[4];
+    _mm_store_ps(h, obj.h); _mm_store_ps(nx, obj.nx); _mm_store_ps(ny, obj.ny); _mm_store_ps(nz, obj.nz);
+    for (int l = 0; l < 4; ++l) {
+        if (valid & (1 << l)) arenaTake(h[l], nx[l], ny[l], nz[l], best);
     }
 }
 
+// Lane = probe: aturan arenaTake per lane
+static inline void arenaTakeProbes(const ArenaLanes& obj, ArenaLanes& best) {
+    const __m128 eps = _mm_set1_ps(0.015f);
+    const __m128 wallY = _mm_set1_ps(0.5f);
+    const __m128 negWallY = _mm_set1_ps(-0.5f);
+    __m128 valid = _mm_cmpgt_ps(obj.h, _mm_set1_ps(-0.5f));
+    __m128 higher = _mm_cmpgt_ps(obj.h, _mm_add_ps(best.h, eps));
+    __m128 level = _mm_cmplt_ps(arenaAbs(_mm_sub_ps(obj.h, best.h)), eps);
+    __m128 curWall = _mm_and_ps(_mm_cmplt_ps(best.ny, wallY), _mm_cmpgt_ps(best.ny, negWallY));
+    __m128 newWall = _mm_and_ps(_mm_cmplt_ps(obj.ny, wallY), _mm_cmpgt_ps(obj.ny, negWallY));
+    __m128 flatter = _mm_cmpgt_ps(obj.ny, _mm_add_ps(best.ny, _mm_set1_ps(0.05f)));
+    __m128 take = _mm_and_ps(valid, _mm_or_ps(higher,
+                  _mm_and_ps(level, _mm_or_ps(curWall, _mm_andnot_ps(newWall, flatter)))));
+    best.h = arenaSelect(take, obj.h, best.h);
+    best.nx = arenaSelect(take, obj.nx, best.nx);
+    best.ny = arenaSelect(take, obj.ny, best.ny);
+    best.nz = arenaSelect(take, obj.nz, best.nz);
+}
 
-void drawRock(float centerX, float centerY, float centerZ, float scale) {
-    GLfloat rock_ambient[] = {0.3f, 0.3f, 0.3f, 1.0f};  
-    GLfloat rock_diffuse[] = {0.6f, 0.6f, 0.6f, 1.0f};  
-    GLfloat rock_specular[] = {0.1f, 0.1f, 0.1f, 1.0f};  
-    GLfloat rock_shininess = 2.0f;                        
-    
-    glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, rock_ambient);
-    glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, rock_diffuse);
-    glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, rock_specular);
-    glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, rock_shininess);
-
-    glPushMatrix();
-    glTranslatef(centerX, centerY, centerZ);
-    glScalef(scale, scale, scale);
-    
-    float vertices[][3] = {
-        {-1.2f, 0.0f, -0.8f},    // 0
-        {0.0f, 0.0f, -1.3f},     // 1  
-        {1.1f, 0.0f, -0.6f},     // 2
-        {1.3f, 0.0f, 0.7f},      // 3
-        {0.2f, 0.0f, 1.4f},      // 4
-        {-0.9f, 0.0f, 1.0f},     // 5
-        {-1.5f, 0.0f, 0.2f},     // 6
-        
-        {-0.8f, 0.6f, -0.9f},    // 7
-        {0.3f, 0.7f, -1.1f},     // 8
-        {1.0f, 0.5f, -0.3f},     // 9
-        {1.1f, 0.8f, 0.8f},      // 10
-        {-0.1f, 0.6f, 1.2f},     // 11
-        {-1.0f, 0.7f, 0.5f},     // 12
-        {-1.2f, 0.5f, -0.1f},    // 13
-
-        {-0.3f, 1.1f, -0.5f},    // 14
-        {0.4f, 1.2f, -0.2f},     // 15
-        {0.6f, 1.0f, 0.4f},      // 16
-        {-0.2f, 1.3f, 0.6f},     // 17
-        {-0.6f, 1.1f, 0.1f},     // 18
-        
-        {0.0f, 1.6f, 0.1f},      // 19
-        {-0.1f, 1.7f, -0.1f},    // 20
-    };
-    
-    int faces[][3] = {
-        {0, 1, 7}, {1, 8, 7}, {1, 2, 8}, {2, 9, 8},
-        {2, 3, 9}, {3, 10, 9}, {3, 4, 10}, {4, 11, 10},
-        {4, 5, 11}, {5, 12, 11}, {5, 6, 12}, {6, 13, 12},
-        {6, 0, 13}, {0, 7, 13},
-        
-        {7, 8, 14}, {8, 15, 14}, {8, 9, 15}, {9, 16, 15},
-        {9, 10, 16}, {10, 17, 16}, {10, 11, 17}, {11, 18, 17},
-        {11, 12, 18}, {12, 19, 18}, {12, 13, 19}, {13, 14, 19},
-        {13, 7, 14},
-        
-        {14, 15, 20}, {15, 16, 20}, {16, 17, 20}, {17, 18, 20},
-        {18, 19, 20}, {19, 14, 20},
-        
-        {7, 12, 18}, {7, 18, 14}, {8, 9, 16}, {8, 16, 15},
-        {10, 11, 17}, {12, 13, 19}, {14, 18, 19},
-        
-        {1, 0, 6}, {1, 6, 4}, {2, 1, 4}, {2, 4, 3},
-        {15, 16, 19}, {15, 19, 18}, {15, 18, 14},
-    };
-    
-    int numFaces = sizeof(faces) / sizeof(faces[0]);
-    
-    glBegin(GL_TRIANGLES);
-    
-    for (int i = 0; i < numFaces; i++) {
-        float* v1 = vertices[faces[i][0]];
-        float* v2 = vertices[faces[i][1]];
-        float* v3 = vertices[faces[i][2]];
-        
-        float edge1[3] = {v2[0] - v1[0], v2[1] - v1[1], v2[2] - v1[2]};
-        float edge2[3] = {v3[0] - v1[0], v3[1] - v1[1], v3[2] - v1[2]};
-        
-        float normal[3] = {
-            edge1[1] * edge2[2] - edge1[2] * edge2[1],
-            edge1[2] * edge2[0] - edge1[0] * edge2[2],
-            edge1[0] * edge2[1] - edge1[1] * edge2[0]
+// Satu probe, semua kandidat cell per blok 4 slot
+static void arenaQueryCandidates(float x, float y, float z, int cell, ArenaSurface& best) {
+    __m128 X = _mm_set1_ps(x), Y = _mm_set1_ps(y), Z = _mm_set1_ps(z);
+    ArenaLanes obj;
+    const ArenaGridLayer& c = arenaGridCubes;
+    for (int s = c.start[cell], last = s + arenaGridRoundUp(c.count[cell]); s < last; s += 4) {
+        auto load = [&](int f) { return _mm_loadu_ps(arenaGridBlock(c, s, f)); };
+        if (arenaCubeLanes(X, Y, Z, load, obj)) arenaTakeCandidates(obj, best);
+    }
+    const ArenaGridLayer& r = arenaGridRamps;
+    for (int s = r.start[cell], last = s + arenaGridRoundUp(r.count[cell]); s < last; s += 4) {
+        auto load = [&](int f) { return _mm_loadu_ps(arenaGridBlock(r, s, f)); };
+        if (arenaRampLanes(X, Y, Z, load, obj)) arenaTakeCandidates(obj, best);
+    }
+}
+
+// 4 probe di cell yang sama, kandidat satu per satu
+static void arenaQueryProbes(__m128 X, __m128 Y, __m128 Z, int cell, ArenaLanes& best) {
+    ArenaLanes obj;
+    const ArenaGridLayer& c = arenaGridCubes;
+    for (int s = c.start[cell], last = s + c.count[cell]; s < last; ++s) {
+        auto load = [&](int f) { return _mm_set1_ps(*arenaGridField(c, s, f)); };
+        if (arenaCubeLanes(X, Y, Z, load, obj)) arenaTakeProbes(obj, best);
+    }
+    const ArenaGridLayer& r = arenaGridRamps;
+    for (int s = r.start[cell], last = s + r.count[cell]; s < last; ++s) {
+        auto load = [&](int f) { return _mm_set1_ps(*arenaGridField(r, s, f)); };
+        if (arenaRampLanes(X, Y, Z, load, obj)) arenaTakeProbes(obj, best);
+    }
+}
+#endif
+
+void getArenaHeightAndNormalAtBatch(const float* xs, const float* ys, const float* zs, int count,
+                                    float* outHeight, float* outNormalX, float* outNormalY, float* outNormalZ) {
+    PROFILE_ZONE_DETAIL("terrain query batch");
+#ifdef ARENA_BATCH_SSE
+    if (arenaGridEnabled && arenaGridDim > 0) {
+        auto cellOf = [&](int k) {
+            return arenaGridCoord(zs[k] - arenaOriginZ) * arenaGridDim + arenaGridCoord(xs[k] - arenaOriginX);
         };
-        
-        float length = sqrt(normal[0]*normal[0] + normal[1]*normal[1] + normal[2]*normal[2]);
-        if (length > 0.001f) {
-            normal[0] /= length;
-            normal[1] /= length;
-            normal[2] /= length;
+        int k = 0;
+        while (k < count) {
+            int cell = cellOf(k);
+            int lanes = 1;
+            while (lanes < 4 && k + lanes < count && cellOf(k + lanes) == cell) ++lanes;
+            if (lanes == 4 && arenaGridCubes.count[cell] + arenaGridRamps.count[cell] < arenaGridLanes) {
+                ArenaLanes best = {_mm_setzero_ps(), _mm_setzero_ps(), _mm_set1_ps(1.0f), _mm_setzero_ps()};
+                arenaQueryProbes(_mm_loadu_ps(xs + k), _mm_loadu_ps(ys + k), _mm_loadu_ps(zs + k), cell, best);
+                _mm_storeu_ps(outHeight + k, best.h);
+                _mm_storeu_ps(outNormalX + k, best.nx);
+                _mm_storeu_ps(outNormalY + k, best.ny);
+                _mm_storeu_ps(outNormalZ + k, best.nz);
+                k += 4;
+                continue;
+            }
+            // Blok cell berurutan di memori, di level padat jarang masih di cache
+            for (const ArenaGridLayer* g : {&arenaGridCubes, &arenaGridRamps}) {
+                const char* first = (const char*)arenaGridBlock(*g, g->start[cell], 0);
+                const char* last = first + (size_t)arenaGridRoundUp(g->count[cell]) * g->numFields * sizeof(float);
+                for (; first < last; first += 64) _mm_prefetch(first, _MM_HINT_T0);
+            }
+            for (int end = k + lanes; k < end; ++k) {
+                ArenaSurface best = {0.0f, 0.0f, 1.0f, 0.0f};
+                arenaQueryCandidates(xs[k], ys[k], zs[k], cell, best);
+                outHeight[k] = best.h;
+                outNormalX[k] = best.nx; outNormalY[k] = best.ny; outNormalZ[k] = best.nz;
+            }
         }
-        
-        float colorVar = 0.8f + (i % 5) * 0.05f;
-        glColor3f(0.5f * colorVar, 0.5f * colorVar, 0.5f * colorVar);
-        
-        glNormal3f(normal[0], normal[1], normal[2]);
-        glVertex3f(v1[0], v1[1], v1[2]);
-        glVertex3f(v2[0], v2[1], v2[2]);
-        glVertex3f(v3[0], v3[1], v3[2]);
+        return;
     }
-    
-    glEnd();
-    
-    glColor3f(0.4f, 0.4f, 0.4f); 
-    
-    struct BumpDetail {
-        float x, y, z, size;
-    };
-    
-    BumpDetail bumps[] = {
-        {-0.3f, 0.8f, -0.2f, 0.1f},
-        {0.4f, 0.6f, 0.3f, 0.08f},
-        {-0.6f, 0.4f, 0.5f, 0.12f},
-        {0.7f, 0.9f, -0.1f, 0.07f},
-        {-0.1f, 1.1f, 0.4f, 0.09f},
-        {0.2f, 0.3f, -0.7f, 0.11f}
-    };
-    
-    for (int i = 0; i < 6; i++) {
-        glPushMatrix();
-        glTranslatef(bumps[i].x, bumps[i].y, bumps[i].z);
-        
-        glBegin(GL_TRIANGLES);
-        float size = bumps[i].size;
-        
-        glNormal3f(0.0f, 1.0f, 0.0f);
-        glVertex3f(-size, 0.0f, -size);
-        glVertex3f(size, 0.0f, -size);
-        glVertex3f(0.0f, size * 0.8f, 0.0f);
-        
-        glVertex3f(size, 0.0f, -size);
-        glVertex3f(size, 0.0f, size);
-        glVertex3f(0.0f, size * 0.8f, 0.0f);
-        
-        glVertex3f(size, 0.0f, size);
-        glVertex3f(-size, 0.0f, size);
-        glVertex3f(0.0f, size * 0.8f, 0.0f);
-        
-        glVertex3f(-size, 0.0f, size);
-        glVertex3f(-size, 0.0f, -size);
-        glVertex3f(0.0f, size * 0.8f, 0.0f);
-        
-        glEnd();
-        glPopMatrix();
+#endif
+    for (int k = 0; k < count; ++k) {
+        getArenaHeightAndNormalAt(xs[k], ys[k], zs[k], outHeight[k], outNormalX[k], outNormalY[k], outNormalZ[k]);
     }
-    
-    glPopMatrix();
-}
\ No newline at end of file
+}
+
+// Baris siap tempel ke file level (.lvl), lihat level.cpp untuk formatnya
+void PrintMarblePositionForPlacement(float x, float y, float z) {
+    printf("~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\n");
+    printf("cube %.2f %.2f %.2f sizeX sizeY sizeZ\n", x, y, z);
+    printf("ramp %.2f %.2f %.2f sizeX sizeY sizeZ x|z\n", x, y, z);
+    printf("bush %.2f %.2f %.2f radius\n", x, y, z);
+    printf("tree %.2f %.2f %.2f trunkHeight trunkRadius foliageRadius\n", x, y, z);
+    printf("rock %.2f %.2f %.2f scale\n", x, y, z);
+    printf("checkpoint %.2f %.2f bonusMinutes\n", x, z);
+    printf("finish %.2f %.2f\n", x, z);
+    printf("coin %.2f %.2f\n", x, z);
+    printf("~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\n");
+}
+
+
+
@@ -1,17 +1,131 @@
 #ifndef ARENA_H
 #define ARENA_H
 
+#include "globals.h"
+#include <vector>
+
+struct ArenaCube {
+    float x, y, z, sizeX, sizeY, sizeZ;
+};
+struct ArenaRamp {
+    float x, y, z, sizeX, sizeY, sizeZ; char axis;
+};
+struct ArenaBush {
+    float x, y, z, radius;
+};
+struct ArenaTree {
+    float x, y, z;
+    float trunkHeight, trunkRadius;
+    float foliageRadius;
+};
+struct ArenaRock {
+    float x, y, z;
+    float scale;
+};
+
+// AABB dunia per objek, dihitung di setupArenaGeometry (buildArenaBounds) untuk culling
+struct ArenaBounds {
+    float minX, minY, minZ;
+    float maxX, maxY, maxZ;
+};
+
+struct Coin {
+    float x, y, z;
+    bool collected;
+};
+
+extern std::vector<ArenaCube> cubes;
+extern std::vector<ArenaRamp> ramps;
+extern std::vector<ArenaBush> bushes;
+extern std::vector<ArenaTree> trees;
+extern std::vector<ArenaRock> rocks;
+extern std::vector<Coin> coins;
+extern std::vector<ArenaBounds> cubeBounds, rampBounds, bushBounds, treeBounds, rockBounds;
 
 void setupArenaGeometry();
-void drawCube(float centerX, float centerY, float centerZ, float sizeX, float sizeY, float sizeZ);
-void drawRamp(float centerX, float centerY, float centerZ, float sizeX, float sizeY, float sizeZ, char axis);
-void drawBush(float centerX, float centerY, float centerZ, float radius);
+void clearArenaGeometry(); // Termasuk coin
+void CreateCube(float x, float y, float z, float sizeX, float sizeY, float sizeZ);
+void CreateRamp(float x, float y, float z, float sizeX, float sizeY, float sizeZ, char axis);
+void CreateBush(float x, float y, float z, float radius);
+void CreateTree(float x, float y, float z, float trunkHeight, float trunkRadius, float foliageRadius);
+void CreateRock(float x, float y, float z, float scale);
+// Rasterisasi cube/ramp ke grid heights (dikosongkan dulu), sama dengan CreateCube/CreateRamp
+// untuk jendela arena berpusat di origin (titik grid di kelipatan langkah grid dunia,
+// origin dibulatkan ke sana). Tidak menyentuh state global (aman dari thread lain).
+void rasterizeArenaHeights(const std::vector<ArenaCube>& cubeList, const std::vector<ArenaRamp>& rampList,
+                           float heights[GRID_SIZE][GRID_SIZE], float originX, float originZ);
+// Ganti semua cube/ramp plus arenaHeights hasil rasterisasinya (hot reload). Hanya
+// primitive yang beda antara list lama dan baru yang diproses, seperti edit runtime:
+// grid broadphase ditambal di footprint-nya, heightfield fast path dibangun ulang di
+// cell footprint itu (juga cell yang tingginya berubah), bounds dan cull grid
+// cube/ramp ditambal. Return jumlah cell yang dibangun ulang. Bounds/cull/LOD
+// bush/tree/rock oleh pemanggil (lihat level.cpp).
+int replaceArenaSolids(const std::vector<ArenaCube>& newCubes, const std::vector<ArenaRamp>& newRamps,
+                       const float newHeights[GRID_SIZE][GRID_SIZE]);
+// Geser jendela arena ke origin baru (streaming, level.cpp) tanpa membangun ulang
+// semuanya. newCubes/newRamps = isi jendela baru, remap[lama] = index baru atau -1
+// (chunk dilepas), added = index baru dari chunk yang baru dimuat (urut naik, urutan
+// relatif primitive yang tetap tidak berubah). Cell heightfield dan cell grid yang
+// tetap di jendela hanya pindah index (lattice heightfield menempel di dunia, grid
+// selebar kelipatan 4 cell); yang dibangun ulang hanya strip baru dan footprint
+// primitive yang dilepas/dimuat. Bounds dan cull grid cube/ramp ikut, origin diisi.
+// Return jumlah cell heightfield yang dibangun ulang.
+int shiftArenaWindow(float originX, float originZ,
+                     const std::vector<ArenaCube>& newCubes, const std::vector<int>& cubeRemap, const std::vector<int>& cubeAdded,
+                     const std::vector<ArenaRamp>& newRamps, const std::vector<int>& rampRemap, const std::vector<int>& rampAdded,
+                     const float newHeights[GRID_SIZE][GRID_SIZE]);
+// Edit cube/ramp saat runtime (platform bergerak, blok hancur), setelah
+// finalizeArenaGeometry. Hanya titik/cell heightfield di footprint lama dan baru
+// yang dihitung ulang. Remove memindahkan primitive terakhir ke index yang dihapus.
+int addArenaCube(const ArenaCube& cube);
+void moveArenaCube(int index, float x, float y, float z);
+void removeArenaCube(int index);
+int addArenaRamp(const ArenaRamp& ramp);
+void moveArenaRamp(int index, float x, float y, float z);
+void removeArenaRamp(int index);
+// Jenis objek yang diedit sejak panggilan terakhir (mask ARENA_CHANGED_* di
+// arenacull.h), untuk renderer yang perlu bake ulang batch-nya
+unsigned takeArenaChanges();
+// Naik setiap kali cube/ramp atau arenaHeights berubah (load level, jendela
+// streaming, edit runtime). Cache turunan (mis. tinggi checkpoint) cukup
+// dibandingkan dengan nilai ini, tanpa ikut menghabiskan takeArenaChanges.
+unsigned arenaSolidVersion();
+// Bangun grid, heightfield, bounds, cull grid, dan LOD dari geometri yang ada.
+// Dipanggil setelah semua Create* (atau setelah arenaHeights diisi langsung), sebelum addCoin.
+void finalizeArenaGeometry();
+void buildArenaSpatialGrid(); // Dipanggil sekali setelah semua CreateCube/CreateRamp
+void buildArenaBounds(); // AABB cube/ramp/bush/tree/rock, mencakup seluruh geometri gambarnya
+void rebuildArenaBounds(unsigned changed); // Hanya jenis di mask (bit 1 << ArenaCullKind, arenacull.h)
+void setArenaSpatialGridEnabled(bool enabled); // false = scan linear (untuk benchmark)
+void buildArenaHeightfield(); // Gradien + mode cell dari arenaHeights
+// Sampling arenaHeights di getArenaHeight/getArenaHeightAndNormal. Hanya cell yang
+// permukaan teratasnya satu primitive (atau tanah) dan lebih tinggi > epsilon dari
+// semua kandidat lain; di pita tepi/dinding query exact hanya mengetes beberapa
+// primitive teratas yang disimpan cell (hasil identik). Pilihan permukaan sama dengan
+// query exact, hasilnya hanya beda pembulatan float: tinggi sampai ~5.3e-6, jumlah
+// |beda| komponen normal sampai ~8e-6 (lihat heightfield di marble_bench).
+void setArenaHeightfieldFastPath(bool enabled);
 float getArenaHeight(float x, float z);
 void getArenaHeightAndNormal(float x, float z, float& outHeight, float& outNormalX, float& outNormalY, float& outNormalZ);
-void drawGround();
 float getArenaHeightAt(float x, float y, float z);
 void getArenaHeightAndNormalAt(float x, float y, float z, float& outHeight, float& outNormalX, float& outNormalY, float& outNormalZ);
+// Versi batch untuk banyak probe sekaligus (CCD); hasil identik dengan memanggil
+// getArenaHeightAndNormalAt per titik (juga setelah jendela streaming bergeser).
+// Dengan SSE2 tiap probe mengetes 4 kandidat cell grid per instruksi (field SoA
+// per cell); di cell yang kandidatnya < 4, 4 probe di cell itu dites sekaligus.
+void getArenaHeightAndNormalAtBatch(const float* xs, const float* ys, const float* zs, int count,
+                                    float* outHeight, float* outNormalX, float* outNormalY, float* outNormalZ);
+void addCoin(float x, float z);
+void clearCoins();
+unsigned arenaCoinVersion(); // Naik tiap addCoin/clearCoins, seperti arenaSolidVersion
 
+// Gambar arena (arenadraw.cpp, butuh OpenGL)
+void drawCube(float centerX, float centerY, float centerZ, float sizeX, float sizeY, float sizeZ);
+void drawRamp(float centerX, float centerY, float centerZ, float sizeX, float sizeY, float sizeZ, char axis);
+void drawBush(float centerX, float centerY, float centerZ, float radius);
+void drawGround();
 void drawTree(float x, float y, float z, float trunkHeight, float trunkRadius, float foliageRadius);
 void drawRock(float centerX, float centerY, float centerZ, float scale);
+void drawCoins();
+void updateCoinAnimation(float deltaTime);
 #endif // ARENA_H
\ No newline at end of file
@@ -0,0 +1,284 @@
+#include "arenacull.h"
+#include "arena.h"
+#include "globals.h"
+#include <algorithm>
+#include <cmath>
+
+// 8 x 8 tile untuk arena 80 x 80: cukup kasar supaya tes tile murah, cukup halus
+// supaya tile di belakang kamera terbuang. Tile menempel di dunia (kelipatan
+// cullTileSize) dan dinomori per blok 2 x 2 tile = satu chunk jendela streaming.
+static const int CULL_TILES = 8;
+static const float cullTileSize = 2.0f * BOUNDS / CULL_TILES;
+static const int CULL_BLOCK_TILES = CULL_TILES / ARENA_CULL_BLOCKS_PER_SIDE;
+
+enum { FRUSTUM_OUTSIDE, FRUSTUM_INTERSECT, FRUSTUM_INSIDE };
+
+struct ArenaCullKindData {
+    std::vector<int> order;      // Index objek, dikelompokkan per tile
+    std::vector<int> tileStart;  // CSR: objek tile t di order[tileStart[t]..tileStart[t+1])
+    std::vector<int> visible;    // Posisi di order yang lolos cull frame ini
+    ArenaBounds tileBounds[CULL_TILES * CULL_TILES]; // Gabungan AABB objek jenis ini per tile
+    bool tileUsed[CULL_TILES * CULL_TILES];
+};
+
+static ArenaCullKindData cullKinds[CULL_KIND_COUNT];
+static ArenaBounds cullTileBounds[CULL_TILES * CULL_TILES];
+static bool cullTileUsed[CULL_TILES * CULL_TILES];
+static float frustumPlanes[6][4];
+static bool frustumValid = false;
+static bool cullingEnabled = true;
+static ArenaCullStats cullStats = {0, 0, 0};
+
+const std::vector<ArenaBounds>& arenaCullBounds(ArenaCullKind kind) {
+    switch (kind) {
+        case CULL_CUBE: return cubeBounds;
+        case CULL_RAMP: return rampBounds;
+        case CULL_BUSH: return bushBounds;
+        case CULL_TREE: return treeBounds;
+        default: return rockBounds;
+    }
+}
+
+// Tile dari posisi objek (bukan pusat AABB), sama dengan pembagian chunk level
+// (floor(x / levelChunkSize)), jadi isi blok = isi chunk jendela
+static int tileIndexOf(ArenaCullKind kind, int i) {
+    float x, z;
+    switch (kind) {
+        case CULL_CUBE: x = cubes[i].x; z = cubes[i].z; break;
+        case CULL_RAMP: x = ramps[i].x; z = ramps[i].z; break;
+        case CULL_BUSH: x = bushes[i].x; z = bushes[i].z; break;
+        case CULL_TREE: x = trees[i].x; z = trees[i].z; break;
+        default: x = rocks[i].x; z = rocks[i].z; break;
+    }
+    int tx = (int)floorf(x / cullTileSize) - (int)lroundf((arenaOriginX - BOUNDS) / cullTileSize);
+    int tz = (int)floorf(z / cullTileSize) - (int)lroundf((arenaOriginZ - BOUNDS) / cullTileSize);
+    tx = std::min(std::max(tx, 0), CULL_TILES - 1);
+    tz = std::min(std::max(tz, 0), CULL_TILES - 1);
+    int block = (tz / CULL_BLOCK_TILES) * ARENA_CULL_BLOCKS_PER_SIDE + tx / CULL_BLOCK_TILES;
+    return (block * CULL_BLOCK_TILES + tz % CULL_BLOCK_TILES) * CULL_BLOCK_TILES + tx % CULL_BLOCK_TILES;
+}
+
+static void markAllVisible(ArenaCullKindData& data) {
+    data.visible.clear();
+    for (int i = 0; i < (int)data.order.size(); ++i) data.visible.push_back(i);
+}
+
+static void markAllVisible() {
+    for (auto& data : cullKinds) markAllVisible(data);
+}
+
+static void growBounds(ArenaBounds& into, const ArenaBounds& b) {
+    into.minX = std::min(into.minX, b.minX); into.minY = std::min(into.minY, b.minY); into.minZ = std::min(into.minZ, b.minZ);
+    into.maxX = std::max(into.maxX, b.maxX); into.maxY = std::max(into.maxY, b.maxY); into.maxZ = std::max(into.maxZ, b.maxZ);
+}
+
+static void buildCullKind(int kind) {
+    const int numTiles = CULL_TILES * CULL_TILES;
+    const std::vector<ArenaBounds>& bounds = arenaCullBounds((ArenaCullKind)kind);
+    ArenaCullKindData& data = cullKinds[kind];
+    int n = (int)bounds.size();
+    std::vector<int> tileOf(n);
+    data.tileStart.assign(numTiles + 1, 0);
+    for (int t = 0; t < numTiles; ++t) data.tileUsed[t] = false;
+    for (int i = 0; i < n; ++i) {
+        int t = tileIndexOf((ArenaCullKind)kind, i);
+        tileOf[i] = t;
+        data.tileStart[t + 1]++;
+        if (!data.tileUsed[t]) {
+            data.tileBounds[t] = bounds[i];
+            data.tileUsed[t] = true;
+        } else {
+            growBounds(data.tileBounds[t], bounds[i]);
+        }
+    }
+    for (int t = 0; t < numTiles; ++t) data.tileStart[t + 1] += data.tileStart[t];
+    data.order.resize(n);
+    std::vector<int> fill(data.tileStart.begin(), data.tileStart.end() - 1);
+    for (int i = 0; i < n; ++i) data.order[fill[tileOf[i]]++] = i;
+    data.visible.reserve(n);
+    markAllVisible(data);
+}
+
+// Bounds tile gabungan semua jenis; jenis yang tidak berubah memakai hasil lamanya
+static void combineTileBounds() {
+    for (int t = 0; t < CULL_TILES * CULL_TILES; ++t) {
+        cullTileUsed[t] = false;
+        for (const auto& data : cullKinds) {
+            if (!data.tileUsed[t]) continue;
+            if (!cullTileUsed[t]) cullTileBounds[t] = data.tileBounds[t];
+            else growBounds(cullTileBounds[t], data.tileBounds[t]);
+            cullTileUsed[t] = true;
+        }
+    }
+}
+
+void rebuildArenaCullGrid(unsigned changed) {
+    for (int kind = 0; kind < CULL_KIND_COUNT; ++kind) {
+        if (changed & (1u << kind)) buildCullKind(kind);
+    }
+    combineTileBounds();
+}
+
+void remapArenaCullKind(ArenaCullKind kind, const std::vector<int>& remap, const std::vector<int>& added) {
+    const int numTiles = CULL_TILES * CULL_TILES;
+    static std::vector<int> newStart, newOrder, addedByTile, addedStart;
+    const std::vector<ArenaBounds>& bounds = arenaCullBounds(kind);
+    ArenaCullKindData& data = cullKinds[kind];
+    // Objek baru dikelompokkan per tile (urut naik karena added urut naik)
+    addedStart.assign(numTiles + 1, 0);
+    for (int k : added) addedStart[tileIndexOf(kind, k) + 1]++;
+    for (int t = 0; t < numTiles; ++t) addedStart[t + 1] += addedStart[t];
+    addedByTile.resize(added.size());
+    std::vector<int> fill(addedStart.begin(), addedStart.end() - 1);
+    for (int k : added) addedByTile[fill[tileIndexOf(kind, k)]++] = k;
+
+    newStart.assign(numTiles + 1, 0);
+    newOrder.clear();
+    newOrder.reserve(bounds.size());
+    for (int t = 0; t < numTiles; ++t) {
+        size_t tileBegin = newOrder.size();
+        bool dropped = false;
+        for (int p = data.tileStart[t]; p < data.tileStart[t + 1]; ++p) {
+            int id = remap[data.order[p]];
+            if (id >= 0) newOrder.push_back(id);
+            else dropped = true;
+        }
+        size_t tileMid = newOrder.size();
+        newOrder.insert(newOrder.end(), addedByTile.begin() + addedStart[t], addedByTile.begin() + addedStart[t + 1]);
+        std::inplace_merge(newOrder.begin() + tileBegin, newOrder.begin() + tileMid, newOrder.end());
+        newStart[t + 1] = (int)newOrder.size();
+        // Objek yang dibuang bisa mengecilkan bounds tile, jadi tile itu dihitung
+        // ulang; tile lain cukup diperluas dengan objek baru
+        if (dropped || !data.tileUsed[t]) {
+            data.tileUsed[t] = newOrder.size() > tileBegin;
+            if (data.tileUsed[t]) data.tileBounds[t] = bounds[newOrder[tileBegin]];
+            for (size_t p = tileBegin + 1; p < newOrder.size(); ++p) growBounds(data.tileBounds[t], bounds[newOrder[p]]);
+        } else {
+            for (int a = addedStart[t]; a < addedStart[t + 1]; ++a) growBounds(data.tileBounds[t], bounds[addedByTile[a]]);
+        }
+    }
+    data.order.swap(newOrder);
+    data.tileStart.swap(newStart);
+    markAllVisible(data);
+    combineTileBounds();
+}
+
+void buildArenaCullGrid() {
+    rebuildArenaCullGrid((1u << CULL_KIND_COUNT) - 1);
+}
+
+void setArenaCullingEnabled(bool enabled) {
+    cullingEnabled = enabled;
+}
+
+bool isArenaCullingEnabled() {
+    return cullingEnabled;
+}
+
+// Plane frustum dari baris matriks clip = projection * modelview (Gribb/Hartmann),
+// normal menghadap ke dalam
+static void extractFrustum(const float* p, const float* m) {
+    float clip[16];
+    for (int col = 0; col < 4; ++col) {
+        for (int row = 0; row < 4; ++row) {
+            clip[col * 4 + row] = p[0 * 4 + row] * m[col * 4 + 0] + p[1 * 4 + row] * m[col * 4 + 1] +
+                                  p[2 * 4 + row] * m[col * 4 + 2] + p[3 * 4 + row] * m[col * 4 + 3];
+        }
+    }
+    for (int i = 0; i < 6; ++i) {
+        int row = i / 2;
+        float sign = (i % 2 == 0) ? 1.0f : -1.0f;
+        for (int k = 0; k < 4; ++k) {
+            frustumPlanes[i][k] = clip[k * 4 + 3] + sign * clip[k * 4 + row];
+        }
+        float len = sqrtf(frustumPlanes[i][0] * frustumPlanes[i][0] + frustumPlanes[i][1] * frustumPlanes[i][1] +
+                          frustumPlanes[i][2] * frustumPlanes[i][2]);
+        if (len > 0.0f) {
+            for (int k = 0; k < 4; ++k) frustumPlanes[i][k] /= len;
+        }
+    }
+    frustumValid = true;
+}
+
+static int testBox(const ArenaBounds& b) {
+    int result = FRUSTUM_INSIDE;
+    for (int i = 0; i < 6; ++i) {
+        const float* pl = frustumPlanes[i];
+        // Sudut paling searah normal (p) dan paling berlawanan (n)
+        float px = pl[0] >= 0.0f ? b.maxX : b.minX, nx = pl[0] >= 0.0f ? b.minX : b.maxX;
+        float py = pl[1] >= 0.0f ? b.maxY : b.minY, ny = pl[1] >= 0.0f ? b.minY : b.maxY;
+        float pz = pl[2] >= 0.0f ? b.maxZ : b.minZ, nz = pl[2] >= 0.0f ? b.minZ : b.maxZ;
+        if (pl[0] * px + pl[1] * py + pl[2] * pz + pl[3] < 0.0f) return FRUSTUM_OUTSIDE;
+        if (pl[0] * nx + pl[1] * ny + pl[2] * nz + pl[3] < 0.0f) result = FRUSTUM_INTERSECT;
+    }
+    return result;
+}
+
+void cullArena(const float* projection, const float* modelview) {
+    cullStats.objectsDrawn = 0;
+    cullStats.objectsCulled = 0;
+    cullStats.tilesCulled = 0;
+    if (!cullingEnabled) {
+        frustumValid = false;
+        markAllVisible();
+        for (const auto& data : cullKinds) cullStats.objectsDrawn += (int)data.order.size();
+        return;
+    }
+    extractFrustum(projection, modelview);
+
+    for (auto& data : cullKinds) data.visible.clear();
+    for (int t = 0; t < CULL_TILES * CULL_TILES; ++t) {
+        if (!cullTileUsed[t]) continue;
+        int tileResult = testBox(cullTileBounds[t]);
+        if (tileResult == FRUSTUM_OUTSIDE) cullStats.tilesCulled++;
+        for (int kind = 0; kind < CULL_KIND_COUNT; ++kind) {
+            ArenaCullKindData& data = cullKinds[kind];
+            int begin = data.tileStart[t], end = data.tileStart[t + 1];
+            if (tileResult == FRUSTUM_OUTSIDE) {
+                cullStats.objectsCulled += end - begin;
+                continue;
+            }
+            const std::vector<ArenaBounds>& bounds = arenaCullBounds((ArenaCullKind)kind);
+            for (int k = begin; k < end; ++k) {
+                if (tileResult == FRUSTUM_INSIDE || testBox(bounds[data.order[k]]) != FRUSTUM_OUTSIDE) {
+                    data.visible.push_back(k);
+                    cullStats.objectsDrawn++;
+                } else {
+                    cullStats.objectsCulled++;
+                }
+            }
+        }
+    }
+}
+
+const std::vector<int>& arenaCullOrder(ArenaCullKind kind) {
+    return cullKinds[kind].order;
+}
+
+void arenaCullBlockRange(ArenaCullKind kind, int block, int& first, int& last) {
+    const int tilesPerBlock = CULL_BLOCK_TILES * CULL_BLOCK_TILES;
+    first = cullKinds[kind].tileStart[block * tilesPerBlock];
+    last = cullKinds[kind].tileStart[(block + 1) * tilesPerBlock];
+}
+
+const std::vector<int>& arenaVisibleObjects(ArenaCullKind kind) {
+    return cullKinds[kind].visible;
+}
+
+bool arenaSphereVisible(float x, float y, float z, float radius) {
+    if (frustumValid) {
+        for (int i = 0; i < 6; ++i) {
+            const float* pl = frustumPlanes[i];
+            if (pl[0] * x + pl[1] * y + pl[2] * z + pl[3] < -radius) {
+                cullStats.objectsCulled++;
+                return false;
+            }
+        }
+    }
+    cullStats.objectsDrawn++;
+    return true;
+}
+
+ArenaCullStats arenaCullStats() {
+    return cullStats;
+}
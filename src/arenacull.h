@@ -0,0 +1,56 @@
+#ifndef ARENACULL_H
+#define ARENACULL_H
+
+#include "arena.h"
+#include <vector>
+
+// View-frustum culling objek arena. Objek dikelompokkan ke tile grid XZ (CSR per
+// jenis objek); tile yang di luar frustum dibuang sekaligus, tile yang seluruhnya
+// di dalam diterima tanpa tes per objek. Tanpa GL: matriks diberikan pemanggil.
+enum ArenaCullKind { CULL_CUBE, CULL_RAMP, CULL_BUSH, CULL_TREE, CULL_ROCK, CULL_KIND_COUNT };
+
+// Mask perubahan untuk membangun ulang sebagian (hot reload level): bit
+// (1 << ArenaCullKind) per jenis objek, plus coin, checkpoint/finish, dan
+// pergeseran jendela arena (arenaOriginX/Z, ground ikut digeser)
+const unsigned ARENA_CHANGED_COINS = 1u << CULL_KIND_COUNT;
+const unsigned ARENA_CHANGED_CHECKPOINTS = 1u << (CULL_KIND_COUNT + 1);
+const unsigned ARENA_CHANGED_ORIGIN = 1u << (CULL_KIND_COUNT + 2);
+
+struct ArenaCullStats {
+    int objectsDrawn;   // Termasuk checkpoint/coin yang lolos arenaSphereVisible
+    int objectsCulled;
+    int tilesCulled;
+};
+
+void buildArenaCullGrid(); // Setelah buildArenaBounds; semua objek awalnya terlihat
+// Hanya jenis di mask changed (bit 1 << ArenaCullKind, bit lain diabaikan), jenis
+// lain tetap dengan urutan dan daftar terlihatnya
+void rebuildArenaCullGrid(unsigned changed);
+// Setelah list objek jenis ini diganti (replaceArenaSolids): remap[lama] = index baru
+// atau -1, added = index baru yang belum ada (urut naik). Objek lama tetap di tile-nya,
+// hasilnya sama dengan rebuildArenaCullGrid tanpa menghitung tile semua objek.
+void remapArenaCullKind(ArenaCullKind kind, const std::vector<int>& remap, const std::vector<int>& added);
+void setArenaCullingEnabled(bool enabled);
+bool isArenaCullingEnabled();
+// Matriks OpenGL column-major (GL_PROJECTION_MATRIX, GL_MODELVIEW_MATRIX tanpa
+// transform objek). Menghitung frustum lalu daftar objek terlihat untuk frame ini.
+void cullArena(const float* projection, const float* modelview);
+// Urutan objek di tile grid (index ke cubes/ramps/...); mesh di-bake dengan urutan
+// ini supaya objek terlihat membentuk range index yang bersambung
+const std::vector<int>& arenaCullOrder(ArenaCullKind kind);
+// Tile dikelompokkan per blok seukuran chunk jendela streaming (levelChunkSize,
+// lihat level.h), ARENA_CULL_BLOCKS blok urut (z, x) seperti chunk jendela. Objek
+// satu blok bersambung di arenaCullOrder di [first, last); urutan di dalam blok hanya
+// bergantung pada isi blok, jadi tetap sama selama chunk-nya resident.
+const int ARENA_CULL_BLOCKS_PER_SIDE = 4;
+const int ARENA_CULL_BLOCKS = ARENA_CULL_BLOCKS_PER_SIDE * ARENA_CULL_BLOCKS_PER_SIDE;
+void arenaCullBlockRange(ArenaCullKind kind, int block, int& first, int& last);
+// AABB objek (cubeBounds, rampBounds, ...) untuk jenis ini, index sama dengan arena
+const std::vector<ArenaBounds>& arenaCullBounds(ArenaCullKind kind);
+// Posisi di arenaCullOrder yang terlihat, urut naik
+const std::vector<int>& arenaVisibleObjects(ArenaCullKind kind);
+// Tes bola untuk objek dinamis (checkpoint, coin), ikut dihitung di statistik
+bool arenaSphereVisible(float x, float y, float z, float radius);
+ArenaCullStats arenaCullStats();
+
+#endif // ARENACULL_H
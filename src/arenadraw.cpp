@@ -0,0 +1,647 @@
+#include "arena.h"
+#include "globals.h"
+#include "graphics.h"
+#include "arenamesh.h"
+#include "primitivemesh.h"
+#include "propinstances.h"
+#include "arenacull.h"
+#include "profiler.h"
+#include <cmath>
+#include <GL/glut.h>
+
+float coinSpinAngle = 0.0f;
+float coinBounceTime = 0.0f;
+
+void updateCoinAnimation(float deltaTime) {
+    coinSpinAngle += 120.0f * deltaTime; // 120 derajat per detik
+    if (coinSpinAngle > 360.0f) coinSpinAngle -= 360.0f;
+    coinBounceTime += deltaTime;
+}
+
+void drawCoins() {
+    if (propInstancingActive()) {
+        drawCoinInstances();
+        return;
+    }
+    for (const Coin& coin : coins) {
+        if (coin.collected) continue;
+        // Radius coin 0.4 plus bounce 0.2
+        if (!arenaSphereVisible(coin.x, coin.y, coin.z, 0.6f)) continue;
+        glPushMatrix();
+        // Animasi naik turun
+        float bounce = 0.2f * sinf(coinBounceTime * 2.5f + coin.x + coin.z);
+        glTranslatef(coin.x, coin.y + bounce, coin.z);
+        // Animasi rotasi
+        glRotatef(coinSpinAngle, 0, 1, 0);
+        // Material: Emas (gold)
+        GLfloat gold_ambient[4] = {0.24725f, 0.1995f, 0.0745f, 1.0f};
+        GLfloat gold_diffuse[4] = {0.75164f, 0.60648f, 0.22648f, 1.0f};
+        GLfloat gold_specular[4] = {0.628281f, 0.555802f, 0.366065f, 1.0f};
+        GLfloat gold_shininess = 51.2f;
+        glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, gold_ambient);
+        glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, gold_diffuse);
+        glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, gold_specular);
+        glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, gold_shininess);
+        glColor3f(1.0f, 0.84f, 0.0f); // Gold color
+        drawPrimitiveDisk(0.4f, 32); // Sisi atas
+        glTranslatef(0, 0.08f, 0);
+        drawPrimitiveDisk(0.4f, 32); // Sisi bawah
+        glTranslatef(0, -0.04f, 0);
+        drawPrimitiveCylinder(0.4f, 0.4f, 0.08f, 32); // Sisi samping
+        glPopMatrix();
+    }
+}
+
+void drawCube(float centerX, float centerY, float centerZ, float sizeX, float sizeY, float sizeZ) {
+    if (enableShadows) {
+        glPushMatrix();
+            GLfloat shadow_plane[4] = {0.0f, 1.0f, 0.0f, -0.01f}; 
+            GLfloat shadow_light[4] = {10.0f, 80.0f, 10.0f, 1.0f};
+            extern void glShadowProjection(const float*, const float*); 
+            glShadowProjection(shadow_light, shadow_plane);
+            glTranslatef(centerX, centerY, centerZ);
+            glScalef(sizeX, sizeY, sizeZ);
+            glEnable(GL_POLYGON_OFFSET_FILL);
+            glPolygonOffset(-2.0f, -2.0f);
+            glDepthMask(GL_FALSE);
+            glDisable(GL_LIGHTING);
+            glColor4f(0.1f, 0.1f, 0.1f, 0.5f);
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            drawPrimitiveCube(1.0f);
+            glDisable(GL_BLEND);
+            glEnable(GL_LIGHTING);
+            glDepthMask(GL_TRUE);
+            glDisable(GL_POLYGON_OFFSET_FILL);
+        glPopMatrix();
+    }
+
+    glPushMatrix();
+    glTranslatef(centerX, centerY, centerZ);
+    glScalef(sizeX, sizeY, sizeZ);
+    glColor3f(0.7f, 0.6f, 0.5f); 
+    drawPrimitiveCube(1.0f);
+    glPopMatrix();
+}
+
+void drawRamp(float centerX, float centerY, float centerZ, float sizeX, float sizeY, float sizeZ, char axis) {
+    if (enableShadows) {
+        glPushMatrix();
+            GLfloat shadow_plane[4] = {0.0f, 1.0f, 0.0f, -0.01f};
+            GLfloat shadow_light[4] = {10.0f, 80.0f, 10.0f, 1.0f};
+            extern void glShadowProjection(const float*, const float*);
+            glShadowProjection(shadow_light, shadow_plane);
+            glTranslatef(centerX, centerY, centerZ);
+            
+            // Setengah ukuran untuk kemudahan perhitungan vertex
+            float hx = sizeX / 2.0f;
+            float hy = sizeY / 2.0f; 
+            float hz = sizeZ / 2.0f;
+              glEnable(GL_POLYGON_OFFSET_FILL);
+            glPolygonOffset(-2.0f, -2.0f);
+            glDepthMask(GL_FALSE);
+            glDisable(GL_LIGHTING);
+            glDisable(GL_TEXTURE_2D); // Disable any textures
+            glColor4f(0.0f, 0.0f, 0.0f, 0.4f); // Pure black shadow
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            
+            if (axis == 'z') {
+                float v[6][3] = {
+                    {-hx, -hy, -hz}, { hx, -hy, -hz}, {-hx, -hy,  hz}, 
+                    { hx, -hy,  hz}, {-hx,  hy,  hz}, { hx,  hy,  hz}
+                };
+                glBegin(GL_QUADS);
+                glVertex3fv(v[0]); glVertex3fv(v[1]); glVertex3fv(v[5]); glVertex3fv(v[4]);
+                glEnd();
+                glBegin(GL_QUADS);
+                glVertex3fv(v[0]); glVertex3fv(v[2]); glVertex3fv(v[3]); glVertex3fv(v[1]);
+                glEnd();
+            } else if (axis == 'x') {
+                float v[6][3] = {
+                    {-hx, -hy, -hz}, {-hx, -hy,  hz}, { hx, -hy, -hz}, 
+                    { hx, -hy,  hz}, { hx,  hy, -hz}, { hx,  hy,  hz}
+                };
+                glBegin(GL_QUADS);
+                glVertex3fv(v[0]); glVertex3fv(v[1]); glVertex3fv(v[5]); glVertex3fv(v[4]);
+                glEnd();
+                glBegin(GL_QUADS);
+                glVertex3fv(v[0]); glVertex3fv(v[2]); glVertex3fv(v[3]); glVertex3fv(v[1]);
+                glEnd();
+            }
+              glDisable(GL_BLEND);
+            glEnable(GL_LIGHTING);
+            glDepthMask(GL_TRUE);
+            glDisable(GL_POLYGON_OFFSET_FILL);
+        glPopMatrix();
+    }
+
+    glPushMatrix();
+    glTranslatef(centerX, centerY, centerZ); // Pindahkan ke pusat ramp
+    
+    glColor3f(0.7f, 0.6f, 0.5f); 
+
+    // Setengah ukuran untuk kemudahan perhitungan vertex
+    // sizeY adalah tinggi total ramp. Puncak ramp akan di centerY + sizeY/2, dasar di centerY - sizeY/2
+    float hx = sizeX / 2.0f;
+    float hy = sizeY / 2.0f; 
+    float hz = sizeZ / 2.0f;
+
+    if (axis == 'z') { // Ramp miring sepanjang sumbu Z
+        
+        float v[6][3] = {
+            {-hx, -hy, -hz}, // v0 (depan-bawah-kiri, kaki ramp)
+            { hx, -hy, -hz}, // v1 (depan-bawah-kanan, kaki ramp)
+            {-hx, -hy,  hz}, // v2 (belakang-bawah-kiri, di dasar bagian vertikal)
+            { hx, -hy,  hz}, // v3 (belakang-bawah-kanan, di dasar bagian vertikal)
+            {-hx,  hy,  hz}, // v4 (belakang-atas-kiri, puncak ramp)
+            { hx,  hy,  hz}  // v5 (belakang-atas-kanan, puncak ramp)
+        };
+
+        
+        float norm_slope_x = 0;
+        float norm_slope_y = -sizeX * sizeZ; 
+        float norm_slope_z = sizeX * sizeY;
+        float len_slope = sqrt(norm_slope_x*norm_slope_x + norm_slope_y*norm_slope_y + norm_slope_z*norm_slope_z);
+        if (len_slope > 1e-6) {
+            norm_slope_x /= len_slope;
+            norm_slope_y /= len_slope;
+            norm_slope_z /= len_slope;
+        }
+      
+        norm_slope_x = 0;
+        norm_slope_y = sizeX * sizeZ;
+        norm_slope_z = -sizeX * sizeY;
+        len_slope = sqrt(norm_slope_y*norm_slope_y + norm_slope_z*norm_slope_z); 
+        if (len_slope > 1e-6) {
+            norm_slope_y /= len_slope;
+            norm_slope_z /= len_slope;
+        }
+
+
+        // 1. Permukaan miring (Top/Sloped face) - QUAD
+        glBegin(GL_QUADS);
+        glNormal3f(norm_slope_x, norm_slope_y, norm_slope_z);
+        glVertex3fv(v[0]); // depan-bawah-kiri (kaki ramp)
+        glVertex3fv(v[1]); // depan-bawah-kanan (kaki ramp)
+        glVertex3fv(v[5]); // belakang-atas-kanan (puncak ramp)
+        glVertex3fv(v[4]); // belakang-atas-kiri (puncak ramp)
+        glEnd();
+
+        // 2. Alas (Bottom face) - QUAD
+        glBegin(GL_QUADS);
+        glNormal3f(0.0f, -1.0f, 0.0f); // Menghadap ke bawah
+        glVertex3fv(v[0]); // depan-bawah-kiri
+        glVertex3fv(v[2]); // belakang-bawah-kiri
+        glVertex3fv(v[3]); // belakang-bawah-kanan
+        glVertex3fv(v[1]); // depan-bawah-kanan
+        glEnd();
+
+        // 3. Sisi belakang vertikal (Back face, di z = hz) - QUAD
+        glBegin(GL_QUADS);
+        glNormal3f(0.0f, 0.0f, 1.0f); // Menghadap ke +Z
+        glVertex3fv(v[2]); // belakang-bawah-kiri
+        glVertex3fv(v[3]); // belakang-bawah-kanan
+        glVertex3fv(v[5]); // belakang-atas-kanan
+        glVertex3fv(v[4]); // belakang-atas-kiri
+        glEnd();
+
+        // 4. Sisi kiri (Left triangle) - TRIANGLE
+        glBegin(GL_TRIANGLES);
+        glNormal3f(-1.0f, 0.0f, 0.0f); // Menghadap ke -X
+        glVertex3fv(v[0]); // depan-bawah-kiri
+        glVertex3fv(v[4]); // belakang-atas-kiri
+        glVertex3fv(v[2]); // belakang-bawah-kiri
+        glEnd();
+
+        // 5. Sisi kanan (Right triangle) - TRIANGLE
+        glBegin(GL_TRIANGLES);
+        glNormal3f(1.0f, 0.0f, 0.0f); // Menghadap ke +X
+        glVertex3fv(v[1]); // depan-bawah-kanan
+        glVertex3fv(v[3]); // belakang-bawah-kanan
+        glVertex3fv(v[5]); // belakang-atas-kanan
+        glEnd();
+
+    } else if (axis == 'x') { // Ramp miring sepanjang sumbu X
+       
+        float v[6][3] = {
+            {-hx, -hy, -hz}, // v0 (kiri-bawah-depan, kaki ramp)
+            {-hx, -hy,  hz}, // v1 (kiri-bawah-belakang, kaki ramp)
+            { hx, -hy, -hz}, // v2 (kanan-bawah-depan, di dasar bagian vertikal)
+            { hx, -hy,  hz}, // v3 (kanan-bawah-belakang, di dasar bagian vertikal)
+            { hx,  hy, -hz}, // v4 (kanan-atas-depan, puncak ramp)
+            { hx,  hy,  hz}  // v5 (kanan-atas-belakang, puncak ramp)
+        };
+
+        
+        float norm_slope_x = sizeZ * sizeY;
+        float norm_slope_y = -sizeZ * sizeX;
+        float norm_slope_z = 0;
+        float len_slope = sqrt(norm_slope_x*norm_slope_x + norm_slope_y*norm_slope_y); 
+        if (len_slope > 1e-6) {
+            norm_slope_x /= len_slope;
+            norm_slope_y /= len_slope;
+        }
+        // Balik normal jika Y negatif (agar mengarah ke atas dari permukaan)
+        if (norm_slope_y < 0) {
+            norm_slope_x *= -1;
+            norm_slope_y *= -1;
+        }
+
+
+        // 1. Permukaan miring (Top/Sloped face) - QUAD
+        glBegin(GL_QUADS);
+        glNormal3f(norm_slope_x, norm_slope_y, norm_slope_z);
+        glVertex3fv(v[0]); // kiri-bawah-depan (kaki ramp)
+        glVertex3fv(v[1]); // kiri-bawah-belakang (kaki ramp)
+        glVertex3fv(v[5]); // kanan-atas-belakang (puncak ramp)
+        glVertex3fv(v[4]); // kanan-atas-depan (puncak ramp)
+        glEnd();
+
+        // 2. Alas (Bottom face) - QUAD
+        glBegin(GL_QUADS);
+        glNormal3f(0.0f, -1.0f, 0.0f); // Menghadap ke bawah
+        glVertex3fv(v[0]); // kiri-bawah-depan
+        glVertex3fv(v[2]); // kanan-bawah-depan
+        glVertex3fv(v[3]); // kanan-bawah-belakang
+        glVertex3fv(v[1]); // kiri-bawah-belakang
+        glEnd();
+
+        // 3. Sisi "belakang" vertikal (di x = hx) (Right face) - QUAD
+        glBegin(GL_QUADS);
+        glNormal3f(1.0f, 0.0f, 0.0f); // Menghadap ke +X
+        glVertex3fv(v[2]); // kanan-bawah-depan
+        glVertex3fv(v[3]); // kanan-bawah-belakang
+        glVertex3fv(v[5]); // kanan-atas-belakang
+        glVertex3fv(v[4]); // kanan-atas-depan
+        glEnd();
+
+        // 4. Sisi "depan" (di -Z) (Front triangle) - TRIANGLE
+        glBegin(GL_TRIANGLES);
+        glNormal3f(0.0f, 0.0f, -1.0f); // Menghadap ke -Z
+        glVertex3fv(v[0]); // kiri-bawah-depan
+        glVertex3fv(v[4]); // kanan-atas-depan
+        glVertex3fv(v[2]); // kanan-bawah-depan
+        glEnd();
+
+        // 5. Sisi "belakang" (di +Z) (Back triangle) - TRIANGLE
+        glBegin(GL_TRIANGLES);
+        glNormal3f(0.0f, 0.0f, 1.0f); // Menghadap ke +Z
+        glVertex3fv(v[1]); // kiri-bawah-belakang
+        glVertex3fv(v[3]); // kanan-bawah-belakang
+        glVertex3fv(v[5]); // kanan-atas-belakang
+        glEnd();
+    }    glPopMatrix();
+}
+
+void drawGround() {
+    PROFILE_ZONE("drawGround");
+    // Jalur utama: mesh statis yang sudah di-bake; di bawah ini jalur immediate
+    // lama, dipakai kalau mesh belum di-bake
+    if (isArenaMeshBaked()) {
+        drawArenaMesh();
+        drawPropInstances();
+        drawCoins();
+        return;
+    }
+
+    GLfloat ground_ambient[] = {0.1f, 0.4f, 0.1f, 1.0f};
+    GLfloat ground_diffuse[] = {0.2f, 0.8f, 0.2f, 1.0f};
+    GLfloat ground_specular[] = {0.1f, 0.2f, 0.1f, 1.0f};
+    GLfloat ground_shininess = 8.0f;
+
+    glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, ground_ambient);
+    glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, ground_diffuse);
+    glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, ground_specular);
+    glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, ground_shininess);
+    glColor3f(0.2f, 0.8f, 0.2f); 
+
+    // Gambar ground sebagai sebuah quad besar
+    glBegin(GL_QUADS);
+    glNormal3f(0.0f, 1.0f, 0.0f); // Normal mengarah ke atas
+    glVertex3f(arenaOriginX - BOUNDS, 0.0f, arenaOriginZ - BOUNDS);
+    glVertex3f(arenaOriginX + BOUNDS, 0.0f, arenaOriginZ - BOUNDS);
+    glVertex3f(arenaOriginX + BOUNDS, 0.0f, arenaOriginZ + BOUNDS);
+    glVertex3f(arenaOriginX - BOUNDS, 0.0f, arenaOriginZ + BOUNDS);
+    glEnd();
+
+    // Material untuk kubus
+    GLfloat cube_ambient[] = {0.5f, 0.4f, 0.3f, 1.0f};
+    GLfloat cube_diffuse[] = {0.7f, 0.6f, 0.5f, 1.0f};
+    GLfloat cube_specular[] = {0.2f, 0.2f, 0.1f, 1.0f};
+    GLfloat cube_shininess = 10.0f;
+    glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, cube_ambient);
+    glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, cube_diffuse);
+    glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, cube_specular);
+    glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, cube_shininess);
+    glColor3f(0.7f, 0.6f, 0.5f); // Warna kubus
+    for (const auto& c : cubes) {
+        drawCube(c.x, c.y, c.z, c.sizeX, c.sizeY, c.sizeZ);
+    }
+
+    // Material untuk ramp
+    GLfloat ramp_ambient[] = {0.3f, 0.3f, 0.5f, 1.0f};
+    GLfloat ramp_diffuse[] = {0.5f, 0.5f, 0.7f, 1.0f};
+    GLfloat ramp_specular[] = {0.1f, 0.1f, 0.2f, 1.0f};
+    GLfloat ramp_shininess = 8.0f;
+    glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, ramp_ambient);
+    glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, ramp_diffuse);
+    glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, ramp_specular);
+    glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, ramp_shininess);
+    glColor3f(0.5f, 0.5f, 0.7f); // Warna ramp
+    for (const auto& r : ramps) {
+        drawRamp(r.x, r.y, r.z, r.sizeX, r.sizeY, r.sizeZ, r.axis);
+    }
+
+    for (const auto& b : bushes) {
+        drawBush(b.x, b.y, b.z, b.radius);
+    }
+    for (const auto& t : trees) {
+        drawTree(t.x, t.y, t.z, t.trunkHeight, t.trunkRadius, t.foliageRadius);
+    }
+    
+    for (const auto& rock : rocks) {
+        drawRock(rock.x, rock.y, rock.z, rock.scale);
+    }
+
+    drawCoins();
+}
+
+
+void drawTree(float x, float y, float z, float trunkHeight, float trunkRadius, float foliageRadius) {
+    GLfloat trunk_ambient[] = {0.2f, 0.1f, 0.05f, 1.0f};
+    GLfloat trunk_diffuse[] = {0.5f, 0.3f, 0.1f, 1.0f};
+    GLfloat trunk_specular[] = {0.1f, 0.05f, 0.02f, 1.0f};
+    GLfloat trunk_shininess = 8.0f;
+    
+    glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, trunk_ambient);
+    glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, trunk_diffuse);
+    glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, trunk_specular);
+    glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, trunk_shininess);
+
+    glColor3f(0.5f, 0.3f, 0.1f);
+    glPushMatrix();
+    glTranslatef(x, y, z);
+    glRotatef(-90, 1, 0, 0);
+    drawPrimitiveCylinder(trunkRadius, trunkRadius * 0.8f, trunkHeight * 0.7f, 12);
+    glPopMatrix();
+
+    glPushMatrix();
+    glTranslatef(x, y + trunkHeight * 0.7f, z);
+    glRotatef(-90, 1, 0, 0);
+    drawPrimitiveCylinder(trunkRadius * 0.8f, trunkRadius * 0.6f, trunkHeight * 0.3f, 12);
+    glPopMatrix();
+
+    float branchHeight = y + trunkHeight * 0.75f;
+    float branchLength = trunkRadius * 2.5f;
+    float branchRadius = trunkRadius * 0.3f;
+    
+    float branchAngles[] = {30.0f, 120.0f, 210.0f, 300.0f};
+    float branchTilts[] = {15.0f, -10.0f, 20.0f, -15.0f};
+    
+    glColor3f(0.4f, 0.25f, 0.1f); 
+    
+    for (int i = 0; i < 4; i++) {
+        glPushMatrix();
+        glTranslatef(x, branchHeight + (i * trunkHeight * 0.05f), z);
+        glRotatef(branchAngles[i], 0, 1, 0);
+        glRotatef(branchTilts[i], 0, 0, 1); 
+        glRotatef(-90, 1, 0, 0);
+        
+        drawPrimitiveCylinder(branchRadius, branchRadius * 0.5f, branchLength, 8);
+        glPopMatrix();
+    }
+
+    GLfloat foliage_ambient[] = {0.05f, 0.2f, 0.05f, 1.0f};
+    GLfloat foliage_diffuse[] = {0.1f, 0.6f, 0.1f, 1.0f};
+    GLfloat foliage_specular[] = {0.02f, 0.1f, 0.02f, 1.0f};
+    GLfloat foliage_shininess = 3.0f;
+    
+    glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, foliage_ambient);
+    glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, foliage_diffuse);
+    glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, foliage_specular);
+    glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, foliage_shininess);
+
+    struct FoliageLayer {
+        float heightOffset, radiusScale, colorVariation;
+    };
+    
+    FoliageLayer layers[] = {
+        {trunkHeight * 0.6f, 1.2f, 0.8f},
+        {trunkHeight * 0.8f, 1.0f, 0.9f},
+        {trunkHeight *  1.0f, 0.7f, 1.0f},
+        {trunkHeight * 1.15f, 0.4f, 1.1f}
+    };
+    
+    for (int i = 0; i < 4; i++) {
+        glPushMatrix();
+        glTranslatef(x, y + layers[i].heightOffset, z);
+        
+        float greenVar = layers[i].colorVariation;
+        glColor3f(0.1f * greenVar, 0.6f * greenVar, 0.1f * greenVar);
+        
+        drawPrimitiveSphere(foliageRadius * layers[i].radiusScale, 14);
+        glPopMatrix();
+    }
+
+    glColor3f(0.15f, 0.5f, 0.15f); 
+    for (int i = 0; i < 4; i++) {
+        float branchEndX = x + cos(branchAngles[i] * M_PI /  180.0f) * branchLength * 0.7f;
+        float branchEndZ = z + sin(branchAngles[i] * M_PI / 180.0f) * branchLength * 0.7f;
+        float branchEndY = branchHeight + (i * trunkHeight * 0.05f) + branchLength * sin(branchTilts[i] * M_PI / 180.0f) * 0.5f;
+        
+        glPushMatrix();
+        glTranslatef(branchEndX, branchEndY, branchEndZ);
+        drawPrimitiveSphere(foliageRadius * 0.3f, 10);
+        glPopMatrix();
+    }
+}
+
+
+void drawBush(float centerX, float centerY, float centerZ, float radius) {
+    GLfloat bush_ambient[] = {0.1f, 0.3f, 0.1f, 1.0f};  
+    GLfloat bush_diffuse[] = {0.2f, 0.6f, 0.2f, 1.0f};  
+    GLfloat bush_specular[] = {0.05f, 0.1f, 0.05f, 1.0f};
+    GLfloat bush_shininess = 5.0f;                   
+    
+    glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, bush_ambient);
+    glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, bush_diffuse);
+    glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, bush_specular);
+    glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, bush_shininess);
+    glColor3f(0.2f, 0.6f, 0.2f); 
+    
+    struct SphereOffset {
+        float x, y, z, scale;
+    };    
+    SphereOffset spheres[] = {
+        {0.0f, 0.0f, 0.0f, 1.3f},
+        
+        {1.0f, -0.2f, -0.7f, 0.7f},
+        {-0.9f, -0.25f, 0.8f, 0.65f},
+        {0.5f, -0.25f, 1.1f, 0.6f},
+        
+        {0.9f, -0.3f, 0.3f, 0.5f},
+        {-1.0f, -0.4f, -0.2f, 0.55f},
+        {0.3f, -0.5f, -1.0f, 0.45f}
+    };
+    
+    int numSpheres = sizeof(spheres) / sizeof(SphereOffset);
+    
+    for (int i = 0; i < numSpheres; i++) {
+        glPushMatrix();
+            glTranslatef(centerX + spheres[i].x * radius, 
+                        centerY + spheres[i].y * radius, 
+                        centerZ + spheres[i].z * radius);
+            
+            float colorVariation = 0.8f + (i % 3) * 0.1f; // Slight variation
+            glColor3f(0.2f * colorVariation, 0.6f * colorVariation, 0.2f * colorVariation);
+            drawPrimitiveSphere(radius * spheres[i].scale, 12);
+        glPopMatrix();
+    }
+}
+
+
+void drawRock(float centerX, float centerY, float centerZ, float scale) {
+    GLfloat rock_ambient[] = {0.3f, 0.3f, 0.3f, 1.0f};  
+    GLfloat rock_diffuse[] = {0.6f, 0.6f, 0.6f, 1.0f};  
+    GLfloat rock_specular[] = {0.1f, 0.1f, 0.1f, 1.0f};  
+    GLfloat rock_shininess = 2.0f;                        
+    
+    glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, rock_ambient);
+    glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, rock_diffuse);
+    glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, rock_specular);
+    glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, rock_shininess);
+
+    glPushMatrix();
+    glTranslatef(centerX, centerY, centerZ);
+    glScalef(scale, scale, scale);
+    
+    float vertices[][3] = {
+        {-1.2f, 0.0f, -0.8f},    // 0
+        {0.0f, 0.0f, -1.3f},     // 1  
+        {1.1f, 0.0f, -0.6f},     // 2
+        {1.3f, 0.0f, 0.7f},      // 3
+        {0.2f, 0.0f, 1.4f},      // 4
+        {-0.9f, 0.0f, 1.0f},     // 5
+        {-1.5f, 0.0f, 0.2f},     // 6
+        
+        {-0.8f, 0.6f, -0.9f},    // 7
+        {0.3f, 0.7f, -1.1f},     // 8
+        {1.0f, 0.5f, -0.3f},     // 9
+        {1.1f, 0.8f, 0.8f},      // 10
+        {-0.1f, 0.6f, 1.2f},     // 11
+        {-1.0f, 0.7f, 0.5f},     // 12
+        {-1.2f, 0.5f, -0.1f},    // 13
+
+        {-0.3f, 1.1f, -0.5f},    // 14
+        {0.4f, 1.2f, -0.2f},     // 15
+        {0.6f, 1.0f, 0.4f},      // 16
+        {-0.2f, 1.3f, 0.6f},     // 17
+        {-0.6f, 1.1f, 0.1f},     // 18
+        
+        {0.0f, 1.6f, 0.1f},      // 19
+        {-0.1f, 1.7f, -0.1f},    // 20
+    };
+    
+    int faces[][3] = {
+        {0, 1, 7}, {1, 8, 7}, {1, 2, 8}, {2, 9, 8},
+        {2, 3, 9}, {3, 10, 9}, {3, 4, 10}, {4, 11, 10},
+        {4, 5, 11}, {5, 12, 11}, {5, 6, 12}, {6, 13, 12},
+        {6, 0, 13}, {0, 7, 13},
+        
+        {7, 8, 14}, {8, 15, 14}, {8, 9, 15}, {9, 16, 15},
+        {9, 10, 16}, {10, 17, 16}, {10, 11, 17}, {11, 18, 17},
+        {11, 12, 18}, {12, 19, 18}, {12, 13, 19}, {13, 14, 19},
+        {13, 7, 14},
+        
+        {14, 15, 20}, {15, 16, 20}, {16, 17, 20}, {17, 18, 20},
+        {18, 19, 20}, {19, 14, 20},
+        
+        {7, 12, 18}, {7, 18, 14}, {8, 9, 16}, {8, 16, 15},
+        {10, 11, 17}, {12, 13, 19}, {14, 18, 19},
+        
+        {1, 0, 6}, {1, 6, 4}, {2, 1, 4}, {2, 4, 3},
+        {15, 16, 19}, {15, 19, 18}, {15, 18, 14},
+    };
+    
+    int numFaces = sizeof(faces) / sizeof(faces[0]);
+    
+    glBegin(GL_TRIANGLES);
+    
+    for (int i = 0; i < numFaces; i++) {
+        float* v1 = vertices[faces[i][0]];
+        float* v2 = vertices[faces[i][1]];
+        float* v3 = vertices[faces[i][2]];
+        
+        float edge1[3] = {v2[0] - v1[0], v2[1] - v1[1], v2[2] - v1[2]};
+        float edge2[3] = {v3[0] - v1[0], v3[1] - v1[1], v3[2] - v1[2]};
+        
+        float normal[3] = {
+            edge1[1] * edge2[2] - edge1[2] * edge2[1],
+            edge1[2] * edge2[0] - edge1[0] * edge2[2],
+            edge1[0] * edge2[1] - edge1[1] * edge2[0]
+        };
+        
+        float length = sqrt(normal[0]*normal[0] + normal[1]*normal[1] + normal[2]*normal[2]);
+        if (length > 0.001f) {
+            normal[0] /= length;
+            normal[1] /= length;
+            normal[2] /= length;
+        }
+        
+        float colorVar = 0.8f + (i % 5) * 0.05f;
+        glColor3f(0.5f * colorVar, 0.5f * colorVar, 0.5f * colorVar);
+        
+        glNormal3f(normal[0], normal[1], normal[2]);
+        glVertex3f(v1[0], v1[1], v1[2]);
+        glVertex3f(v2[0], v2[1], v2[2]);
+        glVertex3f(v3[0], v3[1], v3[2]);
+    }
+    
+    glEnd();
+    
+    glColor3f(0.4f, 0.4f, 0.4f); 
+    
+    struct BumpDetail {
+        float x, y, z, size;
+    };
+    
+    BumpDetail bumps[] = {
+        {-0.3f, 0.8f, -0.2f, 0.1f},
+        {0.4f, 0.6f, 0.3f, 0.08f},
+        {-0.6f, 0.4f, 0.5f, 0.12f},
+        {0.7f, 0.9f, -0.1f, 0.07f},
+        {-0.1f, 1.1f, 0.4f, 0.09f},
+        {0.2f, 0.3f, -0.7f, 0.11f}
+    };
+    
+    for (int i = 0; i < 6; i++) {
+        glPushMatrix();
+        glTranslatef(bumps[i].x, bumps[i].y, bumps[i].z);
+        
+        glBegin(GL_TRIANGLES);
+        float size = bumps[i].size;
+        
+        glNormal3f(0.0f, 1.0f, 0.0f);
+        glVertex3f(-size, 0.0f, -size);
+        glVertex3f(size, 0.0f, -size);
+        glVertex3f(0.0f, size * 0.8f, 0.0f);
+        
+        glVertex3f(size, 0.0f, -size);
+        glVertex3f(size, 0.0f, size);
+        glVertex3f(0.0f, size * 0.8f, 0.0f);
+        
+        glVertex3f(size, 0.0f, size);
+        glVertex3f(-size, 0.0f, size);
+        glVertex3f(0.0f, size * 0.8f, 0.0f);
+        
+        glVertex3f(-size, 0.0f, size);
+        glVertex3f(-size, 0.0f, -size);
+        glVertex3f(0.0f, size * 0.8f, 0.0f);
+        
+        glEnd();
+        glPopMatrix();
+    }
+    
+    glPopMatrix();
+}
\ No newline at end of file
@@ -0,0 +1,138 @@
+#include "arenalod.h"
+#include "arena.h"
+#include <algorithm>
+#include <cmath>
+
+// Batas diameter bounding sphere di layar (pixel) antar level: di atas 200 px
+// level 0, di atas 80 px level 1, sisanya level 2. Viewport 600 px tinggi,
+// pohon biasa turun ke level 1 sekitar 40 unit dari kamera.
+static const float lodSwitchPixels[ARENA_LOD_LEVELS - 1] = {200.0f, 80.0f};
+static const float lodHysteresis = 0.15f; // Harus lewat batas +-15% sebelum pindah
+static const float lodFadeSeconds = 0.25f;
+
+struct ArenaLodObject {
+    float cx, cy, cz, radius;
+    int level, fromLevel;
+    float fade;      // 0..1, >= 1 berarti tidak sedang crossfade
+    int lastSeen;    // Frame terakhir objek lolos culling
+};
+
+struct ArenaLodKindData {
+    std::vector<ArenaLodObject> objects; // Per posisi di arenaCullOrder
+    std::vector<int> passes[ARENA_LOD_PASSES];
+};
+
+static ArenaLodKindData lodKinds[CULL_KIND_COUNT];
+static const std::vector<int> noLodObjects;
+static bool lodEnabled = true;
+static int lodFrame = 0;
+static int lodLevelCounts[ARENA_LOD_LEVELS] = {0, 0, 0};
+static float lodEyeX = 0.0f, lodEyeY = 0.0f, lodEyeZ = 0.0f;
+static float lodPixelScale = 0.0f; // Pixel per unit pada jarak 1
+
+int arenaLodLevels(ArenaCullKind kind) {
+    switch (kind) {
+        case CULL_TREE:
+        case CULL_BUSH: return 3;
+        case CULL_ROCK: return 2; // Level 1 tanpa tonjolan, lebih kasar tidak ada gunanya
+        default: return 1;
+    }
+}
+
+void buildArenaLod() {
+    rebuildArenaLod((1u << CULL_KIND_COUNT) - 1);
+}
+
+void rebuildArenaLod(unsigned changed) {
+    for (int kind = 0; kind < CULL_KIND_COUNT; ++kind) {
+        if (!(changed & (1u << kind))) continue;
+        ArenaLodKindData& data = lodKinds[kind];
+        data.objects.clear();
+        for (auto& pass : data.passes) pass.clear();
+        if (arenaLodLevels((ArenaCullKind)kind) < 2) continue;
+        const std::vector<int>& order = arenaCullOrder((ArenaCullKind)kind);
+        const std::vector<ArenaBounds>& bounds = arenaCullBounds((ArenaCullKind)kind);
+        for (int i : order) {
+            const ArenaBounds& b = bounds[i];
+            float hx = 0.5f * (b.maxX - b.minX), hy = 0.5f * (b.maxY - b.minY), hz = 0.5f * (b.maxZ - b.minZ);
+            ArenaLodObject obj = {b.minX + hx, b.minY + hy, b.minZ + hz, sqrtf(hx * hx + hy * hy + hz * hz),
+                                  0, 0, 1.0f, -2};
+            data.objects.push_back(obj);
+        }
+        // Sebelum update pertama semuanya level 0 solid; reserve supaya update
+        // per frame tidak alokasi
+        for (auto& pass : data.passes) pass.reserve(order.size());
+        for (int k = 0; k < (int)order.size(); ++k) data.passes[0].push_back(k);
+    }
+}
+
+void setArenaLodEnabled(bool enabled) {
+    lodEnabled = enabled;
+}
+
+bool isArenaLodEnabled() {
+    return lodEnabled;
+}
+
+float arenaProjectedSize(float x, float y, float z, float radius) {
+    float dx = x - lodEyeX, dy = y - lodEyeY, dz = z - lodEyeZ;
+    float dist = std::max(sqrtf(dx * dx + dy * dy + dz * dz), radius);
+    if (dist <= 0.0f) return 0.0f;
+    return 2.0f * radius * lodPixelScale / dist;
+}
+
+static int selectLevel(int current, float size, int levels) {
+    int level = std::min(current, levels - 1);
+    while (level > 0 && size > lodSwitchPixels[level - 1] * (1.0f + lodHysteresis)) --level;
+    while (level < levels - 1 && size < lodSwitchPixels[level] * (1.0f - lodHysteresis)) ++level;
+    return level;
+}
+
+void updateArenaLod(const float* projection, const float* modelview, int viewportHeight, float frameSeconds) {
+    // Posisi kamera = -R^T * t dari modelview column-major
+    lodEyeX = -(modelview[0] * modelview[12] + modelview[1] * modelview[13] + modelview[2] * modelview[14]);
+    lodEyeY = -(modelview[4] * modelview[12] + modelview[5] * modelview[13] + modelview[6] * modelview[14]);
+    lodEyeZ = -(modelview[8] * modelview[12] + modelview[9] * modelview[13] + modelview[10] * modelview[14]);
+    lodPixelScale = projection[5] * 0.5f * (float)viewportHeight;
+    ++lodFrame;
+    for (int& count : lodLevelCounts) count = 0;
+
+    for (int kind = 0; kind < CULL_KIND_COUNT; ++kind) {
+        ArenaLodKindData& data = lodKinds[kind];
+        if (data.objects.empty()) continue;
+        int levels = arenaLodLevels((ArenaCullKind)kind);
+        for (auto& pass : data.passes) pass.clear();
+        for (int k : arenaVisibleObjects((ArenaCullKind)kind)) {
+            ArenaLodObject& obj = data.objects[k];
+            // Objek yang baru masuk layar langsung di level yang benar, tanpa crossfade
+            bool seenLastFrame = obj.lastSeen == lodFrame - 1;
+            obj.lastSeen = lodFrame;
+            int target = lodEnabled ? selectLevel(obj.level, arenaProjectedSize(obj.cx, obj.cy, obj.cz, obj.radius), levels) : 0;
+            if (target != obj.level) {
+                obj.fromLevel = obj.level;
+                obj.level = target;
+                obj.fade = seenLastFrame && lodEnabled ? 0.0f : 1.0f;
+            } else if (obj.fade < 1.0f) {
+                obj.fade += frameSeconds / lodFadeSeconds;
+            }
+            lodLevelCounts[obj.level]++;
+            if (obj.fade >= 1.0f) {
+                data.passes[obj.level * ARENA_LOD_PATTERNS].push_back(k);
+                continue;
+            }
+            // Level baru menutup 1/4, 2/4, 3/4 pixel; level lama sisanya
+            int step = 1 + std::min(2, (int)(obj.fade * 3.0f));
+            data.passes[obj.level * ARENA_LOD_PATTERNS + step].push_back(k);
+            data.passes[obj.fromLevel * ARENA_LOD_PATTERNS + 3 + step].push_back(k);
+        }
+    }
+}
+
+const std::vector<int>& arenaLodPassObjects(ArenaCullKind kind, int pass) {
+    if (lodKinds[kind].objects.empty()) return noLodObjects;
+    return lodKinds[kind].passes[pass];
+}
+
+int arenaLodObjectsAtLevel(int level) {
+    return lodLevelCounts[level];
+}
@@ -0,0 +1,33 @@
+#ifndef ARENALOD_H
+#define ARENALOD_H
+
+#include "arenacull.h"
+#include <vector>
+
+// Level-of-detail prop (bush, tree, rock) dari ukuran proyeksi di layar. Pindah
+// level pakai hysteresis supaya tidak bolak-balik di batas, lalu crossfade singkat:
+// level lama dan baru digambar bersamaan dengan pola stipple yang saling
+// melengkapi. Tanpa GL, renderer yang memasang pola stipple per pass.
+const int ARENA_LOD_LEVELS = 3;        // Level 0 paling detail
+const int ARENA_LOD_PATTERNS = 7;      // 0 solid, 1..3 level baru (1/4..3/4 pixel), 4..6 komplemennya
+const int ARENA_LOD_PASSES = ARENA_LOD_LEVELS * ARENA_LOD_PATTERNS;
+
+inline int arenaLodPassLevel(int pass) { return pass / ARENA_LOD_PATTERNS; }
+inline int arenaLodPassPattern(int pass) { return pass % ARENA_LOD_PATTERNS; }
+
+void buildArenaLod(); // Setelah buildArenaCullGrid, semua objek mulai di level 0
+void rebuildArenaLod(unsigned changed); // Hanya jenis di mask, level/crossfade jenis lain tetap
+void setArenaLodEnabled(bool enabled);
+bool isArenaLodEnabled();
+// Setelah cullArena dengan matriks yang sama. viewportHeight dalam pixel,
+// frameSeconds untuk lama crossfade.
+void updateArenaLod(const float* projection, const float* modelview, int viewportHeight, float frameSeconds);
+int arenaLodLevels(ArenaCullKind kind); // 1 untuk cube/ramp (tanpa LOD)
+// Posisi di arenaCullOrder yang digambar di pass ini, urut naik. Objek yang sedang
+// crossfade muncul di dua pass (level lama dan baru).
+const std::vector<int>& arenaLodPassObjects(ArenaCullKind kind, int pass);
+// Diameter bola di layar (pixel) menurut kamera frame terakhir
+float arenaProjectedSize(float x, float y, float z, float radius);
+int arenaLodObjectsAtLevel(int level); // Statistik frame terakhir, objek crossfade dihitung di level barunya
+
+#endif // ARENALOD_H
@@ -0,0 +1,854 @@
+#include "arenamesh.h"
+#include "arena.h"
+#include "globals.h"
+#include "graphics.h"
+#include "glbuffer.h"
+#include "propinstances.h"
+#include "arenacull.h"
+#include "arenalod.h"
+#include "level.h"
+#include <GL/glut.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+const ArenaMaterial arenaMaterials[MESH_BATCH_COUNT] = {
+    {{0.1f, 0.4f, 0.1f, 1.0f}, {0.2f, 0.8f, 0.2f, 1.0f}, {0.1f, 0.2f, 0.1f, 1.0f}, 8.0f},        // ground
+    {{0.5f, 0.4f, 0.3f, 1.0f}, {0.7f, 0.6f, 0.5f, 1.0f}, {0.2f, 0.2f, 0.1f, 1.0f}, 10.0f},       // cube
+    {{0.3f, 0.3f, 0.5f, 1.0f}, {0.5f, 0.5f, 0.7f, 1.0f}, {0.1f, 0.1f, 0.2f, 1.0f}, 8.0f},        // ramp
+    {{0.2f, 0.1f, 0.05f, 1.0f}, {0.5f, 0.3f, 0.1f, 1.0f}, {0.1f, 0.05f, 0.02f, 1.0f}, 8.0f},     // trunk
+    {{0.05f, 0.2f, 0.05f, 1.0f}, {0.1f, 0.6f, 0.1f, 1.0f}, {0.02f, 0.1f, 0.02f, 1.0f}, 3.0f},    // foliage
+    {{0.1f, 0.3f, 0.1f, 1.0f}, {0.2f, 0.6f, 0.2f, 1.0f}, {0.05f, 0.1f, 0.05f, 1.0f}, 5.0f},      // bush
+    {{0.3f, 0.3f, 0.3f, 1.0f}, {0.6f, 0.6f, 0.6f, 1.0f}, {0.1f, 0.1f, 0.1f, 1.0f}, 2.0f},        // rock
+};
+
+// Batch objek satu chunk jendela streaming (blok cull yang sama, lihat
+// arenaCullBlockRange), atau seluruh arena kalau level tidak di-stream. Chunk yang
+// tetap resident waktu jendela pindah membawa set-nya tanpa bake ulang.
+struct ArenaMeshSet {
+    LevelChunkKey key = {0, 0, 0};   // serial 0 = bukan chunk streaming, tidak pernah dipakai ulang
+    int block = -1;                  // -1 = semua objek
+    int counts[CULL_KIND_COUNT] = {}; // Jumlah objek per jenis waktu di-bake
+    ArenaMeshBatch batches[MESH_BATCH_COUNT]; // MESH_GROUND kosong, ground satu untuk semua set
+    // Bayangan planar cube dan ramp: satu buffer, dua range karena warnanya beda
+    ArenaMeshBatch shadow;
+    int shadowRampFirst = 0;
+};
+
+static ArenaMeshBatch arenaGroundBatch;
+static std::vector<ArenaMeshSet> arenaMeshSets;
+static bool arenaMeshBaked = false;
+static int arenaMeshLastDrawCalls = 0;
+
+// Transform affine 3x4 (baris), dipakai seperti glTranslatef/glRotatef/glScalef:
+// setiap operasi dikalikan di kanan
+struct ArenaXform {
+    float m[3][4];
+};
+
+static ArenaXform xformIdentity() {
+    ArenaXform t = {{{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}}};
+    return t;
+}
+
+static ArenaXform xformMul(const ArenaXform& a, const ArenaXform& b) {
+    ArenaXform t;
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            t.m[i][j] = a.m[i][0] * b.m[0][j] + a.m[i][1] * b.m[1][j] + a.m[i][2] * b.m[2][j] + (j == 3 ? a.m[i][3] : 0.0f);
+        }
+    }
+    return t;
+}
+
+static ArenaXform xformTranslate(const ArenaXform& a, float x, float y, float z) {
+    ArenaXform t = xformIdentity();
+    t.m[0][3] = x; t.m[1][3] = y; t.m[2][3] = z;
+    return xformMul(a, t);
+}
+
+static ArenaXform xformScale(const ArenaXform& a, float s) {
+    ArenaXform t = xformIdentity();
+    t.m[0][0] = s; t.m[1][1] = s; t.m[2][2] = s;
+    return xformMul(a, t);
+}
+
+static ArenaXform xformRotate(const ArenaXform& a, float degrees, float x, float y, float z) {
+    float len = sqrtf(x * x + y * y + z * z);
+    x /= len; y /= len; z /= len;
+    float rad = degrees * (float)M_PI / 180.0f;
+    float c = cosf(rad), s = sinf(rad), k = 1.0f - c;
+    ArenaXform t = {{
+        {x * x * k + c,     x * y * k - z * s, x * z * k + y * s, 0},
+        {y * x * k + z * s, y * y * k + c,     y * z * k - x * s, 0},
+        {z * x * k - y * s, z * y * k + x * s, z * z * k + c,     0},
+    }};
+    return xformMul(a, t);
+}
+
+static GLuint addVertex(ArenaMeshBatch& batch, const ArenaXform& t,
+                        float px, float py, float pz, float nx, float ny, float nz,
+                        float r, float g, float b) {
+    ArenaVertex v;
+    v.px = t.m[0][0] * px + t.m[0][1] * py + t.m[0][2] * pz + t.m[0][3];
+    v.py = t.m[1][0] * px + t.m[1][1] * py + t.m[1][2] * pz + t.m[1][3];
+    v.pz = t.m[2][0] * px + t.m[2][1] * py + t.m[2][2] * pz + t.m[2][3];
+    // Transform di sini hanya rotasi + skala seragam, cukup dinormalisasi ulang
+    float wx = t.m[0][0] * nx + t.m[0][1] * ny + t.m[0][2] * nz;
+    float wy = t.m[1][0] * nx + t.m[1][1] * ny + t.m[1][2] * nz;
+    float wz = t.m[2][0] * nx + t.m[2][1] * ny + t.m[2][2] * nz;
+    float len = sqrtf(wx * wx + wy * wy + wz * wz);
+    if (len > 1e-6f) { wx /= len; wy /= len; wz /= len; }
+    v.nx = wx; v.ny = wy; v.nz = wz;
+    v.r = r; v.g = g; v.b = b;
+    batch.vertices.push_back(v);
+    return (GLuint)(batch.vertices.size() - 1);
+}
+
+static void addTriangle(ArenaMeshBatch& batch, const ArenaXform& t, const float* a, const float* b, const float* c,
+                        float nx, float ny, float nz, float r, float g, float bl) {
+    batch.indices.push_back(addVertex(batch, t, a[0], a[1], a[2], nx, ny, nz, r, g, bl));
+    batch.indices.push_back(addVertex(batch, t, b[0], b[1], b[2], nx, ny, nz, r, g, bl));
+    batch.indices.push_back(addVertex(batch, t, c[0], c[1], c[2], nx, ny, nz, r, g, bl));
+}
+
+static void addQuad(ArenaMeshBatch& batch, const ArenaXform& t, const float* a, const float* b, const float* c, const float* d,
+                    float nx, float ny, float nz, float r, float g, float bl) {
+    GLuint i0 = addVertex(batch, t, a[0], a[1], a[2], nx, ny, nz, r, g, bl);
+    GLuint i1 = addVertex(batch, t, b[0], b[1], b[2], nx, ny, nz, r, g, bl);
+    GLuint i2 = addVertex(batch, t, c[0], c[1], c[2], nx, ny, nz, r, g, bl);
+    GLuint i3 = addVertex(batch, t, d[0], d[1], d[2], nx, ny, nz, r, g, bl);
+    GLuint quad[6] = {i0, i1, i2, i0, i2, i3};
+    batch.indices.insert(batch.indices.end(), quad, quad + 6);
+}
+
+// Pengganti glutSolidSphere (normal halus)
+static void addSphere(ArenaMeshBatch& batch, const ArenaXform& t, float radius, int slices, int stacks,
+                      float r, float g, float b) {
+    GLuint base = (GLuint)batch.vertices.size();
+    for (int i = 0; i <= stacks; ++i) {
+        float phi = (float)M_PI * i / stacks;
+        float ringY = cosf(phi), ringR = sinf(phi);
+        for (int j = 0; j <= slices; ++j) {
+            float theta = 2.0f * (float)M_PI * j / slices;
+            float nx = ringR * cosf(theta), nz = ringR * sinf(theta);
+            addVertex(batch, t, radius * nx, radius * ringY, radius * nz, nx, ringY, nz, r, g, b);
+        }
+    }
+    for (int i = 0; i < stacks; ++i) {
+        for (int j = 0; j < slices; ++j) {
+            GLuint a = base + i * (slices + 1) + j;
+            GLuint c = a + slices + 1;
+            GLuint tri[6] = {a, a + 1, c, a + 1, c + 1, c};
+            batch.indices.insert(batch.indices.end(), tri, tri + 6);
+        }
+    }
+}
+
+// Pengganti gluCylinder: sepanjang +Z lokal, tanpa tutup
+static void addCylinder(ArenaMeshBatch& batch, const ArenaXform& t, float baseRadius, float topRadius, float height,
+                        int slices, int stacks, float r, float g, float b) {
+    GLuint base = (GLuint)batch.vertices.size();
+    float nzSlope = (baseRadius - topRadius) / height;
+    for (int i = 0; i <= stacks; ++i) {
+        float z = height * i / stacks;
+        float rad = baseRadius + (topRadius - baseRadius) * i / stacks;
+        for (int j = 0; j <= slices; ++j) {
+            float a = 2.0f * (float)M_PI * j / slices;
+            float sx = sinf(a), cy = cosf(a);
+            addVertex(batch, t, rad * sx, rad * cy, z, sx, cy, nzSlope, r, g, b);
+        }
+    }
+    for (int i = 0; i < stacks; ++i) {
+        for (int j = 0; j < slices; ++j) {
+            GLuint a = base + i * (slices + 1) + j;
+            GLuint c = a + slices + 1;
+            GLuint tri[6] = {a, c, a + 1, a + 1, c, c + 1};
+            batch.indices.insert(batch.indices.end(), tri, tri + 6);
+        }
+    }
+}
+
+// Sama dengan glutSolidCube(1) yang di-scale ke ukuran cube
+static void addBox(ArenaMeshBatch& batch, float cx, float cy, float cz, float sx, float sy, float sz,
+                   float r, float g, float b) {
+    ArenaXform t = xformIdentity();
+    float x0 = cx - sx / 2.0f, x1 = cx + sx / 2.0f;
+    float y0 = cy - sy / 2.0f, y1 = cy + sy / 2.0f;
+    float z0 = cz - sz / 2.0f, z1 = cz + sz / 2.0f;
+    float v[8][3] = {
+        {x0, y0, z0}, {x1, y0, z0}, {x1, y1, z0}, {x0, y1, z0},
+        {x0, y0, z1}, {x1, y0, z1}, {x1, y1, z1}, {x0, y1, z1},
+    };
+    addQuad(batch, t, v[4], v[5], v[6], v[7], 0, 0, 1, r, g, b);
+    addQuad(batch, t, v[1], v[0], v[3], v[2], 0, 0, -1, r, g, b);
+    addQuad(batch, t, v[5], v[1], v[2], v[6], 1, 0, 0, r, g, b);
+    addQuad(batch, t, v[0], v[4], v[7], v[3], -1, 0, 0, r, g, b);
+    addQuad(batch, t, v[3], v[7], v[6], v[2], 0, 1, 0, r, g, b);
+    addQuad(batch, t, v[0], v[1], v[5], v[4], 0, -1, 0, r, g, b);
+}
+
+static void bakeRamp(ArenaMeshBatch& batch, ArenaMeshBatch& shadow, const ArenaRamp& ramp) {
+    ArenaXform t = xformTranslate(xformIdentity(), ramp.x, ramp.y, ramp.z);
+    float hx = ramp.sizeX / 2.0f, hy = ramp.sizeY / 2.0f, hz = ramp.sizeZ / 2.0f;
+    const float r = 0.7f, g = 0.6f, b = 0.5f;
+    if (ramp.axis == 'z') {
+        float v[6][3] = {
+            {-hx, -hy, -hz}, { hx, -hy, -hz}, {-hx, -hy,  hz},
+            { hx, -hy,  hz}, {-hx,  hy,  hz}, { hx,  hy,  hz}
+        };
+        float ny = ramp.sizeX * ramp.sizeZ, nz = -ramp.sizeX * ramp.sizeY;
+        float len = sqrtf(ny * ny + nz * nz);
+        if (len > 1e-6f) { ny /= len; nz /= len; }
+        addQuad(batch, t, v[0], v[1], v[5], v[4], 0, ny, nz, r, g, b);
+        addQuad(batch, t, v[0], v[2], v[3], v[1], 0, -1, 0, r, g, b);
+        addQuad(batch, t, v[2], v[3], v[5], v[4], 0, 0, 1, r, g, b);
+        addTriangle(batch, t, v[0], v[4], v[2], -1, 0, 0, r, g, b);
+        addTriangle(batch, t, v[1], v[3], v[5], 1, 0, 0, r, g, b);
+        addQuad(shadow, t, v[0], v[1], v[5], v[4], 0, 1, 0, 0, 0, 0);
+        addQuad(shadow, t, v[0], v[2], v[3], v[1], 0, 1, 0, 0, 0, 0);
+    } else if (ramp.axis == 'x') {
+        float v[6][3] = {
+            {-hx, -hy, -hz}, {-hx, -hy,  hz}, { hx, -hy, -hz},
+            { hx, -hy,  hz}, { hx,  hy, -hz}, { hx,  hy,  hz}
+        };
+        float nx = ramp.sizeZ * ramp.sizeY, ny = -ramp.sizeZ * ramp.sizeX;
+        float len = sqrtf(nx * nx + ny * ny);
+        if (len > 1e-6f) { nx /= len; ny /= len; }
+        if (ny < 0) { nx *= -1; ny *= -1; }
+        addQuad(batch, t, v[0], v[1], v[5], v[4], nx, ny, 0, r, g, b);
+        addQuad(batch, t, v[0], v[2], v[3], v[1], 0, -1, 0, r, g, b);
+        addQuad(batch, t, v[2], v[3], v[5], v[4], 1, 0, 0, r, g, b);
+        addTriangle(batch, t, v[0], v[4], v[2], 0, 0, -1, r, g, b);
+        addTriangle(batch, t, v[1], v[3], v[5], 0, 0, 1, r, g, b);
+        addQuad(shadow, t, v[0], v[1], v[5], v[4], 0, 1, 0, 0, 0, 0);
+        addQuad(shadow, t, v[0], v[2], v[3], v[1], 0, 1, 0, 0, 0, 0);
+    }
+}
+
+// Tessellation tree per level LOD; level 2 tanpa cabang dan daun di ujung cabang
+struct TreeLodDetail {
+    int trunkSlices, lowerStacks, upperStacks;
+    int branchSlices, branchStacks;
+    int foliageSlices, foliageStacks;
+    int budSlices, budStacks;
+};
+static const TreeLodDetail treeLodDetail[ARENA_LOD_LEVELS] = {
+    {12, 8, 6, 8, 4, 14, 14, 10, 10},
+    {8, 2, 1, 5, 1, 8, 6, 6, 4},
+    {6, 1, 1, 0, 0, 6, 4, 0, 0},
+};
+
+void bakeTree(ArenaMeshBatch& trunk, ArenaMeshBatch& foliage, const ArenaTree& tree, int lod) {
+    const TreeLodDetail& d = treeLodDetail[lod];
+    float x = tree.x, y = tree.y, z = tree.z;
+    float trunkHeight = tree.trunkHeight, trunkRadius = tree.trunkRadius, foliageRadius = tree.foliageRadius;
+    ArenaXform up = xformRotate(xformTranslate(xformIdentity(), x, y, z), -90, 1, 0, 0);
+    addCylinder(trunk, up, trunkRadius, trunkRadius * 0.8f, trunkHeight * 0.7f, d.trunkSlices, d.lowerStacks, 0.5f, 0.3f, 0.1f);
+    up = xformRotate(xformTranslate(xformIdentity(), x, y + trunkHeight * 0.7f, z), -90, 1, 0, 0);
+    addCylinder(trunk, up, trunkRadius * 0.8f, trunkRadius * 0.6f, trunkHeight * 0.3f, d.trunkSlices, d.upperStacks, 0.5f, 0.3f, 0.1f);
+
+    float branchHeight = y + trunkHeight * 0.75f;
+    float branchLength = trunkRadius * 2.5f;
+    float branchRadius = trunkRadius * 0.3f;
+    const float branchAngles[] = {30.0f, 120.0f, 210.0f, 300.0f};
+    const float branchTilts[] = {15.0f, -10.0f, 20.0f, -15.0f};
+    for (int i = 0; i < 4 && d.branchSlices > 0; i++) {
+        ArenaXform t = xformTranslate(xformIdentity(), x, branchHeight + (i * trunkHeight * 0.05f), z);
+        t = xformRotate(t, branchAngles[i], 0, 1, 0);
+        t = xformRotate(t, branchTilts[i], 0, 0, 1);
+        t = xformRotate(t, -90, 1, 0, 0);
+        addCylinder(trunk, t, branchRadius, branchRadius * 0.5f, branchLength, d.branchSlices, d.branchStacks, 0.4f, 0.25f, 0.1f);
+    }
+
+    const float layerHeight[] = {0.6f, 0.8f, 1.0f, 1.15f};
+    const float layerRadius[] = {1.2f, 1.0f, 0.7f, 0.4f};
+    const float layerColor[] = {0.8f, 0.9f, 1.0f, 1.1f};
+    for (int i = 0; i < 4; i++) {
+        ArenaXform t = xformTranslate(xformIdentity(), x, y + trunkHeight * layerHeight[i], z);
+        float v = layerColor[i];
+        addSphere(foliage, t, foliageRadius * layerRadius[i], d.foliageSlices, d.foliageStacks, 0.1f * v, 0.6f * v, 0.1f * v);
+    }
+    for (int i = 0; i < 4 && d.budSlices > 0; i++) {
+        float branchEndX = x + cos(branchAngles[i] * M_PI / 180.0f) * branchLength * 0.7f;
+        float branchEndZ = z + sin(branchAngles[i] * M_PI / 180.0f) * branchLength * 0.7f;
+        float branchEndY = branchHeight + (i * trunkHeight * 0.05f) + branchLength * sin(branchTilts[i] * M_PI / 180.0f) * 0.5f;
+        ArenaXform t = xformTranslate(xformIdentity(), branchEndX, branchEndY, branchEndZ);
+        addSphere(foliage, t, foliageRadius * 0.3f, d.budSlices, d.budStacks, 0.15f, 0.5f, 0.15f);
+    }
+}
+
+// Bush per level LOD: {jumlah bola (yang terbesar duluan), slices, stacks}
+static const int bushLodDetail[ARENA_LOD_LEVELS][3] = {{7, 12, 12}, {7, 7, 5}, {3, 6, 4}};
+
+void bakeBush(ArenaMeshBatch& batch, const ArenaBush& bush, int lod) {
+    const int* d = bushLodDetail[lod];
+    const float spheres[][4] = {
+        {0.0f, 0.0f, 0.0f, 1.3f},
+        {1.0f, -0.2f, -0.7f, 0.7f},
+        {-0.9f, -0.25f, 0.8f, 0.65f},
+        {0.5f, -0.25f, 1.1f, 0.6f},
+        {0.9f, -0.3f, 0.3f, 0.5f},
+        {-1.0f, -0.4f, -0.2f, 0.55f},
+        {0.3f, -0.5f, -1.0f, 0.45f}
+    };
+    for (int i = 0; i < d[0]; i++) {
+        ArenaXform t = xformTranslate(xformIdentity(), bush.x + spheres[i][0] * bush.radius,
+                                      bush.y + spheres[i][1] * bush.radius, bush.z + spheres[i][2] * bush.radius);
+        float v = 0.8f + (i % 3) * 0.1f;
+        addSphere(batch, t, bush.radius * spheres[i][3], d[1], d[2], 0.2f * v, 0.6f * v, 0.2f * v);
+    }
+}
+
+void bakeRock(ArenaMeshBatch& batch, const ArenaRock& rock, int lod) {
+    ArenaXform t = xformScale(xformTranslate(xformIdentity(), rock.x, rock.y, rock.z), rock.scale);
+    static const float vertices[][3] = {
+        {-1.2f, 0.0f, -0.8f}, {0.0f, 0.0f, -1.3f}, {1.1f, 0.0f, -0.6f}, {1.3f, 0.0f, 0.7f},
+        {0.2f, 0.0f, 1.4f}, {-0.9f, 0.0f, 1.0f}, {-1.5f, 0.0f, 0.2f},
+        {-0.8f, 0.6f, -0.9f}, {0.3f, 0.7f, -1.1f}, {1.0f, 0.5f, -0.3f}, {1.1f, 0.8f, 0.8f},
+        {-0.1f, 0.6f, 1.2f}, {-1.0f, 0.7f, 0.5f}, {-1.2f, 0.5f, -0.1f},
+        {-0.3f, 1.1f, -0.5f}, {0.4f, 1.2f, -0.2f}, {0.6f, 1.0f, 0.4f}, {-0.2f, 1.3f, 0.6f}, {-0.6f, 1.1f, 0.1f},
+        {0.0f, 1.6f, 0.1f}, {-0.1f, 1.7f, -0.1f},
+    };
+    static const int faces[][3] = {
+        {0, 1, 7}, {1, 8, 7}, {1, 2, 8}, {2, 9, 8},
+        {2, 3, 9}, {3, 10, 9}, {3, 4, 10}, {4, 11, 10},
+        {4, 5, 11}, {5, 12, 11}, {5, 6, 12}, {6, 13, 12},
+        {6, 0, 13}, {0, 7, 13},
+        {7, 8, 14}, {8, 15, 14}, {8, 9, 15}, {9, 16, 15},
+        {9, 10, 16}, {10, 17, 16}, {10, 11, 17}, {11, 18, 17},
+        {11, 12, 18}, {12, 19, 18}, {12, 13, 19}, {13, 14, 19},
+        {13, 7, 14},
+        {14, 15, 20}, {15, 16, 20}, {16, 17, 20}, {17, 18, 20},
+        {18, 19, 20}, {19, 14, 20},
+        {7, 12, 18}, {7, 18, 14}, {8, 9, 16}, {8, 16, 15},
+        {10, 11, 17}, {12, 13, 19}, {14, 18, 19},
+        {1, 0, 6}, {1, 6, 4}, {2, 1, 4}, {2, 4, 3},
+        {15, 16, 19}, {15, 19, 18}, {15, 18, 14},
+    };
+    int numFaces = sizeof(faces) / sizeof(faces[0]);
+    for (int i = 0; i < numFaces; i++) {
+        const float* v1 = vertices[faces[i][0]];
+        const float* v2 = vertices[faces[i][1]];
+        const float* v3 = vertices[faces[i][2]];
+        float e1[3] = {v2[0] - v1[0], v2[1] - v1[1], v2[2] - v1[2]};
+        float e2[3] = {v3[0] - v1[0], v3[1] - v1[1], v3[2] - v1[2]};
+        float n[3] = {
+            e1[1] * e2[2] - e1[2] * e2[1],
+            e1[2] * e2[0] - e1[0] * e2[2],
+            e1[0] * e2[1] - e1[1] * e2[0]
+        };
+        float c = 0.5f * (0.8f + (i % 5) * 0.05f);
+        addTriangle(batch, t, v1, v2, v3, n[0], n[1], n[2], c, c, c);
+    }
+    if (lod > 0) return; // Tonjolan kecil tidak kelihatan dari jauh
+
+    const float bumps[][4] = {
+        {-0.3f, 0.8f, -0.2f, 0.1f},
+        {0.4f, 0.6f, 0.3f, 0.08f},
+        {-0.6f, 0.4f, 0.5f, 0.12f},
+        {0.7f, 0.9f, -0.1f, 0.07f},
+        {-0.1f, 1.1f, 0.4f, 0.09f},
+        {0.2f, 0.3f, -0.7f, 0.11f}
+    };
+    for (int i = 0; i < 6; i++) {
+        ArenaXform bt = xformTranslate(t, bumps[i][0], bumps[i][1], bumps[i][2]);
+        float s = bumps[i][3];
+        float corners[4][3] = {{-s, 0.0f, -s}, {s, 0.0f, -s}, {s, 0.0f, s}, {-s, 0.0f, s}};
+        float tip[3] = {0.0f, s * 0.8f, 0.0f};
+        for (int k = 0; k < 4; k++) {
+            addTriangle(batch, bt, corners[k], corners[(k + 1) % 4], tip, 0, 1, 0, 0.4f, 0.4f, 0.4f);
+        }
+    }
+}
+
+static void uploadBatch(ArenaMeshBatch& batch) {
+    if (batch.indices.empty() || !hasGLBuffers()) return;
+    glbGenBuffers(1, &batch.vbo);
+    glbBindBuffer(GL_ARRAY_BUFFER, batch.vbo);
+    glbBufferData(GL_ARRAY_BUFFER, batch.vertices.size() * sizeof(ArenaVertex), batch.vertices.data(), GL_STATIC_DRAW);
+    glbGenBuffers(1, &batch.ibo);
+    glbBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch.ibo);
+    glbBufferData(GL_ELEMENT_ARRAY_BUFFER, batch.indices.size() * sizeof(GLuint), batch.indices.data(), GL_STATIC_DRAW);
+    glbBindBuffer(GL_ARRAY_BUFFER, 0);
+    glbBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    // Data sudah di GPU, salinan CPU tidak perlu lagi (jumlah index tetap disimpan)
+    batch.vertices.clear();
+    batch.vertices.shrink_to_fit();
+}
+
+static void freeBatch(ArenaMeshBatch& batch) {
+    if (batch.vbo) glbDeleteBuffers(1, &batch.vbo);
+    if (batch.ibo) glbDeleteBuffers(1, &batch.ibo);
+    batch.vbo = batch.ibo = 0;
+    batch.vertices.clear();
+    batch.indices.clear();
+    batch.cullKind = -1;
+    batch.lodLevels = 1;
+    batch.objectFirst.clear();
+    batch.runCounts.clear();
+    batch.runOffsets.clear();
+}
+
+static void beginCulledBatch(ArenaMeshBatch& batch, ArenaCullKind kind) {
+    batch.cullKind = kind;
+    batch.lodLevels = arenaLodLevels(kind);
+    batch.objectFirst.assign(1, 0);
+}
+
+// Level LOD berikutnya dimulai tepat setelah objek terakhir level sebelumnya
+static void beginLodLevel(ArenaMeshBatch& batch) {
+    batch.objectFirst.push_back((GLuint)batch.indices.size());
+}
+
+static void endCulledObject(ArenaMeshBatch& batch) {
+    batch.objectFirst.push_back((GLuint)batch.indices.size());
+}
+
+// Bayer 4x4: pola 1..3 menutup pixel dengan nilai < 4 * langkah, pola 4..6 sisanya,
+// jadi pasangan pola k dan k + 3 menutup layar tepat sekali
+static const int lodBayer[4][4] = {{0, 8, 2, 10}, {12, 4, 14, 6}, {3, 11, 1, 9}, {15, 7, 13, 5}};
+static GLubyte lodFadeStipples[ARENA_LOD_PATTERNS][128];
+static bool lodFadeStipplesReady = false;
+
+static void buildLodFadeStipples() {
+    for (int p = 1; p < ARENA_LOD_PATTERNS; ++p) {
+        int step = p <= 3 ? p : p - 3;
+        bool inverse = p > 3;
+        for (int y = 0; y < 32; ++y) {
+            for (int x = 0; x < 32; ++x) {
+                bool on = (lodBayer[y % 4][x % 4] < 4 * step) != inverse;
+                if (on) lodFadeStipples[p][y * 4 + x / 8] |= (GLubyte)(0x80 >> (x % 8));
+            }
+        }
+    }
+    lodFadeStipplesReady = true;
+}
+
+void beginLodFadePattern(int pattern) {
+    if (pattern == 0) return;
+    if (!lodFadeStipplesReady) buildLodFadeStipples();
+    glEnable(GL_POLYGON_STIPPLE);
+    glPolygonStipple(lodFadeStipples[pattern]);
+}
+
+void endLodFadePattern(int pattern) {
+    if (pattern != 0) glDisable(GL_POLYGON_STIPPLE);
+}
+
+static void freeMeshSet(ArenaMeshSet& set) {
+    for (auto& batch : set.batches) freeBatch(batch);
+    freeBatch(set.shadow);
+    set.shadowRampFirst = 0;
+}
+
+void releaseArenaMesh() {
+    freeBatch(arenaGroundBatch);
+    for (auto& set : arenaMeshSets) freeMeshSet(set);
+    arenaMeshSets.clear();
+    arenaMeshBaked = false;
+}
+
+// Posisi objek set di arenaCullOrder: [first, last)
+static void meshSetRange(const ArenaMeshSet& set, ArenaCullKind kind, int& first, int& last) {
+    if (set.block < 0) {
+        first = 0;
+        last = (int)arenaCullOrder(kind).size();
+    } else {
+        arenaCullBlockRange(kind, set.block, first, last);
+    }
+}
+
+// Objek di-bake dengan urutan tile culling supaya yang terlihat bersambung
+static void bakeSolidBatches(ArenaMeshSet& set) {
+    int first, last;
+    ArenaMeshBatch& cubeBatch = set.batches[MESH_CUBE];
+    beginCulledBatch(cubeBatch, CULL_CUBE);
+    meshSetRange(set, CULL_CUBE, first, last);
+    for (int k = first; k < last; ++k) {
+        const ArenaCube& c = cubes[arenaCullOrder(CULL_CUBE)[k]];
+        addBox(cubeBatch, c.x, c.y, c.z, c.sizeX, c.sizeY, c.sizeZ, 0.7f, 0.6f, 0.5f);
+        addBox(set.shadow, c.x, c.y, c.z, c.sizeX, c.sizeY, c.sizeZ, 0, 0, 0);
+        endCulledObject(cubeBatch);
+    }
+    set.shadowRampFirst = (int)set.shadow.indices.size();
+    ArenaMeshBatch& rampBatch = set.batches[MESH_RAMP];
+    beginCulledBatch(rampBatch, CULL_RAMP);
+    meshSetRange(set, CULL_RAMP, first, last);
+    for (int k = first; k < last; ++k) {
+        bakeRamp(rampBatch, set.shadow, ramps[arenaCullOrder(CULL_RAMP)[k]]);
+        endCulledObject(rampBatch);
+    }
+}
+
+// Semua level LOD prop di-bake, level demi level
+static void bakeBushBatch(ArenaMeshSet& set) {
+    ArenaMeshBatch& bushBatch = set.batches[MESH_BUSH];
+    int first, last;
+    beginCulledBatch(bushBatch, CULL_BUSH);
+    meshSetRange(set, CULL_BUSH, first, last);
+    for (int lod = 0; lod < bushBatch.lodLevels; ++lod) {
+        if (lod > 0) beginLodLevel(bushBatch);
+        for (int k = first; k < last; ++k) {
+            bakeBush(bushBatch, bushes[arenaCullOrder(CULL_BUSH)[k]], lod);
+            endCulledObject(bushBatch);
+        }
+    }
+}
+
+static void bakeTreeBatches(ArenaMeshSet& set) {
+    ArenaMeshBatch& trunkBatch = set.batches[MESH_TRUNK];
+    ArenaMeshBatch& foliageBatch = set.batches[MESH_FOLIAGE];
+    int first, last;
+    beginCulledBatch(trunkBatch, CULL_TREE);
+    beginCulledBatch(foliageBatch, CULL_TREE);
+    meshSetRange(set, CULL_TREE, first, last);
+    for (int lod = 0; lod < trunkBatch.lodLevels; ++lod) {
+        if (lod > 0) {
+            beginLodLevel(trunkBatch);
+            beginLodLevel(foliageBatch);
+        }
+        for (int k = first; k < last; ++k) {
+            bakeTree(trunkBatch, foliageBatch, trees[arenaCullOrder(CULL_TREE)[k]], lod);
+            endCulledObject(trunkBatch);
+            endCulledObject(foliageBatch);
+        }
+    }
+}
+
+static void bakeRockBatch(ArenaMeshSet& set) {
+    ArenaMeshBatch& rockBatch = set.batches[MESH_ROCK];
+    int first, last;
+    beginCulledBatch(rockBatch, CULL_ROCK);
+    meshSetRange(set, CULL_ROCK, first, last);
+    for (int lod = 0; lod < rockBatch.lodLevels; ++lod) {
+        if (lod > 0) beginLodLevel(rockBatch);
+        for (int k = first; k < last; ++k) {
+            bakeRock(rockBatch, rocks[arenaCullOrder(CULL_ROCK)[k]], lod);
+            endCulledObject(rockBatch);
+        }
+    }
+}
+
+static void finishBatch(ArenaMeshBatch& batch) {
+    uploadBatch(batch);
+    batch.runCounts.reserve(batch.objectFirst.size());
+    batch.runOffsets.reserve(batch.objectFirst.size());
+}
+
+// Ground satu quad seluas jendela arena, ikut pindah kalau origin bergeser
+static void bakeGroundBatch() {
+    float x0 = arenaOriginX - BOUNDS, x1 = arenaOriginX + BOUNDS;
+    float z0 = arenaOriginZ - BOUNDS, z1 = arenaOriginZ + BOUNDS;
+    float g0[3] = {x0, 0.0f, z0}, g1[3] = {x1, 0.0f, z0};
+    float g2[3] = {x1, 0.0f, z1}, g3[3] = {x0, 0.0f, z1};
+    addQuad(arenaGroundBatch, xformIdentity(), g0, g1, g2, g3, 0, 1, 0, 0.2f, 0.8f, 0.2f);
+    finishBatch(arenaGroundBatch);
+}
+
+// Bake ulang batch jenis di mask (bit 1 << ArenaCullKind) di satu set, return jumlah batch
+static int bakeMeshSet(ArenaMeshSet& set, unsigned changedKinds) {
+    for (int kind = 0; kind < CULL_KIND_COUNT; ++kind) {
+        int first, last;
+        meshSetRange(set, (ArenaCullKind)kind, first, last);
+        set.counts[kind] = last - first;
+    }
+    int rebaked = 0;
+    // Cube dan ramp berbagi batch bayangan, jadi selalu di-bake bersama
+    if (changedKinds & ((1u << CULL_CUBE) | (1u << CULL_RAMP))) {
+        freeBatch(set.batches[MESH_CUBE]);
+        freeBatch(set.batches[MESH_RAMP]);
+        freeBatch(set.shadow);
+        bakeSolidBatches(set);
+        finishBatch(set.batches[MESH_CUBE]);
+        finishBatch(set.batches[MESH_RAMP]);
+        uploadBatch(set.shadow);
+        rebaked += 2;
+    }
+    if (propInstancingActive()) return rebaked;
+    if (changedKinds & (1u << CULL_BUSH)) {
+        freeBatch(set.batches[MESH_BUSH]);
+        bakeBushBatch(set);
+        finishBatch(set.batches[MESH_BUSH]);
+        rebaked += 1;
+    }
+    if (changedKinds & (1u << CULL_TREE)) {
+        freeBatch(set.batches[MESH_TRUNK]);
+        freeBatch(set.batches[MESH_FOLIAGE]);
+        bakeTreeBatches(set);
+        finishBatch(set.batches[MESH_TRUNK]);
+        finishBatch(set.batches[MESH_FOLIAGE]);
+        rebaked += 2;
+    }
+    if (changedKinds & (1u << CULL_ROCK)) {
+        freeBatch(set.batches[MESH_ROCK]);
+        bakeRockBatch(set);
+        finishBatch(set.batches[MESH_ROCK]);
+        rebaked += 1;
+    }
+    return rebaked;
+}
+
+// Satu set per chunk jendela streaming (urut blok cull), atau satu set untuk semua
+static void layoutMeshSets(std::vector<ArenaMeshSet>& sets) {
+    const std::vector<LevelChunkKey>& chunks = residentLevelChunks();
+    sets.clear();
+    if ((int)chunks.size() != ARENA_CULL_BLOCKS) {
+        sets.resize(1);
+        return;
+    }
+    sets.resize(ARENA_CULL_BLOCKS);
+    for (int b = 0; b < ARENA_CULL_BLOCKS; ++b) {
+        sets[b].key = chunks[b];
+        sets[b].block = b;
+    }
+}
+
+// Set lama bisa dipakai untuk set baru: chunk yang sama belum dipasang ulang, dan
+// jumlah objek di bloknya sekarang sama dengan waktu di-bake
+static bool meshSetReusable(const ArenaMeshSet& baked, const ArenaMeshSet& set) {
+    if (baked.key.serial == 0 || baked.key.serial != set.key.serial) return false;
+    for (int kind = 0; kind < CULL_KIND_COUNT; ++kind) {
+        int first, last;
+        meshSetRange(set, (ArenaCullKind)kind, first, last);
+        if (baked.counts[kind] != last - first) return false;
+    }
+    return true;
+}
+
+void bakeArenaMesh() {
+    releaseArenaMesh();
+
+    bakeGroundBatch();
+    layoutMeshSets(arenaMeshSets);
+    size_t triangles = arenaGroundBatch.indices.size() / 3;
+    for (auto& set : arenaMeshSets) {
+        bakeMeshSet(set, (1u << CULL_KIND_COUNT) - 1);
+        for (const auto& batch : set.batches) triangles += batch.indices.size() / 3;
+    }
+    arenaMeshBaked = true;
+    std::cout << "Arena mesh baked: " << MESH_BATCH_COUNT << " batches x " << arenaMeshSets.size() << " chunk sets, "
+              << triangles << " triangles (" << (hasGLBuffers() ? "VBO" : "vertex array") << ")" << std::endl;
+}
+
+int rebakeArenaMesh(unsigned changedKinds) {
+    if (!arenaMeshBaked) {
+        bakeArenaMesh();
+        return (int)arenaMeshSets.size() * (MESH_BATCH_COUNT - 1) + 1;
+    }
+    int rebaked = 0;
+    if (changedKinds & ARENA_CHANGED_ORIGIN) {
+        freeBatch(arenaGroundBatch);
+        bakeGroundBatch();
+        rebaked += 1;
+        // Jendela pindah: set chunk yang tetap resident dipindah ke bloknya yang baru
+        // (geometri di koordinat dunia, tidak berubah), hanya chunk baru yang di-bake
+        std::vector<ArenaMeshSet> sets;
+        layoutMeshSets(sets);
+        for (auto& set : sets) {
+            auto it = std::find_if(arenaMeshSets.begin(), arenaMeshSets.end(),
+                                   [&set](const ArenaMeshSet& baked) { return meshSetReusable(baked, set); });
+            if (it == arenaMeshSets.end()) {
+                rebaked += bakeMeshSet(set, (1u << CULL_KIND_COUNT) - 1);
+                continue;
+            }
+            int block = set.block;
+            set = std::move(*it);
+            set.block = block;
+            *it = ArenaMeshSet(); // Buffer GL sudah milik set baru
+        }
+        for (auto& set : arenaMeshSets) freeMeshSet(set);
+        arenaMeshSets.swap(sets);
+        return rebaked;
+    }
+    for (auto& set : arenaMeshSets) rebaked += bakeMeshSet(set, changedKinds);
+    return rebaked;
+}
+
+bool isArenaMeshBaked() {
+    return arenaMeshBaked;
+}
+
+int arenaMeshDrawCalls() {
+    return arenaMeshLastDrawCalls;
+}
+
+// Set pointer vertex array untuk batch; VBO pakai offset, fallback pakai pointer client
+static const GLvoid* bindBatch(const ArenaMeshBatch& batch, bool withNormalColor) {
+    const char* base = nullptr;
+    if (batch.vbo) {
+        glbBindBuffer(GL_ARRAY_BUFFER, batch.vbo);
+        glbBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch.ibo);
+    } else {
+        base = (const char*)batch.vertices.data();
+    }
+    glVertexPointer(3, GL_FLOAT, sizeof(ArenaVertex), base + offsetof(ArenaVertex, px));
+    if (withNormalColor) {
+        glNormalPointer(GL_FLOAT, sizeof(ArenaVertex), base + offsetof(ArenaVertex, nx));
+        glColorPointer(3, GL_FLOAT, sizeof(ArenaVertex), base + offsetof(ArenaVertex, r));
+    }
+    return batch.ibo ? nullptr : (const GLvoid*)batch.indices.data();
+}
+
+static void unbindBatches() {
+    if (hasGLBuffers()) {
+        glbBindBuffer(GL_ARRAY_BUFFER, 0);
+        glbBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
+}
+
+// Tambah range index objek-objek di level LOD ini; objek bersebelahan digabung.
+// objects = posisi di arenaCullOrder yang ada di set ini, first = posisi objek
+// pertama set (objek ke-0 batch).
+static void appendRuns(ArenaMeshBatch& batch, const GLuint* indices, const int* objects, size_t count,
+                       int first, int level) {
+    const GLuint* objectFirst = batch.objectFirst.data() + level * (batch.objectFirst.size() / batch.lodLevels);
+    for (size_t k = 0; k < count;) {
+        int begin = objects[k] - first, last = begin;
+        while (++k < count && objects[k] - first == last + 1) last = objects[k] - first;
+        GLuint from = objectFirst[begin], to = objectFirst[last + 1];
+        if (to == from) continue;
+        batch.runCounts.push_back((GLsizei)(to - from));
+        batch.runOffsets.push_back(indices + from);
+    }
+}
+
+// Bagian list posisi (urut naik) yang jatuh di [first, last)
+static void appendSetRuns(ArenaMeshBatch& batch, const GLuint* indices, const std::vector<int>& objects,
+                          int first, int last, int level) {
+    auto lo = std::lower_bound(objects.begin(), objects.end(), first);
+    auto hi = std::lower_bound(lo, objects.end(), last);
+    appendRuns(batch, indices, objects.data() + (lo - objects.begin()), (size_t)(hi - lo), first, level);
+}
+
+static void flushRuns(ArenaMeshBatch& batch) {
+    if (batch.runCounts.empty()) return;
+    if (glbMultiDrawElements) {
+        glbMultiDrawElements(GL_TRIANGLES, batch.runCounts.data(), GL_UNSIGNED_INT,
+                             batch.runOffsets.data(), (GLsizei)batch.runCounts.size());
+        arenaMeshLastDrawCalls++;
+    } else {
+        for (size_t r = 0; r < batch.runCounts.size(); ++r) {
+            glDrawElements(GL_TRIANGLES, batch.runCounts[r], GL_UNSIGNED_INT, batch.runOffsets[r]);
+            arenaMeshLastDrawCalls++;
+        }
+    }
+    batch.runCounts.clear();
+    batch.runOffsets.clear();
+}
+
+// Batch tanpa culling digambar utuh; batch dengan culling hanya range objek set
+// yang lolos arenaVisibleObjects. Batch dengan LOD: semua pass solid dalam satu
+// draw, pass crossfade masing-masing dengan pola stipple-nya.
+static void drawBatchElements(const ArenaMeshSet* set, ArenaMeshBatch& batch, const GLuint* indices) {
+    if (batch.cullKind < 0) {
+        glDrawElements(GL_TRIANGLES, (GLsizei)batch.indices.size(), GL_UNSIGNED_INT, indices);
+        arenaMeshLastDrawCalls++;
+        return;
+    }
+    ArenaCullKind kind = (ArenaCullKind)batch.cullKind;
+    int first, last;
+    meshSetRange(*set, kind, first, last);
+    if (batch.lodLevels == 1) {
+        appendSetRuns(batch, indices, arenaVisibleObjects(kind), first, last, 0);
+        flushRuns(batch);
+        return;
+    }
+    for (int level = 0; level < batch.lodLevels; ++level) {
+        appendSetRuns(batch, indices, arenaLodPassObjects(kind, level * ARENA_LOD_PATTERNS), first, last, level);
+    }
+    flushRuns(batch);
+    for (int pass = 0; pass < batch.lodLevels * ARENA_LOD_PATTERNS; ++pass) {
+        int pattern = arenaLodPassPattern(pass);
+        if (pattern == 0) continue;
+        appendSetRuns(batch, indices, arenaLodPassObjects(kind, pass), first, last, arenaLodPassLevel(pass));
+        if (batch.runCounts.empty()) continue;
+        beginLodFadePattern(pattern);
+        flushRuns(batch);
+        endLodFadePattern(pattern);
+    }
+}
+
+static void drawShadowBatch() {
+    glPushMatrix();
+    GLfloat shadow_plane[4] = {0.0f, 1.0f, 0.0f, -0.01f};
+    GLfloat shadow_light[4] = {10.0f, 80.0f, 10.0f, 1.0f};
+    glShadowProjection(shadow_light, shadow_plane);
+    glEnable(GL_POLYGON_OFFSET_FILL);
+    glPolygonOffset(-2.0f, -2.0f);
+    glDepthMask(GL_FALSE);
+    glDisable(GL_LIGHTING);
+    glDisable(GL_TEXTURE_2D);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    // Bayangan cube semua set dulu, lalu ramp, supaya urutan blending sama dengan
+    // waktu semuanya satu buffer
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glColor4f(0.1f, 0.1f, 0.1f, 0.5f);
+    for (auto& set : arenaMeshSets) {
+        if (set.shadowRampFirst == 0) continue;
+        const GLuint* indices = (const GLuint*)bindBatch(set.shadow, false);
+        glDrawElements(GL_TRIANGLES, set.shadowRampFirst, GL_UNSIGNED_INT, indices);
+        arenaMeshLastDrawCalls++;
+    }
+    glColor4f(0.0f, 0.0f, 0.0f, 0.4f);
+    for (auto& set : arenaMeshSets) {
+        int numRampIndices = (int)set.shadow.indices.size() - set.shadowRampFirst;
+        if (numRampIndices == 0) continue;
+        const GLuint* indices = (const GLuint*)bindBatch(set.shadow, false);
+        glDrawElements(GL_TRIANGLES, numRampIndices, GL_UNSIGNED_INT, indices + set.shadowRampFirst);
+        arenaMeshLastDrawCalls++;
+    }
+    glDisableClientState(GL_VERTEX_ARRAY);
+    unbindBatches();
+
+    glDisable(GL_BLEND);
+    glEnable(GL_LIGHTING);
+    glDepthMask(GL_TRUE);
+    glDisable(GL_POLYGON_OFFSET_FILL);
+    glPopMatrix();
+}
+
+static void setArenaMaterial(const ArenaMaterial& m) {
+    glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, m.ambient);
+    glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, m.diffuse);
+    glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, m.specular);
+    glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, m.shininess);
+}
+
+// Per material: ground, lalu batch material itu dari tiap set chunk
+void drawArenaMesh() {
+    arenaMeshLastDrawCalls = 0;
+    if (!arenaMeshBaked) return;
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_NORMAL_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    if (!arenaGroundBatch.indices.empty()) {
+        setArenaMaterial(arenaMaterials[MESH_GROUND]);
+        const GLvoid* indices = bindBatch(arenaGroundBatch, true);
+        drawBatchElements(nullptr, arenaGroundBatch, (const GLuint*)indices);
+    }
+    for (int i = MESH_GROUND + 1; i < MESH_BATCH_COUNT; ++i) {
+        bool materialSet = false;
+        for (auto& set : arenaMeshSets) {
+            ArenaMeshBatch& batch = set.batches[i];
+            if (batch.indices.empty()) continue;
+            if (!materialSet) {
+                setArenaMaterial(arenaMaterials[i]);
+                materialSet = true;
+            }
+            const GLvoid* indices = bindBatch(batch, true);
+            drawBatchElements(&set, batch, (const GLuint*)indices);
+        }
+    }
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_NORMAL_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    unbindBatches();
+
+    if (enableShadows) drawShadowBatch();
+}
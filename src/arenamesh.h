@@ -0,0 +1,64 @@
+#ifndef ARENAMESH_H
+#define ARENAMESH_H
+
+#include "arena.h"
+#include <GL/glut.h>
+#include <vector>
+
+// Geometri statis arena (ground, cube, ramp, bush, tree, rock) di-tessellate sekali
+// ke batch vertex/index interleaved per material, lalu tiap frame cukup beberapa
+// draw call. Pakai VBO kalau driver punya (GL 1.5), kalau tidak vertex array biasa.
+// Kalau instancing prop aktif (propinstances.h), tree/bush/rock tidak ikut di-bake.
+void bakeArenaMesh();    // Setelah setupArenaGeometry, butuh context GL
+void releaseArenaMesh();
+// Bake ulang hanya batch jenis objek yang berubah (bit 1 << ArenaCullKind, lihat
+// ARENA_CHANGED_* di arenacull.h). Return jumlah batch yang di-bake ulang.
+int rebakeArenaMesh(unsigned changedKinds);
+bool isArenaMeshBaked();
+void drawArenaMesh();    // Semua batch + bayangan cube/ramp kalau enableShadows
+int arenaMeshDrawCalls(); // Draw call di drawArenaMesh terakhir
+
+struct ArenaVertex {
+    float px, py, pz;
+    float nx, ny, nz;
+    float r, g, b;
+};
+
+struct ArenaMaterial {
+    GLfloat ambient[4], diffuse[4], specular[4];
+    GLfloat shininess;
+};
+
+// Batch per material, urutan sama dengan urutan gambar di drawGround lama
+enum ArenaMeshBatchId {
+    MESH_GROUND, MESH_CUBE, MESH_RAMP, MESH_TRUNK, MESH_FOLIAGE, MESH_BUSH, MESH_ROCK, MESH_BATCH_COUNT
+};
+
+extern const ArenaMaterial arenaMaterials[MESH_BATCH_COUNT];
+
+struct ArenaMeshBatch {
+    std::vector<ArenaVertex> vertices;
+    std::vector<GLuint> indices;
+    GLuint vbo = 0, ibo = 0;
+    // Untuk culling: index objek ke-k (urutan arenaCullOrder) di level LOD l ada di
+    // indices[objectFirst[l * (n + 1) + k]..objectFirst[l * (n + 1) + k + 1]), semua
+    // level berurutan di buffer yang sama. cullKind -1 = selalu digambar utuh.
+    int cullKind = -1;
+    int lodLevels = 1;
+    std::vector<GLuint> objectFirst;
+    std::vector<GLsizei> runCounts;         // Range bersambung objek terlihat, diisi per frame
+    std::vector<const GLvoid*> runOffsets;
+};
+
+// Tessellate satu prop ke batch materialnya (koordinat dunia prop apa adanya) di
+// level LOD tertentu (0 paling detail, lihat arenalod.h). propinstances.cpp
+// memakainya untuk membuat prototype instancing.
+void bakeTree(ArenaMeshBatch& trunk, ArenaMeshBatch& foliage, const ArenaTree& tree, int lod);
+void bakeBush(ArenaMeshBatch& batch, const ArenaBush& bush, int lod);
+void bakeRock(ArenaMeshBatch& batch, const ArenaRock& rock, int lod);
+
+// Pola stipple crossfade LOD (arenaLodPassPattern); pola 0 = solid, tanpa stipple
+void beginLodFadePattern(int pattern);
+void endLodFadePattern(int pattern);
+
+#endif // ARENAMESH_H
@@ -1,12 +1,15 @@
 #include "checkpoint.h"
+#include "simmath.h"
 #include "globals.h" 
 #include "arena.h"   
 #include "marble.h" 
 #include "timer.h"  
+#include "level.h"
+#include "trigger.h"
+#include "profiler.h"
 #include <vector>
 #include <cmath>    
 #include <iostream> 
-#include <GL/glut.h>
 
 // Variabel global dari globals.h yang terutama terkait checkpoint
 std::vector<Vec3> checkpoints;
@@ -14,103 +17,158 @@ int activeCheckpointIndex = -1;
 std::vector<bool> checkpointCollected; 
 
 
-void addCheckpoint(float x, float z, float bonusMinutes) {
-    CheckpointData data;
-    data.position = {x, 0.0f, z}; // Y is placeholder
-    data.bonusMinutes = bonusMinutes;
-    
-    checkpointData.push_back(data);
-    checkpoints.push_back({x, 0.0f, z}); 
-    checkpointCollected.push_back(false); 
+std::vector<LevelHazard> hazards;
+
+// Semua objek gameplay jadi volume di trigger.h; file ini mengisi volumenya dan
+// menangani event per jenis. Checkpoint/finish tidak pernah bergerak: tinggi
+// tanahnya (checkpoints[i].y, finishPosition.y) di-resolve sekali dan diulang
+// hanya kalau arenaSolidVersion berubah (load, jendela streaming, edit cube/ramp).
+// Radius volume dipilih supaya sama dengan tes jarak lama: pusat marble kurang
+// dari 1.5 * marbleRadius dari titik tanah + 0.5.
+static const float markerTriggerRadius = marbleRadius * 0.5f;
+static const float coinTriggerRadius = 0.4f;
+static bool markerTriggersDirty = true;   // Checkpoint/finish/hazard ditambah atau dikosongkan
+static unsigned markerHeightVersion = 0;
+static unsigned coinTriggerVersion = 0;
+static bool coinTriggersBuilt = false;
+static bool triggerHandlersSet = false;
+
+// Di level streaming tanah di luar jendela belum ada; checkpoint di sana
+// menyimpan tinggi lama sampai jendelanya terpasang (marble juga belum bisa ke sana)
+static bool insideArenaWindow(float x, float z) {
+    return std::fabs(x - arenaOriginX) <= BOUNDS && std::fabs(z - arenaOriginZ) <= BOUNDS;
+}
+
+static void resolveGroundHeight(Vec3& p) {
+    if (!insideArenaWindow(p.x, p.z)) return;
+    float nx, ny, nz;
+    getArenaHeightAndNormal(p.x, p.z, p.y, nx, ny, nz);
+}
+
+static TriggerVolume markerVolume(const Vec3& ground) {
+    TriggerVolume v = {TRIGGER_SPHERE, ground.x, ground.y + 0.5f, ground.z, markerTriggerRadius, 0.0f, 0.0f, 0.0f};
+    return v;
+}
+
+static void rebuildMarkerTriggers() {
+    clearTriggers(TRIGGER_CHECKPOINT);
+    clearTriggers(TRIGGER_FINISH);
+    clearTriggers(TRIGGER_HAZARD);
+    for (const Vec3& cp : checkpoints) addTrigger(TRIGGER_CHECKPOINT, markerVolume(cp));
+    if (finishSet) addTrigger(TRIGGER_FINISH, markerVolume(finishPosition));
+    for (const LevelHazard& h : hazards) {
+        TriggerVolume v = {TRIGGER_BOX, h.x, h.y, h.z, 0.0f, 0.5f * h.sizeX, 0.5f * h.sizeY, 0.5f * h.sizeZ};
+        addTrigger(TRIGGER_HAZARD, v);
+    }
 }
 
-void checkCheckpointCollision() {
-    for (int i = 0; i < checkpoints.size(); ++i) {
-        if (checkpointCollected[i]) {
-            continue;
+static void checkpointEvents(const TriggerEvent* events, int count) {
+    for (int e = 0; e < count; ++e) {
+        int i = events[e].id;
+        if (!events[e].entered || checkpointCollected[i]) continue;
+        checkpointCollected[i] = true;
+        if (i > activeCheckpointIndex) {
+            activeCheckpointIndex = i;
         }
-        
-        Vec3 cp = checkpoints[i];
-        float cpGroundH, dummyNX, dummyNY, dummyNZ;
-        getArenaHeightAndNormal(cp.x, cp.z, cpGroundH, dummyNX, dummyNY, dummyNZ);
-        float cpY = cpGroundH + 0.5f;       
-        float dx = marbleX - cp.x;
-        float dz = marbleZ - cp.z;
-        float dy = marbleY - cpY;
-        float dist3D = sqrt(dx * dx + dy * dy + dz * dz);
-        
-        float collisionRadius = marbleRadius + (marbleRadius * 0.5f); 
-        
-        if (dist3D < collisionRadius) {
-                checkpointCollected[i] = true;
-                if (i > activeCheckpointIndex) {
-                    activeCheckpointIndex = i;
-                }
-                if (i > 0) {
-                    score += 100; 
-                    double bonusSeconds = checkpointData[i].bonusMinutes * 60.0;
-                    addTimeToCountdown(bonusSeconds);
-                    std::cout << "Checkpoint " << i + 1 << " collected! Score +100. Time +" 
-                              << checkpointData[i].bonusMinutes << " min. Spawn point updated." << std::endl;
-                } else {
-                    std::cout << "Spawn checkpoint collected (no score). Spawn point updated." << std::endl;
-                }
-                  recordCheckpointTime();
-            }
+        if (i > 0) {
+            score += 100; 
+            double bonusSeconds = checkpointData[i].bonusMinutes * 60.0;
+            addTimeToCountdown(bonusSeconds);
+            std::cout << "Checkpoint " << i + 1 << " collected! Score +100. Time +" 
+                      << checkpointData[i].bonusMinutes << " min. Spawn point updated." << std::endl;
+        } else {
+            std::cout << "Spawn checkpoint collected (no score). Spawn point updated." << std::endl;
         }
+        recordCheckpointTime();
+    }
+}
+
+static void finishEvents(const TriggerEvent* events, int count) {
+    for (int e = 0; e < count; ++e) {
+        if (!events[e].entered || finishReached) continue;
+        finishReached = true;
+        std::cout << "FINISH! Congratulations, you have completed the level!" << std::endl;
+    }
+}
+
+static void coinEvents(const TriggerEvent* events, int count) {
+    for (int e = 0; e < count; ++e) {
+        if (!events[e].entered) continue;
+        coins[events[e].id].collected = true;
+        setTriggerEnabled(TRIGGER_COIN, events[e].id, false);
+    }
+}
+
+// Hazard dites terakhir (jenis terakhir di batch), jadi respawn tidak mengganggu
+// event checkpoint/coin di tick yang sama
+static void hazardEvents(const TriggerEvent* events, int count) {
+    for (int e = 0; e < count; ++e) {
+        if (!events[e].entered) continue;
+        resetMarble();
+        return;
     }
+}
 
-void drawCheckpoints() {
-    glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT | GL_LIGHTING_BIT); // Simpan state GL
-    glEnable(GL_LIGHTING); // Pastikan lighting aktif untuk checkpoint
-
-    for (size_t i = 0; i < checkpoints.size(); ++i) {
-        const Vec3& cp_data = checkpoints[i]; // cp_data.y adalah Y yang disimpan saat addCheckpoint (saat ini 0.0f)
-
-        float cpGroundH, dummyNX, dummyNY, dummyNZ;
-        // Dapatkan ketinggian tanah di lokasi XZ checkpoint
-        getArenaHeightAndNormal(cp_data.x, cp_data.z, cpGroundH, dummyNX, dummyNY, dummyNZ);
-        
-        // Radius visual checkpoint adalah setengah dari radius bola pemain
-        float visualCheckpointRadius = marbleRadius * 0.5f;
-        // Y efektif untuk visual checkpoint (pusat bola checkpoint)
-        float cpEffectiveY = cpGroundH + visualCheckpointRadius;        glPushMatrix();
-        glTranslatef(cp_data.x, cpEffectiveY, cp_data.z);        // Set material properties for checkpoints
-        GLfloat cp_ambient[4], cp_diffuse[4], cp_specular[4];
-        GLfloat cp_shininess;
-        
-        if (!checkpointCollected[i]) {
-            // Checkpoint belum diambil: material kuning berkilau
-            cp_ambient[0] = 0.3f; cp_ambient[1] = 0.3f; cp_ambient[2] = 0.0f; cp_ambient[3] = 0.8f;
-            cp_diffuse[0] = 1.0f; cp_diffuse[1] = 1.0f; cp_diffuse[2] = 0.0f; cp_diffuse[3] = 0.8f;
-            cp_specular[0] = 1.0f; cp_specular[1] = 1.0f; cp_specular[2] = 0.5f; cp_specular[3] = 0.8f;
-            cp_shininess = 60.0f;
-            
-            glEnable(GL_BLEND);
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-            glColor4f(1.0f, 1.0f, 0.0f, 0.8f); // Kuning dengan alpha 0.8
+void syncLevelTriggers() {
+    if (!triggerHandlersSet) {
+        setTriggerHandler(TRIGGER_CHECKPOINT, checkpointEvents);
+        setTriggerHandler(TRIGGER_FINISH, finishEvents);
+        setTriggerHandler(TRIGGER_COIN, coinEvents);
+        setTriggerHandler(TRIGGER_HAZARD, hazardEvents);
+        triggerHandlersSet = true;
+    }
+    unsigned version = arenaSolidVersion();
+    if (markerTriggersDirty || version != markerHeightVersion) {
+        for (size_t i = 0; i < checkpoints.size(); ++i) {
+            resolveGroundHeight(checkpoints[i]);
+            checkpointData[i].position.y = checkpoints[i].y;
+        }
+        if (finishSet) resolveGroundHeight(finishPosition);
+        if (markerTriggersDirty) {
+            rebuildMarkerTriggers();
         } else {
-            // Checkpoint sudah diambil: material abu-abu transparan
-            cp_ambient[0] = 0.2f; cp_ambient[1] = 0.2f; cp_ambient[2] = 0.2f; cp_ambient[3] = 0.3f;
-            cp_diffuse[0] = 0.6f; cp_diffuse[1] = 0.6f; cp_diffuse[2] = 0.6f; cp_diffuse[3] = 0.3f;
-            cp_specular[0] = 0.3f; cp_specular[1] = 0.3f; cp_specular[2] = 0.3f; cp_specular[3] = 0.3f;
-            cp_shininess = 20.0f;
-            
-            glEnable(GL_BLEND);
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-            glColor4f(0.6f, 0.6f, 0.6f, 0.3f); // Abu-abu dengan alpha 0.3
+            for (size_t i = 0; i < checkpoints.size(); ++i) {
+                const Vec3& cp = checkpoints[i];
+                moveTrigger(TRIGGER_CHECKPOINT, (int)i, cp.x, cp.y + 0.5f, cp.z);
+            }
+            if (finishSet) moveTrigger(TRIGGER_FINISH, 0, finishPosition.x, finishPosition.y + 0.5f, finishPosition.z);
+        }
+        markerTriggersDirty = false;
+        markerHeightVersion = version;
+    }
+    // Coin dibuat ulang bersama arena (load, jendela streaming, hot reload)
+    if (!coinTriggersBuilt || arenaCoinVersion() != coinTriggerVersion) {
+        clearTriggers(TRIGGER_COIN);
+        for (size_t i = 0; i < coins.size(); ++i) {
+            const Coin& c = coins[i];
+            addTrigger(TRIGGER_COIN, {TRIGGER_SPHERE, c.x, c.y, c.z, coinTriggerRadius, 0.0f, 0.0f, 0.0f});
+            if (c.collected) setTriggerEnabled(TRIGGER_COIN, (int)i, false);
         }
-        
-        glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, cp_ambient);
-        glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, cp_diffuse);
-        glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, cp_specular);
-        glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, cp_shininess);
-        
-        glutSolidSphere(visualCheckpointRadius, 16, 16); // Gambar bola checkpoint
-
-        glPopMatrix();
+        coinTriggerVersion = arenaCoinVersion();
+        coinTriggersBuilt = true;
     }
-    glPopAttrib(); // Kembalikan state GL
+}
+
+void updateLevelTriggers() {
+    PROFILE_ZONE_DETAIL("updateLevelTriggers");
+    syncLevelTriggers();
+    updateTriggers(marbleX, marbleY, marbleZ, marbleRadius);
+}
+
+void addCheckpoint(float x, float z, float bonusMinutes) {
+    CheckpointData data;
+    data.position = {x, 0.0f, z}; // Y diisi syncLevelTriggers
+    data.bonusMinutes = bonusMinutes;
+    
+    checkpointData.push_back(data);
+    checkpoints.push_back({x, 0.0f, z}); 
+    checkpointCollected.push_back(false); 
+    markerTriggersDirty = true;
+}
+
+void addHazard(float x, float y, float z, float sizeX, float sizeY, float sizeZ) {
+    hazards.push_back({x, y, z, sizeX, sizeY, sizeZ});
+    markerTriggersDirty = true;
 }
 
 void resetMarble() {
@@ -139,6 +197,7 @@ void resetMarble() {
 
     marbleX = resetPos.x;
     marbleZ = resetPos.z;
+    ensureLevelWindow(marbleX, marbleZ);
     float resetGroundH, dummyNX, dummyNY, dummyNZ;
     getArenaHeightAndNormal(marbleX, marbleZ, resetGroundH, dummyNX, dummyNY, dummyNZ);
     marbleY = resetGroundH + 0.5f;
@@ -154,52 +213,22 @@ bool finishSet = false;
 bool finishReached = false;
 
 void addFinish(float x, float z) {
-    finishPosition = {x, 0.0f, z};
+    finishPosition = {x, 0.0f, z}; // Y diisi syncLevelTriggers
     finishSet = true;
     finishReached = false;
+    markerTriggersDirty = true;
 }
 
-void checkFinishCollision() {
-    if (!finishSet || finishReached) return;
-    float finishGroundH, dummyNX, dummyNY, dummyNZ;
-    getArenaHeightAndNormal(finishPosition.x, finishPosition.z, finishGroundH, dummyNX, dummyNY, dummyNZ);
-    float finishY = finishGroundH + 0.5f;
-    float dx = marbleX - finishPosition.x;
-    float dz = marbleZ - finishPosition.z;
-    float dy = marbleY - finishY;
-    float dist3D = sqrt(dx * dx + dy * dy + dz * dz);
-    float collisionRadius = marbleRadius + (marbleRadius * 0.5f);
-    if (dist3D < collisionRadius) {
-        finishReached = true;
-        std::cout << "FINISH! Congratulations, you have completed the level!" << std::endl;
-    }
-}
-
-void drawFinish() {
-    if (!finishSet) return;
-    float finishGroundH, dummyNX, dummyNY, dummyNZ;
-    getArenaHeightAndNormal(finishPosition.x, finishPosition.z, finishGroundH, dummyNX, dummyNY, dummyNZ);
-    float visualFinishRadius = marbleRadius * 0.7f;
-    float finishEffectiveY = finishGroundH + visualFinishRadius;
-    glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT | GL_LIGHTING_BIT);
-    glEnable(GL_LIGHTING);
-    glPushMatrix();
-    glTranslatef(finishPosition.x, finishEffectiveY, finishPosition.z);
-    // Material: Biru terang berkilau
-    GLfloat f_ambient[4] = {0.0f, 0.2f, 0.6f, 0.9f};
-    GLfloat f_diffuse[4] = {0.2f, 0.6f, 1.0f, 0.9f};
-    GLfloat f_specular[4] = {0.8f, 0.8f, 1.0f, 0.9f};
-    GLfloat f_shininess = 80.0f;
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glColor4f(0.2f, 0.6f, 1.0f, 0.9f);
-    glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, f_ambient);
-    glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, f_diffuse);
-    glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, f_specular);
-    glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, f_shininess);
-    glutSolidSphere(visualFinishRadius, 20, 20);
-    glPopMatrix();
-    glPopAttrib();
+// Kosongkan checkpoint + finish + hazard sebelum level baru dipasang
+void clearCheckpoints() {
+    checkpointData.clear();
+    checkpoints.clear();
+    checkpointCollected.clear();
+    hazards.clear();
+    activeCheckpointIndex = -1;
+    finishSet = false;
+    finishReached = false;
+    markerTriggersDirty = true;
 }
 
 void setupCheckpoints() {
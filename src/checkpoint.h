@@ -4,11 +4,33 @@
 #include "globals.h" 
 
 void addCheckpoint(float x, float z, float bonusMinutes = 1.0f);
-void checkCheckpointCollision();
 void resetMarble(); 
 void setupCheckpoints(); 
-void drawCheckpoints();
 void addFinish(float x, float z);
-void checkFinishCollision();
+void clearCheckpoints(); // Termasuk finish dan hazard
+
+// Hazard: box (pusat + ukuran, seperti cube) yang me-respawn marble ke checkpoint
+// aktif begitu dimasuki. Tidak solid, tidak ikut heightfield.
+struct LevelHazard {
+    float x, y, z, sizeX, sizeY, sizeZ;
+};
+extern std::vector<LevelHazard> hazards;
+void addHazard(float x, float y, float z, float sizeX, float sizeY, float sizeZ);
+
+// Checkpoint, finish, coin, dan hazard sebagai volume trigger (trigger.h).
+// syncLevelTriggers menyamakan volume dengan state level (tinggi tanah di
+// checkpoints[i].y dan finishPosition.y, coin baru setelah streaming/reload);
+// murah kalau tidak ada yang berubah, jadi kode gambar boleh memanggilnya juga.
+// updateLevelTriggers: sync lalu satu kali updateTriggers dengan bola marble, per tick.
+void syncLevelTriggers();
+void updateLevelTriggers();
+
+extern Vec3 finishPosition; // y = tinggi tanah, lihat syncLevelTriggers
+extern bool finishSet;
+extern bool finishReached;
+
+// Gambar checkpoint, finish, dan hazard (checkpointdraw.cpp, butuh OpenGL)
+void drawCheckpoints();
 void drawFinish();
+void drawHazards();
 #endif // CHECKPOINT_H
\ No newline at end of file
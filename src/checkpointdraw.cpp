@@ -0,0 +1,120 @@
+#include "checkpoint.h"
+#include "globals.h"
+#include "arena.h"
+#include "primitivemesh.h"
+#include "arenacull.h"
+#include "profiler.h"
+#include <GL/glut.h>
+#include <cmath>
+
+void drawCheckpoints() {
+    PROFILE_ZONE("drawCheckpoints");
+    glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT | GL_LIGHTING_BIT); // Simpan state GL
+    glEnable(GL_LIGHTING); // Pastikan lighting aktif untuk checkpoint
+    syncLevelTriggers();
+
+    for (size_t i = 0; i < checkpoints.size(); ++i) {
+        const Vec3& cp_data = checkpoints[i]; // cp_data.y = tinggi tanah di XZ checkpoint (cache)
+        float cpGroundH = cp_data.y;
+
+        // Radius visual checkpoint adalah setengah dari radius bola pemain
+        float visualCheckpointRadius = marbleRadius * 0.5f;
+        // Y efektif untuk visual checkpoint (pusat bola checkpoint)
+        float cpEffectiveY = cpGroundH + visualCheckpointRadius;
+        if (!arenaSphereVisible(cp_data.x, cpEffectiveY, cp_data.z, visualCheckpointRadius)) continue;
+        glPushMatrix();
+        glTranslatef(cp_data.x, cpEffectiveY, cp_data.z);        // Set material properties for checkpoints
+        GLfloat cp_ambient[4], cp_diffuse[4], cp_specular[4];
+        GLfloat cp_shininess;
+        
+        if (!checkpointCollected[i]) {
+            // Checkpoint belum diambil: material kuning berkilau
+            cp_ambient[0] = 0.3f; cp_ambient[1] = 0.3f; cp_ambient[2] = 0.0f; cp_ambient[3] = 0.8f;
+            cp_diffuse[0] = 1.0f; cp_diffuse[1] = 1.0f; cp_diffuse[2] = 0.0f; cp_diffuse[3] = 0.8f;
+            cp_specular[0] = 1.0f; cp_specular[1] = 1.0f; cp_specular[2] = 0.5f; cp_specular[3] = 0.8f;
+            cp_shininess = 60.0f;
+            
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            glColor4f(1.0f, 1.0f, 0.0f, 0.8f); // Kuning dengan alpha 0.8
+        } else {
+            // Checkpoint sudah diambil: material abu-abu transparan
+            cp_ambient[0] = 0.2f; cp_ambient[1] = 0.2f; cp_ambient[2] = 0.2f; cp_ambient[3] = 0.3f;
+            cp_diffuse[0] = 0.6f; cp_diffuse[1] = 0.6f; cp_diffuse[2] = 0.6f; cp_diffuse[3] = 0.3f;
+            cp_specular[0] = 0.3f; cp_specular[1] = 0.3f; cp_specular[2] = 0.3f; cp_specular[3] = 0.3f;
+            cp_shininess = 20.0f;
+            
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            glColor4f(0.6f, 0.6f, 0.6f, 0.3f); // Abu-abu dengan alpha 0.3
+        }
+        
+        glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, cp_ambient);
+        glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, cp_diffuse);
+        glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, cp_specular);
+        glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, cp_shininess);
+        
+        drawPrimitiveSphere(visualCheckpointRadius, 16); // Gambar bola checkpoint
+
+        glPopMatrix();
+    }
+    glPopAttrib(); // Kembalikan state GL
+}
+
+void drawFinish() {
+    PROFILE_ZONE("drawFinish");
+    if (!finishSet) return;
+    syncLevelTriggers();
+    float finishGroundH = finishPosition.y;
+    float visualFinishRadius = marbleRadius * 0.7f;
+    float finishEffectiveY = finishGroundH + visualFinishRadius;
+    if (!arenaSphereVisible(finishPosition.x, finishEffectiveY, finishPosition.z, visualFinishRadius)) return;
+    glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT | GL_LIGHTING_BIT);
+    glEnable(GL_LIGHTING);
+    glPushMatrix();
+    glTranslatef(finishPosition.x, finishEffectiveY, finishPosition.z);
+    // Material: Biru terang berkilau
+    GLfloat f_ambient[4] = {0.0f, 0.2f, 0.6f, 0.9f};
+    GLfloat f_diffuse[4] = {0.2f, 0.6f, 1.0f, 0.9f};
+    GLfloat f_specular[4] = {0.8f, 0.8f, 1.0f, 0.9f};
+    GLfloat f_shininess = 80.0f;
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glColor4f(0.2f, 0.6f, 1.0f, 0.9f);
+    glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, f_ambient);
+    glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, f_diffuse);
+    glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, f_specular);
+    glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, f_shininess);
+    drawPrimitiveSphere(visualFinishRadius, 20);
+    glPopMatrix();
+    glPopAttrib();
+}
+
+// Hazard: box merah transparan, tanpa depth write supaya objek di dalamnya tetap kelihatan
+void drawHazards() {
+    PROFILE_ZONE("drawHazards");
+    if (hazards.empty()) return;
+    glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT | GL_LIGHTING_BIT | GL_DEPTH_BUFFER_BIT);
+    glEnable(GL_LIGHTING);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDepthMask(GL_FALSE);
+    GLfloat h_ambient[4] = {0.4f, 0.0f, 0.0f, 0.35f};
+    GLfloat h_diffuse[4] = {1.0f, 0.15f, 0.1f, 0.35f};
+    GLfloat h_specular[4] = {0.2f, 0.2f, 0.2f, 0.35f};
+    glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, h_ambient);
+    glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, h_diffuse);
+    glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, h_specular);
+    glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, 10.0f);
+    glColor4f(1.0f, 0.15f, 0.1f, 0.35f);
+    for (const LevelHazard& h : hazards) {
+        float radius = 0.5f * sqrtf(h.sizeX * h.sizeX + h.sizeY * h.sizeY + h.sizeZ * h.sizeZ);
+        if (!arenaSphereVisible(h.x, h.y, h.z, radius)) continue;
+        glPushMatrix();
+        glTranslatef(h.x, h.y, h.z);
+        glScalef(h.sizeX, h.sizeY, h.sizeZ);
+        drawPrimitiveCube(1.0f);
+        glPopMatrix();
+    }
+    glPopAttrib();
+}
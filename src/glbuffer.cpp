@@ -0,0 +1,31 @@
+#include "glbuffer.h"
+#include <GL/freeglut_ext.h>
+
+GLProcLoader glProcLoader = glutGetProcAddress;
+PFNGLGENBUFFERSPROC glbGenBuffers = nullptr;
+PFNGLBINDBUFFERPROC glbBindBuffer = nullptr;
+PFNGLBUFFERDATAPROC glbBufferData = nullptr;
+PFNGLDELETEBUFFERSPROC glbDeleteBuffers = nullptr;
+PFNGLBUFFERSUBDATAPROC glbBufferSubData = nullptr;
+PFNGLMULTIDRAWELEMENTSPROC glbMultiDrawElements = nullptr;
+static bool glBuffersChecked = false;
+
+bool hasGLBuffers() {
+    if (!glBuffersChecked) {
+        glBuffersChecked = true;
+        glbGenBuffers = (PFNGLGENBUFFERSPROC)glProcLoader("glGenBuffers");
+        glbBindBuffer = (PFNGLBINDBUFFERPROC)glProcLoader("glBindBuffer");
+        glbBufferData = (PFNGLBUFFERDATAPROC)glProcLoader("glBufferData");
+        glbDeleteBuffers = (PFNGLDELETEBUFFERSPROC)glProcLoader("glDeleteBuffers");
+        glbBufferSubData = (PFNGLBUFFERSUBDATAPROC)glProcLoader("glBufferSubData");
+        if (!glbGenBuffers || !glbBindBuffer || !glbBufferData || !glbDeleteBuffers || !glbBufferSubData) {
+            glbGenBuffers = (PFNGLGENBUFFERSPROC)glProcLoader("glGenBuffersARB");
+            glbBindBuffer = (PFNGLBINDBUFFERPROC)glProcLoader("glBindBufferARB");
+            glbBufferData = (PFNGLBUFFERDATAPROC)glProcLoader("glBufferDataARB");
+            glbDeleteBuffers = (PFNGLDELETEBUFFERSPROC)glProcLoader("glDeleteBuffersARB");
+            glbBufferSubData = (PFNGLBUFFERSUBDATAPROC)glProcLoader("glBufferSubDataARB");
+        }
+        glbMultiDrawElements = (PFNGLMULTIDRAWELEMENTSPROC)glProcLoader("glMultiDrawElements");
+    }
+    return glbGenBuffers && glbBindBuffer && glbBufferData && glbDeleteBuffers && glbBufferSubData;
+}
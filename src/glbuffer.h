@@ -0,0 +1,24 @@
+#ifndef GLBUFFER_H
+#define GLBUFFER_H
+
+#include <GL/glut.h>
+#include <GL/glext.h>
+
+// Pengambil alamat fungsi GL (extension/versi di atas 1.1). Default
+// glutGetProcAddress; context tanpa GLUT (marble_render lewat EGL) mengganti ini
+// sebelum hasGLBuffers/hasGLInstancing pertama.
+typedef void (*GLProc)();
+typedef GLProc (*GLProcLoader)(const char* name);
+extern GLProcLoader glProcLoader;
+
+// Buffer object (GL 1.5) diambil lewat glProcLoader karena di Linux tidak
+// ada loader extension. Kalau tidak tersedia, pemanggil pakai vertex array biasa.
+bool hasGLBuffers();
+extern PFNGLGENBUFFERSPROC glbGenBuffers;
+extern PFNGLBINDBUFFERPROC glbBindBuffer;
+extern PFNGLBUFFERDATAPROC glbBufferData;
+extern PFNGLDELETEBUFFERSPROC glbDeleteBuffers;
+extern PFNGLBUFFERSUBDATAPROC glbBufferSubData;
+extern PFNGLMULTIDRAWELEMENTSPROC glbMultiDrawElements; // GL 1.4, boleh null
+
+#endif // GLBUFFER_H
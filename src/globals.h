@@ -1,11 +1,8 @@
 #ifndef GLOBALS_H
 #define GLOBALS_H
 
-#include <GL/glut.h>
 #include <vector>
 
-struct GLUquadric;
-
 #ifndef M_PI
 #define M_PI 3.14159265358979323846f
 #endif
@@ -29,6 +26,7 @@ const float marbleRadius = 0.5f;
 
 const float restitution_ground = 0.5f; 
 const float restitution_wall = 0.4f;  
+const float restitution_marble = 0.8f; // Tabrakan antar marble (MarbleWorld)
 
 extern float marbleX, marbleZ;
 extern float marbleVX, marbleVZ;
@@ -45,7 +43,17 @@ extern int lastMouseX, lastMouseY;
 extern bool keyStates[256];
 extern bool specialKeyStates[256];
 
+// Index tombol panah di keyStates, nilainya sama dengan GLUT_KEY_* supaya
+// kode simulasi tidak perlu header GLUT
+const int KEY_ARROW_LEFT = 100;
+const int KEY_ARROW_UP = 101;
+const int KEY_ARROW_RIGHT = 102;
+const int KEY_ARROW_DOWN = 103;
+
 extern float arenaHeights[GRID_SIZE][GRID_SIZE];
+// Titik tengah jendela arena (+-BOUNDS) di koordinat dunia. 0 kecuali level
+// streaming (level.h) yang menggeser jendela mengikuti marble.
+extern float arenaOriginX, arenaOriginZ;
 
 struct Vec3 {
     float x, y, z;
@@ -61,12 +69,7 @@ extern std::vector<Vec3> checkpoints;
 extern int activeCheckpointIndex;
 extern std::vector<bool> checkpointCollected;
 
-extern GLuint marbleTextureID; 
-extern GLUquadric* sphereQuadric; 
-
 extern int score;
 
-extern bool enableShadows;
-
 void initGame(); 
 #endif // GLOBALS_H
\ No newline at end of file
@@ -0,0 +1,111 @@
+#include "glshader.h"
+#include "glbuffer.h"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+PFNGLCREATESHADERPROC glsCreateShader = nullptr;
+PFNGLSHADERSOURCEPROC glsShaderSource = nullptr;
+PFNGLCOMPILESHADERPROC glsCompileShader = nullptr;
+PFNGLGETSHADERIVPROC glsGetShaderiv = nullptr;
+PFNGLGETSHADERINFOLOGPROC glsGetShaderInfoLog = nullptr;
+PFNGLDELETESHADERPROC glsDeleteShader = nullptr;
+PFNGLCREATEPROGRAMPROC glsCreateProgram = nullptr;
+PFNGLATTACHSHADERPROC glsAttachShader = nullptr;
+PFNGLBINDATTRIBLOCATIONPROC glsBindAttribLocation = nullptr;
+PFNGLLINKPROGRAMPROC glsLinkProgram = nullptr;
+PFNGLGETPROGRAMIVPROC glsGetProgramiv = nullptr;
+PFNGLGETPROGRAMINFOLOGPROC glsGetProgramInfoLog = nullptr;
+PFNGLDELETEPROGRAMPROC glsDeleteProgram = nullptr;
+PFNGLUSEPROGRAMPROC glsUseProgram = nullptr;
+PFNGLGETUNIFORMLOCATIONPROC glsGetUniformLocation = nullptr;
+PFNGLUNIFORM1FPROC glsUniform1f = nullptr;
+PFNGLVERTEXATTRIBPOINTERPROC glsVertexAttribPointer = nullptr;
+PFNGLENABLEVERTEXATTRIBARRAYPROC glsEnableVertexAttribArray = nullptr;
+PFNGLDISABLEVERTEXATTRIBARRAYPROC glsDisableVertexAttribArray = nullptr;
+PFNGLVERTEXATTRIBDIVISORPROC glsVertexAttribDivisor = nullptr;
+PFNGLDRAWELEMENTSINSTANCEDPROC glsDrawElementsInstanced = nullptr;
+static bool glInstancingChecked = false;
+static bool glInstancingSupported = false;
+
+// glXGetProcAddress bisa mengembalikan pointer untuk fungsi yang tidak didukung,
+// jadi versi/extension dicek dulu
+static bool glSupportsInstancing() {
+    const char* version = (const char*)glGetString(GL_VERSION);
+    int major = 0, minor = 0;
+    if (version && sscanf(version, "%d.%d", &major, &minor) == 2) {
+        if (major > 3 || (major == 3 && minor >= 3)) return true;
+    }
+    const char* extensions = (const char*)glGetString(GL_EXTENSIONS);
+    return extensions && major >= 2 &&
+           strstr(extensions, "GL_ARB_instanced_arrays") && strstr(extensions, "GL_ARB_draw_instanced");
+}
+
+template <typename T>
+static void loadGLProc(T& proc, const char* name, const char* arbName) {
+    proc = (T)glProcLoader(name);
+    if (!proc && arbName) proc = (T)glProcLoader(arbName);
+}
+
+bool hasGLInstancing() {
+    if (glInstancingChecked) return glInstancingSupported;
+    glInstancingChecked = true;
+    if (!glSupportsInstancing()) return false;
+    loadGLProc(glsCreateShader, "glCreateShader", nullptr);
+    loadGLProc(glsShaderSource, "glShaderSource", nullptr);
+    loadGLProc(glsCompileShader, "glCompileShader", nullptr);
+    loadGLProc(glsGetShaderiv, "glGetShaderiv", nullptr);
+    loadGLProc(glsGetShaderInfoLog, "glGetShaderInfoLog", nullptr);
+    loadGLProc(glsDeleteShader, "glDeleteShader", nullptr);
+    loadGLProc(glsCreateProgram, "glCreateProgram", nullptr);
+    loadGLProc(glsAttachShader, "glAttachShader", nullptr);
+    loadGLProc(glsBindAttribLocation, "glBindAttribLocation", nullptr);
+    loadGLProc(glsLinkProgram, "glLinkProgram", nullptr);
+    loadGLProc(glsGetProgramiv, "glGetProgramiv", nullptr);
+    loadGLProc(glsGetProgramInfoLog, "glGetProgramInfoLog", nullptr);
+    loadGLProc(glsDeleteProgram, "glDeleteProgram", nullptr);
+    loadGLProc(glsUseProgram, "glUseProgram", nullptr);
+    loadGLProc(glsGetUniformLocation, "glGetUniformLocation", nullptr);
+    loadGLProc(glsUniform1f, "glUniform1f", nullptr);
+    loadGLProc(glsVertexAttribPointer, "glVertexAttribPointer", nullptr);
+    loadGLProc(glsEnableVertexAttribArray, "glEnableVertexAttribArray", nullptr);
+    loadGLProc(glsDisableVertexAttribArray, "glDisableVertexAttribArray", nullptr);
+    loadGLProc(glsVertexAttribDivisor, "glVertexAttribDivisor", "glVertexAttribDivisorARB");
+    loadGLProc(glsDrawElementsInstanced, "glDrawElementsInstanced", "glDrawElementsInstancedARB");
+    glInstancingSupported = glsCreateShader && glsShaderSource && glsCompileShader && glsGetShaderiv &&
+                            glsGetShaderInfoLog && glsDeleteShader && glsCreateProgram && glsAttachShader &&
+                            glsBindAttribLocation && glsLinkProgram && glsGetProgramiv && glsGetProgramInfoLog &&
+                            glsDeleteProgram && glsUseProgram && glsGetUniformLocation && glsUniform1f &&
+                            glsVertexAttribPointer && glsEnableVertexAttribArray && glsDisableVertexAttribArray &&
+                            glsVertexAttribDivisor && glsDrawElementsInstanced;
+    return glInstancingSupported;
+}
+
+GLuint buildVertexProgram(const char* source, const char* const* attribNames, int numAttribs) {
+    if (!hasGLInstancing()) return 0;
+    GLuint shader = glsCreateShader(GL_VERTEX_SHADER);
+    glsShaderSource(shader, 1, &source, nullptr);
+    glsCompileShader(shader);
+    GLint ok = GL_FALSE;
+    char log[1024];
+    glsGetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+    if (!ok) {
+        glsGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+        std::cerr << "Vertex shader compile failed: " << log << std::endl;
+        glsDeleteShader(shader);
+        return 0;
+    }
+    GLuint program = glsCreateProgram();
+    glsAttachShader(program, shader);
+    for (int i = 0; i < numAttribs; ++i) glsBindAttribLocation(program, i, attribNames[i]);
+    glsLinkProgram(program);
+    glsDeleteShader(shader); // Tetap hidup selama masih ter-attach
+    glsGetProgramiv(program, GL_LINK_STATUS, &ok);
+    if (!ok) {
+        glsGetProgramInfoLog(program, sizeof(log), nullptr, log);
+        std::cerr << "Shader program link failed: " << log << std::endl;
+        glsDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
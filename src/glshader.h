@@ -0,0 +1,36 @@
+#ifndef GLSHADER_H
+#define GLSHADER_H
+
+#include <GL/glut.h>
+#include <GL/glext.h>
+
+// Shader GLSL dan instancing (GL 3.3, atau ARB_instanced_arrays + ARB_draw_instanced),
+// entry point diambil lewat glProcLoader seperti glbuffer.h.
+bool hasGLInstancing();
+extern PFNGLCREATESHADERPROC glsCreateShader;
+extern PFNGLSHADERSOURCEPROC glsShaderSource;
+extern PFNGLCOMPILESHADERPROC glsCompileShader;
+extern PFNGLGETSHADERIVPROC glsGetShaderiv;
+extern PFNGLGETSHADERINFOLOGPROC glsGetShaderInfoLog;
+extern PFNGLDELETESHADERPROC glsDeleteShader;
+extern PFNGLCREATEPROGRAMPROC glsCreateProgram;
+extern PFNGLATTACHSHADERPROC glsAttachShader;
+extern PFNGLBINDATTRIBLOCATIONPROC glsBindAttribLocation;
+extern PFNGLLINKPROGRAMPROC glsLinkProgram;
+extern PFNGLGETPROGRAMIVPROC glsGetProgramiv;
+extern PFNGLGETPROGRAMINFOLOGPROC glsGetProgramInfoLog;
+extern PFNGLDELETEPROGRAMPROC glsDeleteProgram;
+extern PFNGLUSEPROGRAMPROC glsUseProgram;
+extern PFNGLGETUNIFORMLOCATIONPROC glsGetUniformLocation;
+extern PFNGLUNIFORM1FPROC glsUniform1f;
+extern PFNGLVERTEXATTRIBPOINTERPROC glsVertexAttribPointer;
+extern PFNGLENABLEVERTEXATTRIBARRAYPROC glsEnableVertexAttribArray;
+extern PFNGLDISABLEVERTEXATTRIBARRAYPROC glsDisableVertexAttribArray;
+extern PFNGLVERTEXATTRIBDIVISORPROC glsVertexAttribDivisor;
+extern PFNGLDRAWELEMENTSINSTANCEDPROC glsDrawElementsInstanced;
+
+// Program dari vertex shader saja (fragment tetap fixed-function, fog ikut jalan).
+// attribNames[i] diikat ke lokasi i. Return 0 kalau compile/link gagal (log ke stderr).
+GLuint buildVertexProgram(const char* source, const char* const* attribNames, int numAttribs);
+
+#endif // GLSHADER_H
@@ -8,60 +8,101 @@
 #include "checkpoint.h" 
 #include "timer.h"     
 #include "imageloader.h" 
+#include "simulation.h"
+#include "arenamesh.h"
+#include "propinstances.h"
+#include "arenacull.h"
+#include "arenalod.h"
+#include "primitivemesh.h"
+#include "alloccounter.h"
+#include "hudtext.h"
+#include "inputrecord.h"
+#include "profiler.h"
 #include <GL/glut.h>
 #include <GL/glu.h>  
 #include <cmath>   
 #include <iostream>  
-#include <string> 
+#include <chrono>
 
 
 
 GLuint marbleTextureID = 0;
 GLUquadric* sphereQuadric = nullptr;
 bool enableShadows = true; 
+bool showRenderStats = false;
+bool showHud = true;
+const char* profileTracePath = "marble_trace.json";
+
+// Fixed timestep: physics selalu maju deltaTime per substep, lepas dari jitter
+// glutTimerFunc. Sisa accumulator dipakai untuk interpolasi posisi yang digambar.
+static const int timerIntervalMs = 16;
+static const int maxPhysicsSubstepsPerFrame = 5; // Batas catch-up, sisanya dibuang
+static const float teleportSnapDistance = 2.0f;  // Reset/respawn tidak diinterpolasi
+
+float renderMarbleX = 0.0f, renderMarbleY = 0.0f, renderMarbleZ = 0.0f;
+static float prevMarbleX = 0.0f, prevMarbleY = 0.0f, prevMarbleZ = 0.0f;
+static double physicsAccumulator = 0.0;
+static std::chrono::steady_clock::time_point lastFrameTime;
+static bool frameClockStarted = false;
+// Waktu antar display() untuk crossfade LOD, terpisah dari clock physics
+static std::chrono::steady_clock::time_point lastDisplayTime;
+static bool displayClockStarted = false;
+
+// Frame steady-state (setelah warmup) tidak boleh mengalokasi heap. Pelanggaran
+// pertama dilaporkan sekali supaya kelihatan tanpa membanjiri console.
+static const int allocationWarmupFrames = 120;
+static int framesSinceInit = 0;
+static bool frameAllocationReported = false;
+
+static void snapRenderState() {
+    prevMarbleX = marbleX; prevMarbleY = marbleY; prevMarbleZ = marbleZ;
+    renderMarbleX = marbleX; renderMarbleY = marbleY; renderMarbleZ = marbleZ;
+}
 
 
-void drawScore() {
-    int totalPossibleScore = 0;
-    if (checkpoints.size() > 1) { 
-        for (int i = 1; i < checkpoints.size(); ++i) { 
-            totalPossibleScore += 100; 
-        }
-    }
-    
-    std::string scoreStr = "Score: " + std::to_string(score) + "/" + std::to_string(totalPossibleScore);
-    glColor3f(1.0f, 1.0f, 0.0f);
-    void* font = GLUT_BITMAP_HELVETICA_18;
-
-    // Setup ortho projection supaya text selalu di posisi layar
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-    int width = glutGet(GLUT_WINDOW_WIDTH);
-    int height = glutGet(GLUT_WINDOW_HEIGHT);
-    gluOrtho2D(0, width, 0, height);
+// Teks HUD: string disimpan di HudText, quad glyph cuma disusun ulang kalau
+// nilainya berubah (score, waktu, statistik)
+static HudText scoreText, timerText, statsText[2], profilerText[2];
+static HudText popupTitleText, popupSubtitleText, popupScoreText;
 
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glLoadIdentity();
+static void drawScore(int screenWidth, int screenHeight) {
+    int totalPossibleScore = checkpoints.size() > 1 ? 100 * ((int)checkpoints.size() - 1) : 0;
+    setHudText(scoreText, HUD_FONT_LARGE, "Score: %d/%d", score, totalPossibleScore);
+    int x = screenWidth / 2 - hudTextWidth(scoreText) / 2;
+    drawHudText(scoreText, x, screenHeight - 40, 1.0f, 1.0f, 0.0f);
+}
 
-    int textWidth = scoreStr.length() * 10; // Kira-kira, tergantung font
-    int x = width / 2 - textWidth / 2;
-    int y = height - 40;
+void displayTimer(int screenHeight) {
+    setHudText(timerText, HUD_FONT_LARGE, "%s", getElapsedTimeString());
+    drawHudText(timerText, 10, screenHeight - 30, 1.0f, 1.0f, 1.0f);
+}
 
-    glRasterPos2i(x, y);
-    for (char c : scoreStr) {
-        glutBitmapCharacter(font, c);
+// Statistik culling di pojok kiri bawah (toggle 'i')
+void drawRenderStats() {
+    ArenaCullStats stats = arenaCullStats();
+    setHudText(statsText[0], HUD_FONT_SMALL, "Objects drawn: %d  culled: %d  tiles culled: %d  culling: %s",
+               stats.objectsDrawn, stats.objectsCulled, stats.tilesCulled, isArenaCullingEnabled() ? "on" : "off");
+    setHudText(statsText[1], HUD_FONT_SMALL, "LOD 0: %d  LOD 1: %d  LOD 2: %d  LOD: %s",
+               arenaLodObjectsAtLevel(0), arenaLodObjectsAtLevel(1), arenaLodObjectsAtLevel(2),
+               isArenaLodEnabled() ? "on" : "off");
+    for (int i = 0; i < 2; ++i) {
+        drawHudText(statsText[i], 10, 28 - 18 * i, 1.0f, 1.0f, 1.0f);
     }
+}
 
-    glPopMatrix();
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
+// Persentil waktu frame dari profiler, di bawah timer (toggle 'p', 't' = dump trace)
+static void drawProfilerOverlay(int screenHeight) {
+    ProfileFrameStats stats = profileFrameStats();
+    setHudText(profilerText[0], HUD_FONT_SMALL, "Frame ms  p50 %.2f  p95 %.2f  p99 %.2f  max %.2f  (%d frames)",
+               stats.p50Ms, stats.p95Ms, stats.p99Ms, stats.maxMs, stats.frames);
+    setHudText(profilerText[1], HUD_FONT_SMALL, "Profiler on: 't' writes %s", profileTracePath);
+    for (int i = 0; i < 2; ++i) {
+        drawHudText(profilerText[i], 10, screenHeight - 52 - 16 * i, 0.6f, 1.0f, 0.6f);
+    }
 }
 
 void updateDynamicLighting() {
-    GLfloat light2_pos[] = {marbleX, marbleY + 15.0f, marbleZ - 20.0f, 1.0f};
+    GLfloat light2_pos[] = {renderMarbleX, renderMarbleY + 15.0f, renderMarbleZ - 20.0f, 1.0f};
     glLightfv(GL_LIGHT2, GL_POSITION, light2_pos);
     static float lightTime = 0.0f;
     lightTime += 0.01f;
@@ -110,13 +151,14 @@ void glShadowProjection(const float* light, const float* plane) {
     glMultMatrixf(mat);
 }
 
-void display() {
+void renderFrame(int screenWidth, int screenHeight, float frameSeconds) {
+    if (showHud) initHudText(); // Bake atlas sekali (FBO)
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     glLoadIdentity();
 
-    float targetX = marbleX;
-    float targetY = marbleY + cameraTargetYOffset;
-    float targetZ = marbleZ;
+    float targetX = renderMarbleX;
+    float targetY = renderMarbleY + cameraTargetYOffset;
+    float targetZ = renderMarbleZ;
 
     float camAngleXRad = degToRad(cameraAngleX);
     float camAngleYRad = degToRad(cameraAngleY);
@@ -132,15 +174,32 @@ void display() {
 
     updateDynamicLighting();
 
+    // Frustum kamera frame ini, dipakai drawGround, checkpoint, dan coin; LOD prop
+    // dan marble dipilih dari kamera yang sama
+    GLfloat projectionMatrix[16], modelviewMatrix[16];
+    glGetFloatv(GL_PROJECTION_MATRIX, projectionMatrix);
+    glGetFloatv(GL_MODELVIEW_MATRIX, modelviewMatrix);
+    // Cube/ramp yang diedit saat runtime (addArenaCube, moveArenaRamp, ...)
+    {
+        PROFILE_ZONE("cull + LOD");
+        unsigned arenaChanges = takeArenaChanges();
+        if (arenaChanges) rebakeArenaMesh(arenaChanges);
+        cullArena(projectionMatrix, modelviewMatrix);
+        GLint viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        updateArenaLod(projectionMatrix, modelviewMatrix, viewport[3], frameSeconds);
+    }
+
     drawGround();
 
 
     if (enableShadows) {
+        PROFILE_ZONE("shadow");
         glPushMatrix();
             GLfloat shadow_plane[4] = {0.0f, 1.0f, 0.0f, -0.01f};
             GLfloat shadow_light[4] = {10.0f, 80.0f, 10.0f, 1.0f}; 
             glShadowProjection(shadow_light, shadow_plane);
-            glTranslatef(marbleX, marbleY, marbleZ); 
+            glTranslatef(renderMarbleX, renderMarbleY, renderMarbleZ); 
 
             glEnable(GL_POLYGON_OFFSET_FILL);
             glPolygonOffset(-2.0f, -2.0f);
@@ -165,16 +224,43 @@ void display() {
     drawMarble();
     drawCheckpoints();
     drawFinish(); 
-    drawScore(); 
-    drawCongratulationsPopup();
-
-    int screenWidth = glutGet(GLUT_WINDOW_WIDTH);
-    int screenHeight = glutGet(GLUT_WINDOW_HEIGHT);
-    displayTimer(screenWidth, screenHeight);
-
-    drawCongratulationsPopup();
+    drawHazards();
+
+    // Semua teks HUD dalam satu pass ortho
+    if (showHud) {
+        PROFILE_ZONE("hud");
+        beginHud(screenWidth, screenHeight);
+        drawScore(screenWidth, screenHeight);
+        displayTimer(screenHeight);
+        if (showRenderStats) drawRenderStats();
+        if (isProfilerEnabled()) drawProfilerOverlay(screenHeight);
+        drawCongratulationsPopup(screenWidth, screenHeight);
+        endHud();
+    }
+}
 
-    glutSwapBuffers();
+void display() {
+    PROFILE_ZONE("display");
+    unsigned long long allocationsBefore = allocationCount();
+    auto displayTime = std::chrono::steady_clock::now();
+    float displaySeconds = displayClockStarted ? std::chrono::duration<float>(displayTime - lastDisplayTime).count() : 0.0f;
+    lastDisplayTime = displayTime;
+    displayClockStarted = true;
+    renderFrame(glutGet(GLUT_WINDOW_WIDTH), glutGet(GLUT_WINDOW_HEIGHT), displaySeconds);
+
+    {
+        PROFILE_ZONE("glutSwapBuffers");
+        glutSwapBuffers();
+    }
+    profileFrameMark();
+
+    unsigned long long frameAllocations = allocationCount() - allocationsBefore;
+    if (framesSinceInit < allocationWarmupFrames) {
+        ++framesSinceInit;
+    } else if (frameAllocations > 0 && !frameAllocationReported) {
+        frameAllocationReported = true;
+        std::cerr << "Warning: steady-state frame made " << frameAllocations << " heap allocations" << std::endl;
+    }
 }
 
 void reshape(int w, int h) {
@@ -188,16 +274,56 @@ void reshape(int w, int h) {
 }
 
 void timer(int value) {
-    updatePhysics();
-    updateTimer();
-    
-    if (isCountdownExpired()) {
-        std::cout << "Time's up! Game Over!" << std::endl;
-        initGame();
+    PROFILE_ZONE("timer");
+    hotReloadLevel();
+    streamLevel();
+    auto now = std::chrono::steady_clock::now();
+    if (!frameClockStarted) {
+        lastFrameTime = now;
+        physicsAccumulator = 0.0;
+        frameClockStarted = true;
+        snapRenderState();
     }
-    
+    physicsAccumulator += std::chrono::duration<double>(now - lastFrameTime).count();
+    lastFrameTime = now;
+
+    {
+        // Semua substep frame ini satu zona; zona per tick ada di level detail
+        PROFILE_ZONE("physics");
+        int substeps = 0;
+        while (physicsAccumulator >= deltaTime && substeps < maxPhysicsSubstepsPerFrame) {
+            prevMarbleX = marbleX; prevMarbleY = marbleY; prevMarbleZ = marbleZ;
+            recordInputTick();
+            bool running = stepSimulation();
+            streamLevelTick();
+            updateMarbleRotation();
+            physicsAccumulator -= deltaTime;
+            ++substeps;
+
+            if (!running) {
+                std::cout << "Time's up! Game Over!" << std::endl;
+                initGame();
+                recordInputEvent(INPUT_EVENT_RESTART);
+                break;
+            }
+            float dx = marbleX - prevMarbleX, dy = marbleY - prevMarbleY, dz = marbleZ - prevMarbleZ;
+            if (dx * dx + dy * dy + dz * dz > teleportSnapDistance * teleportSnapDistance) {
+                snapRenderState();
+            }
+        }
+    }
+    // Frame terlambat jauh (window di-drag, breakpoint, dll): jangan kejar semuanya
+    if (physicsAccumulator >= deltaTime) {
+        physicsAccumulator = 0.0;
+    }
+
+    float alpha = (float)(physicsAccumulator / deltaTime);
+    renderMarbleX = prevMarbleX + (marbleX - prevMarbleX) * alpha;
+    renderMarbleY = prevMarbleY + (marbleY - prevMarbleY) * alpha;
+    renderMarbleZ = prevMarbleZ + (marbleZ - prevMarbleZ) * alpha;
+
     glutPostRedisplay();
-    glutTimerFunc(16, timer, 0); 
+    glutTimerFunc(timerIntervalMs, timer, 0); 
 }
 
 void initGraphics() {
@@ -256,7 +382,7 @@ void initGraphics() {
 
     Image* image = loadBMP("textures/marble_texture.bmp"); 
     if (image == nullptr) {
-        std::cerr << "Failed to load marble texture using imageloader." << std::endl;
+        std::cerr << "Failed to load marble texture: " << imageLoadError() << std::endl;
     } else {
         glGenTextures(1, &marbleTextureID);
         glBindTexture(GL_TEXTURE_2D, marbleTextureID);
@@ -277,72 +403,44 @@ void initGraphics() {
     } else {
         std::cerr << "Failed to create GLUquadric object." << std::endl;
     }
+
+    // Arena baru saja dibangun ulang oleh initSimulation
+    buildPropInstances();
+    bakeArenaMesh();
+    initPrimitiveMeshes();
+
+    frameClockStarted = false;
+    framesSinceInit = 0;
+    snapRenderState();
 }
 
-void drawCongratulationsPopup() {
+// Teks popup dijaga tetap di dalam kotak (margin 10 kiri/kanan, 20 atas/bawah)
+static void drawPopupLine(HudText& text, int boxX, int boxY, int boxW, int boxH, int textY,
+                          float r, float g, float b) {
+    int textWidth = hudTextWidth(text);
+    int textX = boxX + boxW/2 - textWidth/2;
+    if (textX < boxX + 10) textX = boxX + 10;
+    if (textX + textWidth > boxX + boxW - 10) textX = boxX + boxW - 10 - textWidth;
+    if (textY < boxY + 20) textY = boxY + 20;
+    if (textY > boxY + boxH - 20) textY = boxY + boxH - 20;
+    drawHudText(text, textX, textY, r, g, b);
+}
+
+void drawCongratulationsPopup(int screenWidth, int screenHeight) {
     extern bool finishReached;
     if (!finishReached) return;
-    int width = glutGet(GLUT_WINDOW_WIDTH);
-    int height = glutGet(GLUT_WINDOW_HEIGHT);
-    const char* lines[] = {"CONGRATULATIONS!", "You finished the level!"};
-    int numLines = 2;
-    char scoreLine[64];
-    snprintf(scoreLine, sizeof(scoreLine), "Your Score: %d", score);
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-    gluOrtho2D(0, width, 0, height);
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glLoadIdentity();
-    glDisable(GL_DEPTH_TEST);
-    glDisable(GL_LIGHTING);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glColor4f(0.0f, 0.0f, 0.0f, 0.7f);
+    setHudText(popupTitleText, HUD_FONT_LARGE, "CONGRATULATIONS!");
+    setHudText(popupSubtitleText, HUD_FONT_LARGE, "You finished the level!");
+    setHudText(popupScoreText, HUD_FONT_LARGE, "Your Score: %d", score);
     int boxW = 420, boxH = 160;
-    int boxX = width/2 - boxW/2, boxY = height/2 - boxH/2;
-    glBegin(GL_QUADS);
-        glVertex2i(boxX, boxY);
-        glVertex2i(boxX + boxW, boxY);
-        glVertex2i(boxX + boxW, boxY + boxH);
-        glVertex2i(boxX, boxY + boxH);
-    glEnd();
-    glColor3f(1.0f, 1.0f, 0.0f);
-    void* font = GLUT_BITMAP_HELVETICA_18;
+    int boxX = screenWidth/2 - boxW/2, boxY = screenHeight/2 - boxH/2;
+    drawHudRect(boxX, boxY, boxW, boxH, 0.0f, 0.0f, 0.0f, 0.7f);
+    int numLines = 2;
     int lineHeight = 36;
-    // Tampilkan dua baris utama
-    for (int i = 0; i < numLines; ++i) {
-        int textWidth = glutBitmapLength(font, (const unsigned char*)lines[i]);
-        int textX = width/2 - textWidth/2;
-        int textY = height/2 + (numLines)*lineHeight/2 - i*lineHeight + 8;
-        if (textX < boxX + 10) textX = boxX + 10;
-        if (textX + textWidth > boxX + boxW - 10) textX = boxX + boxW - 10 - textWidth;
-        if (textY < boxY + 20) textY = boxY + 20;
-        if (textY > boxY + boxH - 20) textY = boxY + boxH - 20;
-        glRasterPos2i(textX, textY);
-        for (const char* p = lines[i]; *p; ++p) {
-            glutBitmapCharacter(font, *p);
-        }
-    }
-    // Tampilkan skor di bawahnya
-    int scoreTextWidth = glutBitmapLength(font, (const unsigned char*)scoreLine);
-    int scoreTextX = width/2 - scoreTextWidth/2;
-    int scoreTextY = height/2 - (numLines)*lineHeight/2 + 8;
-    if (scoreTextX < boxX + 10) scoreTextX = boxX + 10;
-    if (scoreTextX + scoreTextWidth > boxX + boxW - 10) scoreTextX = boxX + boxW - 10 - scoreTextWidth;
-    if (scoreTextY < boxY + 20) scoreTextY = boxY + 20;
-    if (scoreTextY > boxY + boxH - 20) scoreTextY = boxY + boxH - 20;
-    glColor3f(0.4f, 1.0f, 0.4f);
-    glRasterPos2i(scoreTextX, scoreTextY);
-    for (const char* p = scoreLine; *p; ++p) {
-        glutBitmapCharacter(font, *p);
-    }
-    glDisable(GL_BLEND);
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_LIGHTING);
-    glPopMatrix();
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
-}
\ No newline at end of file
+    int top = screenHeight/2 + numLines*lineHeight/2 + 8;
+    drawPopupLine(popupTitleText, boxX, boxY, boxW, boxH, top, 1.0f, 1.0f, 0.0f);
+    drawPopupLine(popupSubtitleText, boxX, boxY, boxW, boxH, top - lineHeight, 1.0f, 1.0f, 0.0f);
+    // Skor di bawahnya
+    drawPopupLine(popupScoreText, boxX, boxY, boxW, boxH, screenHeight/2 - numLines*lineHeight/2 + 8,
+                  0.4f, 1.0f, 0.4f);
+}
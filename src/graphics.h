@@ -1,13 +1,37 @@
 #ifndef GRAPHICS_H
 #define GRAPHICS_H
 
+#include <GL/glut.h>
+
+extern GLuint marbleTextureID; 
+extern GLUquadric* sphereQuadric; 
+extern bool enableShadows;
+extern bool showRenderStats; // Statistik culling di layar
+extern bool showHud; // Teks HUD (glyph dari font GLUT, butuh glutInit)
+extern const char* profileTracePath; // Tujuan dump profiler (tombol 't')
+
+// Posisi marble yang digambar: interpolasi antara dua state physics terakhir
+extern float renderMarbleX, renderMarbleY, renderMarbleZ;
+
+// Satu frame lengkap tanpa swap buffer. frameSeconds = waktu sejak frame
+// sebelumnya (crossfade LOD); marble_render memakai nilai tetap supaya gambar
+// bisa dibandingkan persis. display() = renderFrame + glutSwapBuffers.
+void renderFrame(int screenWidth, int screenHeight, float frameSeconds);
 void display();
 void reshape(int w, int h);
 void timer(int value);
 void initGraphics(); // For OpenGL specific initializations
 void updateDynamicLighting(); // Update lighting based on marble position
-void drawCongratulationsPopup(); // Menampilkan pop up UI di dalam game
+void drawCongratulationsPopup(int screenWidth, int screenHeight); // Pop up finish, di antara beginHud/endHud
+void displayTimer(int screenHeight);
+void drawRenderStats();
+void glShadowProjection(const float* light, const float* plane);
 
 void initGame();
+void switchToNextLevel(); // Tombol 'n': level berikutnya dari argumen (main.cpp)
+// Hook aplikasi yang dipanggil timer() tiap tick (main.cpp; marble_render tanpa timer, kosong)
+void hotReloadLevel(); // --watch: pasang perubahan file level aktif
+void streamLevel();    // Level streaming: jendela chunk pindah -> bangun ulang batch render
+void streamLevelTick(); // Sesudah tiap stepSimulation: jendela per tick selama merekam
 
 #endif // GRAPHICS_H
\ No newline at end of file
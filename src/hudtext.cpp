@@ -0,0 +1,297 @@
+#include "hudtext.h"
+#include "glbuffer.h"
+#include <GL/glut.h>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+// Atlas 512 x 256 GL_ALPHA. Tiap font punya blok cell sendiri, satu glyph per
+// cell, ASCII 32..126. Glyph digambar di cell dengan pen di (GLYPH_PAD, baseline)
+// supaya xorig negatif dan descender tetap masuk cell.
+static const int ATLAS_W = 512, ATLAS_H = 256;
+static const int ATLAS_USED_H = 180; // Helvetica 18: 5 baris x 24, Helvetica 12: 3 baris x 20
+static const int FIRST_GLYPH = 32, GLYPH_COUNT = 95;
+static const int GLYPH_PAD = 2;
+
+struct HudFontInfo {
+    void* glutFont;
+    int cellW, cellH;
+    int baseline;           // Baris baseline dari bawah cell
+    int atlasY;             // Baris bawah blok font ini di atlas
+    int columns;
+    int advance[GLYPH_COUNT];
+};
+
+static HudFontInfo fonts[HUD_FONT_COUNT] = {
+    { GLUT_BITMAP_HELVETICA_12, 16, 20, 5, 120, 0, {} },
+    { GLUT_BITMAP_HELVETICA_18, 24, 24, 6, 0, 0, {} },
+};
+static GLuint atlasTexture = 0;
+static bool metricsReady = false;
+static bool bakeTried = false;
+static bool atlasReady = false;
+static int rebuildCount = 0;
+
+// Framebuffer object (GL 3.0, ARB_framebuffer_object, atau EXT) supaya atlas
+// di-bake di luar window: tidak bergantung ukuran window, dan tidak kena tes
+// pixel ownership kalau window tertutup/belum tampil
+static PFNGLGENFRAMEBUFFERSPROC hudGenFramebuffers = nullptr;
+static PFNGLBINDFRAMEBUFFERPROC hudBindFramebuffer = nullptr;
+static PFNGLFRAMEBUFFERTEXTURE2DPROC hudFramebufferTexture2D = nullptr;
+static PFNGLCHECKFRAMEBUFFERSTATUSPROC hudCheckFramebufferStatus = nullptr;
+static PFNGLDELETEFRAMEBUFFERSPROC hudDeleteFramebuffers = nullptr;
+
+template <typename T>
+static void loadHudProc(T& proc, const char* name, const char* suffix) {
+    char fullName[64];
+    snprintf(fullName, sizeof(fullName), "%s%s", name, suffix);
+    proc = (T)glProcLoader(fullName);
+}
+
+// glXGetProcAddress bisa mengembalikan pointer untuk fungsi yang tidak didukung,
+// jadi versi/extension dicek dulu
+static bool loadFramebufferProcs() {
+    const char* version = (const char*)glGetString(GL_VERSION);
+    const char* extensions = (const char*)glGetString(GL_EXTENSIONS);
+    int major = 0, minor = 0;
+    if (version) sscanf(version, "%d.%d", &major, &minor);
+    const char* suffix;
+    if (major >= 3 || (extensions && strstr(extensions, "GL_ARB_framebuffer_object"))) {
+        suffix = "";
+    } else if (extensions && strstr(extensions, "GL_EXT_framebuffer_object")) {
+        suffix = "EXT";
+    } else {
+        return false;
+    }
+    loadHudProc(hudGenFramebuffers, "glGenFramebuffers", suffix);
+    loadHudProc(hudBindFramebuffer, "glBindFramebuffer", suffix);
+    loadHudProc(hudFramebufferTexture2D, "glFramebufferTexture2D", suffix);
+    loadHudProc(hudCheckFramebufferStatus, "glCheckFramebufferStatus", suffix);
+    loadHudProc(hudDeleteFramebuffers, "glDeleteFramebuffers", suffix);
+    return hudGenFramebuffers && hudBindFramebuffer && hudFramebufferTexture2D &&
+           hudCheckFramebufferStatus && hudDeleteFramebuffers;
+}
+
+static void loadFontMetrics() {
+    for (int f = 0; f < HUD_FONT_COUNT; ++f) {
+        HudFontInfo& font = fonts[f];
+        font.columns = ATLAS_W / font.cellW;
+        for (int g = 0; g < GLYPH_COUNT; ++g) font.advance[g] = glutBitmapWidth(font.glutFont, FIRST_GLYPH + g);
+    }
+    metricsReady = true;
+}
+
+// Gambar semua glyph ke texture RGBA lewat FBO lalu baca channel merahnya.
+// false kalau FBO tidak didukung atau tidak lengkap.
+static bool bakeAtlas(unsigned char* pixels) {
+    if (!loadFramebufferProcs()) return false;
+    GLint previousFramebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+    // Disimpan selagi framebuffer window terpasang, jadi read/draw buffer yang
+    // dipulihkan glPopAttrib (GL_BACK) tidak jatuh ke FBO
+    glPushAttrib(GL_ALL_ATTRIB_BITS);
+    GLuint target = 0, framebuffer = 0;
+    glGenTextures(1, &target);
+    glBindTexture(GL_TEXTURE_2D, target);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, ATLAS_W, ATLAS_H, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    hudGenFramebuffers(1, &framebuffer);
+    hudBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    hudFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, target, 0);
+    bool complete = hudCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+
+    if (complete) {
+        glViewport(0, 0, ATLAS_W, ATLAS_H);
+        glMatrixMode(GL_PROJECTION);
+        glPushMatrix();
+        glLoadIdentity();
+        gluOrtho2D(0, ATLAS_W, 0, ATLAS_H);
+        glMatrixMode(GL_MODELVIEW);
+        glPushMatrix();
+        glLoadIdentity();
+        glDisable(GL_LIGHTING);
+        glDisable(GL_DEPTH_TEST);
+        glDisable(GL_FOG);
+        glDisable(GL_TEXTURE_2D);
+        glDisable(GL_BLEND);
+        glDisable(GL_SCISSOR_TEST);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glColor3f(1.0f, 1.0f, 1.0f);
+
+        for (int f = 0; f < HUD_FONT_COUNT; ++f) {
+            const HudFontInfo& font = fonts[f];
+            for (int g = 0; g < GLYPH_COUNT; ++g) {
+                int cellX = (g % font.columns) * font.cellW;
+                int cellY = font.atlasY + (g / font.columns) * font.cellH;
+                glRasterPos2i(cellX + GLYPH_PAD, cellY + font.baseline);
+                glutBitmapCharacter(font.glutFont, FIRST_GLYPH + g);
+            }
+        }
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, ATLAS_W, ATLAS_USED_H, GL_RED, GL_UNSIGNED_BYTE, pixels);
+
+        glMatrixMode(GL_PROJECTION);
+        glPopMatrix();
+        glMatrixMode(GL_MODELVIEW);
+        glPopMatrix();
+    }
+    hudBindFramebuffer(GL_FRAMEBUFFER, (GLuint)previousFramebuffer);
+    glPopAttrib();
+    hudDeleteFramebuffers(1, &framebuffer);
+    glDeleteTextures(1, &target);
+    return complete;
+}
+
+void initHudText() {
+    if (!metricsReady) loadFontMetrics();
+    if (bakeTried) return;
+    bakeTried = true;
+    static unsigned char pixels[ATLAS_W * ATLAS_H];
+    memset(pixels, 0, sizeof(pixels));
+    // Tanpa FBO teks tetap digambar per karakter dengan glutBitmapCharacter
+    if (!bakeAtlas(pixels)) return;
+
+    if (!atlasTexture) glGenTextures(1, &atlasTexture);
+    glBindTexture(GL_TEXTURE_2D, atlasTexture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, ATLAS_W, ATLAS_H, 0, GL_ALPHA, GL_UNSIGNED_BYTE, pixels);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    atlasReady = true;
+}
+
+bool setHudText(HudText& text, HudFont font, const char* format, ...) {
+    char buffer[HUD_TEXT_CAPACITY];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (length < 0) length = 0;
+    if (length >= HUD_TEXT_CAPACITY) length = HUD_TEXT_CAPACITY - 1;
+
+    if (font == text.font && length == text.length && memcmp(buffer, text.text, length) == 0) return false;
+    memcpy(text.text, buffer, length + 1);
+    text.length = length;
+    text.font = font;
+    text.dirty = true;
+    return true;
+}
+
+// Susun quad glyph relatif ke pen (0, baseline 0); posisi layar lewat translate
+// di drawHudText, jadi pindah posisi tidak perlu susun ulang
+static void rebuildHudText(HudText& text) {
+    const HudFontInfo& font = fonts[text.font];
+    float* v = text.vertices;
+    int pen = 0, quads = 0;
+    for (int i = 0; i < text.length; ++i) {
+        int g = (unsigned char)text.text[i] - FIRST_GLYPH;
+        if (g < 0 || g >= GLYPH_COUNT) continue;
+        int cellX = (g % font.columns) * font.cellW;
+        int cellY = font.atlasY + (g / font.columns) * font.cellH;
+        float x0 = (float)(pen - GLYPH_PAD), x1 = x0 + font.cellW;
+        float y0 = (float)(-font.baseline), y1 = y0 + font.cellH;
+        float u0 = (float)cellX / ATLAS_W, u1 = (float)(cellX + font.cellW) / ATLAS_W;
+        float v0 = (float)cellY / ATLAS_H, v1 = (float)(cellY + font.cellH) / ATLAS_H;
+        float quad[16] = { x0, y0, u0, v0,  x1, y0, u1, v0,  x1, y1, u1, v1,  x0, y1, u0, v1 };
+        memcpy(v, quad, sizeof(quad));
+        v += 16;
+        ++quads;
+        pen += font.advance[g];
+    }
+    text.quads = quads;
+    text.width = pen;
+    text.dirty = false;
+    ++rebuildCount;
+}
+
+int hudTextWidth(HudText& text) {
+    if (text.dirty && metricsReady) rebuildHudText(text);
+    return text.width;
+}
+
+int hudTextRebuilds() {
+    return rebuildCount;
+}
+
+void beginHud(int screenWidth, int screenHeight) {
+    glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT | GL_COLOR_BUFFER_BIT | GL_TEXTURE_BIT);
+    glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    gluOrtho2D(0, screenWidth, 0, screenHeight);
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+
+    glDisable(GL_LIGHTING);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_FOG);
+    glDisable(GL_CULL_FACE);
+    glEnable(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, atlasTexture);
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+    // Alpha test, bukan blend: pixel glyph persis sama dengan glutBitmapCharacter
+    glEnable(GL_ALPHA_TEST);
+    glAlphaFunc(GL_GREATER, 0.5f);
+    glDisableClientState(GL_NORMAL_ARRAY);
+    glDisableClientState(GL_COLOR_ARRAY);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+}
+
+// Sebelum atlas ada (atau tanpa FBO): per karakter lewat raster position seperti dulu
+static void drawHudTextGlut(const HudText& text, int x, int y, float r, float g, float b) {
+    glDisable(GL_TEXTURE_2D);
+    glDisable(GL_ALPHA_TEST);
+    glColor3f(r, g, b);
+    glRasterPos2i(x, y);
+    for (int i = 0; i < text.length; ++i) glutBitmapCharacter(fonts[text.font].glutFont, (unsigned char)text.text[i]);
+    glEnable(GL_ALPHA_TEST);
+    glEnable(GL_TEXTURE_2D);
+}
+
+void drawHudText(HudText& text, int x, int y, float r, float g, float b) {
+    if (!metricsReady) return;
+    if (!atlasReady) {
+        drawHudTextGlut(text, x, y, r, g, b);
+        return;
+    }
+    if (text.dirty) rebuildHudText(text);
+    if (text.quads == 0) return;
+    glColor3f(r, g, b);
+    glPushMatrix();
+    glTranslatef((float)x, (float)y, 0.0f);
+    glVertexPointer(2, GL_FLOAT, 4 * sizeof(float), text.vertices);
+    glTexCoordPointer(2, GL_FLOAT, 4 * sizeof(float), text.vertices + 2);
+    glDrawArrays(GL_QUADS, 0, text.quads * 4);
+    glPopMatrix();
+}
+
+void drawHudRect(int x, int y, int w, int h, float r, float g, float b, float a) {
+    glDisable(GL_TEXTURE_2D);
+    glDisable(GL_ALPHA_TEST);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glColor4f(r, g, b, a);
+    glRecti(x, y, x + w, y + h);
+    glDisable(GL_BLEND);
+    glEnable(GL_ALPHA_TEST);
+    glEnable(GL_TEXTURE_2D);
+}
+
+void endHud() {
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+    glPopMatrix();
+    glPopClientAttrib();
+    glPopAttrib();
+}
@@ -0,0 +1,38 @@
+#ifndef HUDTEXT_H
+#define HUDTEXT_H
+
+// Teks HUD tanpa alokasi per frame. Glyph font bitmap GLUT (Helvetica 12/18)
+// di-bake sekali ke satu texture atlas; tiap HudText menyimpan string plus quad
+// glyph-nya di buffer ukuran tetap dan hanya menyusun ulang quad kalau string
+// yang tampil berubah. Satu HudText digambar dengan satu glDrawArrays.
+enum HudFont { HUD_FONT_SMALL, HUD_FONT_LARGE, HUD_FONT_COUNT };
+
+const int HUD_TEXT_CAPACITY = 128; // Termasuk '\0', string lebih panjang dipotong
+
+struct HudText {
+    char text[HUD_TEXT_CAPACITY];
+    int length;
+    HudFont font;
+    bool dirty;                               // Quad belum disusun dari text
+    int quads;
+    int width;                                // Pixel, jumlah advance glyph
+    float vertices[HUD_TEXT_CAPACITY * 16];   // x, y, u, v per sudut quad
+};
+
+// Ukuran glyph dari font GLUT, lalu bake atlas sekali ke framebuffer object (tidak
+// bergantung ukuran atau visibilitas window). Tanpa FBO teks digambar per karakter
+// dengan glutBitmapCharacter. Dipanggil tiap frame sebelum HUD, butuh context GL.
+void initHudText();
+// printf ke buffer tetap. Return true kalau string atau font berubah.
+bool setHudText(HudText& text, HudFont font, const char* format, ...);
+int hudTextWidth(HudText& text);
+int hudTextRebuilds(); // Berapa kali quad disusun ulang sejak start (statistik)
+
+// Semua gambar HUD di antara beginHud/endHud: proyeksi ortho pixel (0,0 di kiri
+// bawah), tanpa lighting/depth, atlas terpasang. y = baseline teks.
+void beginHud(int screenWidth, int screenHeight);
+void drawHudText(HudText& text, int x, int y, float r, float g, float b);
+void drawHudRect(int x, int y, int w, int h, float r, float g, float b, float a);
+void endHud();
+
+#endif // HUDTEXT_H
@@ -1,6 +1,18 @@
-#include <assert.h>
-#include <fstream>
+#include <cstdint>
+#include <cstring>
+#include <string>
 #include "imageloader.h"
+#include "mappedfile.h"
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <tmmintrin.h>
+#define IMAGE_SWIZZLE_SSSE3 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define IMAGE_SSSE3_TARGET
+#else
+#define IMAGE_SSSE3_TARGET __attribute__((target("ssse3")))
+#endif
+#endif
 
 using namespace std;
 
@@ -10,6 +22,8 @@ Image::~Image() {
     delete[] pixels;
 }
 
+static string imageError;
+
 namespace {
     //Konversi 4 buah karakter ke integer,
     //menggunakan bentuk little-endian
@@ -27,151 +41,136 @@ namespace {
                        (unsigned char)bytes[0]);
     }
 
-    //Membaca 4 byte selanjutnya sebagai integer,
-    //menggunakan bentuk little-endian
-    int readInt(ifstream &input) {
-        char buffer[4];
-        input.read(buffer, 4);
-        return toInt(buffer);
+    //Satu baris BGR -> RGB, byte per byte
+    void swizzleRowScalar(const unsigned char* src, unsigned char* dst, int first, int width) {
+        for (int x = first; x < width; x++) {
+            dst[3 * x] = src[3 * x + 2];
+            dst[3 * x + 1] = src[3 * x + 1];
+            dst[3 * x + 2] = src[3 * x];
+        }
     }
 
-    //Membaca 2 byte selanjutnya sebagai short,
-    //menggunakan bentuk little-endian
-    short readShort(ifstream &input) {
-        char buffer[2];
-        input.read(buffer, 2);
-        return toShort(buffer);
+#ifdef IMAGE_SWIZZLE_SSSE3
+    //4 pixel (12 byte) per pshufb. Load/store 16 byte, jadi hanya selama 16 byte
+    //itu masih di dalam baris; 4 byte sisa store ditimpa iterasi berikutnya.
+    IMAGE_SSSE3_TARGET
+    void swizzleRowSsse3(const unsigned char* src, unsigned char* dst, int width) {
+        const __m128i mask = _mm_setr_epi8(2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, -1, -1, -1, -1);
+        int x = 0;
+        for (; 3 * x + 16 <= 3 * width; x += 4) {
+            __m128i bgr = _mm_loadu_si128((const __m128i*)(src + 3 * x));
+            _mm_storeu_si128((__m128i*)(dst + 3 * x), _mm_shuffle_epi8(bgr, mask));
+        }
+        swizzleRowScalar(src, dst, x, width);
+    }
+
+    bool cpuHasSsse3() {
+#ifdef __SSSE3__
+        return true;
+#elif defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 1);
+        return (info[2] & (1 << 9)) != 0;
+#else
+        return __builtin_cpu_supports("ssse3");
+#endif
+    }
+#endif
+
+    bool fail(const char* filename, const char* reason) {
+        imageError = string(filename) + ": " + reason;
+        return false;
     }
 
-    template<class T>
-    class auto_array {
-        private:
-            T* array;
-            mutable bool isReleased;
-        public:
-            explicit auto_array(T* array_ = NULL) :
-                array(array_), isReleased(false) {
-            }
-
-            auto_array(const auto_array<T> &aarray) {
-                array = aarray.array;
-                isReleased = aarray.isReleased;
-                aarray.isReleased = true;
-            }
-
-            ~auto_array() {
-                if (!isReleased && array != NULL) {
-                    delete[] array;
-                }
-            }
-
-            T* get() const {
-                return array;
-            }
-
-            T &operator*() const {
-                return *array;
-            }
-
-            void operator=(const auto_array<T> &aarray) {
-                if (!isReleased && array != NULL) {
-                    delete[] array;
-                }
-                array = aarray.array;
-                isReleased = aarray.isReleased;
-                aarray.isReleased = true;
-            }
-
-            T* operator->() const {
-                return array;
-            }
-
-            T* release() {
-                isReleased = true;
-                return array;
-            }
-
-            void reset(T* array_ = NULL) {
-                if (!isReleased && array != NULL) {
-                    delete[] array;
-                }
-                array = array_;
-            }
-
-            T* operator+(int i) {
-                return array + i;
-            }
-
-            T &operator[](int i) {
-                return array[i];
-            }
-    };
+    //Cek header dan ukuran, hasilnya sudah pasti muat di dalam file
+    bool parseHeader(const MappedFile& file, const char* filename,
+                     int& width, int& height, bool& topDown, size_t& dataOffset, size_t& stride) {
+        const char* data = file.data;
+        if (file.size < 18 || data[0] != 'B' || data[1] != 'M') return fail(filename, "bukan file bitmap");
+        dataOffset = (uint32_t)toInt(data + 10);
+        int headerSize = toInt(data + 14);
+        if ((size_t)headerSize > file.size - 14) return fail(filename, "header bitmap terpotong");
+        int bitsPerPixel;
+        int compression = 0;
+        switch (headerSize) {
+            case 12:
+                //OS/2 V1
+                width = (unsigned short)toShort(data + 18);
+                height = (unsigned short)toShort(data + 20);
+                bitsPerPixel = toShort(data + 24);
+                break;
+            case 40:  //V3
+            case 52:
+            case 56:
+            case 64:  //OS/2 V2
+            case 108: //Windows V4
+            case 124: //Windows V5
+                width = toInt(data + 18);
+                height = toInt(data + 22);
+                bitsPerPixel = toShort(data + 28);
+                compression = toInt(data + 30);
+                break;
+            default:
+                return fail(filename, "format header bitmap tidak diketahui");
+        }
+        if (bitsPerPixel != 24) return fail(filename, "gambar tidak 24 bits per pixel");
+        if (compression != 0) return fail(filename, "gambar dikompres");
+        //Tinggi negatif = baris disimpan dari atas ke bawah
+        topDown = height < 0;
+        if (width <= 0 || height == 0 || height == INT32_MIN) return fail(filename, "ukuran gambar tidak valid");
+        if (topDown) height = -height;
+
+        //Tiap baris di-pad ke kelipatan 4 byte
+        uint64_t rowBytes = ((uint64_t)width * 3 + 3) & ~(uint64_t)3;
+        uint64_t pixelBytes = rowBytes * (uint64_t)height;
+        if ((uint64_t)width * (uint64_t)height * 3 > (uint64_t)INT32_MAX ||
+            dataOffset > file.size || pixelBytes > file.size - dataOffset) {
+            return fail(filename, "data pixel terpotong atau terlalu besar");
+        }
+        stride = (size_t)rowBytes;
+        return true;
+    }
 }
 
+//File di-map langsung (tanpa buffer baca), BGR -> RGB ditulis langsung ke
+//array hasil. Baris dibalik kalau bitmap top-down supaya tetap mulai dari bawah.
 Image* loadBMP(const char* filename) {
-    ifstream input;
-    input.open(filename, ifstream::binary);
-    assert(!input.fail() || !"File tidak ditemukan!!!"); // [cite: 22]
-    char buffer[2];
-    input.read(buffer, 2);
-    assert(buffer[0] == 'B' && buffer[1] == 'M' || !"Bukan file bitmap!!!"); // [cite: 23]
-    input.ignore(8);
-    int dataOffset = readInt(input);
-
-    //Baca header
-    int headerSize = readInt(input);
-    int width;
-    int height;
-    switch (headerSize) {
-        case 40:
-            //V3
-            width = readInt(input);
-            height = readInt(input);
-            input.ignore(2);
-            assert(readShort(input) == 24 || !"Gambar tidak 24 bits per pixel!"); // [cite: 24]
-            assert(readShort(input) == 0 || !"Gambar dikompres!"); // [cite: 25]
-            break;
-        case 12:
-            //OS/2 V1
-            width = readShort(input);
-            height = readShort(input);
-            input.ignore(2);
-            assert(readShort(input) == 24 || !"Gambar tidak 24 bits per pixel!"); // [cite: 26]
-            break;
-        case 64:
-            //OS/2 V2
-            assert(!"Tidak dapat mengambil OS/2 V2 bitmaps"); // [cite: 27]
-            break;
-        case 108:
-            //Windows V4
-            assert(!"Tidak dapat mengambil Windows V4 bitmaps"); // [cite: 27]
-            break;
-        case 124:
-            //Windows V5
-            assert(!"Tidak dapat mengambil Windows V5 bitmaps"); // [cite: 28]
-            break;
-        default:
-            assert(!"Format bitmap ini tidak diketahui!"); // [cite: 28]
+    MappedFile file;
+    if (!mapFile(filename, file)) {
+        fail(filename, "file tidak ditemukan atau kosong");
+        return nullptr;
+    }
+    int width = 0, height = 0;
+    bool topDown = false;
+    size_t dataOffset = 0, stride = 0;
+    if (!parseHeader(file, filename, width, height, topDown, dataOffset, stride)) {
+        unmapFile(file);
+        return nullptr;
     }
 
-    //Membaca data
-    int bytesPerRow = ((width * 3 + 3) / 4) * 4 - (width * 3 % 4); // [cite: 29]
-    int size = bytesPerRow * height; // [cite: 29]
-    auto_array<char> pixels(new char[size]); // [cite: 29]
-    input.seekg(dataOffset, ios_base::beg); // [cite: 30]
-    input.read(pixels.get(), size); // [cite: 30]
-
-    //Mengambil data yang mempunyai format benar
-    auto_array<char> pixels2(new char[width * height * 3]); // [cite: 30]
-    for(int y = 0; y < height; y++) { // [cite: 31]
-        for(int x = 0; x < width; x++) { // [cite: 31]
-            for(int c = 0; c < 3; c++) { // [cite: 31]
-                pixels2[3 * (width * y + x) + c] = // [cite: 31]
-                    pixels[bytesPerRow * y + 3 * x + (2 - c)]; // [cite: 31]
-            }
+    size_t dstStride = (size_t)width * 3;
+    char* pixels = new char[dstStride * height];
+    const unsigned char* src = (const unsigned char*)file.data + dataOffset;
+#ifdef IMAGE_SWIZZLE_SSSE3
+    static const bool useSsse3 = cpuHasSsse3();
+#endif
+    for (int y = 0; y < height; y++) {
+        const unsigned char* srcRow = src + stride * (topDown ? height - 1 - y : y);
+        unsigned char* dstRow = (unsigned char*)pixels + dstStride * y;
+#ifdef IMAGE_SWIZZLE_SSSE3
+        if (useSsse3) {
+            swizzleRowSsse3(srcRow, dstRow, width);
+            continue;
         }
+#endif
+        swizzleRowScalar(srcRow, dstRow, 0, width);
     }
 
-    input.close();
-    return new Image(pixels2.release(), width, height); // [cite: 31]
-}
\ No newline at end of file
+    unmapFile(file);
+    imageError.clear();
+    return new Image(pixels, width, height);
+}
+
+const char* imageLoadError() {
+    return imageError.c_str();
+}
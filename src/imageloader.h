@@ -44,4 +44,7 @@ class Image {
 //Reads a bitmap image from file.
 Image* loadBMP(const char* filename); // [cite: 39]
 
+//Alasan loadBMP terakhir mengembalikan nullptr (kosong kalau berhasil)
+const char* imageLoadError();
+
 #endif
\ No newline at end of file
@@ -2,19 +2,17 @@
 #include "globals.h" 
 #include "utils.h"   
 #include "checkpoint.h" 
+#include "graphics.h"
+#include "arenacull.h"
+#include "arenalod.h"
+#include "inputrecord.h"
+#include "profiler.h"
 #include <GL/glut.h>
 #include <cstdlib> 
+#include <cstdio>
 
 bool isDragging = false;
 int lastMouseX = 0, lastMouseY = 0;
-bool keyStates[256]; 
-
-
-void initKeyStates() {
-    for (int i = 0; i < 256; ++i) {
-        keyStates[i] = false;
-    }
-}
 
 void specialKeysDown(int key, int x, int y) {
     switch (key) {
@@ -43,6 +41,7 @@ void normalKeysDown(unsigned char key, int x, int y) {
     }
     if (key == 'r' || key == 'R') {
         resetMarble();
+        recordInputEvent(INPUT_EVENT_RESET);
     }
     if (key == 'o' || key == 'O') {
         extern float marbleX, marbleY, marbleZ;
@@ -53,6 +52,24 @@ void normalKeysDown(unsigned char key, int x, int y) {
         enableShadows = !enableShadows;
         glutPostRedisplay();
     }
+    if (key == 'c' || key == 'C') {
+        setArenaCullingEnabled(!isArenaCullingEnabled());
+    }
+    if (key == 'l' || key == 'L') {
+        setArenaLodEnabled(!isArenaLodEnabled());
+    }
+    if (key == 'i' || key == 'I') {
+        showRenderStats = !showRenderStats;
+    }
+    if (key == 'p' || key == 'P') {
+        setProfilerEnabled(!isProfilerEnabled());
+    }
+    if (key == 't' || key == 'T') {
+        if (!writeProfileTrace(profileTracePath)) printf("profile: cannot write %s\n", profileTracePath);
+    }
+    if (key == 'n' || key == 'N') {
+        switchToNextLevel();
+    }
 }
 
 void normalKeysUp(unsigned char key, int x, int y) {
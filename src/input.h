@@ -8,6 +8,4 @@ void normalKeysUp(unsigned char key, int x, int y);
 void mouseButton(int button, int state, int x, int y);
 void mouseMove(int x, int y);
 
-void initKeyStates();
-
 #endif // INPUT_H
\ No newline at end of file
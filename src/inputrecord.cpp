@@ -0,0 +1,252 @@
+#include "inputrecord.h"
+#include "globals.h"
+#include "checkpoint.h"
+#include "simulation.h"
+#include "level.h"
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Entri: satu byte flag lalu varint jumlah tick (0 = hanya kejadian, di akhir
+// rekaman). Float kamera disimpan mentah (bit persis, byte order mesin perekam).
+static const char replayMagic[4] = {'M', 'R', 'P', 'L'};
+static const uint32_t replayVersion = 1;
+static const unsigned ENTRY_KEYS = 0x0f;        // Bit 0..3: atas, bawah, kiri, kanan
+static const unsigned ENTRY_CAMERA = 0x10;      // Diikuti float cameraAngleX
+static const unsigned ENTRY_EVENT_SHIFT = 5;    // Bit 5..6: InputEvent sebelum tick pertama
+static const unsigned ENTRY_END = 0x80;         // Diikuti footer ReplayFinalState
+
+static const int arrowKeys[4] = { KEY_ARROW_UP, KEY_ARROW_DOWN, KEY_ARROW_LEFT, KEY_ARROW_RIGHT };
+
+// --- Rekam ---
+
+static FILE* recordFile = nullptr;
+static long long recordedTicks = 0;
+static unsigned pendingEvents = 0;
+static bool runOpen = false;        // Entri yang sedang dikumpulkan
+static unsigned runKeys = 0;
+static float runCamera = 0.0f;
+static unsigned runEvents = 0;
+static bool runHasCamera = false;
+static unsigned long long runTicks = 0;
+static bool cameraWritten = false;
+static float lastCamera = 0.0f;
+
+static void writeVarint(unsigned long long v) {
+    unsigned char buffer[10];
+    int n = 0;
+    do {
+        buffer[n] = (unsigned char)(v & 0x7f);
+        v >>= 7;
+        if (v) buffer[n] |= 0x80;
+        ++n;
+    } while (v);
+    fwrite(buffer, 1, n, recordFile);
+}
+
+static void flushRun() {
+    if (!runOpen) return;
+    unsigned char flags = (unsigned char)(runKeys | (runEvents << ENTRY_EVENT_SHIFT) | (runHasCamera ? ENTRY_CAMERA : 0));
+    fputc(flags, recordFile);
+    if (runHasCamera) fwrite(&runCamera, sizeof(float), 1, recordFile);
+    writeVarint(runTicks);
+    runOpen = false;
+}
+
+static unsigned currentArrowKeys() {
+    unsigned keys = 0;
+    for (int k = 0; k < 4; ++k) {
+        if (keyStates[arrowKeys[k]]) keys |= 1u << k;
+    }
+    return keys;
+}
+
+ReplayFinalState currentReplayState() {
+    return { recordedTicks, marbleX, marbleY, marbleZ, marbleVX, marbleVY, marbleVZ, score, activeCheckpointIndex };
+}
+
+bool startInputRecording(const char* path) {
+    stopInputRecording();
+    recordFile = fopen(path, "wb");
+    if (!recordFile) return false;
+    const char* level = currentLevelName();
+    uint16_t nameLength = (uint16_t)strlen(level);
+    fwrite(replayMagic, 1, sizeof(replayMagic), recordFile);
+    fwrite(&replayVersion, sizeof(replayVersion), 1, recordFile);
+    fwrite(&nameLength, sizeof(nameLength), 1, recordFile);
+    fwrite(level, 1, nameLength, recordFile);
+    recordedTicks = 0;
+    pendingEvents = 0;
+    runOpen = false;
+    cameraWritten = false;
+    return true;
+}
+
+void stopInputRecording() {
+    if (!recordFile) return;
+    flushRun();
+    if (pendingEvents) {
+        runOpen = true;
+        runKeys = 0;
+        runHasCamera = false;
+        runEvents = pendingEvents;
+        runTicks = 0;
+        flushRun();
+    }
+    fputc(ENTRY_END, recordFile);
+    ReplayFinalState state = currentReplayState();
+    fwrite(&state, sizeof(state), 1, recordFile);
+    fclose(recordFile);
+    recordFile = nullptr;
+    printf("Recording stopped after %lld ticks\n", recordedTicks);
+}
+
+bool isInputRecording() {
+    return recordFile != nullptr;
+}
+
+void recordInputEvent(InputEvent event) {
+    if (recordFile) pendingEvents |= event;
+}
+
+void recordInputTick() {
+    if (!recordFile) return;
+    unsigned keys = currentArrowKeys();
+    bool cameraChanged = !cameraWritten || memcmp(&cameraAngleX, &lastCamera, sizeof(float)) != 0;
+    if (runOpen && !pendingEvents && !cameraChanged && keys == runKeys) {
+        ++runTicks;
+    } else {
+        flushRun();
+        runOpen = true;
+        runKeys = keys;
+        runEvents = pendingEvents;
+        runHasCamera = cameraChanged;
+        runCamera = cameraAngleX;
+        runTicks = 1;
+        pendingEvents = 0;
+        lastCamera = cameraAngleX;
+        cameraWritten = true;
+    }
+    ++recordedTicks;
+}
+
+// --- Replay ---
+
+static std::vector<unsigned char> replayData;
+static size_t replayPos = 0;
+static std::string replayLevel;
+static std::string replayError;
+static ReplayFinalState replayFooter;
+static unsigned replayKeys = 0;
+static unsigned long long replayRemaining = 0;
+
+struct ReplayEntry {
+    unsigned flags;
+    float camera;
+    unsigned long long ticks;
+};
+
+// Baca satu entri di pos; false kalau data terpotong/rusak
+static bool readEntry(size_t& pos, ReplayEntry& entry) {
+    if (pos >= replayData.size()) return false;
+    entry.flags = replayData[pos++];
+    if (entry.flags & ENTRY_END) return true;
+    if (entry.flags & ENTRY_CAMERA) {
+        if (pos + sizeof(float) > replayData.size()) return false;
+        memcpy(&entry.camera, &replayData[pos], sizeof(float));
+        pos += sizeof(float);
+    }
+    entry.ticks = 0;
+    for (int shift = 0; ; shift += 7) {
+        if (pos >= replayData.size() || shift > 63) return false;
+        unsigned char b = replayData[pos++];
+        entry.ticks |= (unsigned long long)(b & 0x7f) << shift;
+        if (!(b & 0x80)) break;
+    }
+    return true;
+}
+
+static bool failReplay(const char* reason) {
+    replayError = reason;
+    replayData.clear();
+    return false;
+}
+
+bool loadInputReplay(const char* path) {
+    replayData.clear();
+    FILE* f = fopen(path, "rb");
+    if (!f) return failReplay("cannot open file");
+    unsigned char chunk[65536];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) replayData.insert(replayData.end(), chunk, chunk + n);
+    fclose(f);
+
+    const size_t fixedHeader = sizeof(replayMagic) + sizeof(uint32_t) + sizeof(uint16_t);
+    if (replayData.size() < fixedHeader || memcmp(replayData.data(), replayMagic, sizeof(replayMagic)) != 0) {
+        return failReplay("not a replay file");
+    }
+    uint32_t version;
+    uint16_t nameLength;
+    memcpy(&version, &replayData[4], sizeof(version));
+    memcpy(&nameLength, &replayData[8], sizeof(nameLength));
+    if (version != replayVersion) return failReplay("unsupported replay version");
+    if (replayData.size() < fixedHeader + nameLength) return failReplay("truncated header");
+    replayLevel.assign((const char*)&replayData[fixedHeader], nameLength);
+
+    // Validasi semua entri sekarang supaya nextReplayTick tidak perlu cek batas
+    size_t pos = fixedHeader + nameLength;
+    size_t firstEntry = pos;
+    long long ticks = 0;
+    ReplayEntry entry;
+    for (;;) {
+        if (!readEntry(pos, entry)) return failReplay("truncated entries (recording not stopped?)");
+        if (entry.flags & ENTRY_END) break;
+        ticks += (long long)entry.ticks;
+    }
+    if (pos + sizeof(ReplayFinalState) > replayData.size()) return failReplay("missing final state");
+    memcpy(&replayFooter, &replayData[pos], sizeof(replayFooter));
+    if (replayFooter.ticks != ticks) return failReplay("tick count mismatch");
+
+    replayPos = firstEntry;
+    replayRemaining = 0;
+    replayKeys = 0;
+    recordedTicks = 0;
+    return true;
+}
+
+const char* inputReplayError() {
+    return replayError.c_str();
+}
+
+const char* replayLevelName() {
+    return replayLevel.c_str();
+}
+
+bool nextReplayTick() {
+    while (replayRemaining == 0) {
+        if (replayData.empty()) return false;
+        ReplayEntry entry;
+        readEntry(replayPos, entry);
+        if (entry.flags & ENTRY_END) {
+            --replayPos; // Tetap di penanda akhir
+            return false;
+        }
+        unsigned events = (entry.flags >> ENTRY_EVENT_SHIFT) & 3;
+        if (events & INPUT_EVENT_RESTART) initSimulation();
+        if (events & INPUT_EVENT_RESET) resetMarble();
+        if (entry.flags & ENTRY_CAMERA) cameraAngleX = entry.camera;
+        replayKeys = entry.flags & ENTRY_KEYS;
+        replayRemaining = entry.ticks;
+    }
+    // initSimulation mengosongkan keyStates, jadi pasang ulang tiap tick
+    for (int k = 0; k < 4; ++k) keyStates[arrowKeys[k]] = (replayKeys >> k) & 1;
+    --replayRemaining;
+    ++recordedTicks;
+    return true;
+}
+
+const ReplayFinalState& replayRecordedState() {
+    return replayFooter;
+}
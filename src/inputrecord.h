@@ -0,0 +1,42 @@
+#ifndef INPUTRECORD_H
+#define INPUTRECORD_H
+
+// Rekam input per tick physics lalu putar ulang secara deterministik (marble_sim
+// --replay). Yang direkam hanya yang dibaca simulasi: 4 tombol panah di keyStates,
+// cameraAngleX, dan kejadian di luar tick (reset 'r', restart game over). Tick
+// beruntun dengan input sama digabung jadi satu entri (run-length), jadi diam atau
+// tahan satu tombol tanpa geser kamera cuma beberapa byte.
+//
+// File: header (magic, versi, path level) + entri + footer state akhir marble,
+// dipakai replay untuk memastikan hasilnya sama persis dengan rekaman.
+// Level streaming harus dipasang per tick dengan wait = true selama merekam
+// (lihat updateLevelStreaming), sama seperti replay.
+
+enum InputEvent {
+    INPUT_EVENT_RESET = 1,    // resetMarble() dari tombol 'r'
+    INPUT_EVENT_RESTART = 2,  // Countdown habis, initSimulation()
+};
+
+// Rekaman dimulai dari state sesudah initSimulation level aktif
+bool startInputRecording(const char* path);
+void stopInputRecording();  // Tulis footer dan tutup file; aman dipanggil berkali-kali
+bool isInputRecording();
+void recordInputEvent(InputEvent event); // Berlaku sebelum tick berikutnya
+void recordInputTick();     // Tepat sebelum stepSimulation
+
+struct ReplayFinalState {
+    long long ticks;
+    float x, y, z, vx, vy, vz;
+    int score, activeCheckpoint;
+};
+
+// Baca seluruh rekaman; gagal = alasan di inputReplayError
+bool loadInputReplay(const char* path);
+const char* inputReplayError();
+const char* replayLevelName();   // Path level saat merekam, "builtin" untuk level bawaan
+// Pasang kejadian dan input tick berikutnya ke simulasi; false kalau rekaman habis
+bool nextReplayTick();
+const ReplayFinalState& replayRecordedState();
+ReplayFinalState currentReplayState();
+
+#endif // INPUTRECORD_H
@@ -0,0 +1,1115 @@
+#include "level.h"
+#include "simmath.h"
+#include "mappedfile.h"
+#include "arena.h"
+#include "arenacull.h"
+#include "arenalod.h"
+#include "checkpoint.h"
+#include "globals.h"
+#include "profiler.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+// ---------------------------------------------------------------------------
+// Format cooked: header lalu section array record (little-endian, offset kelipatan
+// 4 dari awal file). Cube/bush/tree/rock memakai layout struct arena apa adanya,
+// heightfield GRID_SIZE x GRID_SIZE sudah dirasterisasi saat cook.
+// Level yang lebih besar dari arena (+-BOUNDS) jadi level streaming: record tiap
+// jenis diurutkan per chunk, section CHUNKS berisi range record per chunk, dan
+// heightfield kosong (dirasterisasi per jendela saat streaming).
+// ---------------------------------------------------------------------------
+enum LevelSection {
+    SECTION_CUBES, SECTION_RAMPS, SECTION_BUSHES, SECTION_TREES, SECTION_ROCKS,
+    SECTION_CHECKPOINTS, SECTION_FINISH, SECTION_COINS, SECTION_HEIGHTS, SECTION_CHUNKS, SECTION_HAZARDS,
+    SECTION_COUNT
+};
+
+// Jenis record yang dibagi per chunk; checkpoint, finish, dan hazard selalu dimuat semua
+enum ChunkKind { CHUNK_CUBES, CHUNK_RAMPS, CHUNK_BUSHES, CHUNK_TREES, CHUNK_ROCKS, CHUNK_COINS, CHUNK_KIND_COUNT };
+static const LevelSection chunkSection[CHUNK_KIND_COUNT] = {
+    SECTION_CUBES, SECTION_RAMPS, SECTION_BUSHES, SECTION_TREES, SECTION_ROCKS, SECTION_COINS
+};
+
+static const char cookedMagic[8] = {'M', 'R', 'B', 'L', 'L', 'V', 'L', 'C'};
+static const uint32_t cookedVersion = 3;
+
+// Chunk = kotak levelChunkSize x levelChunkSize, objek masuk chunk tempat titik
+// tengahnya. Jendela arena selebar LEVEL_WINDOW_CHUNKS chunk dengan origin di sudut chunk.
+static const float levelChunkSize = BOUNDS / 2.0f;
+static const int LEVEL_WINDOW_CHUNKS = 4;
+
+struct CookedSection {
+    uint32_t offset, count;
+};
+
+struct CookedHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t gridSize;
+    float bounds;
+    uint32_t reserved;
+    CookedSection sections[SECTION_COUNT];
+};
+
+struct CookedRamp {
+    float x, y, z, sizeX, sizeY, sizeZ;
+    int32_t axis;
+};
+
+struct CookedCheckpoint {
+    float x, z, bonusMinutes;
+};
+
+struct CookedPoint {
+    float x, y, z; // Finish dan coin; y tidak dipakai, tinggi coin ikut tanah saat dipasang
+};
+
+struct CookedChunk {
+    int32_t cx, cz;                     // Urut naik (cz, cx)
+    uint32_t first[CHUNK_KIND_COUNT];   // Index record pertama di section jenisnya
+    uint32_t count[CHUNK_KIND_COUNT];
+};
+
+static_assert(sizeof(ArenaCube) == 6 * sizeof(float), "ArenaCube disalin langsung dari file cooked");
+static_assert(sizeof(ArenaBush) == 4 * sizeof(float), "ArenaBush disalin langsung dari file cooked");
+static_assert(sizeof(ArenaTree) == 6 * sizeof(float), "ArenaTree disalin langsung dari file cooked");
+static_assert(sizeof(ArenaRock) == 4 * sizeof(float), "ArenaRock disalin langsung dari file cooked");
+static_assert(sizeof(LevelHazard) == 6 * sizeof(float), "LevelHazard disalin langsung dari file cooked");
+
+static const uint32_t sectionRecordSize[SECTION_COUNT] = {
+    sizeof(ArenaCube), sizeof(CookedRamp), sizeof(ArenaBush), sizeof(ArenaTree), sizeof(ArenaRock),
+    sizeof(CookedCheckpoint), sizeof(CookedPoint), sizeof(CookedPoint), sizeof(float), sizeof(CookedChunk),
+    sizeof(LevelHazard)
+};
+
+// Level teks setelah parsing, sebelum dipasang ke arena
+struct LevelSource {
+    std::vector<ArenaCube> cubes;
+    std::vector<ArenaRamp> ramps;
+    std::vector<ArenaBush> bushes;
+    std::vector<ArenaTree> trees;
+    std::vector<ArenaRock> rocks;
+    std::vector<CookedCheckpoint> checkpoints;
+    std::vector<CookedPoint> finish; // 0 atau 1
+    std::vector<CookedPoint> coins;
+    std::vector<LevelHazard> hazards;
+};
+
+static std::string levelName = "builtin";
+static std::string levelError;
+static std::vector<char> levelBlob; // Level teks yang sudah di-cook di memori
+static MappedFile levelMapping;     // Level cooked, tetap di-map selama aktif
+static const char* levelData = nullptr;
+
+static bool isCooked(const char* data, size_t size) {
+    return size >= sizeof(cookedMagic) && memcmp(data, cookedMagic, sizeof(cookedMagic)) == 0;
+}
+
+static bool validateCooked(const char* data, size_t size) {
+    if (size < sizeof(CookedHeader)) {
+        levelError = "cooked file too small";
+        return false;
+    }
+    CookedHeader header;
+    memcpy(&header, data, sizeof(header));
+    if (header.version != cookedVersion) {
+        levelError = "cooked version " + std::to_string(header.version) + ", expected " + std::to_string(cookedVersion);
+        return false;
+    }
+    if (header.gridSize != (uint32_t)GRID_SIZE || header.bounds != BOUNDS) {
+        levelError = "cooked for a different arena grid, re-cook it";
+        return false;
+    }
+    for (int s = 0; s < SECTION_COUNT; ++s) {
+        const CookedSection& sec = header.sections[s];
+        uint64_t end = (uint64_t)sec.offset + (uint64_t)sec.count * sectionRecordSize[s];
+        if (sec.offset % 4 != 0 || sec.offset < sizeof(CookedHeader) || end > size) {
+            levelError = "cooked section " + std::to_string(s) + " out of range";
+            return false;
+        }
+    }
+    bool streamed = header.sections[SECTION_CHUNKS].count > 0;
+    if (header.sections[SECTION_HEIGHTS].count != (streamed ? 0u : (uint32_t)(GRID_SIZE * GRID_SIZE)) ||
+        header.sections[SECTION_FINISH].count > 1) {
+        levelError = "cooked file is corrupt";
+        return false;
+    }
+    const CookedChunk* chunks = (const CookedChunk*)(data + header.sections[SECTION_CHUNKS].offset);
+    for (uint32_t c = 0; c < header.sections[SECTION_CHUNKS].count; ++c) {
+        for (int k = 0; k < CHUNK_KIND_COUNT; ++k) {
+            if ((uint64_t)chunks[c].first[k] + chunks[c].count[k] > header.sections[chunkSection[k]].count) {
+                levelError = "cooked chunk table out of range";
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static bool isStreamedLevel(const char* data) {
+    return ((const CookedHeader*)data)->sections[SECTION_CHUNKS].count > 0;
+}
+
+static void applyCookedCheckpoints(const char* data) {
+    const CookedSection* sec = ((const CookedHeader*)data)->sections;
+    clearCheckpoints();
+    const CookedCheckpoint* cpData = (const CookedCheckpoint*)(data + sec[SECTION_CHECKPOINTS].offset);
+    for (uint32_t i = 0; i < sec[SECTION_CHECKPOINTS].count; ++i) {
+        addCheckpoint(cpData[i].x, cpData[i].z, cpData[i].bonusMinutes);
+    }
+    if (sec[SECTION_FINISH].count == 1) {
+        const CookedPoint* finish = (const CookedPoint*)(data + sec[SECTION_FINISH].offset);
+        addFinish(finish->x, finish->z);
+    }
+    const LevelHazard* hazardData = (const LevelHazard*)(data + sec[SECTION_HAZARDS].offset);
+    for (uint32_t i = 0; i < sec[SECTION_HAZARDS].count; ++i) {
+        const LevelHazard& h = hazardData[i];
+        addHazard(h.x, h.y, h.z, h.sizeX, h.sizeY, h.sizeZ);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Streaming: hanya chunk di jendela LEVEL_WINDOW_CHUNKS x LEVEL_WINDOW_CHUNKS
+// sekitar marble yang ada di arena. Begitu marble menjauh dari origin, thread
+// latar menyalin record chunk baru dari level (file cooked tetap di-map, jadi
+// halaman chunk yang tidak dipakai boleh dibuang OS) dan merasterisasi heightfield
+// jendela baru; thread utama tinggal memasangnya. Chunk yang sudah resident
+// dipakai ulang, chunk di luar jendela dilepas. Checkpoint, finish, dan hazard
+// selalu resident; status coin disimpan per coin di level supaya tetap setelah chunk
+// dilepas dan dimuat lagi.
+// ---------------------------------------------------------------------------
+struct LevelChunk {
+    int cx, cz;
+    std::vector<ArenaCube> cubes;
+    std::vector<ArenaRamp> ramps;
+    std::vector<ArenaBush> bushes;
+    std::vector<ArenaTree> trees;
+    std::vector<ArenaRock> rocks;
+    std::vector<CookedPoint> coins;
+    std::vector<int> coinIds;           // Index coin di level, untuk status collected
+};
+
+typedef std::shared_ptr<const LevelChunk> LevelChunkPtr;
+
+struct LevelWindow {
+    float originX, originZ;
+    std::vector<LevelChunkPtr> chunks;
+    std::vector<float> heights;         // GRID_SIZE x GRID_SIZE relatif ke origin jendela
+    int chunksLoaded;                   // Chunk yang disalin dari level (bukan dipakai ulang)
+};
+
+static bool streamActive = false;
+static bool streamIncremental = true;
+static std::vector<LevelChunkPtr> residentChunks;
+static std::vector<LevelChunkKey> residentKeys;  // Paralel dengan residentChunks
+static unsigned nextChunkSerial = 0;
+static unsigned installedSolidVersion = 0;     // arenaSolidVersion setelah install terakhir
+static std::vector<int> residentCoinIds;       // Paralel dengan coins
+static std::vector<bool> levelCoinCollected;   // Per coin di level
+static std::future<LevelWindow> pendingWindow;
+static bool windowPending = false;
+static float pendingOriginX = 0.0f, pendingOriginZ = 0.0f;
+static unsigned streamChanges = 0;             // Belum diambil updateLevelStreaming
+static LevelStreamStats streamStats = {0, 0, 0, 0.0};
+
+static int chunkCoord(float v) {
+    return (int)floorf(v / levelChunkSize);
+}
+
+static float chunkCorner(float v) {
+    return floorf(v / levelChunkSize + 0.5f) * levelChunkSize;
+}
+
+// Origin jendela untuk posisi marble: sudut chunk terdekat, pindah hanya kalau
+// marble sudah lebih dari 3/4 chunk dari origin sekarang (hysteresis)
+static float windowOriginFor(float v, float current) {
+    if (fabsf(v - current) <= 0.75f * levelChunkSize) return current;
+    return chunkCorner(v);
+}
+
+static const CookedChunk* findCookedChunk(const char* data, int cx, int cz) {
+    const CookedSection& sec = ((const CookedHeader*)data)->sections[SECTION_CHUNKS];
+    const CookedChunk* first = (const CookedChunk*)(data + sec.offset);
+    const CookedChunk* last = first + sec.count;
+    const CookedChunk* it = std::lower_bound(first, last, std::make_pair(cz, cx),
+        [](const CookedChunk& c, const std::pair<int, int>& key) { return std::make_pair((int)c.cz, (int)c.cx) < key; });
+    return it != last && it->cx == cx && it->cz == cz ? it : nullptr;
+}
+
+template <typename T>
+static void copyChunkRecords(std::vector<T>& out, const char* data, const CookedChunk& chunk, ChunkKind kind) {
+    const CookedSection& sec = ((const CookedHeader*)data)->sections[chunkSection[kind]];
+    const T* first = (const T*)(data + sec.offset) + chunk.first[kind];
+    out.assign(first, first + chunk.count[kind]);
+}
+
+static LevelChunkPtr loadLevelChunk(const char* data, int cx, int cz) {
+    std::shared_ptr<LevelChunk> chunk = std::make_shared<LevelChunk>();
+    chunk->cx = cx;
+    chunk->cz = cz;
+    const CookedChunk* cooked = findCookedChunk(data, cx, cz);
+    if (!cooked) return chunk; // Chunk kosong tetap dicatat supaya tidak dicari lagi
+    copyChunkRecords(chunk->cubes, data, *cooked, CHUNK_CUBES);
+    std::vector<CookedRamp> cookedRamps;
+    copyChunkRecords(cookedRamps, data, *cooked, CHUNK_RAMPS);
+    for (const auto& r : cookedRamps) chunk->ramps.push_back({r.x, r.y, r.z, r.sizeX, r.sizeY, r.sizeZ, (char)r.axis});
+    copyChunkRecords(chunk->bushes, data, *cooked, CHUNK_BUSHES);
+    copyChunkRecords(chunk->trees, data, *cooked, CHUNK_TREES);
+    copyChunkRecords(chunk->rocks, data, *cooked, CHUNK_ROCKS);
+    copyChunkRecords(chunk->coins, data, *cooked, CHUNK_COINS);
+    for (uint32_t i = 0; i < cooked->count[CHUNK_COINS]; ++i) chunk->coinIds.push_back((int)(cooked->first[CHUNK_COINS] + i));
+    return chunk;
+}
+
+// Jalan di thread latar: hanya membaca data level (tidak dilepas selama ada
+// jendela pending) dan chunk resident yang immutable, tidak menyentuh state arena
+static LevelWindow loadLevelWindow(const char* data, float originX, float originZ, std::vector<LevelChunkPtr> reuse) {
+    PROFILE_ZONE("loadLevelWindow");
+    LevelWindow window;
+    window.originX = originX;
+    window.originZ = originZ;
+    window.chunksLoaded = 0;
+    int cx0 = chunkCoord(originX) - LEVEL_WINDOW_CHUNKS / 2;
+    int cz0 = chunkCoord(originZ) - LEVEL_WINDOW_CHUNKS / 2;
+    for (int cz = cz0; cz < cz0 + LEVEL_WINDOW_CHUNKS; ++cz) {
+        for (int cx = cx0; cx < cx0 + LEVEL_WINDOW_CHUNKS; ++cx) {
+            auto it = std::find_if(reuse.begin(), reuse.end(),
+                                   [cx, cz](const LevelChunkPtr& c) { return c->cx == cx && c->cz == cz; });
+            if (it != reuse.end()) {
+                window.chunks.push_back(*it);
+            } else {
+                window.chunks.push_back(loadLevelChunk(data, cx, cz));
+                ++window.chunksLoaded;
+            }
+        }
+    }
+    std::vector<ArenaCube> windowCubes;
+    std::vector<ArenaRamp> windowRamps;
+    for (const auto& c : window.chunks) {
+        windowCubes.insert(windowCubes.end(), c->cubes.begin(), c->cubes.end());
+        windowRamps.insert(windowRamps.end(), c->ramps.begin(), c->ramps.end());
+    }
+    window.heights.resize(GRID_SIZE * GRID_SIZE);
+    rasterizeArenaHeights(windowCubes, windowRamps, (float(*)[GRID_SIZE])window.heights.data(), originX, originZ);
+    return window;
+}
+
+static void storeResidentCoins() {
+    if (residentCoinIds.size() != coins.size()) return;
+    for (size_t i = 0; i < coins.size(); ++i) levelCoinCollected[residentCoinIds[i]] = coins[i].collected;
+}
+
+// Record satu jenis dari chunk jendela, disambung urut chunk (cz, cx). remap[lama]
+// = index baru record chunk yang tetap resident atau -1, added = index record chunk
+// yang baru masuk; urutan chunk selalu naik, jadi record yang tetap tidak bertukar urutan.
+template <typename T>
+static void windowRecords(const LevelWindow& window, std::vector<T> LevelChunk::*records,
+                          std::vector<T>& out, std::vector<int>& remap, std::vector<int>& added) {
+    out.clear();
+    remap.clear();
+    added.clear();
+    for (const auto& c : residentChunks) {
+        auto it = std::find(window.chunks.begin(), window.chunks.end(), c);
+        int first = -1;
+        if (it != window.chunks.end()) {
+            first = 0;
+            for (auto before = window.chunks.begin(); before != it; ++before) first += (int)((**before).*records).size();
+        }
+        for (size_t k = 0; k < ((*c).*records).size(); ++k) remap.push_back(first < 0 ? -1 : first + (int)k);
+    }
+    for (const auto& c : window.chunks) {
+        bool resident = std::find(residentChunks.begin(), residentChunks.end(), c) != residentChunks.end();
+        for (size_t k = 0; k < ((*c).*records).size(); ++k) {
+            if (!resident) added.push_back((int)out.size());
+            out.push_back(((*c).*records)[k]);
+        }
+    }
+}
+
+// Jendela pertama, setelah edit runtime, atau untuk benchmark: semua dibangun dari nol
+static void installFullWindow(const LevelWindow& window) {
+    arenaOriginX = window.originX;
+    arenaOriginZ = window.originZ;
+    clearArenaGeometry();
+    for (const auto& c : window.chunks) {
+        cubes.insert(cubes.end(), c->cubes.begin(), c->cubes.end());
+        ramps.insert(ramps.end(), c->ramps.begin(), c->ramps.end());
+        bushes.insert(bushes.end(), c->bushes.begin(), c->bushes.end());
+        trees.insert(trees.end(), c->trees.begin(), c->trees.end());
+        rocks.insert(rocks.end(), c->rocks.begin(), c->rocks.end());
+    }
+    memcpy(arenaHeights, window.heights.data(), sizeof(arenaHeights));
+    finalizeArenaGeometry();
+}
+
+// Jendela bergeser: chunk yang tetap resident membawa cell heightfield dan cell grid
+// solid-nya (shiftArenaWindow), hanya chunk yang masuk/keluar yang diproses. Prop
+// cukup disambung ulang, struktur turunannya murah.
+static void installWindowDelta(const LevelWindow& window) {
+    static std::vector<ArenaCube> newCubes;
+    static std::vector<ArenaRamp> newRamps;
+    static std::vector<int> cubeRemap, cubeAdded, rampRemap, rampAdded, propRemap, propAdded;
+    windowRecords(window, &LevelChunk::cubes, newCubes, cubeRemap, cubeAdded);
+    windowRecords(window, &LevelChunk::ramps, newRamps, rampRemap, rampAdded);
+    clearCoins();
+    shiftArenaWindow(window.originX, window.originZ, newCubes, cubeRemap, cubeAdded, newRamps, rampRemap, rampAdded,
+                     (const float(*)[GRID_SIZE])window.heights.data());
+    windowRecords(window, &LevelChunk::bushes, bushes, propRemap, propAdded);
+    windowRecords(window, &LevelChunk::trees, trees, propRemap, propAdded);
+    windowRecords(window, &LevelChunk::rocks, rocks, propRemap, propAdded);
+    const unsigned props = (1u << CULL_BUSH) | (1u << CULL_TREE) | (1u << CULL_ROCK);
+    rebuildArenaBounds(props);
+    rebuildArenaCullGrid(props);
+    rebuildArenaLod((1u << CULL_KIND_COUNT) - 1);
+}
+
+static void installLevelWindow(const LevelWindow& window) {
+    PROFILE_ZONE("installLevelWindow");
+    auto start = std::chrono::steady_clock::now();
+    storeResidentCoins();
+    // Edit runtime (addArenaCube, ...) mengubah arena di luar isi chunk
+    bool delta = streamIncremental && !residentChunks.empty() && arenaSolidVersion() == installedSolidVersion;
+    if (delta) installWindowDelta(window);
+    else installFullWindow(window);
+    residentCoinIds.clear();
+    for (const auto& c : window.chunks) {
+        for (size_t i = 0; i < c->coins.size(); ++i) {
+            addCoin(c->coins[i].x, c->coins[i].z);
+            coins.back().collected = levelCoinCollected[c->coinIds[i]];
+            residentCoinIds.push_back(c->coinIds[i]);
+        }
+    }
+    // Serial baru untuk chunk yang isinya di arena baru dipasang
+    std::vector<LevelChunkKey> keys;
+    for (const auto& c : window.chunks) {
+        auto it = std::find(residentChunks.begin(), residentChunks.end(), c);
+        if (delta && it != residentChunks.end()) keys.push_back(residentKeys[it - residentChunks.begin()]);
+        else keys.push_back({c->cx, c->cz, ++nextChunkSerial == 0 ? ++nextChunkSerial : nextChunkSerial});
+    }
+    residentKeys.swap(keys);
+    residentChunks = window.chunks;
+    installedSolidVersion = arenaSolidVersion();
+    streamChanges |= ((1u << CULL_KIND_COUNT) - 1) | ARENA_CHANGED_COINS | ARENA_CHANGED_ORIGIN;
+    streamStats.windowsInstalled++;
+    streamStats.chunksLoaded += window.chunksLoaded;
+    streamStats.residentChunks = (int)residentChunks.size();
+    streamStats.lastInstallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void discardPendingWindow() {
+    if (!windowPending) return;
+    pendingWindow.wait();
+    pendingWindow = std::future<LevelWindow>();
+    windowPending = false;
+}
+
+static void requestLevelWindow(float originX, float originZ) {
+    pendingOriginX = originX;
+    pendingOriginZ = originZ;
+    const char* data = levelData;
+    std::vector<LevelChunkPtr> reuse = residentChunks;
+    pendingWindow = std::async(std::launch::async, [data, originX, originZ, reuse]() {
+        setProfileThreadName("level stream");
+        return loadLevelWindow(data, originX, originZ, reuse);
+    });
+    windowPending = true;
+}
+
+static void resetLevelStreaming() {
+    discardPendingWindow();
+    residentChunks.clear();
+    residentKeys.clear();
+    residentCoinIds.clear();
+    levelCoinCollected.clear();
+    streamActive = false;
+    arenaOriginX = 0.0f;
+    arenaOriginZ = 0.0f;
+}
+
+// Marble di luar area aman jendela (mis. respawn ke checkpoint jauh): pasang
+// jendela yang benar sekarang juga, tanpa menunggu frame berikutnya
+static bool outsideLevelWindow(float x, float z) {
+    const float safe = BOUNDS - 0.5f * levelChunkSize;
+    return fabsf(x - arenaOriginX) > safe || fabsf(z - arenaOriginZ) > safe;
+}
+
+// keepCoins: status collected per coin level yang dipertahankan (hot reload)
+static void startLevelStream(const char* data, float originX, float originZ, const std::vector<bool>* keepCoins) {
+    resetLevelStreaming();
+    streamActive = true;
+    streamStats = {0, 0, 0, 0.0};
+    levelCoinCollected.assign(((const CookedHeader*)data)->sections[SECTION_COINS].count, false);
+    if (keepCoins && keepCoins->size() == levelCoinCollected.size()) levelCoinCollected = *keepCoins;
+    installLevelWindow(loadLevelWindow(data, originX, originZ, {}));
+}
+
+static void applyStreamedLevel(const char* data) {
+    applyCookedCheckpoints(data);
+    // Jendela pertama di sekitar spawn (sama dengan resetMarble)
+    float spawnX = checkpoints.empty() ? 0.0f : checkpoints[0].x;
+    float spawnZ = checkpoints.empty() ? -BOUNDS + 2.0f : checkpoints[0].z;
+    startLevelStream(data, chunkCorner(spawnX), chunkCorner(spawnZ), nullptr);
+}
+
+unsigned updateLevelStreaming(float x, float z, bool wait) {
+    if (!streamActive) return 0;
+    float originX = windowOriginFor(x, arenaOriginX);
+    float originZ = windowOriginFor(z, arenaOriginZ);
+    bool urgent = wait || outsideLevelWindow(x, z);
+    if (windowPending &&
+        (urgent || pendingWindow.wait_for(std::chrono::seconds(0)) == std::future_status::ready)) {
+        LevelWindow window = pendingWindow.get();
+        windowPending = false;
+        // Jendela basi (marble sudah pindah lagi) dibuang, minta yang baru
+        if (window.originX == originX && window.originZ == originZ) installLevelWindow(window);
+    }
+    if (!windowPending && (originX != arenaOriginX || originZ != arenaOriginZ)) {
+        requestLevelWindow(originX, originZ);
+        if (urgent) {
+            installLevelWindow(pendingWindow.get());
+            windowPending = false;
+        }
+    }
+    unsigned changes = streamChanges;
+    streamChanges = 0;
+    return changes;
+}
+
+void ensureLevelWindow(float x, float z) {
+    if (!streamActive || !outsideLevelWindow(x, z)) return;
+    discardPendingWindow();
+    installLevelWindow(loadLevelWindow(levelData, chunkCorner(x), chunkCorner(z), residentChunks));
+}
+
+bool isLevelStreamed() {
+    return streamActive;
+}
+
+const std::vector<LevelChunkKey>& residentLevelChunks() {
+    return residentKeys;
+}
+
+void setLevelStreamIncremental(bool enabled) {
+    streamIncremental = enabled;
+}
+
+LevelStreamStats levelStreamStats() {
+    return streamStats;
+}
+
+// Pasang level cooked yang sudah divalidasi. Tidak ada parsing: array disalin,
+// heightfield di-memcpy, lalu struktur turunan (grid, bounds, cull, LOD) dibangun.
+static void applyCookedArena(const char* data) {
+    const CookedHeader* header = (const CookedHeader*)data;
+    const CookedSection* sec = header->sections;
+    resetLevelStreaming();
+    clearArenaGeometry();
+    const ArenaCube* cubeData = (const ArenaCube*)(data + sec[SECTION_CUBES].offset);
+    cubes.assign(cubeData, cubeData + sec[SECTION_CUBES].count);
+    const CookedRamp* rampData = (const CookedRamp*)(data + sec[SECTION_RAMPS].offset);
+    ramps.reserve(sec[SECTION_RAMPS].count);
+    for (uint32_t i = 0; i < sec[SECTION_RAMPS].count; ++i) {
+        const CookedRamp& r = rampData[i];
+        ramps.push_back({r.x, r.y, r.z, r.sizeX, r.sizeY, r.sizeZ, (char)r.axis});
+    }
+    const ArenaBush* bushData = (const ArenaBush*)(data + sec[SECTION_BUSHES].offset);
+    bushes.assign(bushData, bushData + sec[SECTION_BUSHES].count);
+    const ArenaTree* treeData = (const ArenaTree*)(data + sec[SECTION_TREES].offset);
+    trees.assign(treeData, treeData + sec[SECTION_TREES].count);
+    const ArenaRock* rockData = (const ArenaRock*)(data + sec[SECTION_ROCKS].offset);
+    rocks.assign(rockData, rockData + sec[SECTION_ROCKS].count);
+    memcpy(arenaHeights, data + sec[SECTION_HEIGHTS].offset, sizeof(arenaHeights));
+    finalizeArenaGeometry();
+
+    const CookedPoint* coinData = (const CookedPoint*)(data + sec[SECTION_COINS].offset);
+    coins.reserve(sec[SECTION_COINS].count);
+    for (uint32_t i = 0; i < sec[SECTION_COINS].count; ++i) addCoin(coinData[i].x, coinData[i].z);
+}
+
+static void applyCooked(const char* data) {
+    if (isStreamedLevel(data)) {
+        applyStreamedLevel(data);
+        return;
+    }
+    applyCookedArena(data);
+    applyCookedCheckpoints(data);
+}
+
+// ---------------------------------------------------------------------------
+// Format teks: satu objek per baris, '#' sampai akhir baris = komentar.
+//   cube x y z sizeX sizeY sizeZ
+//   ramp x y z sizeX sizeY sizeZ x|z
+//   bush x y z radius
+//   tree x y z trunkHeight trunkRadius foliageRadius
+//   rock x y z scale
+//   checkpoint x z [bonusMinutes]   (urutan baris = urutan checkpoint, yang pertama spawn)
+//   finish x z
+//   coin x z                        (tinggi coin mengikuti tanah)
+//   hazard x y z sizeX sizeY sizeZ  (box yang me-respawn marble, lihat checkpoint.h)
+// ---------------------------------------------------------------------------
+static bool readFloats(const char*& p, float* out, int count) {
+    for (int i = 0; i < count; ++i) {
+        char* end;
+        out[i] = strtof(p, &end);
+        if (end == p) return false;
+        p = end;
+    }
+    return true;
+}
+
+static bool onlySpace(const char* p) {
+    while (*p == ' ' || *p == '\t' || *p == '\r') ++p;
+    return *p == '\0';
+}
+
+static bool parseLevelLine(const char* line, LevelSource& src, std::string& error) {
+    while (*line == ' ' || *line == '\t') ++line;
+    if (*line == '\0' || *line == '\r') return true;
+    char keyword[16];
+    int used = 0;
+    while (line[used] && line[used] != ' ' && line[used] != '\t' && line[used] != '\r' && used < 15) {
+        keyword[used] = line[used];
+        ++used;
+    }
+    keyword[used] = '\0';
+    const char* p = line + used;
+    float v[6];
+    if (strcmp(keyword, "cube") == 0) {
+        if (!readFloats(p, v, 6)) { error = "cube needs x y z sizeX sizeY sizeZ"; return false; }
+        if (v[3] <= 0.0f || v[4] <= 0.0f || v[5] <= 0.0f) { error = "cube size must be positive"; return false; }
+        src.cubes.push_back({v[0], v[1], v[2], v[3], v[4], v[5]});
+    } else if (strcmp(keyword, "ramp") == 0) {
+        char axis[4];
+        int n = 0;
+        if (!readFloats(p, v, 6) || sscanf(p, "%3s%n", axis, &n) != 1 || (strcmp(axis, "x") != 0 && strcmp(axis, "z") != 0)) {
+            error = "ramp needs x y z sizeX sizeY sizeZ x|z";
+            return false;
+        }
+        if (v[3] <= 0.0f || v[4] <= 0.0f || v[5] <= 0.0f) { error = "ramp size must be positive"; return false; }
+        p += n;
+        src.ramps.push_back({v[0], v[1], v[2], v[3], v[4], v[5], axis[0]});
+    } else if (strcmp(keyword, "bush") == 0) {
+        if (!readFloats(p, v, 4)) { error = "bush needs x y z radius"; return false; }
+        src.bushes.push_back({v[0], v[1], v[2], v[3]});
+    } else if (strcmp(keyword, "tree") == 0) {
+        if (!readFloats(p, v, 6)) { error = "tree needs x y z trunkHeight trunkRadius foliageRadius"; return false; }
+        src.trees.push_back({v[0], v[1], v[2], v[3], v[4], v[5]});
+    } else if (strcmp(keyword, "rock") == 0) {
+        if (!readFloats(p, v, 4)) { error = "rock needs x y z scale"; return false; }
+        src.rocks.push_back({v[0], v[1], v[2], v[3]});
+    } else if (strcmp(keyword, "checkpoint") == 0) {
+        if (!readFloats(p, v, 2)) { error = "checkpoint needs x z [bonusMinutes]"; return false; }
+        v[2] = 1.0f;
+        if (!onlySpace(p) && !readFloats(p, v + 2, 1)) { error = "checkpoint bonusMinutes must be a number"; return false; }
+        src.checkpoints.push_back({v[0], v[1], v[2]});
+    } else if (strcmp(keyword, "finish") == 0) {
+        if (!readFloats(p, v, 2)) { error = "finish needs x z"; return false; }
+        if (!src.finish.empty()) { error = "only one finish per level"; return false; }
+        src.finish.push_back({v[0], 0.0f, v[1]});
+    } else if (strcmp(keyword, "coin") == 0) {
+        if (!readFloats(p, v, 2)) { error = "coin needs x z"; return false; }
+        src.coins.push_back({v[0], 0.0f, v[1]});
+    } else if (strcmp(keyword, "hazard") == 0) {
+        if (!readFloats(p, v, 6)) { error = "hazard needs x y z sizeX sizeY sizeZ"; return false; }
+        if (v[3] <= 0.0f || v[4] <= 0.0f || v[5] <= 0.0f) { error = "hazard size must be positive"; return false; }
+        src.hazards.push_back({v[0], v[1], v[2], v[3], v[4], v[5]});
+    } else {
+        error = std::string("unknown keyword '") + keyword + "'";
+        return false;
+    }
+    if (!onlySpace(p)) {
+        error = std::string("extra values after ") + keyword;
+        return false;
+    }
+    return true;
+}
+
+static bool parseLevelText(const char* path, const char* text, size_t size, LevelSource& src) {
+    std::string line;
+    int lineNumber = 0;
+    size_t pos = 0;
+    while (pos < size) {
+        size_t end = pos;
+        while (end < size && text[end] != '\n') ++end;
+        line.assign(text + pos, end - pos);
+        pos = end + 1;
+        ++lineNumber;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) line.resize(comment);
+        std::string error;
+        if (!parseLevelLine(line.c_str(), src, error)) {
+            levelError = std::string(path) + ":" + std::to_string(lineNumber) + ": " + error;
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool insideArena(float x, float z) {
+    return x >= -BOUNDS && x <= BOUNDS && z >= -BOUNDS && z <= BOUNDS;
+}
+
+// Level muat di satu arena kalau titik tengah semua objek di dalam +-BOUNDS (dinding
+// tepi boleh menonjol keluar, seperti level bawaan); kalau tidak, jadi level streaming
+static bool levelFitsArena(const LevelSource& src) {
+    for (const auto& c : src.cubes) if (!insideArena(c.x, c.z)) return false;
+    for (const auto& r : src.ramps) if (!insideArena(r.x, r.z)) return false;
+    for (const auto& b : src.bushes) if (!insideArena(b.x, b.z)) return false;
+    for (const auto& t : src.trees) if (!insideArena(t.x, t.z)) return false;
+    for (const auto& r : src.rocks) if (!insideArena(r.x, r.z)) return false;
+    for (const auto& c : src.checkpoints) if (!insideArena(c.x, c.z)) return false;
+    for (const auto& p : src.finish) if (!insideArena(p.x, p.z)) return false;
+    for (const auto& p : src.coins) if (!insideArena(p.x, p.z)) return false;
+    for (const auto& h : src.hazards) if (!insideArena(h.x, h.z)) return false;
+    return true;
+}
+
+static std::pair<int, int> chunkKey(float x, float z) {
+    return std::make_pair(chunkCoord(z), chunkCoord(x));
+}
+
+// Urutkan record per chunk (stabil, urutan dalam chunk tetap) dan catat range-nya
+template <typename T>
+static void sortIntoChunks(std::vector<T>& records, ChunkKind kind, std::vector<CookedChunk>& chunks) {
+    std::stable_sort(records.begin(), records.end(),
+                     [](const T& a, const T& b) { return chunkKey(a.x, a.z) < chunkKey(b.x, b.z); });
+    for (uint32_t i = 0; i < records.size(); ++i) {
+        std::pair<int, int> key = chunkKey(records[i].x, records[i].z);
+        auto it = std::lower_bound(chunks.begin(), chunks.end(), key,
+            [](const CookedChunk& c, const std::pair<int, int>& k) { return std::make_pair((int)c.cz, (int)c.cx) < k; });
+        if (it == chunks.end() || it->cz != key.first || it->cx != key.second) {
+            CookedChunk chunk;
+            memset(&chunk, 0, sizeof(chunk));
+            chunk.cz = key.first;
+            chunk.cx = key.second;
+            it = chunks.insert(it, chunk);
+        }
+        if (it->count[kind] == 0) it->first[kind] = i;
+        it->count[kind]++;
+    }
+}
+
+// Level teks ke blob berformat cooked. Heightfield dirasterisasi sama seperti
+// CreateCube/CreateRamp, tanpa menyentuh state arena yang sedang dipakai.
+static void cookLevelSource(const LevelSource& source, std::vector<char>& blob) {
+    LevelSource src = source;
+    std::vector<float> heights;
+    std::vector<CookedChunk> chunks;
+    if (levelFitsArena(src)) {
+        heights.resize(GRID_SIZE * GRID_SIZE);
+        rasterizeArenaHeights(src.cubes, src.ramps, (float(*)[GRID_SIZE])heights.data(), 0.0f, 0.0f);
+    } else {
+        sortIntoChunks(src.cubes, CHUNK_CUBES, chunks);
+        sortIntoChunks(src.ramps, CHUNK_RAMPS, chunks);
+        sortIntoChunks(src.bushes, CHUNK_BUSHES, chunks);
+        sortIntoChunks(src.trees, CHUNK_TREES, chunks);
+        sortIntoChunks(src.rocks, CHUNK_ROCKS, chunks);
+        sortIntoChunks(src.coins, CHUNK_COINS, chunks);
+    }
+    std::vector<CookedRamp> cookedRamps;
+    for (const auto& r : src.ramps) cookedRamps.push_back({r.x, r.y, r.z, r.sizeX, r.sizeY, r.sizeZ, (int32_t)r.axis});
+
+    const void* sectionData[SECTION_COUNT] = {
+        src.cubes.data(), cookedRamps.data(), src.bushes.data(), src.trees.data(), src.rocks.data(),
+        src.checkpoints.data(), src.finish.data(), src.coins.data(), heights.data(), chunks.data(),
+        src.hazards.data()
+    };
+    uint32_t sectionCount[SECTION_COUNT] = {
+        (uint32_t)src.cubes.size(), (uint32_t)cookedRamps.size(), (uint32_t)src.bushes.size(),
+        (uint32_t)src.trees.size(), (uint32_t)src.rocks.size(), (uint32_t)src.checkpoints.size(),
+        (uint32_t)src.finish.size(), (uint32_t)src.coins.size(), (uint32_t)heights.size(), (uint32_t)chunks.size(),
+        (uint32_t)src.hazards.size()
+    };
+    CookedHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, cookedMagic, sizeof(cookedMagic));
+    header.version = cookedVersion;
+    header.gridSize = GRID_SIZE;
+    header.bounds = BOUNDS;
+    uint32_t offset = sizeof(CookedHeader);
+    for (int s = 0; s < SECTION_COUNT; ++s) {
+        header.sections[s].offset = offset;
+        header.sections[s].count = sectionCount[s];
+        offset += sectionCount[s] * sectionRecordSize[s];
+    }
+    blob.assign(offset, 0);
+    memcpy(blob.data(), &header, sizeof(header));
+    for (int s = 0; s < SECTION_COUNT; ++s) {
+        if (sectionCount[s] > 0) {
+            memcpy(blob.data() + header.sections[s].offset, sectionData[s], sectionCount[s] * sectionRecordSize[s]);
+        }
+    }
+}
+
+static bool loadLevelText(const char* path, const MappedFile& file, std::vector<char>& blob) {
+    LevelSource src;
+    if (!parseLevelText(path, file.data, file.size, src)) return false;
+    cookLevelSource(src, blob);
+    return true;
+}
+
+// Baca file level: cooked tetap di-map (mapping), teks di-cook ke blob
+static const char* readLevel(const char* path, MappedFile& mapping, std::vector<char>& blob, bool& cooked) {
+    MappedFile file;
+    if (!mapFile(path, file)) {
+        levelError = std::string("cannot open ") + path;
+        return nullptr;
+    }
+    cooked = isCooked(file.data, file.size);
+    if (cooked) {
+        if (!validateCooked(file.data, file.size)) {
+            levelError = std::string(path) + ": " + levelError;
+            unmapFile(file);
+            return nullptr;
+        }
+        mapping = file;
+        return mapping.data;
+    }
+    bool ok = loadLevelText(path, file, blob);
+    unmapFile(file);
+    return ok ? blob.data() : nullptr;
+}
+
+static void releaseCurrentLevel() {
+    discardPendingWindow(); // Thread streaming masih membaca data level lama
+    unmapFile(levelMapping);
+    std::vector<char>().swap(levelBlob);
+    levelData = nullptr;
+}
+
+static void installLevel(const char* path, MappedFile& mapping, std::vector<char>& blob, bool cooked) {
+    releaseCurrentLevel();
+    if (cooked) {
+        levelMapping = mapping;
+        levelData = levelMapping.data;
+    } else {
+        levelBlob.swap(blob);
+        levelData = levelBlob.data();
+    }
+    levelName = path;
+    levelError.clear();
+}
+
+bool loadLevelFile(const char* path) {
+    auto start = std::chrono::steady_clock::now();
+    MappedFile mapping;
+    std::vector<char> blob;
+    bool cooked = false;
+    if (!readLevel(path, mapping, blob, cooked)) return false;
+    installLevel(path, mapping, blob, cooked);
+    const CookedSection* sec = ((const CookedHeader*)levelData)->sections;
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Level " << path << " loaded (" << (cooked ? "cooked" : "text") << "): "
+              << sec[SECTION_CUBES].count + sec[SECTION_RAMPS].count + sec[SECTION_BUSHES].count +
+                 sec[SECTION_TREES].count + sec[SECTION_ROCKS].count << " objects, "
+              << sec[SECTION_CHECKPOINTS].count << " checkpoints, " << sec[SECTION_COINS].count << " coins, ";
+    if (sec[SECTION_HAZARDS].count > 0) std::cout << sec[SECTION_HAZARDS].count << " hazards, ";
+    if (sec[SECTION_CHUNKS].count > 0) std::cout << "streamed in " << sec[SECTION_CHUNKS].count << " chunks, ";
+    std::cout << ms << " ms" << std::endl;
+    return true;
+}
+
+bool cookLevelFile(const char* textPath, const char* cookedPath) {
+    MappedFile file;
+    if (!mapFile(textPath, file)) {
+        levelError = std::string("cannot open ") + textPath;
+        return false;
+    }
+    std::vector<char> blob;
+    bool ok = false;
+    if (isCooked(file.data, file.size)) {
+        levelError = std::string(textPath) + " is already cooked";
+    } else {
+        ok = loadLevelText(textPath, file, blob);
+    }
+    unmapFile(file);
+    if (!ok) return false;
+    // Tulis ke file sementara lalu rename: game yang sedang me-map file lama
+    // (hot reload) tetap membaca isi lama sampai pindah ke file baru
+    std::string tempPath = std::string(cookedPath) + ".tmp";
+    FILE* out = fopen(tempPath.c_str(), "wb");
+    if (!out) {
+        levelError = std::string("cannot write ") + tempPath;
+        return false;
+    }
+    bool written = fwrite(blob.data(), 1, blob.size(), out) == blob.size();
+    written = fclose(out) == 0 && written;
+#ifdef _WIN32
+    written = written && MoveFileExA(tempPath.c_str(), cookedPath, MOVEFILE_REPLACE_EXISTING);
+#else
+    written = written && rename(tempPath.c_str(), cookedPath) == 0;
+#endif
+    if (!written) {
+        remove(tempPath.c_str());
+        levelError = std::string("failed writing ") + cookedPath;
+        return false;
+    }
+    std::cout << "Cooked " << textPath << " -> " << cookedPath << " (" << blob.size() << " bytes)" << std::endl;
+    return true;
+}
+
+void useBuiltinLevel() {
+    releaseCurrentLevel();
+    levelName = "builtin";
+}
+
+const char* currentLevelName() {
+    return levelName.c_str();
+}
+
+const char* levelLoadError() {
+    return levelError.c_str();
+}
+
+void applyCurrentLevel() {
+    if (levelData) {
+        applyCooked(levelData);
+        return;
+    }
+    resetLevelStreaming();
+    setupArenaGeometry();
+    clearCheckpoints();
+    setupCheckpoints();
+}
+
+// ---------------------------------------------------------------------------
+// Hot reload: file level aktif dipantau (inotify di Linux, selain itu cek mtime
+// dan ukuran), lalu hanya jenis objek yang berubah yang dipasang ulang. Marble,
+// timer, dan progress checkpoint (kalau jumlahnya sama) tidak direset.
+// ---------------------------------------------------------------------------
+static const float hotReloadPollSeconds = 0.25f; // Interval cek mtime tanpa inotify
+
+static bool hotReloadEnabled = false;
+static std::string watchedPath;
+static long long watchedStamp = -1;
+static std::chrono::steady_clock::time_point lastWatchPoll;
+#ifdef __linux__
+static int watchFd = -1;
+static std::string watchedFileName;
+#endif
+
+static long long fileStamp(const char* path) {
+    struct stat st;
+    if (stat(path, &st) != 0) return -1;
+    return (long long)st.st_mtime * 1000003LL + (long long)st.st_size;
+}
+
+static void watchLevel(const std::string& path) {
+    watchedPath = path;
+    watchedStamp = fileStamp(path.c_str());
+    lastWatchPoll = std::chrono::steady_clock::now();
+#ifdef __linux__
+    if (watchFd >= 0) close(watchFd);
+    watchFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (watchFd < 0) return;
+    // Pantau direktorinya: editor sering menyimpan lewat file baru + rename
+    size_t slash = path.find_last_of('/');
+    std::string dir = slash == std::string::npos ? "." : path.substr(0, slash + 1);
+    watchedFileName = slash == std::string::npos ? path : path.substr(slash + 1);
+    if (inotify_add_watch(watchFd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        close(watchFd);
+        watchFd = -1;
+    }
+#endif
+}
+
+static void unwatchLevel() {
+    watchedPath.clear();
+#ifdef __linux__
+    if (watchFd >= 0) close(watchFd);
+    watchFd = -1;
+#endif
+}
+
+static bool watchedFileChanged() {
+#ifdef __linux__
+    if (watchFd >= 0) {
+        alignas(struct inotify_event) char buffer[4096];
+        bool changed = false;
+        ssize_t n;
+        while ((n = read(watchFd, buffer, sizeof(buffer))) > 0) {
+            for (char* p = buffer; p < buffer + n;) {
+                const struct inotify_event* event = (const struct inotify_event*)p;
+                if (event->len > 0 && watchedFileName == event->name) changed = true;
+                p += sizeof(struct inotify_event) + event->len;
+            }
+        }
+        return changed;
+    }
+#endif
+    auto now = std::chrono::steady_clock::now();
+    if (std::chrono::duration<float>(now - lastWatchPoll).count() < hotReloadPollSeconds) return false;
+    lastWatchPoll = now;
+    long long stamp = fileStamp(watchedPath.c_str());
+    if (stamp == watchedStamp) return false;
+    watchedStamp = stamp;
+    return stamp >= 0;
+}
+
+void setLevelHotReload(bool enabled) {
+    hotReloadEnabled = enabled;
+    if (!enabled) unwatchLevel();
+}
+
+bool isLevelHotReloadEnabled() {
+    return hotReloadEnabled;
+}
+
+template <typename T>
+static bool sameRecords(const std::vector<T>& current, const char* data, const CookedSection& sec) {
+    return current.size() == sec.count && (sec.count == 0 || memcmp(current.data(), data + sec.offset, sec.count * sizeof(T)) == 0);
+}
+
+static bool sameRamps(const char* data, const CookedSection& sec) {
+    if (ramps.size() != sec.count) return false;
+    const CookedRamp* r = (const CookedRamp*)(data + sec.offset);
+    for (uint32_t i = 0; i < sec.count; ++i) {
+        const ArenaRamp& a = ramps[i];
+        if (a.x != r[i].x || a.y != r[i].y || a.z != r[i].z || a.sizeX != r[i].sizeX || a.sizeY != r[i].sizeY ||
+            a.sizeZ != r[i].sizeZ || a.axis != (char)r[i].axis) return false;
+    }
+    return true;
+}
+
+static bool sameCheckpoints(const char* data, const CookedSection* sec) {
+    if (checkpointData.size() != sec[SECTION_CHECKPOINTS].count) return false;
+    const CookedCheckpoint* cp = (const CookedCheckpoint*)(data + sec[SECTION_CHECKPOINTS].offset);
+    for (uint32_t i = 0; i < sec[SECTION_CHECKPOINTS].count; ++i) {
+        const CheckpointData& c = checkpointData[i];
+        if (c.position.x != cp[i].x || c.position.z != cp[i].z || c.bonusMinutes != cp[i].bonusMinutes) return false;
+    }
+    if (finishSet != (sec[SECTION_FINISH].count == 1)) return false;
+    if (!sameRecords(hazards, data, sec[SECTION_HAZARDS])) return false;
+    const CookedPoint* finish = (const CookedPoint*)(data + sec[SECTION_FINISH].offset);
+    return !finishSet || (finishPosition.x == finish->x && finishPosition.z == finish->z);
+}
+
+template <typename T>
+static void assignRecords(std::vector<T>& out, const char* data, const CookedSection& sec) {
+    const T* first = (const T*)(data + sec.offset);
+    out.assign(first, first + sec.count);
+}
+
+// Checkpoint/finish dari level baru; kalau cuma digeser, progress pemain tetap
+static unsigned reapplyCheckpoints(const char* data) {
+    if (sameCheckpoints(data, ((const CookedHeader*)data)->sections)) return 0;
+    std::vector<bool> collected = checkpointCollected;
+    int active = activeCheckpointIndex;
+    bool reached = finishReached;
+    applyCookedCheckpoints(data);
+    if (collected.size() == checkpointCollected.size()) {
+        checkpointCollected = collected;
+        activeCheckpointIndex = active;
+        finishReached = reached && finishSet;
+    }
+    return ARENA_CHANGED_CHECKPOINTS;
+}
+
+// Pasang hanya bagian level yang berbeda dari state sekarang
+static unsigned applyCookedChanges(const char* data) {
+    const CookedSection* sec = ((const CookedHeader*)data)->sections;
+    unsigned changed = 0;
+    if (!sameRecords(cubes, data, sec[SECTION_CUBES])) changed |= 1u << CULL_CUBE;
+    if (!sameRamps(data, sec[SECTION_RAMPS])) changed |= 1u << CULL_RAMP;
+    if (!sameRecords(bushes, data, sec[SECTION_BUSHES])) changed |= 1u << CULL_BUSH;
+    if (!sameRecords(trees, data, sec[SECTION_TREES])) changed |= 1u << CULL_TREE;
+    if (!sameRecords(rocks, data, sec[SECTION_ROCKS])) changed |= 1u << CULL_ROCK;
+
+    if (changed & ((1u << CULL_CUBE) | (1u << CULL_RAMP))) {
+        std::vector<ArenaCube> newCubes;
+        assignRecords(newCubes, data, sec[SECTION_CUBES]);
+        std::vector<ArenaRamp> newRamps;
+        const CookedRamp* r = (const CookedRamp*)(data + sec[SECTION_RAMPS].offset);
+        for (uint32_t i = 0; i < sec[SECTION_RAMPS].count; ++i) {
+            newRamps.push_back({r[i].x, r[i].y, r[i].z, r[i].sizeX, r[i].sizeY, r[i].sizeZ, (char)r[i].axis});
+        }
+        int cells = replaceArenaSolids(newCubes, newRamps, (const float(*)[GRID_SIZE])(data + sec[SECTION_HEIGHTS].offset));
+        std::cout << "Hot reload: " << cells << " heightfield cells rebuilt" << std::endl;
+    }
+    if (changed & (1u << CULL_BUSH)) assignRecords(bushes, data, sec[SECTION_BUSHES]);
+    if (changed & (1u << CULL_TREE)) assignRecords(trees, data, sec[SECTION_TREES]);
+    if (changed & (1u << CULL_ROCK)) assignRecords(rocks, data, sec[SECTION_ROCKS]);
+    // Bounds dan cull grid cube/ramp sudah ditambal replaceArenaSolids
+    unsigned props = changed & ~((1u << CULL_CUBE) | (1u << CULL_RAMP));
+    if (props) {
+        rebuildArenaBounds(props);
+        rebuildArenaCullGrid(props);
+        rebuildArenaLod(props);
+    }
+
+    // Tinggi coin ikut tanah, jadi dihitung ulang kalau coin atau cube/ramp berubah.
+    // Coin di posisi yang sama tetap berstatus sudah diambil.
+    std::vector<Coin> oldCoins = coins;
+    clearCoins();
+    const CookedPoint* coinData = (const CookedPoint*)(data + sec[SECTION_COINS].offset);
+    for (uint32_t i = 0; i < sec[SECTION_COINS].count; ++i) {
+        addCoin(coinData[i].x, coinData[i].z);
+        Coin& coin = coins.back();
+        if (i < oldCoins.size() && oldCoins[i].x == coin.x && oldCoins[i].z == coin.z) {
+            coin.collected = oldCoins[i].collected;
+            if (oldCoins[i].y == coin.y) continue;
+        }
+        changed |= ARENA_CHANGED_COINS;
+    }
+    if (coins.size() != oldCoins.size()) changed |= ARENA_CHANGED_COINS;
+
+    return changed | reapplyCheckpoints(data);
+}
+
+// Level streaming di-reload utuh: jendela dipasang ulang di origin yang sama dari
+// isi file baru (chunk resident lama berasal dari file lama), status coin tetap
+// kalau jumlah coin sama
+static unsigned reloadStreamedLevel(const char* path, MappedFile& mapping, std::vector<char>& blob, bool cooked) {
+    storeResidentCoins();
+    std::vector<bool> coinState = levelCoinCollected;
+    float originX = arenaOriginX, originZ = arenaOriginZ;
+    installLevel(path, mapping, blob, cooked);
+    if (isStreamedLevel(levelData)) {
+        startLevelStream(levelData, originX, originZ, &coinState);
+        streamChanges = 0;
+    } else {
+        applyCookedArena(levelData);
+    }
+    return ((1u << CULL_KIND_COUNT) - 1) | ARENA_CHANGED_COINS | ARENA_CHANGED_ORIGIN | reapplyCheckpoints(levelData);
+}
+
+unsigned pollLevelHotReload() {
+    if (!hotReloadEnabled || !levelData) return 0;
+    if (watchedPath != levelName) {
+        watchLevel(levelName); // Level baru (mis. ganti level), mulai pantau dari sini
+        return 0;
+    }
+    if (!watchedFileChanged()) return 0;
+    std::string path = levelName;
+    MappedFile mapping;
+    std::vector<char> blob;
+    bool cooked = false;
+    const char* data = readLevel(path.c_str(), mapping, blob, cooked);
+    if (!data) {
+        std::cout << "Hot reload failed, keeping current level: " << levelError << std::endl;
+        return 0;
+    }
+    if (streamActive || isStreamedLevel(data)) return reloadStreamedLevel(path.c_str(), mapping, blob, cooked);
+    unsigned changed = applyCookedChanges(data);
+    installLevel(path.c_str(), mapping, blob, cooked);
+    return changed;
+}
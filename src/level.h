@@ -0,0 +1,62 @@
+#ifndef LEVEL_H
+#define LEVEL_H
+
+#include <vector>
+
+// Level dari file: geometri arena, checkpoint, finish, dan coin.
+//  - Teks (.lvl) untuk authoring, satu objek per baris (lihat levels/arena1.lvl).
+//  - Cooked (.lvlc) biner hasil --cook: header + array record siap pakai plus
+//    heightfield, di-mmap lalu disalin langsung tanpa parsing.
+// Format dideteksi dari magic di awal file, bukan dari ekstensi.
+// Jadikan level aktif; baru terpasang di applyCurrentLevel (initSimulation).
+// Gagal = level sebelumnya tetap, alasan di levelLoadError. Level teks dirasterisasi
+// lewat state arena, jadi tetap panggil initSimulation sesudahnya.
+bool loadLevelFile(const char* path);
+bool cookLevelFile(const char* textPath, const char* cookedPath);
+void useBuiltinLevel();               // Level bawaan (setupArenaGeometry + setupCheckpoints)
+const char* currentLevelName();       // Path file, atau "builtin"
+const char* levelLoadError();
+
+// Hot reload level file: pollLevelHotReload dipanggil tiap frame, kalau file
+// level aktif berubah isinya dipasang tanpa reset marble/timer. Return mask
+// perubahan (lihat ARENA_CHANGED_* di arenacull.h), 0 = tidak ada yang berubah
+// atau file gagal dibaca (level lama tetap dipakai).
+void setLevelHotReload(bool enabled);
+bool isLevelHotReloadEnabled();
+unsigned pollLevelHotReload();
+
+// Level lebih besar dari arena (objek di luar +-BOUNDS) di-stream per chunk: hanya
+// jendela 4 x 4 chunk (= 80 x 80, lihat arenaOriginX/Z) sekitar marble yang dimuat.
+// updateLevelStreaming dipanggil tiap tick dengan posisi marble; chunk baru disiapkan
+// thread latar lalu dipasang begitu siap. wait = true menunggu sampai jendela yang
+// benar terpasang (hasil deterministik, untuk marble_sim). Return mask ARENA_CHANGED_*
+// seperti pollLevelHotReload, 0 kalau jendela tidak pindah.
+struct LevelStreamStats {
+    int windowsInstalled;
+    int chunksLoaded;      // Chunk yang disalin dari file (chunk resident dipakai ulang)
+    int residentChunks;
+    double lastInstallMs;  // Waktu memasang jendela terakhir di thread utama
+};
+unsigned updateLevelStreaming(float x, float z, bool wait);
+// Pasang jendela sekarang juga kalau (x, z) di luar jendela, mis. respawn ke checkpoint jauh
+void ensureLevelWindow(float x, float z);
+bool isLevelStreamed();
+LevelStreamStats levelStreamStats();
+// Chunk jendela yang terpasang, urut (cz, cx) sama dengan blok cull
+// (arenaCullBlockRange); kosong kalau level tidak di-stream. serial tetap selama
+// isi chunk di arena tidak dipasang ulang, jadi renderer cukup bake chunk yang
+// serial-nya baru (chunk masuk jendela, atau jendela dipasang utuh).
+struct LevelChunkKey {
+    int cx, cz;
+    unsigned serial;
+};
+const std::vector<LevelChunkKey>& residentLevelChunks();
+// false = tiap jendela dipasang utuh (clear + finalizeArenaGeometry), untuk benchmark.
+// Default true: chunk yang tetap resident tidak dibangun ulang (shiftArenaWindow).
+void setLevelStreamIncremental(bool enabled);
+
+// Pasang level aktif ke state arena + checkpoint (dipanggil initSimulation).
+// Untuk level file ini cuma salin array dan bangun ulang struktur turunan.
+void applyCurrentLevel();
+
+#endif // LEVEL_H
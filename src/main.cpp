@@ -10,29 +10,150 @@
 #include "checkpoint.h"
 #include "graphics.h" 
 #include "timer.h"
+#include "simulation.h"
+#include "level.h"
+#include "arenamesh.h"
+#include "propinstances.h"
+#include "inputrecord.h"
+#include "profiler.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Level yang bisa diganti dengan tombol 'n' (urut sesuai argumen)
+static std::vector<std::string> levelPaths;
+static int levelIndex = 0;
+static const char* recordPath = nullptr; // --record FILE
 
 void initGame() {
-    initKeyStates();
-    setupArenaGeometry();
-    setupCheckpoints();
-    resetMarbleInitialState();
-    score = 0; 
-    activeCheckpointIndex = -1;
-    resetMarble();
+    initSimulation();
     initGraphics();
-    resetTimer();
-    initCountdownTimer(60.0);
-    startTimer();
+}
+
+// Pindah ke level berikutnya tanpa restart: muat file, pasang ulang simulasi,
+// lalu bangun ulang cache render (instance prop + batch arena)
+void switchToNextLevel() {
+    if (levelPaths.empty()) return;
+    auto start = std::chrono::steady_clock::now();
+    int next = (levelIndex + 1) % (int)levelPaths.size();
+    if (!loadLevelFile(levelPaths[next].c_str())) {
+        printf("Level switch failed: %s\n", levelLoadError());
+        return;
+    }
+    levelIndex = next;
+    stopInputRecording(); // Rekaman hanya untuk satu level
+    initSimulation();
+    buildPropInstances();
+    bakeArenaMesh();
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    printf("Switched to %s in %.2f ms\n", currentLevelName(), ms);
+}
+
+// Dipanggil tiap tick timer. Kalau file level aktif berubah (--watch), pasang
+// perubahannya lalu bangun ulang hanya batch/instance jenis objek yang berubah
+void hotReloadLevel() {
+    PROFILE_ZONE("hotReloadLevel");
+    auto start = std::chrono::steady_clock::now();
+    unsigned changed = pollLevelHotReload();
+    if (!changed) return;
+    if (isInputRecording()) {
+        printf("Level changed on disk, stopping recording\n");
+        stopInputRecording();
+    }
+    int batches = rebakeArenaMesh(changed);
+    int propTypes = rebuildPropInstances(changed);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    printf("Hot reloaded %s in %.2f ms (change mask 0x%x, %d mesh batches, %d prop types rebuilt)\n",
+           currentLevelName(), ms, changed, batches, propTypes);
+}
+
+// Selama merekam, jendela dipasang per tick physics dan ditunggu (sama seperti
+// replay di marble_sim), bukan kapan saja thread latar selesai
+static unsigned recordedStreamChanges = 0;
+
+void streamLevelTick() {
+    if (isInputRecording()) recordedStreamChanges |= updateLevelStreaming(marbleX, marbleZ, true);
+}
+
+// Dipanggil tiap tick timer. Level streaming: kalau jendela chunk di sekitar
+// marble pindah, bangun ulang batch arena dan instance prop untuk isi barunya
+void streamLevel() {
+    PROFILE_ZONE("streamLevel");
+    unsigned changed = recordedStreamChanges;
+    recordedStreamChanges = 0;
+    if (!isInputRecording()) changed |= updateLevelStreaming(marbleX, marbleZ, false);
+    if (!changed) return;
+    auto start = std::chrono::steady_clock::now();
+    rebakeArenaMesh(changed);
+    rebuildPropInstances(changed);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    LevelStreamStats stats = levelStreamStats();
+    printf("Streamed window at (%.0f, %.0f): %d chunks resident, %d loaded so far, install %.2f ms + render %.2f ms\n",
+           arenaOriginX, arenaOriginZ, stats.residentChunks, stats.chunksLoaded, stats.lastInstallMs, ms);
+}
+
+// MarbleGame [--watch] [--record run.rec] [--wall-clock-timer] [level.lvl|level.lvlc ...]
+// atau MarbleGame --cook in.lvl out.lvlc. Tanpa level coba levels/arena1.lvl, kalau
+// tidak ada pakai level bawaan. Rekaman diputar ulang dengan marble_sim --replay.
+static bool parseArguments(int argc, char** argv, int& exitCode) {
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--cook") == 0 && i + 2 < argc) {
+            bool ok = cookLevelFile(argv[i + 1], argv[i + 2]);
+            if (!ok) printf("cook: %s\n", levelLoadError());
+            exitCode = ok ? 0 : 1;
+            return false;
+        }
+        if (strcmp(argv[i], "--watch") == 0) {
+            setLevelHotReload(true);
+            continue;
+        }
+        if (strcmp(argv[i], "--wall-clock-timer") == 0) {
+            setTimerWallClockDisplay(true);
+            continue;
+        }
+        if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordPath = argv[++i];
+            continue;
+        }
+        levelPaths.push_back(argv[i]);
+    }
+    if (levelPaths.empty()) {
+        if (!loadLevelFile("levels/arena1.lvl")) {
+            printf("Using builtin level (%s)\n", levelLoadError());
+        }
+        return true;
+    }
+    if (!loadLevelFile(levelPaths[0].c_str())) {
+        printf("level: %s\n", levelLoadError());
+        exitCode = 1;
+        return false;
+    }
+    return true;
 }
 
 
 int main(int argc, char** argv) {
-    glutInit(&argc, argv);
+    setProfileThreadName("main");
+    setProfilerDetail(true); // Zona per tick ikut begitu 'p' ditekan (lihat profiler.h)
+    glutInit(&argc, argv); // Buang argumen khusus GLUT dulu
+    int exitCode = 0;
+    if (!parseArguments(argc, argv, exitCode)) return exitCode;
     glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB | GLUT_DEPTH);
     glutInitWindowSize(800, 600);
     glutCreateWindow("Marble Arena Game - Refactored");
 
     initGame();
+    if (recordPath) {
+        if (startInputRecording(recordPath)) {
+            printf("Recording input to %s\n", recordPath);
+            atexit(stopInputRecording); // ESC dan tutup window keluar lewat exit()
+        } else {
+            printf("record: cannot write %s\n", recordPath);
+        }
+    }
 
     glutDisplayFunc(display);
     glutReshapeFunc(reshape);
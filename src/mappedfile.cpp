@@ -0,0 +1,56 @@
+#include "mappedfile.h"
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+bool mapFile(const char* path, MappedFile& out) {
+#ifdef _WIN32
+    out.file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (out.file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(out.file, &size) || size.QuadPart == 0) {
+        CloseHandle(out.file);
+        out.file = INVALID_HANDLE_VALUE;
+        return false;
+    }
+    out.mapping = CreateFileMappingA(out.file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    out.data = out.mapping ? (const char*)MapViewOfFile(out.mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!out.data) {
+        if (out.mapping) CloseHandle(out.mapping);
+        CloseHandle(out.file);
+        out = MappedFile();
+        return false;
+    }
+    out.size = (size_t)size.QuadPart;
+    return true;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return false;
+    }
+    void* data = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // Mapping tetap valid setelah fd ditutup
+    if (data == MAP_FAILED) return false;
+    out.data = (const char*)data;
+    out.size = (size_t)st.st_size;
+    return true;
+#endif
+}
+
+void unmapFile(MappedFile& file) {
+    if (!file.data) return;
+#ifdef _WIN32
+    UnmapViewOfFile(file.data);
+    CloseHandle(file.mapping);
+    CloseHandle(file.file);
+#else
+    munmap((void*)file.data, file.size);
+#endif
+    file = MappedFile();
+}
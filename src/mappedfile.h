@@ -0,0 +1,24 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+// File read-only yang di-map ke memori (mmap / MapViewOfFile). Halaman baru
+// dibaca dari disk (atau page cache) waktu disentuh, tanpa salinan ke buffer.
+struct MappedFile {
+    const char* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+};
+
+// false kalau file tidak bisa dibuka, kosong, atau gagal di-map
+bool mapFile(const char* path, MappedFile& out);
+void unmapFile(MappedFile& file); // Aman untuk MappedFile kosong
+
+#endif // MAPPEDFILE_H
@@ -1,7 +1,13 @@
 #ifndef MARBLE_H
 #define MARBLE_H
 
-void drawMarble();
 void resetMarbleInitialState(); 
 
+extern float totalRotationAngleX;
+extern float totalRotationAngleZ;
+
+// Gambar marble (marbledraw.cpp, butuh OpenGL)
+void drawMarble();
+void updateMarbleRotation();
+
 #endif // MARBLE_H
\ No newline at end of file
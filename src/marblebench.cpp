@@ -0,0 +1,1206 @@
+// marble_bench: microbenchmark query terrain arena.
+// Membandingkan broadphase grid dengan scan linear lama, fast path heightfield
+// dengan query exact, dan query batch (SIMD) dengan query per titik untuk sapuan
+// probe CCD, pada level acak berisi 10, 1k dan 100k primitive. Lalu edit
+// cube/ramp runtime (tambah/geser/hapus) dibandingkan dengan bangun ulang penuh,
+// hot reload file level besar dibandingkan dengan load penuh, jendela streaming
+// yang bergeser (pasang delta vs pasang utuh), dan trigger per tick (checkpoint +
+// coin): scan semua volume vs broadphase.
+// Lalu biaya profiler (zona kosong dan tick physics, profiler mati vs nyala).
+// Lalu suite regresi: ketiga query terrain di titik acak dan titik sulit
+// (tepi, sambungan ramp, pita epsilon dinding), satu tick updatePhysics, dan
+// setup level (rasterisasi CreateCube/CreateRamp, finalize, setupArenaGeometry).
+// Terakhir cek determinisme: rekam input acak lalu replay, state akhir harus
+// sama bit per bit dengan footer rekaman (kalau beda, exit code 1).
+//
+// Semua seed tetap. --json FILE menulis semua angka (satu hasil per baris),
+// --compare FILE membandingkan dengan JSON dari commit lain: waktu yang naik
+// lebih dari --threshold persen (default 10), mismatch/error yang naik, atau
+// hash state akhir replay yang berubah dihitung regresi, exit code 1.
+#include "arena.h"
+#include "arenacull.h"
+#include "checkpoint.h"
+#include "globals.h"
+#include "inputrecord.h"
+#include "level.h"
+#include "simulation.h"
+#include "trigger.h"
+#include "physics.h"
+#include "profiler.h"
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct QueryPoint {
+    float x, y, z;
+};
+
+struct QueryResult {
+    float h, nx, ny, nz;
+};
+
+// Satu angka hasil benchmark, nama "bagian/metrik/kasus"
+struct BenchResult {
+    std::string name;
+    double value;
+    std::string unit; // "ns", "us", "count"/"error" (bukan waktu, tidak boleh naik), atau "hash" (tidak boleh berubah)
+};
+
+static std::vector<BenchResult> benchResults;
+
+static void recordResult(const std::string& name, double value, const char* unit) {
+    benchResults.push_back({name, value, unit});
+}
+
+// Waktu terbaik dari beberapa ulangan, per item. Minimum lebih stabil antar run
+// daripada rata-rata (gangguan scheduler/cache hanya bisa menambah waktu).
+template <typename Body>
+static double bestNsPerItem(int repeats, int items, Body body) {
+    double best = 0.0;
+    for (int r = 0; r < repeats; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / items;
+        if (r == 0 || ns < best) best = ns;
+    }
+    return best;
+}
+
+// Primitive di sekitar arenaOriginX/Z (0 kecuali benchmark jendela streaming)
+static void buildRandomLevel(int numPrimitives, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> pos(-BOUNDS, BOUNDS);
+    std::uniform_real_distribution<float> size(0.5f, 3.0f);
+    std::uniform_real_distribution<float> height(0.5f, 4.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    clearArenaGeometry();
+    for (int i = 0; i < numPrimitives; ++i) {
+        float x = arenaOriginX + pos(rng), z = arenaOriginZ + pos(rng);
+        float sx = size(rng), sy = size(rng) * 0.5f, sz = size(rng);
+        float y = height(rng);
+        if (unit(rng) < 0.7f) {
+            CreateCube(x, y, z, sx, sy, sz);
+        } else {
+            CreateRamp(x, y, z, sx, sy, sz, unit(rng) < 0.5f ? 'x' : 'z');
+        }
+    }
+    buildArenaSpatialGrid();
+}
+
+// Terbaik dari 3 putaran (hasil query tiap putaran sama)
+static double runQueries(const std::vector<QueryPoint>& points, std::vector<QueryResult>& results) {
+    return bestNsPerItem(3, (int)points.size(), [&] {
+        for (size_t i = 0; i < points.size(); ++i) {
+            const QueryPoint& p = points[i];
+            QueryResult& r = results[i];
+            getArenaHeightAndNormalAt(p.x, p.y, p.z, r.h, r.nx, r.ny, r.nz);
+        }
+    });
+}
+
+static double runSurfaceQueries(const std::vector<QueryPoint>& points, std::vector<QueryResult>& results) {
+    return bestNsPerItem(3, (int)points.size(), [&] {
+        for (size_t i = 0; i < points.size(); ++i) {
+            const QueryPoint& p = points[i];
+            QueryResult& r = results[i];
+            getArenaHeightAndNormal(p.x, p.z, r.h, r.nx, r.ny, r.nz);
+        }
+    });
+}
+
+static void benchHeightfield(int numPrimitives) {
+    buildRandomLevel(numPrimitives, 1234u + numPrimitives);
+    buildArenaHeightfield();
+
+    const int numQueries = 200000;
+    std::mt19937 rng(7u);
+    std::uniform_real_distribution<float> pos(-BOUNDS, BOUNDS);
+    std::vector<QueryPoint> points(numQueries);
+    for (auto& p : points) {
+        p.x = pos(rng); p.y = 0.0f; p.z = pos(rng);
+    }
+
+    std::vector<QueryResult> exact(numQueries), fast(numQueries);
+    setArenaHeightfieldFastPath(false);
+    double exactNs = runSurfaceQueries(points, exact);
+    setArenaHeightfieldFastPath(true);
+    double fastNs = runSurfaceQueries(points, fast);
+
+    float maxHeightErr = 0.0f, maxNormalErr = 0.0f;
+    for (int i = 0; i < numQueries; ++i) {
+        float dh = std::fabs(exact[i].h - fast[i].h);
+        float dn = std::fabs(exact[i].nx - fast[i].nx) + std::fabs(exact[i].ny - fast[i].ny) +
+                   std::fabs(exact[i].nz - fast[i].nz);
+        if (dh > maxHeightErr) maxHeightErr = dh;
+        if (dn > maxNormalErr) maxNormalErr = dn;
+    }
+
+    printf("%10d %10d %14.1f %14.1f %9.1fx %11.2e %11.2e\n",
+           numPrimitives, numQueries, exactNs, fastNs, exactNs / fastNs, maxHeightErr, maxNormalErr);
+    std::string n = std::to_string(numPrimitives);
+    recordResult("heightfield/exact/" + n, exactNs, "ns");
+    recordResult("heightfield/fast/" + n, fastNs, "ns");
+    recordResult("heightfield/max_dh/" + n, maxHeightErr, "error");
+    recordResult("heightfield/max_dn/" + n, maxNormalErr, "error");
+}
+
+static void benchLevel(int numPrimitives) {
+    buildRandomLevel(numPrimitives, 1234u + numPrimitives);
+
+    // Jumlah query diskalakan supaya scan linear di level besar tetap selesai cepat
+    long long budget = 200000000LL / (numPrimitives > 0 ? numPrimitives : 1);
+    int numQueries = (int)(budget < 1000 ? 1000 : (budget > 200000 ? 200000 : budget));
+
+    std::mt19937 rng(42u);
+    std::uniform_real_distribution<float> pos(-BOUNDS, BOUNDS);
+    std::uniform_real_distribution<float> height(0.0f, 6.0f);
+    std::vector<QueryPoint> points(numQueries);
+    for (auto& p : points) {
+        p.x = pos(rng); p.y = height(rng); p.z = pos(rng);
+    }
+
+    std::vector<QueryResult> linear(numQueries), grid(numQueries);
+    setArenaSpatialGridEnabled(false);
+    double linearNs = runQueries(points, linear);
+    setArenaSpatialGridEnabled(true);
+    double gridNs = runQueries(points, grid);
+
+    int mismatches = 0;
+    for (int i = 0; i < numQueries; ++i) {
+        if (linear[i].h != grid[i].h || linear[i].nx != grid[i].nx ||
+            linear[i].ny != grid[i].ny || linear[i].nz != grid[i].nz) {
+            ++mismatches;
+        }
+    }
+
+    printf("%10d %10d %14.1f %14.1f %9.1fx %11d\n",
+           numPrimitives, numQueries, linearNs, gridNs, linearNs / gridNs, mismatches);
+    std::string n = std::to_string(numPrimitives);
+    recordResult("grid/linear/" + n, linearNs, "ns");
+    recordResult("grid/grid/" + n, gridNs, "ns");
+    recordResult("grid/mismatches/" + n, mismatches, "count");
+}
+
+// Sapuan seperti CCD di physics.cpp: 9 probe sepanjang satu sumbu. Separuh
+// sapuan dimulai tepat di tepi primitive supaya cabang dinding/sudut ikut teruji.
+// originX/Z bukan nol = jendela level streaming yang sudah bergeser; grid dan
+// batch harus tetap memakai koordinat relatif origin.
+static const int sweepProbes = 9;
+
+static void benchBatch(int numPrimitives, float originX, float originZ) {
+    arenaOriginX = originX;
+    arenaOriginZ = originZ;
+    buildRandomLevel(numPrimitives, 1234u + numPrimitives);
+
+    const int numSweeps = 50000;
+    std::mt19937 rng(11u);
+    std::uniform_real_distribution<float> pos(-BOUNDS, BOUNDS);
+    std::uniform_real_distribution<float> height(0.0f, 6.0f);
+    std::uniform_real_distribution<float> length(-0.8f, 0.8f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<QueryPoint> points(numSweeps * sweepProbes);
+    for (int s = 0; s < numSweeps; ++s) {
+        float x = originX + pos(rng), y = height(rng), z = originZ + pos(rng);
+        if (unit(rng) < 0.5f && !cubes.empty()) {
+            const ArenaCube& c = cubes[rng() % cubes.size()];
+            x = c.x + c.sizeX / 2.0f;
+            z = c.z + (unit(rng) - 0.5f) * c.sizeZ;
+            y = c.y + (unit(rng) - 0.5f) * c.sizeY;
+        }
+        bool alongX = unit(rng) < 0.5f;
+        float len = length(rng);
+        for (int i = 0; i < sweepProbes; ++i) {
+            float f = (float)i / (sweepProbes - 1);
+            QueryPoint& p = points[s * sweepProbes + i];
+            p.x = alongX ? x + f * len : x;
+            p.y = y;
+            p.z = alongX ? z : z + f * len;
+        }
+    }
+
+    std::vector<QueryResult> single(points.size());
+    std::vector<float> xs(points.size()), ys(points.size()), zs(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        xs[i] = points[i].x; ys[i] = points[i].y; zs[i] = points[i].z;
+    }
+    std::vector<float> h(points.size()), nx(points.size()), ny(points.size()), nz(points.size());
+    // Per titik dan batch diukur bergantian supaya perubahan kecepatan mesin
+    // di tengah jalan kena keduanya
+    double singleNs = 0.0, batchNs = 0.0;
+    for (int round = 0; round < 5; ++round) {
+        double roundSingle = bestNsPerItem(1, numSweeps, [&] {
+            for (size_t i = 0; i < points.size(); ++i) {
+                const QueryPoint& p = points[i];
+                QueryResult& r = single[i];
+                getArenaHeightAndNormalAt(p.x, p.y, p.z, r.h, r.nx, r.ny, r.nz);
+            }
+        });
+        double roundBatch = bestNsPerItem(1, numSweeps, [&] {
+            for (int s = 0; s < numSweeps; ++s) {
+                int o = s * sweepProbes;
+                getArenaHeightAndNormalAtBatch(&xs[o], &ys[o], &zs[o], sweepProbes, &h[o], &nx[o], &ny[o], &nz[o]);
+            }
+        });
+        if (round == 0 || roundSingle < singleNs) singleNs = roundSingle;
+        if (round == 0 || roundBatch < batchNs) batchNs = roundBatch;
+    }
+
+    int mismatches = 0;
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (single[i].h != h[i] || single[i].nx != nx[i] || single[i].ny != ny[i] || single[i].nz != nz[i]) {
+            ++mismatches;
+        }
+    }
+
+    arenaOriginX = 0.0f;
+    arenaOriginZ = 0.0f;
+
+    std::string n = std::to_string(numPrimitives);
+    if (originX != 0.0f || originZ != 0.0f) {
+        char origin[32];
+        snprintf(origin, sizeof(origin), "@%g,%g", originX, originZ);
+        n += origin;
+    }
+    printf("%16s %10d %14.1f %14.1f %9.1fx %11d\n",
+           n.c_str(), numSweeps, singleNs, batchNs, singleNs / batchNs, mismatches);
+    recordResult("batch/single/" + n, singleNs, "ns");
+    recordResult("batch/batch/" + n, batchNs, "ns");
+    recordResult("batch/mismatches/" + n, mismatches, "count");
+}
+
+// Edit acak pada level yang sudah jadi, lalu cek arenaHeights dan hasil query
+// sama persis dengan level yang dibangun ulang dari nol dengan primitive yang sama
+static void benchEdits(int numPrimitives) {
+    buildRandomLevel(numPrimitives, 1234u + numPrimitives);
+    finalizeArenaGeometry();
+
+    const int numEdits = 300;
+    std::mt19937 rng(99u);
+    std::uniform_real_distribution<float> pos(-BOUNDS, BOUNDS);
+    std::uniform_real_distribution<float> step(-2.0f, 2.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    auto start = std::chrono::steady_clock::now();
+    for (int e = 0; e < numEdits; ++e) {
+        float kind = unit(rng);
+        bool ramp = unit(rng) < 0.3f;
+        int count = ramp ? (int)ramps.size() : (int)cubes.size();
+        if (kind < 0.3f || count == 0) {
+            float x = pos(rng), z = pos(rng);
+            if (ramp) addArenaRamp({x, 2.0f, z, 2.0f, 1.0f, 3.0f, unit(rng) < 0.5f ? 'x' : 'z'});
+            else addArenaCube({x, 2.0f, z, 2.0f, 1.0f, 2.0f});
+        } else if (kind < 0.8f) {
+            int k = (int)(unit(rng) * count) % count;
+            if (ramp) moveArenaRamp(k, ramps[k].x + step(rng), ramps[k].y, ramps[k].z + step(rng));
+            else moveArenaCube(k, cubes[k].x + step(rng), cubes[k].y + 0.5f * step(rng), cubes[k].z + step(rng));
+        } else {
+            int k = (int)(unit(rng) * count) % count;
+            if (ramp) removeArenaRamp(k);
+            else removeArenaCube(k);
+        }
+    }
+    double editUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / numEdits;
+    takeArenaChanges();
+
+    const int numQueries = 50000;
+    std::vector<QueryPoint> points(numQueries);
+    for (auto& p : points) {
+        p.x = pos(rng); p.y = 6.0f * unit(rng); p.z = pos(rng);
+    }
+    std::vector<float> editedHeights(&arenaHeights[0][0], &arenaHeights[0][0] + GRID_SIZE * GRID_SIZE);
+    std::vector<QueryResult> edited(numQueries), surfaceEdited(numQueries);
+    runQueries(points, edited);
+    runSurfaceQueries(points, surfaceEdited);
+
+    std::vector<ArenaCube> cubeList = cubes;
+    std::vector<ArenaRamp> rampList = ramps;
+    start = std::chrono::steady_clock::now();
+    clearArenaGeometry();
+    for (const ArenaCube& c : cubeList) CreateCube(c.x, c.y, c.z, c.sizeX, c.sizeY, c.sizeZ);
+    for (const ArenaRamp& r : rampList) CreateRamp(r.x, r.y, r.z, r.sizeX, r.sizeY, r.sizeZ, r.axis);
+    finalizeArenaGeometry();
+    double rebuildUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    int mismatches = 0;
+    const float* heights = &arenaHeights[0][0];
+    for (int i = 0; i < GRID_SIZE * GRID_SIZE; ++i) {
+        if (heights[i] != editedHeights[i]) ++mismatches;
+    }
+    std::vector<QueryResult> rebuilt(numQueries), surfaceRebuilt(numQueries);
+    runQueries(points, rebuilt);
+    runSurfaceQueries(points, surfaceRebuilt);
+    for (int i = 0; i < numQueries; ++i) {
+        const QueryResult& a = edited[i];
+        const QueryResult& b = rebuilt[i];
+        const QueryResult& c = surfaceEdited[i];
+        const QueryResult& d = surfaceRebuilt[i];
+        if (a.h != b.h || a.nx != b.nx || a.ny != b.ny || a.nz != b.nz) ++mismatches;
+        if (c.h != d.h || c.nx != d.nx || c.ny != d.ny || c.nz != d.nz) ++mismatches;
+    }
+
+    printf("%10d %10d %14.1f %14.1f %9.1fx %11d\n",
+           numPrimitives, numEdits, editUs, rebuildUs, rebuildUs / editUs, mismatches);
+    std::string n = std::to_string(numPrimitives);
+    recordResult("edits/edit/" + n, editUs, "us");
+    recordResult("edits/rebuild/" + n, rebuildUs, "us");
+    recordResult("edits/mismatches/" + n, mismatches, "count");
+}
+
+// Hot reload level besar: level acak ditulis sebagai teks lalu di-cook ke satu
+// file yang dipantau, versi B menggeser 10 cube, menghapus 5 cube, dan menyisipkan
+// 5 ramp di tengah list (index sesudahnya bergeser). Yang diukur satu
+// pollLevelHotReload (baca + validasi file, pasang perubahan), dibandingkan
+// dengan load penuh file yang sama; hasil query keduanya harus sama.
+static const char* reloadLevelPath = "marble_bench_reload.lvlc";
+
+static void writeLevelLines(const char* path, const std::vector<std::string>& lines) {
+    FILE* out = fopen(path, "w");
+    if (!out) return;
+    for (const auto& line : lines) fprintf(out, "%s\n", line.c_str());
+    fclose(out);
+}
+
+static unsigned pollReloadUntilChanged(double& ms) {
+    for (int attempt = 0; attempt < 40; ++attempt) {
+        auto start = std::chrono::steady_clock::now();
+        unsigned changed = pollLevelHotReload();
+        ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (changed) return changed;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50)); // Tanpa inotify: cek mtime tiap 0.25 s
+    }
+    return 0;
+}
+
+static void benchReload(int numPrimitives) {
+    std::mt19937 rng(4321u + numPrimitives);
+    std::uniform_real_distribution<float> pos(-BOUNDS, BOUNDS);
+    std::uniform_real_distribution<float> size(0.5f, 3.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    char line[160];
+    std::vector<std::string> before;
+    for (int i = 0; i < numPrimitives; ++i) {
+        snprintf(line, sizeof(line), "cube %.3f %.3f %.3f %.3f %.3f %.3f", pos(rng), 0.5f + 3.5f * unit(rng), pos(rng),
+                 size(rng), 0.5f * size(rng), size(rng));
+        before.push_back(line);
+    }
+    for (int i = 0; i < numPrimitives / 100; ++i) {
+        snprintf(line, sizeof(line), "tree %.3f 0.3 %.3f 5.0 0.2 1.5", pos(rng), pos(rng));
+        before.push_back(line);
+        snprintf(line, sizeof(line), "bush %.3f 0.5 %.3f 0.7", pos(rng), pos(rng));
+        before.push_back(line);
+    }
+    std::vector<std::string> after = before;
+    const int numMoved = 10, numRemoved = 5, numAdded = 5;
+    for (int e = 0; e < numMoved; ++e) {
+        int k = (int)(unit(rng) * numPrimitives) % numPrimitives;
+        snprintf(line, sizeof(line), "cube %.3f 2.0 %.3f 2.0 1.0 2.0", pos(rng), pos(rng));
+        after[k] = line;
+    }
+    for (int e = 0; e < numRemoved; ++e) after.erase(after.begin() + (int)(unit(rng) * (numPrimitives - e)) % (numPrimitives - e));
+    for (int e = 0; e < numAdded; ++e) {
+        snprintf(line, sizeof(line), "ramp %.3f 1.5 %.3f 2.0 1.0 3.0 %s", pos(rng), pos(rng), unit(rng) < 0.5f ? "x" : "z");
+        after.insert(after.begin() + (int)(unit(rng) * numPrimitives) % numPrimitives, line);
+    }
+    writeLevelLines("marble_bench_reload_a.lvl", before);
+    writeLevelLines("marble_bench_reload_b.lvl", after);
+
+    cookLevelFile("marble_bench_reload_a.lvl", reloadLevelPath);
+    loadLevelFile(reloadLevelPath);
+    applyCurrentLevel();
+    setLevelHotReload(true);
+    pollLevelHotReload(); // Mulai memantau file
+
+    // B, A, B, A, B: reload bolak-balik. Yang pertama juga membayar alokasi buffer tambal.
+    double bestMs = 0.0, worstMs = 0.0;
+    bool detected = true;
+    for (int round = 0; round < 5; ++round) {
+        cookLevelFile(round % 2 == 0 ? "marble_bench_reload_b.lvl" : "marble_bench_reload_a.lvl", reloadLevelPath);
+        double ms = 0.0;
+        if (!pollReloadUntilChanged(ms)) detected = false;
+        if (round == 0 || ms < bestMs) bestMs = ms;
+        worstMs = std::max(worstMs, ms);
+    }
+
+    std::uniform_real_distribution<float> heightDist(0.0f, 6.0f);
+    const int numQueries = 50000;
+    std::vector<QueryPoint> points(numQueries);
+    for (auto& p : points) {
+        p.x = pos(rng); p.y = heightDist(rng); p.z = pos(rng);
+    }
+    std::vector<float> reloadedHeights(&arenaHeights[0][0], &arenaHeights[0][0] + GRID_SIZE * GRID_SIZE);
+    std::vector<QueryResult> reloaded(numQueries), surfaceReloaded(numQueries);
+    runQueries(points, reloaded);
+    runSurfaceQueries(points, surfaceReloaded);
+    std::vector<std::vector<int>> reloadedOrder;
+    std::vector<std::vector<ArenaBounds>> reloadedBounds;
+    for (int kind = 0; kind < CULL_KIND_COUNT; ++kind) {
+        reloadedOrder.push_back(arenaCullOrder((ArenaCullKind)kind));
+        reloadedBounds.push_back(arenaCullBounds((ArenaCullKind)kind));
+    }
+
+    double fullMs = 0.0;
+    for (int r = 0; r < 3; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        loadLevelFile(reloadLevelPath);
+        applyCurrentLevel();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (r == 0 || ms < fullMs) fullMs = ms;
+    }
+
+    int mismatches = detected ? 0 : 1;
+    const float* heights = &arenaHeights[0][0];
+    for (int i = 0; i < GRID_SIZE * GRID_SIZE; ++i) {
+        if (heights[i] != reloadedHeights[i]) ++mismatches;
+    }
+    // Urutan cull dan AABB hasil tambal harus sama dengan bangun ulang penuh
+    for (int kind = 0; kind < CULL_KIND_COUNT; ++kind) {
+        if (reloadedOrder[kind] != arenaCullOrder((ArenaCullKind)kind)) ++mismatches;
+        const std::vector<ArenaBounds>& b = arenaCullBounds((ArenaCullKind)kind);
+        if (b.size() != reloadedBounds[kind].size() ||
+            memcmp(b.data(), reloadedBounds[kind].data(), b.size() * sizeof(ArenaBounds)) != 0) ++mismatches;
+    }
+    std::vector<QueryResult> full(numQueries), surfaceFull(numQueries);
+    runQueries(points, full);
+    runSurfaceQueries(points, surfaceFull);
+    for (int i = 0; i < numQueries; ++i) {
+        const QueryResult& a = reloaded[i];
+        const QueryResult& b = full[i];
+        const QueryResult& c = surfaceReloaded[i];
+        const QueryResult& d = surfaceFull[i];
+        if (a.h != b.h || a.nx != b.nx || a.ny != b.ny || a.nz != b.nz) ++mismatches;
+        if (c.h != d.h || c.nx != d.nx || c.ny != d.ny || c.nz != d.nz) ++mismatches;
+    }
+
+    setLevelHotReload(false);
+    useBuiltinLevel();
+    remove(reloadLevelPath);
+    remove("marble_bench_reload_a.lvl");
+    remove("marble_bench_reload_b.lvl");
+
+    printf("%10d %10d %10.2f %10.2f %10.2f %9.1fx %11d   (terlama %s frame 16.7 ms)\n", numPrimitives,
+           numMoved + numRemoved + numAdded, bestMs, worstMs, fullMs, fullMs / bestMs, mismatches,
+           worstMs < 1000.0 / 60.0 ? "di bawah" : "MELEBIHI");
+    std::string n = std::to_string(numPrimitives);
+    recordResult("reload/reload/" + n, bestMs * 1000.0, "us");
+    recordResult("reload/reload_worst/" + n, worstMs * 1000.0, "us");
+    recordResult("reload/full/" + n, fullMs * 1000.0, "us");
+    recordResult("reload/mismatches/" + n, mismatches, "count");
+}
+
+// Jendela streaming bergeser: level 240 x 240 di-cook, marble dibawa lewat jalur
+// yang memindahkan jendela satu chunk tiap langkah (satu kolom/baris chunk masuk
+// dan keluar). Pasang delta (chunk resident tidak dibangun ulang) dibandingkan
+// dengan pasang utuh tiap jendela; hasil query, heightfield, dan cull tiap jendela
+// keduanya harus sama.
+struct StreamWindowSnapshot {
+    std::vector<QueryResult> exact, surface;
+    std::vector<float> heights;
+    std::vector<std::vector<int>> order;
+    std::vector<std::vector<ArenaBounds>> bounds;
+};
+
+static const int streamWindowSteps = 12;
+
+static double walkStreamWindows(const char* levelPath, bool incremental, std::vector<StreamWindowSnapshot>& out,
+                                double& worstMs) {
+    setLevelStreamIncremental(incremental);
+    loadLevelFile(levelPath);
+    initSimulation();
+    out.assign(streamWindowSteps, StreamWindowSnapshot());
+    double totalMs = 0.0;
+    worstMs = 0.0;
+    for (int step = 0; step < streamWindowSteps; ++step) {
+        // Timur 6 langkah lalu utara 6 langkah, 20 unit (satu chunk) per langkah
+        float x = -60.0f + 20.0f * std::min(step + 1, 6);
+        float z = -60.0f + 20.0f * std::max(step - 5, 0);
+        updateLevelStreaming(x, z, true);
+        double ms = levelStreamStats().lastInstallMs;
+        totalMs += ms;
+        worstMs = std::max(worstMs, ms);
+
+        std::mt19937 rng(900u + step);
+        std::uniform_real_distribution<float> pos(-BOUNDS, BOUNDS);
+        std::uniform_real_distribution<float> heightDist(0.0f, 6.0f);
+        std::vector<QueryPoint> points(20000);
+        for (auto& p : points) {
+            p.x = arenaOriginX + pos(rng); p.y = heightDist(rng); p.z = arenaOriginZ + pos(rng);
+        }
+        StreamWindowSnapshot& s = out[step];
+        s.exact.resize(points.size());
+        s.surface.resize(points.size());
+        runQueries(points, s.exact);
+        runSurfaceQueries(points, s.surface);
+        s.heights.assign(&arenaHeights[0][0], &arenaHeights[0][0] + GRID_SIZE * GRID_SIZE);
+        for (int kind = 0; kind < CULL_KIND_COUNT; ++kind) {
+            s.order.push_back(arenaCullOrder((ArenaCullKind)kind));
+            s.bounds.push_back(arenaCullBounds((ArenaCullKind)kind));
+        }
+    }
+    setLevelStreamIncremental(true);
+    return totalMs / streamWindowSteps;
+}
+
+static void benchStreamWindow(int numPrimitives) {
+    const char* levelPath = "marble_bench_window.lvl";
+    std::mt19937 rng(2468u + numPrimitives);
+    std::uniform_real_distribution<float> pos(-120.0f, 120.0f);
+    std::uniform_real_distribution<float> size(0.5f, 3.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<std::string> lines = {"checkpoint -60 -60", "finish 100 100"};
+    char line[160];
+    for (int i = 0; i < numPrimitives; ++i) {
+        if (unit(rng) < 0.7f) {
+            snprintf(line, sizeof(line), "cube %.2f %.2f %.2f %.2f %.2f %.2f", pos(rng), 0.5f + 3.5f * unit(rng), pos(rng),
+                     size(rng), 0.5f * size(rng), size(rng));
+        } else {
+            snprintf(line, sizeof(line), "ramp %.2f %.2f %.2f %.2f %.2f %.2f %s", pos(rng), 0.5f + 3.5f * unit(rng), pos(rng),
+                     size(rng), 0.5f * size(rng), size(rng), unit(rng) < 0.5f ? "x" : "z");
+        }
+        lines.push_back(line);
+    }
+    for (int i = 0; i < numPrimitives / 100; ++i) {
+        snprintf(line, sizeof(line), "tree %.2f 0.3 %.2f 5.0 0.2 1.5", pos(rng), pos(rng));
+        lines.push_back(line);
+        snprintf(line, sizeof(line), "rock %.2f 0.3 %.2f 0.8", pos(rng), pos(rng));
+        lines.push_back(line);
+    }
+    writeLevelLines(levelPath, lines);
+
+    std::vector<StreamWindowSnapshot> delta, full;
+    double deltaWorstMs = 0.0, fullWorstMs = 0.0;
+    double deltaMs = walkStreamWindows(levelPath, true, delta, deltaWorstMs);
+    double fullMs = walkStreamWindows(levelPath, false, full, fullWorstMs);
+
+    int mismatches = 0;
+    for (int step = 0; step < streamWindowSteps; ++step) {
+        const StreamWindowSnapshot& a = delta[step];
+        const StreamWindowSnapshot& b = full[step];
+        if (a.heights != b.heights) ++mismatches;
+        for (size_t i = 0; i < a.exact.size(); ++i) {
+            const QueryResult& p = a.exact[i];
+            const QueryResult& q = b.exact[i];
+            const QueryResult& r = a.surface[i];
+            const QueryResult& s = b.surface[i];
+            if (p.h != q.h || p.nx != q.nx || p.ny != q.ny || p.nz != q.nz) ++mismatches;
+            if (r.h != s.h || r.nx != s.nx || r.ny != s.ny || r.nz != s.nz) ++mismatches;
+        }
+        for (int kind = 0; kind < CULL_KIND_COUNT; ++kind) {
+            if (a.order[kind] != b.order[kind]) ++mismatches;
+            if (a.bounds[kind].size() != b.bounds[kind].size() ||
+                memcmp(a.bounds[kind].data(), b.bounds[kind].data(), a.bounds[kind].size() * sizeof(ArenaBounds)) != 0) ++mismatches;
+        }
+    }
+    useBuiltinLevel();
+    initSimulation();
+    remove(levelPath);
+
+    printf("%10d %10d %10.2f %10.2f %10.2f %9.1fx %11d\n", numPrimitives, streamWindowSteps, deltaMs, deltaWorstMs,
+           fullMs, fullMs / deltaMs, mismatches);
+    std::string n = std::to_string(numPrimitives);
+    recordResult("stream_window/delta/" + n, deltaMs * 1000.0, "us");
+    recordResult("stream_window/delta_worst/" + n, deltaWorstMs * 1000.0, "us");
+    recordResult("stream_window/full/" + n, fullMs * 1000.0, "us");
+    recordResult("stream_window/mismatches/" + n, mismatches, "count");
+}
+
+// Input acak per tick, sama dengan marble_sim --random-input
+static void randomizeInput(std::mt19937& rng) {
+    static const int keys[4] = { KEY_ARROW_UP, KEY_ARROW_DOWN, KEY_ARROW_LEFT, KEY_ARROW_RIGHT };
+    if (rng() % 40 == 0) {
+        int key = keys[rng() % 4];
+        keyStates[key] = !keyStates[key];
+    }
+    if (rng() % 50 == 0) cameraAngleX += (float)((int)(rng() % 41) - 20) * 1.3f;
+}
+
+// FNV-1a 32 bit dari footer state akhir; muat persis di double untuk JSON
+static unsigned hashReplayState(const ReplayFinalState& state) {
+    const unsigned char* bytes = (const unsigned char*)&state;
+    unsigned h = 2166136261u;
+    for (size_t i = 0; i < sizeof(state); ++i) h = (h ^ bytes[i]) * 16777619u;
+    return h;
+}
+
+// Rekam numTicks tick input acak di level aktif (urutan tick sama dengan marble_sim),
+// lalu putar ulang rekamannya di proses yang sama dan bandingkan dengan footer.
+// Beda = physics/streaming tidak deterministik lagi. Hash footer dicatat supaya
+// --compare juga menangkap lintasan yang berubah antar commit/build.
+static int benchReplay(const char* label, unsigned seed, int numTicks) {
+    const char* recordPath = "marble_bench_replay.rec";
+    initSimulation();
+    std::mt19937 rng(seed);
+    startInputRecording(recordPath);
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < numTicks; ++t) {
+        randomizeInput(rng);
+        recordInputTick();
+        bool running = stepSimulation();
+        updateLevelStreaming(marbleX, marbleZ, true);
+        if (!running) {
+            initSimulation();
+            recordInputEvent(INPUT_EVENT_RESTART);
+        }
+    }
+    double recordMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    stopInputRecording();
+
+    int mismatches = 1;
+    unsigned hash = 0;
+    double replayMs = 0.0;
+    if (loadInputReplay(recordPath)) {
+        const char* level = replayLevelName();
+        if (strcmp(level, "builtin") == 0) useBuiltinLevel();
+        else loadLevelFile(level);
+        initSimulation();
+        start = std::chrono::steady_clock::now();
+        while (nextReplayTick()) {
+            stepSimulation();
+            updateLevelStreaming(marbleX, marbleZ, true);
+        }
+        replayMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        ReplayFinalState got = currentReplayState();
+        const ReplayFinalState& want = replayRecordedState();
+        mismatches = memcmp(&got, &want, sizeof(got)) != 0;
+        hash = hashReplayState(want);
+    }
+    remove(recordPath);
+
+    printf("%10s %10d %10.1f %10.1f   %08x %11d\n", label, numTicks, recordMs, replayMs, hash, mismatches);
+    std::string n = label;
+    recordResult("replay/record/" + n, recordMs * 1000.0, "us");
+    recordResult("replay/replay/" + n, replayMs * 1000.0, "us");
+    recordResult("replay/state_hash/" + n, hash, "hash");
+    recordResult("replay/mismatches/" + n, mismatches, "count");
+    return mismatches;
+}
+
+// Level streaming 240 x 240 (jendela arena harus pindah) dengan checkpoint jauh
+static int benchStreamedReplay(int numTicks) {
+    const char* levelPath = "marble_bench_replay.lvl";
+    std::mt19937 rng(77u);
+    std::uniform_real_distribution<float> pos(-120.0f, 120.0f);
+    std::uniform_real_distribution<float> size(0.5f, 3.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<std::string> lines = {"checkpoint 0 -30", "checkpoint 0 60 1", "checkpoint 60 60 1", "finish 100 100"};
+    char line[160];
+    for (int i = 0; i < 3000; ++i) {
+        if (unit(rng) < 0.7f) {
+            snprintf(line, sizeof(line), "cube %.2f %.2f %.2f %.2f %.2f %.2f", pos(rng), 0.3f + unit(rng), pos(rng),
+                     size(rng), 0.5f * size(rng), size(rng));
+        } else {
+            snprintf(line, sizeof(line), "ramp %.2f %.2f %.2f %.2f %.2f %.2f %s", pos(rng), 0.3f + unit(rng), pos(rng),
+                     size(rng), 0.5f * size(rng), size(rng), unit(rng) < 0.5f ? "x" : "z");
+        }
+        lines.push_back(line);
+    }
+    writeLevelLines(levelPath, lines);
+    int mismatches = 1;
+    if (loadLevelFile(levelPath)) mismatches = benchReplay("streamed", 11u, numTicks);
+    useBuiltinLevel();
+    initSimulation();
+    remove(levelPath);
+    return mismatches;
+}
+
+// Marble berjalan acak di level 1k primitive berisi numTriggers checkpoint dan
+// numTriggers coin. Kedua mode harus mengambil yang sama (score dan flag collected).
+static double runTriggerWalk(int numTriggers, int numTicks, std::vector<bool>& collected, int& finalScore) {
+    std::mt19937 rng(5u);
+    std::uniform_real_distribution<float> pos(-BOUNDS, BOUNDS);
+    std::uniform_real_distribution<float> step(-0.3f, 0.3f);
+    clearCheckpoints();
+    clearCoins();
+    for (int i = 0; i < numTriggers; ++i) {
+        addCheckpoint(pos(rng), pos(rng), 0.0f);
+        addCoin(pos(rng), pos(rng));
+    }
+    score = 0;
+    activeCheckpointIndex = -1;
+    marbleX = 0.0f; marbleZ = 0.0f;
+    syncLevelTriggers();
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < numTicks; ++t) {
+        marbleX = std::max(-BOUNDS, std::min(BOUNDS, marbleX + step(rng)));
+        marbleZ = std::max(-BOUNDS, std::min(BOUNDS, marbleZ + step(rng)));
+        marbleY = getArenaHeight(marbleX, marbleZ) + 0.5f;
+        updateLevelTriggers();
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / numTicks;
+    collected = checkpointCollected;
+    for (const Coin& c : coins) collected.push_back(c.collected);
+    finalScore = score;
+    return ns;
+}
+
+static void benchTriggers(int numTriggers) {
+    buildRandomLevel(1000, 2024u);
+    finalizeArenaGeometry();
+    const int numTicks = 20000;
+    std::vector<bool> linearCollected, hashCollected;
+    int linearScore = 0, hashScore = 0;
+    // Pesan "Checkpoint collected" dibuang supaya tidak ikut terukur
+    std::streambuf* out = std::cout.rdbuf(nullptr);
+    setTriggerBroadphaseEnabled(false);
+    double linearNs = runTriggerWalk(numTriggers, numTicks, linearCollected, linearScore);
+    setTriggerBroadphaseEnabled(true);
+    double hashNs = runTriggerWalk(numTriggers, numTicks, hashCollected, hashScore);
+    std::cout.rdbuf(out);
+    std::cout.clear();
+
+    int mismatches = linearScore != hashScore;
+    for (size_t i = 0; i < linearCollected.size(); ++i) {
+        if (linearCollected[i] != hashCollected[i]) ++mismatches;
+    }
+    printf("%10d %10d %14.1f %14.1f %9.1fx %11d\n",
+           2 * numTriggers, numTicks, linearNs, hashNs, linearNs / hashNs, mismatches);
+    std::string n = std::to_string(2 * numTriggers);
+    recordResult("triggers/linear/" + n, linearNs, "ns");
+    recordResult("triggers/hash/" + n, hashNs, "ns");
+    recordResult("triggers/mismatches/" + n, mismatches, "count");
+}
+
+static volatile int profileSink = 0;
+
+static double profiledZoneNs(int numZones) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < numZones; ++i) {
+        PROFILE_ZONE("bench zone");
+        profileSink = i;
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / numZones;
+}
+
+// Marble didorong terus di level 1k primitive; state awal sama untuk kedua mode
+static double physicsTickNs(int numTicks) {
+    marbleX = 0.0f; marbleZ = 0.0f;
+    marbleY = getArenaHeight(0.0f, 0.0f) + marbleRadius;
+    marbleVX = marbleVY = marbleVZ = 0.0f;
+    cameraAngleX = -90.0f;
+    keyStates[KEY_ARROW_UP] = true;
+    auto start = std::chrono::steady_clock::now();
+    for (int t = 0; t < numTicks; ++t) {
+        if (t % 500 == 0) cameraAngleX += 37.0f;
+        updatePhysics();
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / numTicks;
+    keyStates[KEY_ARROW_UP] = false;
+    return ns;
+}
+
+// Profiler mati, nyala (default: zona per frame saja, tanpa zona per tick),
+// dan nyala + detail, bergantian beberapa putaran supaya perubahan kecepatan
+// mesin kena semua mode. State akhir harus sama di ketiganya.
+static void benchProfiler() {
+    const int numZones = 2000000, numTicks = 50000, rounds = 10;
+    buildRandomLevel(1000, 77u);
+    finalizeArenaGeometry();
+    clearCheckpoints();
+    std::streambuf* out = std::cout.rdbuf(nullptr);
+    setProfilerEnabled(false);
+    double zoneOffNs = profiledZoneNs(numZones);
+    setProfilerEnabled(true);
+    double zoneOnNs = profiledZoneNs(numZones);
+
+    // Zona kosong di atas memenuhi ring (1.5 MB), jadi tick diukur terpisah
+    double tickNs[3] = {0.0, 0.0, 0.0}; // mati, nyala, nyala + detail
+    double zonesPerTick[3] = {0.0, 0.0, 0.0};
+    float finalX[3], finalZ[3];
+    for (int round = 0; round < rounds; ++round) {
+        // Urutan diputar: mode detail mengisi ring dan mengotori cache mode berikutnya
+        for (int step = 0; step < 3; ++step) {
+            int mode = (round + step) % 3;
+            setProfilerDetail(mode == 2);
+            setProfilerEnabled(mode > 0);
+            uint64_t zonesBefore = profileZonesRecorded();
+            double t = physicsTickNs(numTicks);
+            zonesPerTick[mode] = (double)(profileZonesRecorded() - zonesBefore) / numTicks;
+            if (tickNs[mode] == 0.0 || t < tickNs[mode]) tickNs[mode] = t;
+            finalX[mode] = marbleX;
+            finalZ[mode] = marbleZ;
+        }
+    }
+    setProfilerEnabled(false);
+    setProfilerDetail(false);
+    std::cout.rdbuf(out);
+    std::cout.clear();
+
+    bool same = finalX[0] == finalX[1] && finalX[0] == finalX[2] && finalZ[0] == finalZ[1] && finalZ[0] == finalZ[2];
+    // Waktu tick di VM naik-turun beberapa persen antar putaran, jadi biaya
+    // juga dihitung dari jumlah zona per tick x biaya satu zona
+    double onPercent = 100.0 * zonesPerTick[1] * (zoneOnNs - zoneOffNs) / tickNs[0];
+    double detailPercent = 100.0 * zonesPerTick[2] * (zoneOnNs - zoneOffNs) / tickNs[0];
+    printf("%10s %14.1f %14.1f\n", "zone", zoneOffNs, zoneOnNs);
+    printf("%10s %14.1f %14.1f   (terukur %+.1f%%, %.1f zona/tick = %.2f%%, state %s)\n", "tick", tickNs[0], tickNs[1],
+           100.0 * (tickNs[1] - tickNs[0]) / tickNs[0], zonesPerTick[1], onPercent, same ? "same" : "DIFFERENT");
+    printf("%10s %14s %14.1f   (terukur %+.1f%%, %.1f zona/tick = %.2f%%, --profile-detail)\n", "tick+det", "",
+           tickNs[2], 100.0 * (tickNs[2] - tickNs[0]) / tickNs[0], zonesPerTick[2], detailPercent);
+    recordResult("profiler/zone_off", zoneOffNs, "ns");
+    recordResult("profiler/zone_on", zoneOnNs, "ns");
+    recordResult("profiler/tick_off", tickNs[0], "ns");
+    recordResult("profiler/tick_on", tickNs[1], "ns");
+    recordResult("profiler/tick_detail", tickNs[2], "ns");
+    recordResult("profiler/tick_on_zones", zonesPerTick[1], "count");
+    // Game: ~16 zona render/timer per frame, physics satu zona per frame, plus zona
+    // detail (selalu nyala di game) untuk paling banyak 5 substep physics
+    const int zonesPerFrame = 17, maxSubsteps = 5;
+    double frameZones = zonesPerFrame + maxSubsteps * zonesPerTick[2];
+    double frameUs = frameZones * zoneOnNs / 1000.0;
+    printf("%10s %14s %14.2f us = %.3f%% of 16.667 ms (%d zones + %d substep x %.1f detail)\n", "frame", "", frameUs,
+           frameUs / 16667.0 * 100.0, zonesPerFrame, maxSubsteps, zonesPerTick[2]);
+    recordResult("profiler/frame_zones", frameZones, "count");
+}
+
+// --- Suite regresi ---
+
+enum PointSet { POINTS_RANDOM, POINTS_EDGE, POINTS_SEAM, POINTS_WALL_BAND, POINT_SET_COUNT };
+static const char* pointSetNames[POINT_SET_COUNT] = {"random", "edge", "seam", "wallband"};
+static const float wallBandEpsilon = 0.015f; // Sama dengan epsilon dinding di arena.cpp
+
+// Titik tepat di garis tepi footprint cube/ramp (dihitung persis seperti
+// arena.cpp), sedikit di atas permukaan atasnya
+static QueryPoint edgePoint(std::mt19937& rng, float minX, float maxX, float minZ, float maxZ, float topY) {
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    float f = unit(rng);
+    QueryPoint p;
+    switch (rng() % 4) {
+        case 0: p.x = minX; p.z = minZ + f * (maxZ - minZ); break;
+        case 1: p.x = maxX; p.z = minZ + f * (maxZ - minZ); break;
+        case 2: p.z = minZ; p.x = minX + f * (maxX - minX); break;
+        default: p.z = maxZ; p.x = minX + f * (maxX - minX); break;
+    }
+    p.y = topY + 0.5f * unit(rng);
+    return p;
+}
+
+static void makePointSet(PointSet set, int count, unsigned seed, std::vector<QueryPoint>& points) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> pos(-BOUNDS, BOUNDS);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::uniform_real_distribution<float> band(-wallBandEpsilon, wallBandEpsilon);
+    points.resize(count);
+    size_t numSolids = cubes.size() + ramps.size();
+    for (QueryPoint& p : points) {
+        if (set == POINTS_RANDOM || numSolids == 0) {
+            p.x = pos(rng); p.y = 6.0f * unit(rng); p.z = pos(rng);
+        } else if (set == POINTS_EDGE) {
+            size_t k = rng() % numSolids;
+            if (k < cubes.size()) {
+                const ArenaCube& c = cubes[k];
+                p = edgePoint(rng, c.x - c.sizeX / 2.0f, c.x + c.sizeX / 2.0f,
+                              c.z - c.sizeZ / 2.0f, c.z + c.sizeZ / 2.0f, c.y + c.sizeY / 2.0f);
+            } else {
+                const ArenaRamp& r = ramps[k - cubes.size()];
+                p = edgePoint(rng, r.x - r.sizeX / 2.0f, r.x + r.sizeX / 2.0f,
+                              r.z - r.sizeZ / 2.0f, r.z + r.sizeZ / 2.0f, r.y + r.sizeY / 2.0f);
+            }
+        } else if (set == POINTS_SEAM && !ramps.empty()) {
+            // Ujung bawah/atas kemiringan ramp, tempat ramp menyambung ke lantai
+            // atau platform berikutnya, digeser sangat sedikit ke kedua sisi
+            const ArenaRamp& r = ramps[rng() % ramps.size()];
+            bool high = unit(rng) < 0.5f;
+            float jitter = (unit(rng) - 0.5f) * 2e-3f;
+            float across = unit(rng) - 0.5f;
+            float baseY = r.y - r.sizeY / 2.0f;
+            if (r.axis == 'z') {
+                p.z = (high ? r.z + r.sizeZ / 2.0f : r.z - r.sizeZ / 2.0f) + jitter;
+                p.x = r.x + across * r.sizeX;
+            } else {
+                p.x = (high ? r.x + r.sizeX / 2.0f : r.x - r.sizeX / 2.0f) + jitter;
+                p.z = r.z + across * r.sizeZ;
+            }
+            p.y = (high ? baseY + r.sizeY : baseY) + 0.3f * unit(rng);
+        } else {
+            // Pita +-epsilon di sisi cube (termasuk sudut), setinggi dinding
+            const ArenaCube& c = cubes.empty() ? ArenaCube{0.0f, 0.5f, 0.0f, 1.0f, 1.0f, 1.0f} : cubes[rng() % cubes.size()];
+            float minX = c.x - c.sizeX / 2.0f, maxX = c.x + c.sizeX / 2.0f;
+            float minZ = c.z - c.sizeZ / 2.0f, maxZ = c.z + c.sizeZ / 2.0f;
+            float f = unit(rng);
+            switch (rng() % 5) {
+                case 0: p.x = minX + band(rng); p.z = minZ + f * (maxZ - minZ); break;
+                case 1: p.x = maxX + band(rng); p.z = minZ + f * (maxZ - minZ); break;
+                case 2: p.z = minZ + band(rng); p.x = minX + f * (maxX - minX); break;
+                case 3: p.z = maxZ + band(rng); p.x = minX + f * (maxX - minX); break;
+                default:
+                    p.x = (unit(rng) < 0.5f ? minX : maxX) + band(rng);
+                    p.z = (unit(rng) < 0.5f ? minZ : maxZ) + band(rng);
+                    break;
+            }
+            p.y = c.y + (unit(rng) - 0.5f) * c.sizeY;
+        }
+    }
+}
+
+static volatile float querySink = 0.0f;
+
+// Ketiga query terrain dengan setting yang dipakai game (grid + fast path heightfield)
+static void benchQueryPoints(int numPrimitives) {
+    buildRandomLevel(numPrimitives, 1234u + numPrimitives);
+    finalizeArenaGeometry();
+    const int numQueries = 100000, repeats = 3;
+    std::vector<QueryPoint> points;
+    std::vector<QueryResult> results(numQueries);
+    for (int set = 0; set < POINT_SET_COUNT; ++set) {
+        makePointSet((PointSet)set, numQueries, 300u + set, points);
+        double heightNs = bestNsPerItem(repeats, numQueries, [&] {
+            float sum = 0.0f;
+            for (const QueryPoint& p : points) sum += getArenaHeight(p.x, p.z);
+            querySink = sum;
+        });
+        double normalNs = runSurfaceQueries(points, results);
+        double atNs = runQueries(points, results);
+        querySink = results[numQueries / 2].h;
+
+        printf("%10d %10s %14.1f %14.1f %14.1f\n", numPrimitives, pointSetNames[set], heightNs, normalNs, atNs);
+        std::string suffix = std::string(pointSetNames[set]) + "/" + std::to_string(numPrimitives);
+        recordResult("query/height/" + suffix, heightNs, "ns");
+        recordResult("query/height_normal/" + suffix, normalNs, "ns");
+        recordResult("query/height_normal_at/" + suffix, atNs, "ns");
+    }
+}
+
+// Satu tick updatePhysics penuh (input, CCD, terrain, trigger). numPrimitives 0 = arena bawaan.
+static void benchPhysicsTick(int numPrimitives) {
+    if (numPrimitives > 0) {
+        buildRandomLevel(numPrimitives, 77u + numPrimitives);
+        finalizeArenaGeometry();
+    } else {
+        setupArenaGeometry();
+    }
+    clearCheckpoints();
+    syncLevelTriggers();
+    const int numTicks = 50000;
+    std::streambuf* out = std::cout.rdbuf(nullptr);
+    double best = 0.0;
+    for (int r = 0; r < 3; ++r) {
+        double ns = physicsTickNs(numTicks);
+        if (r == 0 || ns < best) best = ns;
+    }
+    std::cout.rdbuf(out);
+    std::cout.clear();
+
+    std::string level = numPrimitives > 0 ? std::to_string(numPrimitives) : "builtin";
+    printf("%10s %10d %14.1f\n", level.c_str(), numTicks, best);
+    recordResult("physics/tick/" + level, best, "ns");
+}
+
+// Rasterisasi CreateCube/CreateRamp ke arenaHeights, lalu finalizeArenaGeometry
+// (grid, heightfield, bounds, cull, LOD) untuk primitive yang sama
+static void benchSetup(int numPrimitives) {
+    buildRandomLevel(numPrimitives, 1234u + numPrimitives);
+    std::vector<ArenaCube> cubeList = cubes;
+    std::vector<ArenaRamp> rampList = ramps;
+    const int repeats = 3;
+    double createUs = bestNsPerItem(repeats, 1, [&] {
+        clearArenaGeometry();
+        for (const ArenaCube& c : cubeList) CreateCube(c.x, c.y, c.z, c.sizeX, c.sizeY, c.sizeZ);
+        for (const ArenaRamp& r : rampList) CreateRamp(r.x, r.y, r.z, r.sizeX, r.sizeY, r.sizeZ, r.axis);
+    }) / 1000.0;
+    double finalizeUs = bestNsPerItem(repeats, 1, [] { finalizeArenaGeometry(); }) / 1000.0;
+
+    printf("%10d %14.1f %14.3f %14.1f\n", numPrimitives, createUs, createUs * 1000.0 / numPrimitives, finalizeUs);
+    std::string n = std::to_string(numPrimitives);
+    recordResult("setup/create/" + n, createUs, "us");
+    recordResult("setup/finalize/" + n, finalizeUs, "us");
+}
+
+static void benchBuiltinSetup() {
+    double setupUs = bestNsPerItem(5, 1, [] { setupArenaGeometry(); }) / 1000.0;
+    printf("%10s %14s %14s %14.1f   (setupArenaGeometry, %d cube + %d ramp)\n",
+           "builtin", "", "", setupUs, (int)cubes.size(), (int)ramps.size());
+    recordResult("setup/builtin", setupUs, "us");
+}
+
+static bool writeBenchJson(const char* path) {
+    FILE* f = fopen(path, "w");
+    if (!f) return false;
+    fprintf(f, "{\n\"benchmark\": \"marble_bench\",\n\"results\": [\n");
+    for (size_t i = 0; i < benchResults.size(); ++i) {
+        const BenchResult& r = benchResults[i];
+        // Hash 32 bit butuh 10 digit penuh
+        const char* format = r.unit == "hash" ? "{\"name\": \"%s\", \"value\": %.0f, \"unit\": \"%s\"}%s\n"
+                                              : "{\"name\": \"%s\", \"value\": %.9g, \"unit\": \"%s\"}%s\n";
+        fprintf(f, format, r.name.c_str(), r.value, r.unit.c_str(), i + 1 < benchResults.size() ? "," : "");
+    }
+    fprintf(f, "]\n}\n");
+    return fclose(f) == 0;
+}
+
+// Baca JSON tulisan writeBenchJson (satu hasil per baris). false kalau file tidak bisa dibuka.
+static bool readBenchJson(const char* path, std::vector<BenchResult>& out) {
+    FILE* f = fopen(path, "r");
+    if (!f) return false;
+    char line[512], name[256], unit[32];
+    double value;
+    while (fgets(line, sizeof(line), f)) {
+        if (sscanf(line, " {\"name\": \"%255[^\"]\", \"value\": %lf, \"unit\": \"%31[^\"]\"", name, &value, unit) == 3) {
+            out.push_back({name, value, unit});
+        }
+    }
+    fclose(f);
+    return true;
+}
+
+// Return jumlah regresi terhadap baseline
+static int compareBenchResults(const std::vector<BenchResult>& baseline, double thresholdPercent) {
+    int regressions = 0, compared = 0;
+    printf("\nDibanding baseline (ambang %.0f%%):\n", thresholdPercent);
+    for (const BenchResult& r : benchResults) {
+        const BenchResult* old = nullptr;
+        for (const BenchResult& b : baseline) {
+            if (b.name == r.name) { old = &b; break; }
+        }
+        if (!old) continue;
+        ++compared;
+        bool timing = r.unit == "ns" || r.unit == "us";
+        double change = old->value != 0.0 ? 100.0 * (r.value - old->value) / old->value : 0.0;
+        bool regressed = timing ? change > thresholdPercent
+                       : r.unit == "hash" ? r.value != old->value
+                       : r.value > old->value + 1e-6 * std::fabs(old->value);
+        bool improved = timing && change < -thresholdPercent;
+        if (!regressed && !improved) continue;
+        printf("  %-40s %12.4g -> %12.4g %s %+7.1f%%  %s\n", r.name.c_str(), old->value, r.value,
+               r.unit.c_str(), change, regressed ? "REGRESSION" : "faster");
+        if (regressed) ++regressions;
+    }
+    printf("  %d hasil dibandingkan, %d regresi\n", compared, regressions);
+    return regressions;
+}
+
+int main(int argc, char** argv) {
+    const char* jsonPath = nullptr;
+    const char* comparePath = nullptr;
+    double thresholdPercent = 10.0;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--json" && i + 1 < argc) jsonPath = argv[++i];
+        else if (arg == "--compare" && i + 1 < argc) comparePath = argv[++i];
+        else if (arg == "--threshold" && i + 1 < argc) thresholdPercent = atof(argv[++i]);
+        else {
+            fprintf(stderr, "Usage: %s [--json FILE] [--compare BASELINE.json] [--threshold PERCENT]\n", argv[0]);
+            return 2;
+        }
+    }
+    std::vector<BenchResult> baseline;
+    if (comparePath && !readBenchJson(comparePath, baseline)) {
+        fprintf(stderr, "Cannot read baseline %s\n", comparePath);
+        return 2;
+    }
+
+    printf("getArenaHeightAndNormalAt: scan linear vs grid broadphase\n");
+    printf("%10s %10s %14s %14s %10s %11s\n",
+           "primitives", "queries", "linear ns/q", "grid ns/q", "speedup", "mismatches");
+    const int levelSizes[] = {10, 1000, 100000};
+    for (int n : levelSizes) {
+        benchLevel(n);
+    }
+
+    printf("\ngetArenaHeightAndNormal: query exact vs fast path heightfield\n");
+    printf("%10s %10s %14s %14s %10s %11s %11s\n",
+           "primitives", "queries", "exact ns/q", "fast ns/q", "speedup", "max dh", "max dn");
+    for (int n : levelSizes) {
+        benchHeightfield(n);
+    }
+
+    printf("\ngetArenaHeightAndNormalAtBatch: sapuan CCD %d probe, per titik vs batch\n", sweepProbes);
+    printf("%16s %10s %14s %14s %10s %11s\n",
+           "prims@origin", "sweeps", "single ns/sw", "batch ns/sw", "speedup", "mismatches");
+    for (int n : levelSizes) {
+        benchBatch(n, 0.0f, 0.0f);
+    }
+    // Jendela streaming yang bergeser di satu sumbu dan di dua sumbu
+    benchBatch(1000, 20.0f, 0.0f);
+    benchBatch(1000, -40.0f, 60.0f);
+
+    printf("\nEdit cube/ramp runtime: per edit vs bangun ulang penuh\n");
+    printf("%10s %10s %14s %14s %10s %11s\n",
+           "primitives", "edits", "edit us", "rebuild us", "speedup", "mismatches");
+    for (int n : levelSizes) {
+        benchEdits(n);
+    }
+
+    printf("\nHot reload level (cooked): pollLevelHotReload (5 kali) vs load penuh\n");
+    printf("%10s %10s %10s %10s %10s %10s %11s\n",
+           "primitives", "edits", "best ms", "worst ms", "full ms", "speedup", "mismatches");
+    // Output load/cook/reload dari level.cpp tidak ikut dicetak
+    std::cout.setstate(std::ios::failbit);
+    const int reloadSizes[] = {10000, 100000};
+    for (int n : reloadSizes) {
+        benchReload(n);
+    }
+    std::cout.clear();
+
+    printf("\nJendela streaming: pasang delta vs pasang utuh (rata-rata per jendela)\n");
+    printf("%10s %10s %10s %10s %10s %10s %11s\n",
+           "primitives", "windows", "delta ms", "worst ms", "full ms", "speedup", "mismatches");
+    std::cout.setstate(std::ios::failbit);
+    const int streamSizes[] = {10000, 100000};
+    for (int n : streamSizes) {
+        benchStreamWindow(n);
+    }
+    std::cout.clear();
+
+    printf("\nTrigger per tick (checkpoint + coin): scan semua volume vs broadphase\n");
+    printf("%10s %10s %14s %14s %10s %11s\n",
+           "volumes", "ticks", "linear ns/t", "hash ns/t", "speedup", "mismatches");
+    const int triggerCounts[] = {10, 300, 5000};
+    for (int n : triggerCounts) {
+        benchTriggers(n);
+    }
+
+    printf("\nProfiler: biaya zona, mati vs nyala\n");
+    printf("%10s %14s %14s\n", "", "off ns", "on ns");
+    benchProfiler();
+
+    printf("\nQuery terrain per jenis titik (grid + heightfield, terbaik dari 3)\n");
+    printf("%10s %10s %14s %14s %14s\n",
+           "primitives", "points", "height ns/q", "normal ns/q", "at ns/q");
+    for (int n : levelSizes) {
+        benchQueryPoints(n);
+    }
+
+    printf("\nTick updatePhysics penuh (input, CCD, terrain, trigger)\n");
+    printf("%10s %10s %14s\n", "level", "ticks", "ns/tick");
+    benchPhysicsTick(0);
+    for (int n : levelSizes) {
+        benchPhysicsTick(n);
+    }
+
+    printf("\nSetup level: rasterisasi CreateCube/CreateRamp lalu finalizeArenaGeometry\n");
+    printf("%10s %14s %14s %14s\n", "primitives", "create us", "create ns/prim", "finalize us");
+    const int setupSizes[] = {10, 1000, 10000, 100000};
+    for (int n : setupSizes) {
+        benchSetup(n);
+    }
+    benchBuiltinSetup();
+
+    printf("\nReplay: rekam input acak lalu putar ulang, state akhir harus sama dengan footer\n");
+    printf("%10s %10s %10s %10s %10s %11s\n", "level", "ticks", "record ms", "replay ms", "state hash", "mismatches");
+    // Output load level dari level.cpp tidak ikut dicetak
+    std::cout.setstate(std::ios::failbit);
+    useBuiltinLevel();
+    int replayMismatches = benchReplay("builtin", 7u, 20000);
+    replayMismatches += benchStreamedReplay(20000);
+    std::cout.clear();
+
+    if (jsonPath) {
+        if (!writeBenchJson(jsonPath)) {
+            fprintf(stderr, "Cannot write %s\n", jsonPath);
+            return 2;
+        }
+        printf("\n%d hasil ditulis ke %s\n", (int)benchResults.size(), jsonPath);
+    }
+    if (comparePath && compareBenchResults(baseline, thresholdPercent) > 0) return 1;
+    if (replayMismatches > 0) {
+        fprintf(stderr, "replay DIVERGED from recording (%d)\n", replayMismatches);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include "marble.h"
+#include "globals.h"
+#include "graphics.h"
+#include "primitivemesh.h"
+#include "arenalod.h"
+#include "profiler.h"
+#include <GL/glut.h>
+#include <GL/glu.h>
+
+// Dipanggil sekali per substep physics, jadi putaran marble tidak ikut frame rate
+void updateMarbleRotation() {
+    if (marbleRadius > 1e-6f && deltaTime > 0.0f) {
+        float deltaAngleX = (marbleVZ * deltaTime / marbleRadius) * (180.0f / 3.1415926535f);
+        float deltaAngleZ = (marbleVX * deltaTime / marbleRadius) * (180.0f / 3.1415926535f);
+        totalRotationAngleX += deltaAngleX;
+        totalRotationAngleZ += deltaAngleZ;
+    }
+}
+
+// LOD marble: slices per level dan batas diameter di layar (pixel) antar level,
+// pindah level harus lewat batas +-15% supaya tidak bolak-balik saat zoom
+static const int marbleLodSlices[] = {32, 24, 16, 12};
+static const float marbleLodPixels[] = {120.0f, 60.0f, 25.0f};
+static const int MARBLE_LOD_LEVELS = sizeof(marbleLodSlices) / sizeof(marbleLodSlices[0]);
+static int marbleLodLevel = 0;
+
+static int selectMarbleSlices() {
+    if (!isArenaLodEnabled()) {
+        marbleLodLevel = 0;
+        return marbleLodSlices[0];
+    }
+    float size = arenaProjectedSize(renderMarbleX, renderMarbleY, renderMarbleZ, 0.5f);
+    while (marbleLodLevel > 0 && size > marbleLodPixels[marbleLodLevel - 1] * 1.15f) --marbleLodLevel;
+    while (marbleLodLevel < MARBLE_LOD_LEVELS - 1 && size < marbleLodPixels[marbleLodLevel] * 0.85f) ++marbleLodLevel;
+    return marbleLodSlices[marbleLodLevel];
+}
+
+void drawMarble() {
+    PROFILE_ZONE("drawMarble");
+    int slices = selectMarbleSlices();
+    glPushMatrix();
+    glTranslatef(renderMarbleX, renderMarbleY, renderMarbleZ);
+
+    glRotatef(totalRotationAngleX, 1.0f, 0.0f, 0.0f);
+    glRotatef(totalRotationAngleZ, 0.0f, 0.0f, 1.0f);    
+    
+    glEnable(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, marbleTextureID);
+
+    glDisable(GL_COLOR_MATERIAL);
+
+    GLfloat marble_ambient[] = {0.8f, 0.8f, 0.8f, 1.0f};
+    GLfloat marble_diffuse[] = {1.0f, 1.0f, 1.0f, 1.0f}; 
+    GLfloat marble_specular[] = {0.7f, 0.7f, 0.7f, 1.0f};
+    GLfloat marble_shininess = 50.0f;
+
+    glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, marble_ambient);
+    glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, marble_diffuse);
+    glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, marble_specular);
+    glMaterialf(GL_FRONT_AND_BACK, GL_SHININESS, marble_shininess);
+    
+    drawPrimitiveTexturedSphere(0.5f, slices);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glDisable(GL_TEXTURE_2D);
+    glEnable(GL_COLOR_MATERIAL); 
+
+    glPopMatrix();
+}
@@ -0,0 +1,402 @@
+// marble_render: benchmark render offscreen dan cek gambar golden, untuk mesin
+// build tanpa display. Context GL dibuat lewat EGL pbuffer (Mesa surfaceless; tanpa
+// GPU jadinya llvmpipe), lalu renderFrame() yang sama dengan game digambar di
+// sepanjang jalur kamera tetap: menyusuri checkpoint level berurutan sampai
+// finish (atau memutari arena kalau titiknya kurang dari 2), kamera di belakang
+// arah jalan. Per frame dicatat waktu (renderFrame + glFinish) dan jumlah draw
+// call, dilaporkan sebagai rata-rata/persentil.
+//
+// Frame tiap --golden-every dibaca ke PPM: --write-golden DIR menyimpannya,
+// --golden DIR membandingkan (pixel dengan selisih channel > --tolerance
+// dihitung beda, frame gagal kalau lebih dari --max-bad persen pixel). Frame
+// gagal ditulis ke DIR sebagai *_actual.ppm dan *_diff.ppm, exit code 1.
+// Golden dibuat di commit lama dengan driver yang sama, lalu dicek di commit baru.
+//
+// HUD tidak digambar: glyph-nya dari font GLUT yang butuh glutInit (display X).
+#include "globals.h"
+#include "arena.h"
+#include "checkpoint.h"
+#include "graphics.h"
+#include "simulation.h"
+#include "level.h"
+#include "arenamesh.h"
+#include "arenacull.h"
+#include "propinstances.h"
+#include "glbuffer.h"
+#include "profiler.h"
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GL/gl.h>
+#include <GL/glext.h>
+#include <dlfcn.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// --- Hitung draw call ---
+// Definisi di executable ini menimpa fungsi libGL (seperti operator new di
+// alloccounter.cpp), termasuk panggilan dari dalam GLU. Entry point yang
+// diambil lewat glProcLoader dibungkus di renderProcLoader.
+static long long drawCalls = 0;
+
+template <typename T>
+static T nextGLProc(const char* name) {
+    return (T)dlsym(RTLD_NEXT, name);
+}
+
+extern "C" {
+void GLAPIENTRY glBegin(GLenum mode) {
+    static auto real = nextGLProc<void (GLAPIENTRY*)(GLenum)>("glBegin");
+    ++drawCalls;
+    real(mode);
+}
+
+void GLAPIENTRY glDrawArrays(GLenum mode, GLint first, GLsizei count) {
+    static auto real = nextGLProc<void (GLAPIENTRY*)(GLenum, GLint, GLsizei)>("glDrawArrays");
+    ++drawCalls;
+    real(mode, first, count);
+}
+
+void GLAPIENTRY glDrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices) {
+    static auto real = nextGLProc<void (GLAPIENTRY*)(GLenum, GLsizei, GLenum, const GLvoid*)>("glDrawElements");
+    ++drawCalls;
+    real(mode, count, type, indices);
+}
+}
+
+static PFNGLMULTIDRAWELEMENTSPROC realMultiDrawElements = nullptr;
+static PFNGLDRAWELEMENTSINSTANCEDPROC realDrawElementsInstanced = nullptr;
+
+static void GLAPIENTRY countedMultiDrawElements(GLenum mode, const GLsizei* count, GLenum type,
+                                                const void* const* indices, GLsizei drawCount) {
+    ++drawCalls;
+    realMultiDrawElements(mode, count, type, indices, drawCount);
+}
+
+static void GLAPIENTRY countedDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type,
+                                                    const void* indices, GLsizei instances) {
+    ++drawCalls;
+    realDrawElementsInstanced(mode, count, type, indices, instances);
+}
+
+static GLProc renderProcLoader(const char* name) {
+    GLProc proc = (GLProc)eglGetProcAddress(name);
+    if (!proc) return nullptr;
+    if (strcmp(name, "glMultiDrawElements") == 0) {
+        realMultiDrawElements = (PFNGLMULTIDRAWELEMENTSPROC)proc;
+        return (GLProc)countedMultiDrawElements;
+    }
+    if (strcmp(name, "glDrawElementsInstanced") == 0 || strcmp(name, "glDrawElementsInstancedARB") == 0) {
+        realDrawElementsInstanced = (PFNGLDRAWELEMENTSINSTANCEDPROC)proc;
+        return (GLProc)countedDrawElementsInstanced;
+    }
+    return proc;
+}
+
+// Hook aplikasi di graphics.h yang dipanggil timer GLUT. Di sini tidak ada
+// timer: simulasi tidak jalan, streaming dipasang per frame oleh placeCamera.
+void initGame() {
+    initSimulation();
+    initGraphics();
+}
+void hotReloadLevel() {}
+void streamLevel() {}
+void streamLevelTick() {}
+
+static bool createOffscreenContext(int width, int height) {
+    EGLDisplay display = EGL_NO_DISPLAY;
+    auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (getPlatformDisplay) display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    if (display == EGL_NO_DISPLAY) display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    EGLint major, minor;
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor)) return false;
+    const EGLint configAttribs[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_DEPTH_SIZE, 24, EGL_NONE
+    };
+    EGLConfig config;
+    EGLint numConfigs = 0;
+    if (!eglChooseConfig(display, configAttribs, &config, 1, &numConfigs) || numConfigs == 0) return false;
+    const EGLint surfaceAttribs[] = {EGL_WIDTH, width, EGL_HEIGHT, height, EGL_NONE};
+    EGLSurface surface = eglCreatePbufferSurface(display, config, surfaceAttribs);
+    if (surface == EGL_NO_SURFACE || !eglBindAPI(EGL_OPENGL_API)) return false;
+    EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, nullptr);
+    return context != EGL_NO_CONTEXT && eglMakeCurrent(display, surface, surface, context);
+}
+
+// --- Jalur kamera ---
+
+static std::vector<Vec3> cameraPath; // Titik XZ berurutan (y tidak dipakai)
+static std::vector<float> cameraPathLength; // Panjang kumulatif sampai titik ke-i
+
+static void buildCameraPath() {
+    cameraPath.clear();
+    for (const Vec3& c : checkpoints) cameraPath.push_back(c);
+    if (finishSet) cameraPath.push_back(finishPosition);
+    if (cameraPath.size() < 2) {
+        cameraPath.clear();
+        const int orbitPoints = 32;
+        for (int i = 0; i <= orbitPoints; ++i) {
+            float a = 2.0f * (float)M_PI * i / orbitPoints;
+            cameraPath.push_back({arenaOriginX + 0.6f * BOUNDS * sinf(a), 0.0f, arenaOriginZ + 0.6f * BOUNDS * cosf(a)});
+        }
+    }
+    cameraPathLength.assign(1, 0.0f);
+    for (size_t i = 1; i < cameraPath.size(); ++i) {
+        float dx = cameraPath[i].x - cameraPath[i - 1].x, dz = cameraPath[i].z - cameraPath[i - 1].z;
+        cameraPathLength.push_back(cameraPathLength.back() + sqrtf(dx * dx + dz * dz));
+    }
+}
+
+static void cameraPathPoint(float distance, float& x, float& z) {
+    distance = std::max(0.0f, std::min(distance, cameraPathLength.back()));
+    size_t i = 1;
+    while (i + 1 < cameraPath.size() && cameraPathLength[i] < distance) ++i;
+    float segment = cameraPathLength[i] - cameraPathLength[i - 1];
+    float f = segment > 0.0f ? (distance - cameraPathLength[i - 1]) / segment : 0.0f;
+    x = cameraPath[i - 1].x + f * (cameraPath[i].x - cameraPath[i - 1].x);
+    z = cameraPath[i - 1].z + f * (cameraPath[i].z - cameraPath[i - 1].z);
+}
+
+// Marble (target kamera) di titik t (0..1) jalur, kamera di belakangnya menghadap
+// titik sedikit di depan. Jendela streaming ikut dipasang seperti di game.
+static void placeCamera(float t) {
+    const float lookAhead = 3.0f;
+    float distance = t * cameraPathLength.back();
+    float x, z, aheadX, aheadZ;
+    cameraPathPoint(distance, x, z);
+    cameraPathPoint(distance + lookAhead, aheadX, aheadZ);
+    if (aheadX == x && aheadZ == z) {
+        // Ujung jalur: lanjutkan arah dari titik di belakang
+        float backX, backZ;
+        cameraPathPoint(distance - lookAhead, backX, backZ);
+        aheadX = 2.0f * x - backX;
+        aheadZ = 2.0f * z - backZ;
+    }
+
+    unsigned changed = updateLevelStreaming(x, z, true);
+    if (changed) {
+        rebakeArenaMesh(changed);
+        rebuildPropInstances(changed);
+    }
+    marbleX = renderMarbleX = x;
+    marbleZ = renderMarbleZ = z;
+    marbleY = renderMarbleY = getArenaHeight(x, z) + marbleRadius;
+    cameraAngleX = atan2f(x - aheadX, z - aheadZ) * 180.0f / (float)M_PI;
+    cameraAngleY = 30.0f; // Cukup tinggi untuk melihat dari atas rintangan, dalam batas mouse (5..85)
+}
+
+// --- Golden image (PPM biner, baris atas dulu) ---
+
+struct FrameImage {
+    int width = 0, height = 0;
+    std::vector<unsigned char> rgb;
+};
+
+static void readFrame(FrameImage& image, int width, int height) {
+    image.width = width;
+    image.height = height;
+    image.rgb.resize((size_t)width * height * 3);
+    std::vector<unsigned char> rows(image.rgb.size());
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, rows.data());
+    size_t stride = (size_t)width * 3;
+    for (int y = 0; y < height; ++y) {
+        memcpy(&image.rgb[y * stride], &rows[(height - 1 - y) * stride], stride);
+    }
+}
+
+static bool writePPM(const std::string& path, const FrameImage& image) {
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) return false;
+    fprintf(f, "P6\n%d %d\n255\n", image.width, image.height);
+    fwrite(image.rgb.data(), 1, image.rgb.size(), f);
+    return fclose(f) == 0;
+}
+
+static bool readPPM(const std::string& path, FrameImage& image) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+    int maxValue = 0;
+    bool ok = fscanf(f, "P6 %d %d %d", &image.width, &image.height, &maxValue) == 3 && maxValue == 255 &&
+              image.width > 0 && image.height > 0 && fgetc(f) != EOF;
+    if (ok) {
+        image.rgb.resize((size_t)image.width * image.height * 3);
+        ok = fread(image.rgb.data(), 1, image.rgb.size(), f) == image.rgb.size();
+    }
+    fclose(f);
+    return ok;
+}
+
+struct GoldenOptions {
+    const char* compareDir = nullptr;
+    const char* writeDir = nullptr;
+    int every = 30;
+    int tolerance = 8;
+    float maxBadPercent = 0.1f;
+};
+
+// Return false kalau frame beda dari golden (atau golden tidak bisa dibaca)
+static bool checkGoldenFrame(const GoldenOptions& golden, int frame, const FrameImage& actual) {
+    char name[32];
+    snprintf(name, sizeof(name), "frame_%04d", frame);
+    if (golden.writeDir) {
+        std::string path = std::string(golden.writeDir) + "/" + name + ".ppm";
+        if (!writePPM(path, actual)) {
+            printf("golden: cannot write %s\n", path.c_str());
+            return false;
+        }
+    }
+    if (!golden.compareDir) return true;
+
+    std::string base = std::string(golden.compareDir) + "/" + name;
+    FrameImage expected;
+    if (!readPPM(base + ".ppm", expected)) {
+        printf("golden %s: cannot read %s.ppm\n", name, base.c_str());
+        return false;
+    }
+    if (expected.width != actual.width || expected.height != actual.height) {
+        printf("golden %s: size %dx%d, expected %dx%d\n", name, actual.width, actual.height, expected.width, expected.height);
+        return false;
+    }
+    int badPixels = 0, maxDiff = 0;
+    FrameImage diff = expected;
+    for (size_t p = 0; p < actual.rgb.size(); p += 3) {
+        int d = 0;
+        for (int c = 0; c < 3; ++c) d = std::max(d, std::abs((int)actual.rgb[p + c] - (int)expected.rgb[p + c]));
+        maxDiff = std::max(maxDiff, d);
+        bool bad = d > golden.tolerance;
+        badPixels += bad;
+        // Pixel beda merah, sisanya golden digelapkan
+        for (int c = 0; c < 3; ++c) diff.rgb[p + c] = bad ? (c == 0 ? 255 : 0) : expected.rgb[p + c] / 4;
+    }
+    float badPercent = 100.0f * badPixels / (actual.width * actual.height);
+    bool ok = badPercent <= golden.maxBadPercent;
+    printf("golden %s: %s (%d pixels = %.3f%% over tolerance %d, max channel diff %d)\n",
+           name, ok ? "ok" : "FAILED", badPixels, badPercent, golden.tolerance, maxDiff);
+    if (!ok) {
+        writePPM(base + "_actual.ppm", actual);
+        writePPM(base + "_diff.ppm", diff);
+    }
+    return ok;
+}
+
+static float percentile(std::vector<float> values, float p) {
+    std::sort(values.begin(), values.end());
+    return values[(size_t)(p * (values.size() - 1) + 0.5f)];
+}
+
+// marble_render [level.lvl|level.lvlc] [--frames N] [--size WxH] [--golden DIR]
+//   [--write-golden DIR] [--golden-every N] [--tolerance N] [--max-bad PERCENT] [--profile FILE]
+int main(int argc, char** argv) {
+    setProfileThreadName("main");
+    const char* levelPath = nullptr;
+    const char* profilePath = nullptr;
+    int numFrames = 240, width = 800, height = 600;
+    GoldenOptions golden;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--frames" && hasValue) numFrames = atoi(argv[++i]);
+        else if (arg == "--size" && hasValue) {
+            if (sscanf(argv[++i], "%dx%d", &width, &height) != 2) width = 0;
+        }
+        else if (arg == "--golden" && hasValue) golden.compareDir = argv[++i];
+        else if (arg == "--write-golden" && hasValue) golden.writeDir = argv[++i];
+        else if (arg == "--golden-every" && hasValue) golden.every = atoi(argv[++i]);
+        else if (arg == "--tolerance" && hasValue) golden.tolerance = atoi(argv[++i]);
+        else if (arg == "--max-bad" && hasValue) golden.maxBadPercent = (float)atof(argv[++i]);
+        else if (arg == "--profile" && hasValue) profilePath = argv[++i];
+        else if (arg[0] != '-' && !levelPath) levelPath = argv[i];
+        else {
+            printf("Usage: %s [level] [--frames N] [--size WxH] [--golden DIR] [--write-golden DIR]\n"
+                   "       [--golden-every N] [--tolerance N] [--max-bad PERCENT] [--profile FILE]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (numFrames < 1 || width < 1 || height < 1 || golden.every < 1) {
+        printf("frames, size and golden-every must be positive\n");
+        return 2;
+    }
+    if (levelPath) {
+        if (!loadLevelFile(levelPath)) {
+            printf("level: %s\n", levelLoadError());
+            return 1;
+        }
+    } else if (!loadLevelFile("levels/arena1.lvl")) {
+        printf("Using builtin level (%s)\n", levelLoadError());
+    }
+    if (golden.writeDir) mkdir(golden.writeDir, 0755);
+
+    if (!createOffscreenContext(width, height)) {
+        printf("Cannot create offscreen EGL context (error 0x%x)\n", eglGetError());
+        return 1;
+    }
+    glProcLoader = renderProcLoader;
+    showHud = false;
+    initGame();
+    reshape(width, height);
+    buildCameraPath();
+    printf("Rendering %s at %dx%d on %s (%s)\n", currentLevelName(), width, height,
+           (const char*)glGetString(GL_RENDERER), (const char*)glGetString(GL_VERSION));
+
+    // Frame tetap 1/60 s untuk crossfade LOD, supaya gambar sama tiap run.
+    // Beberapa frame pertama (upload buffer, compile shader) tidak dihitung.
+    const float frameSeconds = 1.0f / 60.0f;
+    const int warmupFrames = 5;
+    placeCamera(0.0f);
+    for (int i = 0; i < warmupFrames; ++i) {
+        renderFrame(width, height, frameSeconds);
+        glFinish();
+    }
+
+    if (profilePath) setProfilerEnabled(true);
+    std::vector<float> frameMs(numFrames);
+    std::vector<long long> frameDrawCalls(numFrames);
+    long long objectsDrawn = 0;
+    int goldenFrames = 0, goldenFailures = 0;
+    FrameImage image;
+    for (int f = 0; f < numFrames; ++f) {
+        placeCamera(numFrames > 1 ? (float)f / (numFrames - 1) : 0.0f);
+        drawCalls = 0;
+        auto start = std::chrono::steady_clock::now();
+        {
+            PROFILE_ZONE("renderFrame + glFinish");
+            renderFrame(width, height, frameSeconds);
+            glFinish();
+        }
+        frameMs[f] = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+        frameDrawCalls[f] = drawCalls;
+        objectsDrawn += arenaCullStats().objectsDrawn;
+        profileFrameMark();
+        if ((golden.compareDir || golden.writeDir) && f % golden.every == 0) {
+            readFrame(image, width, height);
+            ++goldenFrames;
+            if (!checkGoldenFrame(golden, f, image)) ++goldenFailures;
+        }
+    }
+
+    double totalMs = 0.0;
+    for (float ms : frameMs) totalMs += ms;
+    long long totalCalls = 0;
+    for (long long calls : frameDrawCalls) totalCalls += calls;
+    auto callRange = std::minmax_element(frameDrawCalls.begin(), frameDrawCalls.end());
+    printf("%d frames: mean %.3f ms (%.1f fps), p50 %.3f, p95 %.3f, p99 %.3f, max %.3f ms\n",
+           numFrames, totalMs / numFrames, 1000.0 * numFrames / totalMs, percentile(frameMs, 0.50f),
+           percentile(frameMs, 0.95f), percentile(frameMs, 0.99f), *std::max_element(frameMs.begin(), frameMs.end()));
+    printf("draw calls per frame: mean %.1f, min %lld, max %lld; objects drawn per frame: mean %.1f\n",
+           (double)totalCalls / numFrames, *callRange.first, *callRange.second, (double)objectsDrawn / numFrames);
+    if (golden.writeDir) printf("golden: %d frames written to %s\n", goldenFrames, golden.writeDir);
+    if (golden.compareDir) printf("golden: %d frames checked, %d failed\n", goldenFrames, goldenFailures);
+    if (profilePath) {
+        setProfilerEnabled(false);
+        writeProfileTrace(profilePath);
+    }
+    return goldenFailures > 0 ? 1 : 0;
+}
@@ -0,0 +1,249 @@
+// marble_sim: menjalankan simulasi tanpa window/OpenGL secepat mungkin dan
+// mengukur throughput simulasi dalam tick per detik.
+//
+//   marble_sim [--ticks N] [--hold up|down|left|right]...
+//   marble_sim --marbles N [--ticks N]   (MarbleWorld, N marble sekaligus)
+//   marble_sim --level levels/arena1.lvl ...  (level dari file, default level bawaan)
+//   marble_sim --cook in.lvl out.lvlc    (level teks -> cooked, lalu keluar)
+//   marble_sim --replay run.rec          (putar ulang rekaman MarbleGame --record)
+//   marble_sim --random-input SEED --record run.rec ...  (input acak, rekam juga)
+//   marble_sim --profile trace.json ...  (zona profiler ke Chrome trace JSON)
+//   marble_sim --profile trace.json --profile-detail ...  (plus zona per tick)
+#include "simulation.h"
+#include "globals.h"
+#include "marbleworld.h"
+#include "level.h"
+#include "inputrecord.h"
+#include "simmath.h"
+#include "timer.h"
+#include "profiler.h"
+#include <chrono>
+#include <random>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static void printUsage() {
+    printf("usage: marble_sim [--level FILE] [--ticks N] [--hold up|down|left|right]...\n");
+    printf("                  [--random-input SEED] [--record RUN.rec] [--profile TRACE.json [--profile-detail]]\n");
+    printf("       marble_sim [--level FILE] --marbles N [--ticks N]\n");
+    printf("       marble_sim --cook IN.lvl OUT.lvlc\n");
+    printf("       marble_sim [--level FILE] --replay RUN.rec\n");
+}
+
+// N marble disebar di grid berjitter di seluruh arena, masing-masing dengan arah
+// dorong acak supaya terus bergerak dan saling bertabrakan
+static int runMarbleWorld(int numMarbles, long long ticks) {
+    MarbleWorld world;
+    std::mt19937 rng(99u);
+    std::uniform_real_distribution<float> jitter(-0.2f, 0.2f);
+    std::uniform_real_distribution<float> dir(-1.0f, 1.0f);
+    int side = 1;
+    while (side * side < numMarbles) ++side;
+    float spacing = (2.0f * BOUNDS - 2.0f) / side;
+    for (int i = 0; i < numMarbles; ++i) {
+        float x = -BOUNDS + 1.0f + (i % side + 0.5f) * spacing + jitter(rng);
+        float z = -BOUNDS + 1.0f + (i / side + 0.5f) * spacing + jitter(rng);
+        int m = addMarble(world, x, z);
+        world.inputX[m] = dir(rng);
+        world.inputZ[m] = dir(rng);
+    }
+
+    long long collisions = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (long long t = 0; t < ticks; ++t) {
+        stepMarbleWorld(world);
+        collisions += world.pairsColliding;
+    }
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    printf("marbles: %d, ticks: %lld\n", numMarbles, ticks);
+    printf("wall time: %.3f s (%.3f ms/tick, budget 60 Hz = 16.667 ms)\n",
+           seconds, seconds * 1000.0 / ticks);
+    printf("throughput: %.0f ticks/s, %.0f marble-steps/s\n",
+           ticks / seconds, (double)numMarbles * ticks / seconds);
+    printf("marble contacts resolved: %lld (last tick tested %d pairs)\n",
+           collisions, world.pairsTested);
+    return 0;
+}
+
+// Putar ulang rekaman secepat mungkin dengan urutan tick yang sama seperti game
+// saat merekam (step, lalu streaming dengan wait), lalu bandingkan state akhir
+// dengan footer rekaman bit per bit. Return 2 kalau hasilnya berbeda.
+static int runReplay(const char* path, bool levelGiven) {
+    if (!loadInputReplay(path)) {
+        fprintf(stderr, "replay: %s\n", inputReplayError());
+        return 1;
+    }
+    const char* level = replayLevelName();
+    if (!levelGiven) {
+        if (strcmp(level, "builtin") == 0) {
+            useBuiltinLevel();
+        } else if (!loadLevelFile(level)) {
+            fprintf(stderr, "replay level %s: %s\n", level, levelLoadError());
+            return 1;
+        }
+    }
+    initSimulation();
+
+    long long ticks = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (nextReplayTick()) {
+        // Game over/restart ikut rekaman, bukan countdown di sini
+        stepSimulation();
+        updateLevelStreaming(marbleX, marbleZ, true);
+        ++ticks;
+    }
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    ReplayFinalState got = currentReplayState();
+    const ReplayFinalState& want = replayRecordedState();
+    printf("replay: %s (level %s), ticks: %lld, math: %s\n", path, level, ticks,
+           isDeterministicMath() ? "deterministic" : "platform");
+    printf("wall time: %.3f s\n", seconds);
+    printf("throughput: %.0f ticks/s (%.1fx real time)\n",
+           ticks / seconds, ticks * deltaTime / seconds);
+    printf("marble: pos (%.3f, %.3f, %.3f) vel (%.3f, %.3f, %.3f)\n",
+           got.x, got.y, got.z, got.vx, got.vy, got.vz);
+    printf("score: %d, active checkpoint: %d\n", got.score, got.activeCheckpoint);
+    if (memcmp(&got, &want, sizeof(got)) != 0) {
+        printf("replay DIVERGED from recording: recorded pos (%.6f, %.6f, %.6f) vel (%.6f, %.6f, %.6f) score %d checkpoint %d\n",
+               want.x, want.y, want.z, want.vx, want.vy, want.vz, want.score, want.activeCheckpoint);
+        return 2;
+    }
+    printf("replay matches recording exactly\n");
+    return 0;
+}
+
+// Input acak per tick (tombol panah berganti, kamera berputar) dari mt19937 mentah,
+// yang urutannya dijamin standar, supaya seed yang sama = input yang sama di mana pun
+static void randomizeInput(std::mt19937& rng) {
+    static const int keys[4] = { KEY_ARROW_UP, KEY_ARROW_DOWN, KEY_ARROW_LEFT, KEY_ARROW_RIGHT };
+    if (rng() % 40 == 0) {
+        int key = keys[rng() % 4];
+        keyStates[key] = !keyStates[key];
+    }
+    if (rng() % 50 == 0) cameraAngleX += (float)((int)(rng() % 41) - 20) * 1.3f;
+}
+
+static int finishRun(int exitCode, const char* profilePath) {
+    if (profilePath && !writeProfileTrace(profilePath)) {
+        fprintf(stderr, "profile: cannot write %s\n", profilePath);
+        return 1;
+    }
+    return exitCode;
+}
+
+static int arrowKeyFromName(const char* name) {
+    if (strcmp(name, "up") == 0) return KEY_ARROW_UP;
+    if (strcmp(name, "down") == 0) return KEY_ARROW_DOWN;
+    if (strcmp(name, "left") == 0) return KEY_ARROW_LEFT;
+    if (strcmp(name, "right") == 0) return KEY_ARROW_RIGHT;
+    return -1;
+}
+
+int main(int argc, char** argv) {
+    setProfileThreadName("main");
+    long long ticks = 100000;
+    int heldKeys[4];
+    int numHeldKeys = 0;
+    int numMarbles = 0;
+    const char* replayPath = nullptr;
+    const char* recordPath = nullptr;
+    const char* profilePath = nullptr;
+    bool randomInput = false;
+    unsigned randomSeed = 0;
+    bool levelGiven = false;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) {
+            ticks = atoll(argv[++i]);
+        } else if (strcmp(argv[i], "--level") == 0 && i + 1 < argc) {
+            if (!loadLevelFile(argv[++i])) {
+                fprintf(stderr, "level: %s\n", levelLoadError());
+                return 1;
+            }
+            levelGiven = true;
+        } else if (strcmp(argv[i], "--cook") == 0 && i + 2 < argc) {
+            if (!cookLevelFile(argv[i + 1], argv[i + 2])) {
+                fprintf(stderr, "cook: %s\n", levelLoadError());
+                return 1;
+            }
+            return 0;
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (strcmp(argv[i], "--profile") == 0 && i + 1 < argc) {
+            profilePath = argv[++i];
+            setProfilerEnabled(true);
+        } else if (strcmp(argv[i], "--profile-detail") == 0) {
+            setProfilerDetail(true);
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordPath = argv[++i];
+        } else if (strcmp(argv[i], "--random-input") == 0 && i + 1 < argc) {
+            randomInput = true;
+            randomSeed = (unsigned)strtoul(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--marbles") == 0 && i + 1 < argc) {
+            numMarbles = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--hold") == 0 && i + 1 < argc) {
+            int key = arrowKeyFromName(argv[++i]);
+            if (key < 0 || numHeldKeys == 4) {
+                printUsage();
+                return 1;
+            }
+            heldKeys[numHeldKeys++] = key;
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (replayPath) return finishRun(runReplay(replayPath, levelGiven), profilePath);
+    initSimulation();
+    if (numMarbles > 0) {
+        return finishRun(runMarbleWorld(numMarbles, ticks), profilePath);
+    }
+    for (int k = 0; k < numHeldKeys; ++k) keyStates[heldKeys[k]] = true;
+    if (recordPath && !startInputRecording(recordPath)) {
+        fprintf(stderr, "record: cannot write %s\n", recordPath);
+        return 1;
+    }
+    std::mt19937 inputRng(randomSeed);
+
+    int gameOvers = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (long long t = 0; t < ticks; ++t) {
+        if (randomInput) randomizeInput(inputRng);
+        recordInputTick();
+        bool running = stepSimulation();
+        updateLevelStreaming(marbleX, marbleZ, true);
+        if (!running) {
+            // Sama seperti game: countdown habis, mulai ulang
+            ++gameOvers;
+            initSimulation();
+            recordInputEvent(INPUT_EVENT_RESTART);
+            for (int k = 0; k < numHeldKeys; ++k) keyStates[heldKeys[k]] = true;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    stopInputRecording();
+
+    printf("ticks: %lld\n", ticks);
+    printf("wall time: %.3f s\n", seconds);
+    printf("throughput: %.0f ticks/s (%.1fx real time)\n",
+           ticks / seconds, ticks * deltaTime / seconds);
+    printf("marble: pos (%.3f, %.3f, %.3f) vel (%.3f, %.3f, %.3f)\n",
+           marbleX, marbleY, marbleZ, marbleVX, marbleVY, marbleVZ);
+    printf("score: %d, active checkpoint: %d, game overs: %d\n",
+           score, activeCheckpointIndex, gameOvers);
+    printf("countdown left: %.3f s, checkpoint splits: %d\n",
+           getRemainingTime(), (int)getCheckpointTimes().size());
+    if (isLevelStreamed()) {
+        LevelStreamStats stats = levelStreamStats();
+        printf("streaming: %d windows installed, %d chunks loaded, %d resident\n",
+               stats.windowsInstalled, stats.chunksLoaded, stats.residentChunks);
+    }
+    return finishRun(0, profilePath);
+}
@@ -0,0 +1,154 @@
+#include "marbleworld.h"
+#include "simmath.h"
+#include "globals.h"
+#include "arena.h"
+#include "physics.h"
+#include <cmath>
+
+// Cell hash selebar satu diameter: pasangan yang bisa bersentuhan pasti ada di
+// cell sendiri atau 8 tetangganya
+static const float marbleHashCellSize = 2.0f * marbleRadius;
+
+static inline int marbleHashCoord(float v) {
+    return (int)floorf(v / marbleHashCellSize);
+}
+
+static inline int marbleHashBucket(int cx, int cz, unsigned mask) {
+    return (int)(((unsigned)cx * 73856093u ^ (unsigned)cz * 19349663u) & mask);
+}
+
+void clearMarbleWorld(MarbleWorld& world) {
+    world.posX.clear(); world.posY.clear(); world.posZ.clear();
+    world.velX.clear(); world.velY.clear(); world.velZ.clear();
+    world.inputX.clear(); world.inputZ.clear();
+    world.spawnX.clear(); world.spawnZ.clear();
+    world.pairsTested = 0;
+    world.pairsColliding = 0;
+}
+
+int addMarble(MarbleWorld& world, float x, float z) {
+    float groundH, nx, ny, nz;
+    getArenaHeightAndNormal(x, z, groundH, nx, ny, nz);
+    world.posX.push_back(x);
+    world.posY.push_back(groundH + marbleRadius);
+    world.posZ.push_back(z);
+    world.velX.push_back(0.0f);
+    world.velY.push_back(0.0f);
+    world.velZ.push_back(0.0f);
+    world.inputX.push_back(0.0f);
+    world.inputZ.push_back(0.0f);
+    world.spawnX.push_back(x);
+    world.spawnZ.push_back(z);
+    return (int)world.posX.size() - 1;
+}
+
+int marbleCount(const MarbleWorld& world) {
+    return (int)world.posX.size();
+}
+
+static void respawnWorldMarble(MarbleWorld& world, int i) {
+    float groundH, nx, ny, nz;
+    getArenaHeightAndNormal(world.spawnX[i], world.spawnZ[i], groundH, nx, ny, nz);
+    world.posX[i] = world.spawnX[i];
+    world.posY[i] = groundH + marbleRadius;
+    world.posZ[i] = world.spawnZ[i];
+    world.velX[i] = 0.0f;
+    world.velY[i] = 0.0f;
+    world.velZ[i] = 0.0f;
+}
+
+// Counting sort index marble ke bucket hash (layout CSR), tanpa alokasi setelah
+// ukuran world stabil
+static unsigned buildMarbleHash(MarbleWorld& world) {
+    int n = marbleCount(world);
+    unsigned tableSize = 1;
+    while (tableSize < 2u * (unsigned)n) tableSize <<= 1;
+    unsigned mask = tableSize - 1;
+
+    world.hashStart.assign(tableSize + 1, 0);
+    world.hashBucket.resize(n);
+    world.hashEntries.resize(n);
+    for (int i = 0; i < n; ++i) {
+        int b = marbleHashBucket(marbleHashCoord(world.posX[i]), marbleHashCoord(world.posZ[i]), mask);
+        world.hashBucket[i] = b;
+        world.hashStart[b + 1]++;
+    }
+    for (unsigned b = 0; b < tableSize; ++b) world.hashStart[b + 1] += world.hashStart[b];
+    for (int i = 0; i < n; ++i) {
+        world.hashEntries[world.hashStart[world.hashBucket[i]]++] = i;
+    }
+    // hashStart[b] sekarang menunjuk akhir bucket b, geser kembali ke awal
+    for (unsigned b = tableSize; b > 0; --b) world.hashStart[b] = world.hashStart[b - 1];
+    world.hashStart[0] = 0;
+    return mask;
+}
+
+static void resolveMarblePair(MarbleWorld& world, int i, int j) {
+    float dx = world.posX[j] - world.posX[i];
+    float dy = world.posY[j] - world.posY[i];
+    float dz = world.posZ[j] - world.posZ[i];
+    float dist2 = dx * dx + dy * dy + dz * dz;
+    const float minDist = 2.0f * marbleRadius;
+    if (dist2 >= minDist * minDist || dist2 < 1e-12f) return;
+    world.pairsColliding++;
+
+    float dist = sqrtf(dist2);
+    float nx = dx / dist, ny = dy / dist, nz = dz / dist;
+
+    // Pisahkan setengah overlap ke masing-masing marble (massa sama)
+    float push = 0.5f * (minDist - dist);
+    world.posX[i] -= nx * push; world.posY[i] -= ny * push; world.posZ[i] -= nz * push;
+    world.posX[j] += nx * push; world.posY[j] += ny * push; world.posZ[j] += nz * push;
+
+    float relVel = (world.velX[j] - world.velX[i]) * nx +
+                   (world.velY[j] - world.velY[i]) * ny +
+                   (world.velZ[j] - world.velZ[i]) * nz;
+    if (relVel < 0.0f) {
+        float impulse = -0.5f * (1.0f + restitution_marble) * relVel;
+        world.velX[i] -= impulse * nx; world.velY[i] -= impulse * ny; world.velZ[i] -= impulse * nz;
+        world.velX[j] += impulse * nx; world.velY[j] += impulse * ny; world.velZ[j] += impulse * nz;
+    }
+}
+
+void stepMarbleWorld(MarbleWorld& world) {
+    int n = marbleCount(world);
+
+    for (int i = 0; i < n; ++i) {
+        if (world.posY[i] < minGroundHeight) {
+            respawnWorldMarble(world, i);
+            continue;
+        }
+        stepMarbleBody(world.posX[i], world.posY[i], world.posZ[i],
+                       world.velX[i], world.velY[i], world.velZ[i],
+                       world.inputX[i], world.inputZ[i]);
+    }
+
+    unsigned mask = buildMarbleHash(world);
+    world.pairsTested = 0;
+    world.pairsColliding = 0;
+    for (int i = 0; i < n; ++i) {
+        int cx = marbleHashCoord(world.posX[i]);
+        int cz = marbleHashCoord(world.posZ[i]);
+        int visited[9];
+        int numVisited = 0;
+        for (int oz = -1; oz <= 1; ++oz) {
+            for (int ox = -1; ox <= 1; ++ox) {
+                int b = marbleHashBucket(cx + ox, cz + oz, mask);
+                // Dua cell tetangga bisa jatuh ke bucket yang sama
+                bool seen = false;
+                for (int v = 0; v < numVisited; ++v) {
+                    if (visited[v] == b) { seen = true; break; }
+                }
+                if (seen) continue;
+                visited[numVisited++] = b;
+
+                for (int k = world.hashStart[b]; k < world.hashStart[b + 1]; ++k) {
+                    int j = world.hashEntries[k];
+                    if (j <= i) continue;
+                    world.pairsTested++;
+                    resolveMarblePair(world, i, j);
+                }
+            }
+        }
+    }
+}
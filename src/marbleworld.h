@@ -0,0 +1,28 @@
+#ifndef MARBLEWORLD_H
+#define MARBLEWORLD_H
+
+#include <vector>
+
+// Banyak marble sekaligus (crowd, ghost race, uji massal level). State disimpan
+// structure-of-arrays; satu step mengintegrasikan semua marble terhadap arena
+// lalu menyelesaikan tabrakan antar marble lewat spatial hash.
+struct MarbleWorld {
+    std::vector<float> posX, posY, posZ;
+    std::vector<float> velX, velY, velZ;
+    std::vector<float> inputX, inputZ;   // Arah dorong per marble, 0 = tanpa input
+    std::vector<float> spawnX, spawnZ;   // Tempat respawn kalau jatuh
+
+    // Spatial hash, dibangun ulang setiap step
+    std::vector<int> hashStart;
+    std::vector<int> hashEntries;
+    std::vector<int> hashBucket;
+    int pairsTested = 0;
+    int pairsColliding = 0;
+};
+
+void clearMarbleWorld(MarbleWorld& world);
+int addMarble(MarbleWorld& world, float x, float z); // Diletakkan di atas permukaan arena
+int marbleCount(const MarbleWorld& world);
+void stepMarbleWorld(MarbleWorld& world);
+
+#endif // MARBLEWORLD_H
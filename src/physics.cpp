@@ -1,26 +1,44 @@
 #include "physics.h"
+#include "simmath.h"
 #include "globals.h" 
 #include "utils.h"   
 #include "arena.h"   
 #include "marble.h"  
 #include "checkpoint.h"
+#include "profiler.h"
 #include <cmath>    
-#include <GL/glut.h> 
 #include <cstdio>
 
 void updatePhysics() {
-    float initialGroundHeight, normalX, normalY, normalZ;
-    getArenaHeightAndNormalAt(marbleX, marbleY, marbleZ, initialGroundHeight, normalX, normalY, normalZ);
-
+    PROFILE_ZONE_DETAIL("updatePhysics");
     if (marbleY < minGroundHeight) {
         resetMarble();
         return;
     }
 
-    checkCheckpointCollision();
-    checkFinishCollision(); 
+    updateLevelTriggers(); // Checkpoint, finish, coin, hazard
+
+    float sinCam, cosCam;
+    simSinCosDegrees(cameraAngleX, sinCam, cosCam);
+
+    float inputDirX = 0.0f;
+    float inputDirZ = 0.0f;
+    if (keyStates[KEY_ARROW_UP])    { inputDirX -= sinCam; inputDirZ -= cosCam; }
+    if (keyStates[KEY_ARROW_DOWN])  { inputDirX += sinCam; inputDirZ += cosCam; }
+    if (keyStates[KEY_ARROW_LEFT])  { inputDirX -= cosCam; inputDirZ += sinCam; }
+    if (keyStates[KEY_ARROW_RIGHT]) { inputDirX += cosCam; inputDirZ -= sinCam; }
+
+    stepMarbleBody(marbleX, marbleY, marbleZ, marbleVX, marbleVY, marbleVZ, inputDirX, inputDirZ);
+}
+
+// Satu tick untuk satu marble terhadap geometri arena: gravitasi, dorongan input
+// (inputDirX/Z belum dinormalisasi, 0 = tidak ada input), CCD dinding dan kontak tanah.
+void stepMarbleBody(float& posX, float& posY, float& posZ, float& velX, float& velY, float& velZ,
+                    float inputDirX, float inputDirZ) {
+    float initialGroundHeight, normalX, normalY, normalZ;
+    getArenaHeightAndNormalAt(posX, posY, posZ, initialGroundHeight, normalX, normalY, normalZ);
 
-    marbleVY -= gravity * deltaTime;
+    velY -= gravity * deltaTime;
 
     float gravityVecY = -gravity;
     float dot_gravity_normal = (gravityVecY * normalY);
@@ -30,17 +48,6 @@ void updatePhysics() {
     float accX = gravityForceX;
     float accZ = gravityForceZ;
 
-    float camAngleXRad = degToRad(cameraAngleX);
-    float cosCam = cos(camAngleXRad);
-    float sinCam = sin(camAngleXRad);
-
-    float inputDirX = 0.0f;
-    float inputDirZ = 0.0f;
-    if (keyStates[GLUT_KEY_UP])    { inputDirX -= sinCam; inputDirZ -= cosCam; }
-    if (keyStates[GLUT_KEY_DOWN])  { inputDirX += sinCam; inputDirZ += cosCam; }
-    if (keyStates[GLUT_KEY_LEFT])  { inputDirX -= cosCam; inputDirZ += sinCam; }
-    if (keyStates[GLUT_KEY_RIGHT]) { inputDirX += cosCam; inputDirZ -= sinCam; }
-
     float inputMagnitude = sqrt(inputDirX * inputDirX + inputDirZ * inputDirZ);
     if (inputMagnitude > 1e-6) {
         inputDirX /= inputMagnitude;
@@ -51,41 +58,49 @@ void updatePhysics() {
         accZ += inputDirZ * effectivePushForce;
     }
 
-    marbleVX += accX * deltaTime;
-    marbleVZ += accZ * deltaTime;
+    velX += accX * deltaTime;
+    velZ += accZ * deltaTime;
 
-    marbleVX *= friction;
-    marbleVZ *= friction;
+    velX *= friction;
+    velZ *= friction;
 
     const float wall_slope_normal_Y_threshold = 0.5f;
     const float collision_check_offset = 0.002f;
     const int CCD_SEGMENTS = 8; 
     const float R_eff = marbleRadius - 0.001f; 
+    float probeX[CCD_SEGMENTS + 1], probeY[CCD_SEGMENTS + 1], probeZ[CCD_SEGMENTS + 1];
+    float probeH[CCD_SEGMENTS + 1], probeNX[CCD_SEGMENTS + 1], probeNY[CCD_SEGMENTS + 1], probeNZ[CCD_SEGMENTS + 1];
 
-    float vx_before_x_collision = marbleVX;
-    float vy_at_x_collision_check = marbleVY;
-    float vz_at_x_collision_check = marbleVZ;
+    float vx_before_x_collision = velX;
+    float vy_at_x_collision_check = velY;
+    float vz_at_x_collision_check = velZ;
     bool collision_handled_X = false;
 
     if (vx_before_x_collision != 0.0f) {
         float signVX = (vx_before_x_collision > 0.0f ? 1.0f : -1.0f);
 
-        float leading_edge_initial_X = marbleX + signVX * R_eff;
-        float final_center_X_candidate = marbleX + vx_before_x_collision * deltaTime;
+        float leading_edge_initial_X = posX + signVX * R_eff;
+        float final_center_X_candidate = posX + vx_before_x_collision * deltaTime;
         float leading_edge_final_X = final_center_X_candidate + signVX * R_eff;
 
+        // Semua probe di-query sekaligus, lalu dicari tabrakan pertama
         for (int i = 0; i <= CCD_SEGMENTS; ++i) {
             float fraction = (CCD_SEGMENTS == 0) ? 1.0f : (float)i / CCD_SEGMENTS;
-            float terrain_probe_X = leading_edge_initial_X + fraction * (leading_edge_final_X - leading_edge_initial_X);
+            probeX[i] = leading_edge_initial_X + fraction * (leading_edge_final_X - leading_edge_initial_X);
+            probeY[i] = posY;
+            probeZ[i] = posZ;
+        }
+        getArenaHeightAndNormalAtBatch(probeX, probeY, probeZ, CCD_SEGMENTS + 1, probeH, probeNX, probeNY, probeNZ);
 
-            float h_terrain, nx_terrain, ny_terrain, nz_terrain;
-            getArenaHeightAndNormalAt(terrain_probe_X, marbleY, marbleZ, h_terrain, nx_terrain, ny_terrain, nz_terrain);
+        for (int i = 0; i <= CCD_SEGMENTS; ++i) {
+            float terrain_probe_X = probeX[i];
+            float h_terrain = probeH[i], nx_terrain = probeNX[i], ny_terrain = probeNY[i], nz_terrain = probeNZ[i];
 
             bool is_wall_at_probe = (ny_terrain < wall_slope_normal_Y_threshold);
-            bool would_penetrate_wall = (marbleY - R_eff < h_terrain - collision_check_offset); 
+            bool would_penetrate_wall = (posY - R_eff < h_terrain - collision_check_offset); 
 
             if (is_wall_at_probe && would_penetrate_wall) {
-                marbleX = terrain_probe_X - signVX * R_eff;
+                posX = terrain_probe_X - signVX * R_eff;
 
                 float reflection_ny_component = ny_terrain;
                 if (is_wall_at_probe) { 
@@ -97,9 +112,9 @@ void updatePhysics() {
                                      vz_at_x_collision_check * nz_terrain;
 
                 if (v_dot_n_wall < 0) { 
-                    marbleVX -= (1 + restitution_wall) * v_dot_n_wall * nx_terrain;
-                    marbleVY -= (1 + restitution_wall) * v_dot_n_wall * reflection_ny_component;
-                    marbleVZ -= (1 + restitution_wall) * v_dot_n_wall * nz_terrain;
+                    velX -= (1 + restitution_wall) * v_dot_n_wall * nx_terrain;
+                    velY -= (1 + restitution_wall) * v_dot_n_wall * reflection_ny_component;
+                    velZ -= (1 + restitution_wall) * v_dot_n_wall * nz_terrain;
                 }
                 collision_handled_X = true;
                 break; 
@@ -107,30 +122,35 @@ void updatePhysics() {
         }
     }
 
-    float vx_at_z_collision_check = marbleVX;
-    float vy_at_z_collision_check = marbleVY;
-    float vz_before_z_collision = marbleVZ;
+    float vx_at_z_collision_check = velX;
+    float vy_at_z_collision_check = velY;
+    float vz_before_z_collision = velZ;
     bool collision_handled_Z = false;
 
     if (vz_before_z_collision != 0.0f) {
         float signVZ = (vz_before_z_collision > 0.0f ? 1.0f : -1.0f);
 
-        float leading_edge_initial_Z = marbleZ + signVZ * R_eff;
-        float final_center_Z_candidate = marbleZ + vz_before_z_collision * deltaTime;
+        float leading_edge_initial_Z = posZ + signVZ * R_eff;
+        float final_center_Z_candidate = posZ + vz_before_z_collision * deltaTime;
         float leading_edge_final_Z = final_center_Z_candidate + signVZ * R_eff;
 
         for (int i = 0; i <= CCD_SEGMENTS; ++i) {
             float fraction = (CCD_SEGMENTS == 0) ? 1.0f : (float)i / CCD_SEGMENTS;
-            float terrain_probe_Z = leading_edge_initial_Z + fraction * (leading_edge_final_Z - leading_edge_initial_Z);
+            probeX[i] = posX;
+            probeY[i] = posY;
+            probeZ[i] = leading_edge_initial_Z + fraction * (leading_edge_final_Z - leading_edge_initial_Z);
+        }
+        getArenaHeightAndNormalAtBatch(probeX, probeY, probeZ, CCD_SEGMENTS + 1, probeH, probeNX, probeNY, probeNZ);
 
-            float h_terrain, nx_terrain, ny_terrain, nz_terrain;
-            getArenaHeightAndNormalAt(marbleX, marbleY, terrain_probe_Z, h_terrain, nx_terrain, ny_terrain, nz_terrain);
+        for (int i = 0; i <= CCD_SEGMENTS; ++i) {
+            float terrain_probe_Z = probeZ[i];
+            float h_terrain = probeH[i], nx_terrain = probeNX[i], ny_terrain = probeNY[i], nz_terrain = probeNZ[i];
 
             bool is_wall_at_probe = (ny_terrain < wall_slope_normal_Y_threshold);
-            bool would_penetrate_wall = (marbleY - R_eff < h_terrain - collision_check_offset);
+            bool would_penetrate_wall = (posY - R_eff < h_terrain - collision_check_offset);
 
             if (is_wall_at_probe && would_penetrate_wall) {
-                marbleZ = terrain_probe_Z - signVZ * R_eff;
+                posZ = terrain_probe_Z - signVZ * R_eff;
 
                 float reflection_ny_component = ny_terrain;
                 if (is_wall_at_probe) {
@@ -141,9 +161,9 @@ void updatePhysics() {
                                      vy_at_z_collision_check * reflection_ny_component +
                                      vz_before_z_collision * nz_terrain;
                 if (v_dot_n_wall < 0) {
-                    marbleVX -= (1 + restitution_wall) * v_dot_n_wall * nx_terrain;
-                    marbleVY -= (1 + restitution_wall) * v_dot_n_wall * reflection_ny_component;
-                    marbleVZ -= (1 + restitution_wall) * v_dot_n_wall * nz_terrain;
+                    velX -= (1 + restitution_wall) * v_dot_n_wall * nx_terrain;
+                    velY -= (1 + restitution_wall) * v_dot_n_wall * reflection_ny_component;
+                    velZ -= (1 + restitution_wall) * v_dot_n_wall * nz_terrain;
                 }
                 collision_handled_Z = true;
                 break;
@@ -151,51 +171,51 @@ void updatePhysics() {
         }
     }
 
-    float marbleY_before = marbleY;
-    marbleX += marbleVX * deltaTime;
-    marbleZ += marbleVZ * deltaTime;
-    marbleY += marbleVY * deltaTime;
+    float marbleY_before = posY;
+    posX += velX * deltaTime;
+    posZ += velZ * deltaTime;
+    posY += velY * deltaTime;
 
     float currentGroundHeight, newNormalX, newNormalY, newNormalZ;
-    getArenaHeightAndNormalAt(marbleX, marbleY, marbleZ, currentGroundHeight, newNormalX, newNormalY, newNormalZ);
+    getArenaHeightAndNormalAt(posX, posY, posZ, currentGroundHeight, newNormalX, newNormalY, newNormalZ);
 
     const float final_collision_wall_threshold_Y = 0.5f;
 
-    if (marbleY < currentGroundHeight + marbleRadius) {
+    if (posY < currentGroundHeight + marbleRadius) {
         bool is_final_contact_a_wall = (newNormalY < final_collision_wall_threshold_Y);
 
         if (!is_final_contact_a_wall) {
-            marbleY = currentGroundHeight + marbleRadius;
+            posY = currentGroundHeight + marbleRadius;
 
-            float v_dot_n_ground = marbleVX * newNormalX + marbleVY * newNormalY + marbleVZ * newNormalZ;
+            float v_dot_n_ground = velX * newNormalX + velY * newNormalY + velZ * newNormalZ;
             if (v_dot_n_ground < 0) {
-                marbleVX -= (1 + restitution_ground) * v_dot_n_ground * newNormalX;
-                marbleVY -= (1 + restitution_ground) * v_dot_n_ground * newNormalY;
-                marbleVZ -= (1 + restitution_ground) * v_dot_n_ground * newNormalZ;
+                velX -= (1 + restitution_ground) * v_dot_n_ground * newNormalX;
+                velY -= (1 + restitution_ground) * v_dot_n_ground * newNormalY;
+                velZ -= (1 + restitution_ground) * v_dot_n_ground * newNormalZ;
             }
         } else {
-            float oldY = marbleY;
-            marbleY = fminf(marbleY, marbleY_before);
-            if (marbleY > marbleY_before + 1e-4f) {
-                printf("[DEBUG] Wall/corner collision tried to increase marbleY! oldY=%.4f, before=%.4f\n", marbleY, marbleY_before);
+            float oldY = posY;
+            posY = fminf(posY, marbleY_before);
+            if (posY > marbleY_before + 1e-4f) {
+                printf("[DEBUG] Wall/corner collision tried to increase posY! oldY=%.4f, before=%.4f\n", posY, marbleY_before);
             }
             float reflection_nx_final = newNormalX;
             float reflection_ny_final = 0.0f;
             float reflection_nz_final = newNormalZ;
-            float v_dot_n_wall = marbleVX * reflection_nx_final + 
-                                 marbleVY * reflection_ny_final + 
-                                 marbleVZ * reflection_nz_final;
+            float v_dot_n_wall = velX * reflection_nx_final + 
+                                 velY * reflection_ny_final + 
+                                 velZ * reflection_nz_final;
             if (v_dot_n_wall < 0) {
-                float oldVY = marbleVY;
-                marbleVX -= (1 + restitution_wall) * v_dot_n_wall * reflection_nx_final;
-                marbleVZ -= (1 + restitution_wall) * v_dot_n_wall * reflection_nz_final;
-                if (marbleVY > oldVY + 1e-4f) {
-                    printf("[DEBUG] Wall/corner collision tried to increase marbleVY! oldVY=%.4f, newVY=%.4f\n", oldVY, marbleVY);
+                float oldVY = velY;
+                velX -= (1 + restitution_wall) * v_dot_n_wall * reflection_nx_final;
+                velZ -= (1 + restitution_wall) * v_dot_n_wall * reflection_nz_final;
+                if (velY > oldVY + 1e-4f) {
+                    printf("[DEBUG] Wall/corner collision tried to increase velY! oldVY=%.4f, newVY=%.4f\n", oldVY, velY);
                 }
             }
         }
     }
 
-    if (fabs(marbleVX) < 0.005f && fabs(accX) < 0.005f) marbleVX = 0.0f; // accX here is from start of frame
-    if (fabs(marbleVZ) < 0.005f && fabs(accZ) < 0.005f) marbleVZ = 0.0f; // accZ here is from start of frame
+    if (fabs(velX) < 0.005f && fabs(accX) < 0.005f) velX = 0.0f; // accX here is from start of frame
+    if (fabs(velZ) < 0.005f && fabs(accZ) < 0.005f) velZ = 0.0f; // accZ here is from start of frame
 }
\ No newline at end of file
@@ -2,5 +2,7 @@
 #define PHYSICS_H
 
 void updatePhysics();
+void stepMarbleBody(float& posX, float& posY, float& posZ, float& velX, float& velY, float& velZ,
+                    float inputDirX, float inputDirZ);
 
 #endif // PHYSICS_H
\ No newline at end of file
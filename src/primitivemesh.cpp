@@ -0,0 +1,283 @@
+#include "primitivemesh.h"
+#include "glbuffer.h"
+#include <GL/glut.h>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+struct PrimitiveVertex {
+    float px, py, pz;
+    float nx, ny, nz;
+    float s, t; // Hanya dipakai bola bertekstur
+};
+
+struct PrimitiveRange {
+    GLuint first;
+    GLsizei count;
+};
+
+static const int primitiveSliceLevels[] = {8, 12, 16, 24, 32};
+static const int PRIMITIVE_LEVEL_COUNT = sizeof(primitiveSliceLevels) / sizeof(primitiveSliceLevels[0]);
+// Rasio top/base silinder yang dipakai pohon dan koin
+static const float primitiveTapers[] = {1.0f, 0.8f, 0.75f, 0.5f};
+static const int PRIMITIVE_TAPER_COUNT = sizeof(primitiveTapers) / sizeof(primitiveTapers[0]);
+static const int primitiveCylinderStacks = 4;
+
+static std::vector<PrimitiveVertex> primitiveVertices;
+static std::vector<GLuint> primitiveIndices;
+static PrimitiveRange sphereRanges[PRIMITIVE_LEVEL_COUNT];
+static PrimitiveRange texturedSphereRanges[PRIMITIVE_LEVEL_COUNT];
+static PrimitiveRange diskRanges[PRIMITIVE_LEVEL_COUNT];
+static PrimitiveRange cylinderRanges[PRIMITIVE_TAPER_COUNT][PRIMITIVE_LEVEL_COUNT];
+static PrimitiveRange cubeRange;
+static GLuint primitiveVbo = 0, primitiveIbo = 0;
+static bool primitiveMeshReady = false;
+
+static void addPrimitiveVertex(float px, float py, float pz, float nx, float ny, float nz,
+                               float s = 0.0f, float t = 0.0f) {
+    float len = sqrtf(nx * nx + ny * ny + nz * nz);
+    if (len > 0.0f) { nx /= len; ny /= len; nz /= len; }
+    PrimitiveVertex v = {px, py, pz, nx, ny, nz, s, t};
+    primitiveVertices.push_back(v);
+}
+
+static PrimitiveRange beginRange() {
+    PrimitiveRange range = {(GLuint)primitiveIndices.size(), 0};
+    return range;
+}
+
+static void endRange(PrimitiveRange& range) {
+    range.count = (GLsizei)(primitiveIndices.size() - range.first);
+}
+
+// Bola radius 1, stacks = slices seperti pemanggilan glutSolidSphere di game
+static void buildSphere(int slices, PrimitiveRange& range) {
+    range = beginRange();
+    int stacks = slices;
+    GLuint base = (GLuint)primitiveVertices.size();
+    for (int i = 0; i <= stacks; ++i) {
+        float phi = (float)M_PI * i / stacks;
+        float ringY = cosf(phi), ringR = sinf(phi);
+        for (int j = 0; j <= slices; ++j) {
+            float theta = 2.0f * (float)M_PI * j / slices;
+            float nx = ringR * cosf(theta), nz = ringR * sinf(theta);
+            addPrimitiveVertex(nx, ringY, nz, nx, ringY, nz);
+        }
+    }
+    for (int i = 0; i < stacks; ++i) {
+        for (int j = 0; j < slices; ++j) {
+            GLuint a = base + i * (slices + 1) + j;
+            GLuint c = a + slices + 1;
+            GLuint tri[6] = {a, a + 1, c, a + 1, c + 1, c};
+            primitiveIndices.insert(primitiveIndices.end(), tri, tri + 6);
+        }
+    }
+    endRange(range);
+}
+
+// Bola radius 1 dengan layout dan koordinat tekstur gluSphere (kutub di sumbu Z,
+// s = 1 - slice / slices, t = 1 - stack / stacks), stacks = slices
+static void buildTexturedSphere(int slices, PrimitiveRange& range) {
+    range = beginRange();
+    int stacks = slices;
+    GLuint base = (GLuint)primitiveVertices.size();
+    for (int i = 0; i <= stacks; ++i) {
+        float phi = (float)M_PI * i / stacks;
+        float ringZ = cosf(phi), ringR = sinf(phi);
+        for (int j = 0; j <= slices; ++j) {
+            float theta = 2.0f * (float)M_PI * j / slices;
+            float nx = ringR * sinf(theta), ny = ringR * cosf(theta);
+            addPrimitiveVertex(nx, ny, ringZ, nx, ny, ringZ, 1.0f - (float)j / slices, 1.0f - (float)i / stacks);
+        }
+    }
+    for (int i = 0; i < stacks; ++i) {
+        for (int j = 0; j < slices; ++j) {
+            GLuint a = base + i * (slices + 1) + j;
+            GLuint c = a + slices + 1;
+            GLuint tri[6] = {c, a, a + 1, c, a + 1, c + 1}; // Urutan quad strip gluSphere
+            primitiveIndices.insert(primitiveIndices.end(), tri, tri + 6);
+        }
+    }
+    endRange(range);
+}
+
+// Disk radius 1 di bidang z = 0 menghadap +Z, sama dengan gluDisk(0, 1, slices, 1)
+static void buildDisk(int slices, PrimitiveRange& range) {
+    range = beginRange();
+    GLuint center = (GLuint)primitiveVertices.size();
+    addPrimitiveVertex(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+    for (int j = 0; j <= slices; ++j) {
+        float a = 2.0f * (float)M_PI * j / slices;
+        addPrimitiveVertex(sinf(a), cosf(a), 0.0f, 0.0f, 0.0f, 1.0f);
+    }
+    for (int j = 0; j < slices; ++j) {
+        GLuint tri[3] = {center, center + 2 + j, center + 1 + j};
+        primitiveIndices.insert(primitiveIndices.end(), tri, tri + 3);
+    }
+    endRange(range);
+}
+
+// Silinder terbuka base radius 1, top radius taper, tinggi 1 sepanjang +Z seperti
+// gluCylinder. Normal benar setelah glScalef karena GL_NORMALIZE aktif.
+static void buildCylinder(int slices, float taper, PrimitiveRange& range) {
+    range = beginRange();
+    GLuint base = (GLuint)primitiveVertices.size();
+    float nzSlope = 1.0f - taper;
+    for (int i = 0; i <= primitiveCylinderStacks; ++i) {
+        float t = (float)i / primitiveCylinderStacks;
+        float rad = 1.0f + (taper - 1.0f) * t;
+        for (int j = 0; j <= slices; ++j) {
+            float a = 2.0f * (float)M_PI * j / slices;
+            float sx = sinf(a), cy = cosf(a);
+            addPrimitiveVertex(rad * sx, rad * cy, t, sx, cy, nzSlope);
+        }
+    }
+    for (int i = 0; i < primitiveCylinderStacks; ++i) {
+        for (int j = 0; j < slices; ++j) {
+            GLuint a = base + i * (slices + 1) + j;
+            GLuint c = a + slices + 1;
+            GLuint tri[6] = {a, c, a + 1, a + 1, c, c + 1};
+            primitiveIndices.insert(primitiveIndices.end(), tri, tri + 6);
+        }
+    }
+    endRange(range);
+}
+
+// Kubus sisi 1 berpusat di origin, normal per sisi seperti glutSolidCube(1)
+static void buildCube(PrimitiveRange& range) {
+    range = beginRange();
+    static const float faces[6][3] = {{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}};
+    for (const float* n : faces) {
+        // Dua sumbu lain dari sisi ini, u x v = n supaya urutan CCW dari luar
+        float u[3] = {n[1], n[2], n[0]};
+        float v[3] = {n[1] * u[2] - n[2] * u[1], n[2] * u[0] - n[0] * u[2], n[0] * u[1] - n[1] * u[0]};
+        GLuint base = (GLuint)primitiveVertices.size();
+        static const float corners[4][2] = {{-1, -1}, {1, -1}, {1, 1}, {-1, 1}};
+        for (const float* c : corners) {
+            addPrimitiveVertex(0.5f * (n[0] + c[0] * u[0] + c[1] * v[0]),
+                               0.5f * (n[1] + c[0] * u[1] + c[1] * v[1]),
+                               0.5f * (n[2] + c[0] * u[2] + c[1] * v[2]), n[0], n[1], n[2]);
+        }
+        GLuint tri[6] = {base, base + 1, base + 2, base, base + 2, base + 3};
+        primitiveIndices.insert(primitiveIndices.end(), tri, tri + 6);
+    }
+    endRange(range);
+}
+
+void initPrimitiveMeshes() {
+    if (primitiveMeshReady) return;
+    buildCube(cubeRange);
+    for (int l = 0; l < PRIMITIVE_LEVEL_COUNT; ++l) {
+        int slices = primitiveSliceLevels[l];
+        buildSphere(slices, sphereRanges[l]);
+        buildTexturedSphere(slices, texturedSphereRanges[l]);
+        buildDisk(slices, diskRanges[l]);
+        for (int t = 0; t < PRIMITIVE_TAPER_COUNT; ++t) {
+            buildCylinder(slices, primitiveTapers[t], cylinderRanges[t][l]);
+        }
+    }
+    if (hasGLBuffers()) {
+        glbGenBuffers(1, &primitiveVbo);
+        glbBindBuffer(GL_ARRAY_BUFFER, primitiveVbo);
+        glbBufferData(GL_ARRAY_BUFFER, primitiveVertices.size() * sizeof(PrimitiveVertex),
+                      primitiveVertices.data(), GL_STATIC_DRAW);
+        glbGenBuffers(1, &primitiveIbo);
+        glbBindBuffer(GL_ELEMENT_ARRAY_BUFFER, primitiveIbo);
+        glbBufferData(GL_ELEMENT_ARRAY_BUFFER, primitiveIndices.size() * sizeof(GLuint),
+                      primitiveIndices.data(), GL_STATIC_DRAW);
+        glbBindBuffer(GL_ARRAY_BUFFER, 0);
+        glbBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        std::vector<PrimitiveVertex>().swap(primitiveVertices);
+        std::vector<GLuint>().swap(primitiveIndices);
+    }
+    primitiveMeshReady = true;
+}
+
+void releasePrimitiveMeshes() {
+    if (primitiveVbo) glbDeleteBuffers(1, &primitiveVbo);
+    if (primitiveIbo) glbDeleteBuffers(1, &primitiveIbo);
+    primitiveVbo = primitiveIbo = 0;
+    std::vector<PrimitiveVertex>().swap(primitiveVertices);
+    std::vector<GLuint>().swap(primitiveIndices);
+    primitiveMeshReady = false;
+}
+
+static int sliceLevel(int slices) {
+    for (int l = 0; l < PRIMITIVE_LEVEL_COUNT; ++l) {
+        if (primitiveSliceLevels[l] >= slices) return l;
+    }
+    return PRIMITIVE_LEVEL_COUNT - 1;
+}
+
+static int taperIndex(float taper) {
+    int best = 0;
+    for (int t = 1; t < PRIMITIVE_TAPER_COUNT; ++t) {
+        if (fabsf(primitiveTapers[t] - taper) < fabsf(primitiveTapers[best] - taper)) best = t;
+    }
+    return best;
+}
+
+static void drawRange(const PrimitiveRange& range, bool textured) {
+    if (!primitiveMeshReady) initPrimitiveMeshes();
+    const char* vertexBase = nullptr;
+    const char* indexBase = nullptr;
+    if (primitiveVbo) {
+        glbBindBuffer(GL_ARRAY_BUFFER, primitiveVbo);
+        glbBindBuffer(GL_ELEMENT_ARRAY_BUFFER, primitiveIbo);
+    } else {
+        vertexBase = (const char*)primitiveVertices.data();
+        indexBase = (const char*)primitiveIndices.data();
+    }
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_NORMAL_ARRAY);
+    glVertexPointer(3, GL_FLOAT, sizeof(PrimitiveVertex), vertexBase + offsetof(PrimitiveVertex, px));
+    glNormalPointer(GL_FLOAT, sizeof(PrimitiveVertex), vertexBase + offsetof(PrimitiveVertex, nx));
+    if (textured) {
+        glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+        glTexCoordPointer(2, GL_FLOAT, sizeof(PrimitiveVertex), vertexBase + offsetof(PrimitiveVertex, s));
+    }
+    glDrawElements(GL_TRIANGLES, range.count, GL_UNSIGNED_INT, indexBase + range.first * sizeof(GLuint));
+    if (textured) glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_NORMAL_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    if (primitiveVbo) {
+        glbBindBuffer(GL_ARRAY_BUFFER, 0);
+        glbBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
+}
+
+void drawPrimitiveSphere(float radius, int slices) {
+    glPushMatrix();
+    glScalef(radius, radius, radius);
+    drawRange(sphereRanges[sliceLevel(slices)], false);
+    glPopMatrix();
+}
+
+void drawPrimitiveTexturedSphere(float radius, int slices) {
+    glPushMatrix();
+    glScalef(radius, radius, radius);
+    drawRange(texturedSphereRanges[sliceLevel(slices)], true);
+    glPopMatrix();
+}
+
+void drawPrimitiveCylinder(float baseRadius, float topRadius, float height, int slices) {
+    float taper = baseRadius > 0.0f ? topRadius / baseRadius : 1.0f;
+    glPushMatrix();
+    glScalef(baseRadius, baseRadius, height);
+    drawRange(cylinderRanges[taperIndex(taper)][sliceLevel(slices)], false);
+    glPopMatrix();
+}
+
+void drawPrimitiveDisk(float radius, int slices) {
+    glPushMatrix();
+    glScalef(radius, radius, radius);
+    drawRange(diskRanges[sliceLevel(slices)], false);
+    glPopMatrix();
+}
+
+void drawPrimitiveCube(float size) {
+    glPushMatrix();
+    glScalef(size, size, size);
+    drawRange(cubeRange, false);
+    glPopMatrix();
+}
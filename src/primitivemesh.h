@@ -0,0 +1,21 @@
+#ifndef PRIMITIVEMESH_H
+#define PRIMITIVEMESH_H
+
+// Bola, silinder, dan disk satuan di-tessellate sekali ke satu buffer bersama di
+// beberapa tingkat slice, lalu dipakai ulang lewat transform. Pengganti
+// gluNewQuadric/glutSolidSphere/glutSolidCube di fungsi draw per frame, bentuk dan orientasi
+// sama dengan versi GLU/GLUT (silinder dan disk sepanjang +Z).
+void initPrimitiveMeshes();    // Butuh context GL, aman dipanggil berkali-kali
+void releasePrimitiveMeshes();
+
+// Slice dibulatkan ke tingkat tessellation terdekat yang tidak lebih kasar.
+// Silinder hanya punya rasio top/base 1.0, 0.8, 0.75, 0.5; rasio lain memakai
+// yang terdekat.
+void drawPrimitiveSphere(float radius, int slices);
+// Seperti gluSphere dengan gluQuadricTexture aktif (kutub di sumbu Z)
+void drawPrimitiveTexturedSphere(float radius, int slices);
+void drawPrimitiveCylinder(float baseRadius, float topRadius, float height, int slices);
+void drawPrimitiveDisk(float radius, int slices);
+void drawPrimitiveCube(float size); // Seperti glutSolidCube
+
+#endif // PRIMITIVEMESH_H
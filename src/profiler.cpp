@@ -0,0 +1,231 @@
+#include "profiler.h"
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+std::atomic<bool> profilerActive(false);
+std::atomic<bool> profilerDetailActive(false);
+static bool profilerDetailWanted = false;
+
+static const int profileRingCapacity = 1 << 16; // Pangkat 2, index = head & (capacity - 1)
+static const int profileFrameWindow = 240;
+
+struct ProfileEvent {
+    const char* name;
+    uint64_t start, end;
+};
+
+// Slot ring dibaca thread dump selagi pemiliknya menulis, jadi field-nya atomic
+// (relaxed, di x86 sama dengan store biasa). Urutan dijaga lewat head, lihat
+// endProfileZone dan copyProfileRing.
+struct ProfileSlot {
+    std::atomic<const char*> name;
+    std::atomic<uint64_t> start, end;
+};
+
+struct ProfileRing {
+    ProfileSlot events[profileRingCapacity];
+    std::atomic<uint64_t> head;    // Jumlah zona yang pernah ditulis ke ring ini
+    std::atomic<bool> inUse;
+    char name[32];
+    int tid;
+};
+
+// Ring dipinjam thread sampai thread itu selesai. Thread std::async berikutnya
+// (streaming level) memakai ulang ring yang lepas, jadi jumlah ring tidak tumbuh.
+static std::mutex profileRingsMutex;
+static std::vector<ProfileRing*> profileRings;
+
+struct ProfileThreadSlot {
+    ProfileRing* ring = nullptr;
+    char name[32] = "";
+    ~ProfileThreadSlot() {
+        if (ring) ring->inUse.store(false, std::memory_order_release);
+    }
+};
+static thread_local ProfileThreadSlot profileThreadSlot;
+
+// Pasangan TSC/steady_clock waktu profiler pertama dinyalakan, untuk konversi ke ns
+static bool profileCalibrated = false;
+static uint64_t calibrationStamp = 0;
+static std::chrono::steady_clock::time_point calibrationTime;
+
+static float frameTimesMs[profileFrameWindow];
+static int frameTimeCount = 0, frameTimeNext = 0;
+static bool frameMarked = false;
+static uint64_t lastFrameStamp = 0;
+static std::chrono::steady_clock::time_point lastFrameTime;
+
+static ProfileRing* acquireProfileRing(const char* threadName) {
+    std::lock_guard<std::mutex> lock(profileRingsMutex);
+    ProfileRing* ring = nullptr;
+    for (ProfileRing* r : profileRings) {
+        bool expected = false;
+        if (r->inUse.compare_exchange_strong(expected, true)) {
+            ring = r;
+            break;
+        }
+    }
+    if (!ring) {
+        ring = new ProfileRing;
+        ring->head.store(0);
+        ring->inUse.store(true);
+        ring->tid = (int)profileRings.size() + 1;
+        profileRings.push_back(ring);
+    }
+    if (threadName[0]) snprintf(ring->name, sizeof(ring->name), "%s", threadName);
+    else snprintf(ring->name, sizeof(ring->name), "thread %d", ring->tid);
+    return ring;
+}
+
+static ProfileRing* threadProfileRing() {
+    if (!profileThreadSlot.ring) profileThreadSlot.ring = acquireProfileRing(profileThreadSlot.name);
+    return profileThreadSlot.ring;
+}
+
+// Seperti seqlock: slot zona ke-head baru ditimpa setelah head (dari zona
+// sebelumnya) terlihat. Fence release di sini berpasangan dengan fence acquire
+// di copyProfileRing, jadi pembaca yang sempat melihat isi baru slot ini pasti
+// juga melihat head >= zona ini dan membuang isi lama slot itu.
+void endProfileZone(const char* name, uint64_t start) {
+    uint64_t end = profileTimestamp();
+    ProfileRing* ring = threadProfileRing();
+    uint64_t head = ring->head.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    ProfileSlot& slot = ring->events[head & (profileRingCapacity - 1)];
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.start.store(start, std::memory_order_relaxed);
+    slot.end.store(end, std::memory_order_relaxed);
+    ring->head.store(head + 1, std::memory_order_release);
+}
+
+void setProfilerEnabled(bool enabled) {
+    if (enabled) {
+        if (!profileCalibrated) {
+            calibrationStamp = profileTimestamp();
+            calibrationTime = std::chrono::steady_clock::now();
+            profileCalibrated = true;
+        }
+        threadProfileRing(); // Alokasi ring di sini, bukan di tengah frame
+    }
+    frameMarked = false;
+    profilerActive.store(enabled, std::memory_order_relaxed);
+    profilerDetailActive.store(enabled && profilerDetailWanted, std::memory_order_relaxed);
+}
+
+bool isProfilerEnabled() {
+    return profilerActive.load(std::memory_order_relaxed);
+}
+
+void setProfilerDetail(bool enabled) {
+    profilerDetailWanted = enabled;
+    profilerDetailActive.store(enabled && isProfilerEnabled(), std::memory_order_relaxed);
+}
+
+bool isProfilerDetailEnabled() {
+    return profilerDetailWanted;
+}
+
+// Ring baru dibuat waktu zona pertama thread ini, nama dipasang saat itu
+void setProfileThreadName(const char* name) {
+    snprintf(profileThreadSlot.name, sizeof(profileThreadSlot.name), "%s", name);
+    if (!profileThreadSlot.ring) return;
+    std::lock_guard<std::mutex> lock(profileRingsMutex);
+    snprintf(profileThreadSlot.ring->name, sizeof(profileThreadSlot.ring->name), "%s", name);
+}
+
+void profileFrameMark() {
+    if (!isProfilerEnabled()) return;
+    uint64_t stamp = profileTimestamp();
+    auto now = std::chrono::steady_clock::now();
+    if (frameMarked) {
+        endProfileZone("frame", lastFrameStamp);
+        frameTimesMs[frameTimeNext] = std::chrono::duration<float, std::milli>(now - lastFrameTime).count();
+        frameTimeNext = (frameTimeNext + 1) % profileFrameWindow;
+        if (frameTimeCount < profileFrameWindow) ++frameTimeCount;
+    }
+    lastFrameStamp = stamp;
+    lastFrameTime = now;
+    frameMarked = true;
+}
+
+ProfileFrameStats profileFrameStats() {
+    ProfileFrameStats stats = {frameTimeCount, 0.0f, 0.0f, 0.0f, 0.0f};
+    if (frameTimeCount == 0) return stats;
+    float sorted[profileFrameWindow];
+    std::copy(frameTimesMs, frameTimesMs + frameTimeCount, sorted);
+    std::sort(sorted, sorted + frameTimeCount);
+    auto percentile = [&](float p) { return sorted[(int)(p * (frameTimeCount - 1) + 0.5f)]; };
+    stats.p50Ms = percentile(0.50f);
+    stats.p95Ms = percentile(0.95f);
+    stats.p99Ms = percentile(0.99f);
+    stats.maxMs = sorted[frameTimeCount - 1];
+    return stats;
+}
+
+uint64_t profileZonesRecorded() {
+    std::lock_guard<std::mutex> lock(profileRingsMutex);
+    uint64_t total = 0;
+    for (const ProfileRing* ring : profileRings) total += ring->head.load(std::memory_order_acquire);
+    return total;
+}
+
+// Salin isi ring tanpa menghentikan thread pemiliknya. head dibaca (acquire)
+// sebelum menyalin, lalu sekali lagi sesudahnya: slot yang selama menyalin
+// mungkin sudah ditimpa (termasuk slot yang sedang ditulis, zona ke-headAfter)
+// dibuang, sisanya snapshot yang konsisten.
+static void copyProfileRing(const ProfileRing& ring, std::vector<ProfileEvent>& out) {
+    uint64_t head = ring.head.load(std::memory_order_acquire);
+    uint64_t count = std::min<uint64_t>(head, profileRingCapacity);
+    uint64_t firstCopied = head - count;
+    out.clear();
+    for (uint64_t i = firstCopied; i < head; ++i) {
+        const ProfileSlot& slot = ring.events[i & (profileRingCapacity - 1)];
+        out.push_back({slot.name.load(std::memory_order_relaxed), slot.start.load(std::memory_order_relaxed),
+                       slot.end.load(std::memory_order_relaxed)});
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t headAfter = ring.head.load(std::memory_order_relaxed);
+    uint64_t firstValid = headAfter + 1 > profileRingCapacity ? headAfter + 1 - profileRingCapacity : 0;
+    if (firstValid > firstCopied) {
+        out.erase(out.begin(), out.begin() + (ptrdiff_t)std::min<uint64_t>(firstValid - firstCopied, out.size()));
+    }
+}
+
+bool writeProfileTrace(const char* path) {
+    FILE* f = fopen(path, "w");
+    if (!f) return false;
+    double nsPerStamp = 1.0;
+#ifdef PROFILER_TSC
+    if (profileCalibrated) {
+        uint64_t stamps = profileTimestamp() - calibrationStamp;
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - calibrationTime).count();
+        if (stamps > 0) nsPerStamp = ns / (double)stamps;
+    }
+#endif
+
+    std::vector<ProfileEvent> events;
+    long long written = 0;
+    fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    std::lock_guard<std::mutex> lock(profileRingsMutex);
+    bool first = true;
+    for (const ProfileRing* ring : profileRings) {
+        fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                first ? "" : ",\n", ring->tid, ring->name);
+        first = false;
+        copyProfileRing(*ring, events);
+        for (const ProfileEvent& e : events) {
+            if (e.start < calibrationStamp) continue;
+            double startUs = (double)(e.start - calibrationStamp) * nsPerStamp / 1000.0;
+            double durationUs = (double)(e.end - e.start) * nsPerStamp / 1000.0;
+            fprintf(f, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                    e.name, ring->tid, startUs, durationUs);
+            ++written;
+        }
+    }
+    fprintf(f, "\n]}\n");
+    bool ok = fclose(f) == 0;
+    printf("Profile trace: %lld zones from %d threads written to %s\n", written, (int)profileRings.size(), path);
+    return ok;
+}
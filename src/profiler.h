@@ -0,0 +1,77 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PROFILER_TSC 1
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define PROFILER_TSC 1
+#endif
+
+// Profiler frame: zona bernama (PROFILE_ZONE) dicatat ke ring buffer per thread
+// (65536 zona terakhir, yang lama ditimpa), tanpa lock dan tanpa alokasi setelah
+// ring thread itu dibuat. Mati = satu load atomic per zona. Timestamp dari TSC
+// (atau steady_clock), dikonversi ke nanodetik waktu dump.
+// Toggle runtime dengan setProfilerEnabled, dump ke JSON Chrome trace
+// (chrome://tracing atau ui.perfetto.dev) dengan writeProfileTrace.
+//
+// Zona yang jalan berkali-kali per tick (query terrain, trigger, updatePhysics)
+// memakai PROFILE_ZONE_DETAIL dan hanya dicatat kalau setProfilerDetail(true)
+// juga dipanggil. Game menyalakannya selalu: paling 5 substep x 4 zona ~50 ns per
+// frame 16.7 ms, jauh di bawah 1%. marble_sim default mati (--profile-detail),
+// karena tick headless yang beruntun membuat zona per tick jadi puluhan persen.
+extern std::atomic<bool> profilerActive;
+extern std::atomic<bool> profilerDetailActive;
+
+inline uint64_t profileTimestamp() {
+#ifdef PROFILER_TSC
+    return __rdtsc();
+#else
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+void endProfileZone(const char* name, uint64_t start); // name harus literal/static
+
+struct ProfileScope {
+    const char* name;
+    uint64_t start;
+    ProfileScope(const char* zoneName, const std::atomic<bool>& active)
+        : name(zoneName), start(active.load(std::memory_order_relaxed) ? profileTimestamp() : 0) {}
+    ~ProfileScope() {
+        if (start) endProfileZone(name, start);
+    }
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(name) ProfileScope PROFILE_CONCAT(profileZone, __LINE__)(name, profilerActive)
+#define PROFILE_ZONE_DETAIL(name) ProfileScope PROFILE_CONCAT(profileZone, __LINE__)(name, profilerDetailActive)
+
+void setProfilerEnabled(bool enabled);
+bool isProfilerEnabled();
+void setProfilerDetail(bool enabled); // Zona PROFILE_ZONE_DETAIL, hanya selama profiler nyala
+bool isProfilerDetailEnabled();
+void setProfileThreadName(const char* name); // Nama baris thread di trace
+
+// Batas frame (sesudah swap buffer). Durasi antar panggilan masuk jendela
+// bergulir 240 frame terakhir untuk persentil di overlay.
+void profileFrameMark();
+struct ProfileFrameStats {
+    int frames;
+    float p50Ms, p95Ms, p99Ms, maxMs;
+};
+ProfileFrameStats profileFrameStats();
+
+// Jumlah zona yang pernah dicatat semua thread (termasuk yang sudah tertimpa)
+uint64_t profileZonesRecorded();
+
+// Semua zona yang masih ada di ring semua thread. false kalau file gagal ditulis.
+bool writeProfileTrace(const char* path);
+
+#endif // PROFILER_H
@@ -0,0 +1,493 @@
+#include "propinstances.h"
+#include "arena.h"
+#include "arenamesh.h"
+#include "glbuffer.h"
+#include "glshader.h"
+#include "arenacull.h"
+#include "arenalod.h"
+#include <GL/glut.h>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+extern float coinSpinAngle;
+extern float coinBounceTime;
+
+// Posisi vertex prototype = protoA * skala.x + protoB * skala.y + protoC * skala.z.
+// Bush/rock/coin cuma pakai protoA (skala seragam). Tree pakai ketiganya karena
+// bentuknya linear terhadap trunkHeight, trunkRadius, dan foliageRadius.
+struct PropVertex {
+    float ax, ay, az;
+    float bx, by, bz;
+    float cx, cy, cz;
+    float nx, ny, nz;
+    float r, g, b;
+    float sr, sg, sb, shininess;
+};
+
+struct PropInstance {
+    float x, y, z, yaw;
+    float scaleA, scaleB, scaleC, colorScale;
+};
+
+enum PropTypeId { PROP_TREE, PROP_BUSH, PROP_ROCK, PROP_COIN, PROP_TYPE_COUNT };
+
+struct PropType {
+    std::vector<PropVertex> vertices;
+    std::vector<GLuint> indices;
+    std::vector<PropInstance> instances;        // Semua instance, urutan arenaCullOrder
+    // Yang lolos culling, dikelompokkan per pass LOD (instance yang crossfade muncul
+    // dua kali), diisi per frame; uploadedInstances = isi instanceVbo saat ini
+    std::vector<PropInstance> visibleInstances, uploadedInstances;
+    GLsizei passStart[ARENA_LOD_PASSES + 1] = {};
+    GLuint vbo = 0, ibo = 0, instanceVbo = 0;
+    size_t instanceCapacity = 0;                // Instance muat di instanceVbo
+    int lodLevels = 1;
+    GLuint lodFirst[ARENA_LOD_LEVELS] = {};     // Range index prototype per level LOD
+    GLsizei lodCount[ARENA_LOD_LEVELS] = {};
+    int cullKind = -1;
+};
+
+static PropType propTypes[PROP_TYPE_COUNT];
+static GLuint propProgram = 0;
+static GLint propBounceAmplitudeLoc = -1, propBounceTimeLoc = -1, propSpinLoc = -1;
+static bool propInstancingReady = false;
+static int propLastDrawCalls = 0;
+
+enum PropAttrib {
+    ATTRIB_PROTO_A, ATTRIB_PROTO_B, ATTRIB_PROTO_C, ATTRIB_NORMAL, ATTRIB_COLOR, ATTRIB_SPECULAR,
+    ATTRIB_INSTANCE_POS, ATTRIB_INSTANCE_SCALE, ATTRIB_COUNT
+};
+static const char* const propAttribNames[ATTRIB_COUNT] = {
+    "protoA", "protoB", "protoC", "protoNormal", "protoColor", "protoSpecular", "instancePosYaw", "instanceScale"
+};
+
+// Lighting per vertex sama dengan pipeline fixed-function game: COLOR_MATERIAL
+// ambient+diffuse, LIGHT0..2, viewer tidak lokal, two-sided lewat gl_BackColor
+static const char* const propVertexShader =
+    "#version 120\n"
+    "attribute vec3 protoA, protoB, protoC, protoNormal, protoColor;\n"
+    "attribute vec4 protoSpecular;\n"
+    "attribute vec4 instancePosYaw;\n"
+    "attribute vec4 instanceScale;\n"
+    "uniform float bounceAmplitude;\n"
+    "uniform float bounceTime;\n"
+    "uniform float spinDegrees;\n"
+    "vec4 shade(vec3 ecPos, vec3 N, vec3 diffuse, vec4 spec) {\n"
+    "    vec3 color = gl_LightModel.ambient.rgb * diffuse;\n"
+    "    for (int i = 0; i < 3; ++i) {\n"
+    "        vec3 L = gl_LightSource[i].position.xyz;\n"
+    "        float att = 1.0;\n"
+    "        if (gl_LightSource[i].position.w != 0.0) {\n"
+    "            L -= ecPos;\n"
+    "            float d = length(L);\n"
+    "            att = 1.0 / (gl_LightSource[i].constantAttenuation + gl_LightSource[i].linearAttenuation * d +\n"
+    "                         gl_LightSource[i].quadraticAttenuation * d * d);\n"
+    "        }\n"
+    "        L = normalize(L);\n"
+    "        vec3 c = gl_LightSource[i].ambient.rgb * diffuse;\n"
+    "        float nDotL = dot(N, L);\n"
+    "        if (nDotL > 0.0) {\n"
+    "            float nDotH = max(dot(N, normalize(L + vec3(0.0, 0.0, 1.0))), 0.0);\n"
+    "            c += nDotL * gl_LightSource[i].diffuse.rgb * diffuse;\n"
+    "            c += pow(nDotH, spec.w) * gl_LightSource[i].specular.rgb * spec.rgb;\n"
+    "        }\n"
+    "        color += att * c;\n"
+    "    }\n"
+    "    return vec4(clamp(color, 0.0, 1.0), 1.0);\n"
+    "}\n"
+    "void main() {\n"
+    "    vec3 local = protoA * instanceScale.x + protoB * instanceScale.y + protoC * instanceScale.z;\n"
+    "    float yaw = radians(instancePosYaw.w + spinDegrees);\n"
+    "    float s = sin(yaw), c = cos(yaw);\n"
+    "    vec3 world = vec3(c * local.x + s * local.z, local.y, c * local.z - s * local.x) + instancePosYaw.xyz;\n"
+    "    world.y += bounceAmplitude * sin(bounceTime * 2.5 + instancePosYaw.x + instancePosYaw.z);\n"
+    "    vec3 normal = vec3(c * protoNormal.x + s * protoNormal.z, protoNormal.y, c * protoNormal.z - s * protoNormal.x);\n"
+    "    vec4 ecPos = gl_ModelViewMatrix * vec4(world, 1.0);\n"
+    "    vec3 N = normalize(gl_NormalMatrix * normal);\n"
+    "    vec3 diffuse = protoColor * instanceScale.w;\n"
+    "    gl_FrontColor = shade(ecPos.xyz, N, diffuse, protoSpecular);\n"
+    "    gl_BackColor = shade(ecPos.xyz, -N, diffuse, protoSpecular);\n"
+    "    gl_FogFragCoord = abs(ecPos.z);\n"
+    "    gl_Position = gl_ProjectionMatrix * ecPos;\n"
+    "}\n";
+
+static PropVertex makePropVertex(const ArenaVertex& ref, const GLfloat* specular, GLfloat shininess) {
+    PropVertex v;
+    v.ax = ref.px; v.ay = ref.py; v.az = ref.pz;
+    v.bx = v.by = v.bz = 0.0f;
+    v.cx = v.cy = v.cz = 0.0f;
+    v.nx = ref.nx; v.ny = ref.ny; v.nz = ref.nz;
+    v.r = ref.r; v.g = ref.g; v.b = ref.b;
+    v.sr = specular[0]; v.sg = specular[1]; v.sb = specular[2]; v.shininess = shininess;
+    return v;
+}
+
+// Tambah satu batch hasil bake prop di origin ke prototype. basisA/B/C (boleh null)
+// adalah bake yang sama dengan satu parameter = 1 dan sisanya 0; topologinya
+// identik sehingga vertex ke-i di semua batch berpasangan.
+static void appendPrototype(PropType& type, const ArenaMeshBatch& reference, const ArenaMeshBatch* basisA,
+                            const ArenaMeshBatch* basisB, const ArenaMeshBatch* basisC, const ArenaMaterial& m) {
+    GLuint base = (GLuint)type.vertices.size();
+    for (size_t i = 0; i < reference.vertices.size(); ++i) {
+        PropVertex v = makePropVertex(reference.vertices[i], m.specular, m.shininess);
+        if (basisA) { v.ax = basisA->vertices[i].px; v.ay = basisA->vertices[i].py; v.az = basisA->vertices[i].pz; }
+        if (basisB) { v.bx = basisB->vertices[i].px; v.by = basisB->vertices[i].py; v.bz = basisB->vertices[i].pz; }
+        if (basisC) { v.cx = basisC->vertices[i].px; v.cy = basisC->vertices[i].py; v.cz = basisC->vertices[i].pz; }
+        type.vertices.push_back(v);
+    }
+    for (GLuint index : reference.indices) type.indices.push_back(base + index);
+}
+
+static void beginPrototypeLevel(PropType& type, int lod) {
+    type.lodFirst[lod] = (GLuint)type.indices.size();
+}
+
+static void endPrototypeLevel(PropType& type, int lod) {
+    type.lodCount[lod] = (GLsizei)(type.indices.size() - type.lodFirst[lod]);
+}
+
+static void buildTreePrototype(PropType& type) {
+    // Normal diambil dari tree pertama; kemiringan trunk sedikit berbeda untuk tree lain
+    ArenaTree ref = trees.empty() ? ArenaTree{0, 0, 0, 5.0f, 0.2f, 1.5f} : trees[0];
+    ref.x = ref.y = ref.z = 0.0f;
+    ArenaTree unitH = {0, 0, 0, 1.0f, 0.0f, 0.0f};
+    ArenaTree unitR = {0, 0, 0, 0.0f, 1.0f, 0.0f};
+    ArenaTree unitF = {0, 0, 0, 0.0f, 0.0f, 1.0f};
+    type.lodLevels = arenaLodLevels(CULL_TREE);
+    for (int lod = 0; lod < type.lodLevels; ++lod) {
+        ArenaMeshBatch trunk[4], foliage[4];
+        bakeTree(trunk[0], foliage[0], ref, lod);
+        bakeTree(trunk[1], foliage[1], unitH, lod);
+        bakeTree(trunk[2], foliage[2], unitR, lod);
+        bakeTree(trunk[3], foliage[3], unitF, lod);
+        beginPrototypeLevel(type, lod);
+        appendPrototype(type, trunk[0], &trunk[1], &trunk[2], &trunk[3], arenaMaterials[MESH_TRUNK]);
+        appendPrototype(type, foliage[0], &foliage[1], &foliage[2], &foliage[3], arenaMaterials[MESH_FOLIAGE]);
+        endPrototypeLevel(type, lod);
+    }
+    type.cullKind = CULL_TREE;
+}
+
+static void buildBushPrototype(PropType& type) {
+    type.lodLevels = arenaLodLevels(CULL_BUSH);
+    for (int lod = 0; lod < type.lodLevels; ++lod) {
+        ArenaMeshBatch unit;
+        bakeBush(unit, ArenaBush{0, 0, 0, 1.0f}, lod);
+        beginPrototypeLevel(type, lod);
+        appendPrototype(type, unit, &unit, nullptr, nullptr, arenaMaterials[MESH_BUSH]);
+        endPrototypeLevel(type, lod);
+    }
+    type.cullKind = CULL_BUSH;
+}
+
+static void buildRockPrototype(PropType& type) {
+    type.lodLevels = arenaLodLevels(CULL_ROCK);
+    for (int lod = 0; lod < type.lodLevels; ++lod) {
+        ArenaMeshBatch unit;
+        bakeRock(unit, ArenaRock{0, 0, 0, 1.0f}, lod);
+        beginPrototypeLevel(type, lod);
+        appendPrototype(type, unit, &unit, nullptr, nullptr, arenaMaterials[MESH_ROCK]);
+        endPrototypeLevel(type, lod);
+    }
+    type.cullKind = CULL_ROCK;
+}
+
+static const GLfloat coinSpecular[4] = {0.628281f, 0.555802f, 0.366065f, 1.0f};
+static const GLfloat coinShininess = 51.2f;
+
+static void addCoinVertex(PropType& type, float x, float y, float z, float nx, float ny, float nz) {
+    ArenaVertex ref = {x, y, z, nx, ny, nz, 1.0f, 0.84f, 0.0f};
+    type.vertices.push_back(makePropVertex(ref, coinSpecular, coinShininess));
+}
+
+// Disk di bidang z = 0 menghadap +Z, digeser offsetY (seperti gluDisk setelah glTranslatef)
+static void addCoinDisk(PropType& type, float radius, float offsetY, int slices) {
+    GLuint center = (GLuint)type.vertices.size();
+    addCoinVertex(type, 0.0f, offsetY, 0.0f, 0.0f, 0.0f, 1.0f);
+    for (int j = 0; j <= slices; ++j) {
+        float a = 2.0f * (float)M_PI * j / slices;
+        addCoinVertex(type, radius * sinf(a), offsetY + radius * cosf(a), 0.0f, 0.0f, 0.0f, 1.0f);
+    }
+    for (int j = 0; j < slices; ++j) {
+        GLuint tri[3] = {center, center + 2 + j, center + 1 + j};
+        type.indices.insert(type.indices.end(), tri, tri + 3);
+    }
+}
+
+// Geometri sama dengan drawCoins: dua disk lalu silinder sepanjang +Z
+static void buildCoinPrototype(PropType& type) {
+    const int slices = 32;
+    const float radius = 0.4f, thickness = 0.08f;
+    beginPrototypeLevel(type, 0);
+    addCoinDisk(type, radius, 0.0f, slices);
+    addCoinDisk(type, radius, 0.08f, slices);
+    GLuint base = (GLuint)type.vertices.size();
+    for (int i = 0; i <= 1; ++i) {
+        for (int j = 0; j <= slices; ++j) {
+            float a = 2.0f * (float)M_PI * j / slices;
+            addCoinVertex(type, radius * sinf(a), 0.04f + radius * cosf(a), thickness * i, sinf(a), cosf(a), 0.0f);
+        }
+    }
+    for (int j = 0; j < slices; ++j) {
+        GLuint a = base + j;
+        GLuint c = a + slices + 1;
+        GLuint tri[6] = {a, c, a + 1, a + 1, c, c + 1};
+        type.indices.insert(type.indices.end(), tri, tri + 6);
+    }
+    endPrototypeLevel(type, 0);
+}
+
+// Instance dari list arena sekarang, urutan arenaCullOrder. Instance coin ditulis
+// per frame (yang belum diambil dan terlihat), buffer dialokasikan untuk semua coin.
+static void fillPropInstances(PropTypeId id) {
+    std::vector<PropInstance>& instances = propTypes[id].instances;
+    instances.clear();
+    switch (id) {
+        case PROP_TREE:
+            for (int i : arenaCullOrder(CULL_TREE)) {
+                const ArenaTree& t = trees[i];
+                instances.push_back({t.x, t.y, t.z, 0.0f, t.trunkHeight, t.trunkRadius, t.foliageRadius, 1.0f});
+            }
+            break;
+        case PROP_BUSH:
+            for (int i : arenaCullOrder(CULL_BUSH)) {
+                const ArenaBush& b = bushes[i];
+                instances.push_back({b.x, b.y, b.z, 0.0f, b.radius, 0.0f, 0.0f, 1.0f});
+            }
+            break;
+        case PROP_ROCK:
+            for (int i : arenaCullOrder(CULL_ROCK)) {
+                const ArenaRock& r = rocks[i];
+                instances.push_back({r.x, r.y, r.z, 0.0f, r.scale, 0.0f, 0.0f, 1.0f});
+            }
+            break;
+        default:
+            for (const Coin& coin : coins) {
+                instances.push_back({coin.x, coin.y, coin.z, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f});
+            }
+            break;
+    }
+}
+
+// Upload hanya kalau isinya berubah dari frame sebelumnya
+static void uploadVisibleInstances(PropType& type) {
+    size_t count = type.visibleInstances.size();
+    if (count == type.uploadedInstances.size() &&
+        (count == 0 || memcmp(type.visibleInstances.data(), type.uploadedInstances.data(), count * sizeof(PropInstance)) == 0)) {
+        return;
+    }
+    type.uploadedInstances.assign(type.visibleInstances.begin(), type.visibleInstances.end());
+    if (count == 0) return;
+    glbBindBuffer(GL_ARRAY_BUFFER, type.instanceVbo);
+    glbBufferSubData(GL_ARRAY_BUFFER, 0, count * sizeof(PropInstance), type.visibleInstances.data());
+    glbBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+static void updateCulledInstances(PropType& type) {
+    type.visibleInstances.clear();
+    type.passStart[0] = 0;
+    for (int pass = 0; pass < ARENA_LOD_PASSES; ++pass) {
+        for (int k : arenaLodPassObjects((ArenaCullKind)type.cullKind, pass)) {
+            type.visibleInstances.push_back(type.instances[k]);
+        }
+        type.passStart[pass + 1] = (GLsizei)type.visibleInstances.size();
+    }
+    uploadVisibleInstances(type);
+}
+
+// Coin tanpa LOD: semuanya di pass 0
+static void updateCoinInstances(PropType& type) {
+    type.visibleInstances.clear();
+    for (size_t i = 0; i < coins.size(); ++i) {
+        const Coin& coin = coins[i];
+        // Radius coin 0.4 plus bounce 0.2
+        if (coin.collected || !arenaSphereVisible(coin.x, coin.y, coin.z, 0.6f)) continue;
+        type.visibleInstances.push_back(type.instances[i]);
+    }
+    type.passStart[0] = 0;
+    for (int pass = 1; pass <= ARENA_LOD_PASSES; ++pass) type.passStart[pass] = (GLsizei)type.visibleInstances.size();
+    uploadVisibleInstances(type);
+}
+
+static void uploadPropType(PropType& type) {
+    glbGenBuffers(1, &type.vbo);
+    glbBindBuffer(GL_ARRAY_BUFFER, type.vbo);
+    glbBufferData(GL_ARRAY_BUFFER, type.vertices.size() * sizeof(PropVertex), type.vertices.data(), GL_STATIC_DRAW);
+    glbGenBuffers(1, &type.ibo);
+    glbBindBuffer(GL_ELEMENT_ARRAY_BUFFER, type.ibo);
+    glbBufferData(GL_ELEMENT_ARRAY_BUFFER, type.indices.size() * sizeof(GLuint), type.indices.data(), GL_STATIC_DRAW);
+    glbBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    glbGenBuffers(1, &type.instanceVbo);
+    std::vector<PropVertex>().swap(type.vertices);
+    std::vector<GLuint>().swap(type.indices);
+}
+
+// Instance yang sedang crossfade digambar di dua level, jadi buffer dua kali jumlah
+// instance; isinya diisi updateCulledInstances/updateCoinInstances. Buffer hanya
+// dialokasikan ulang (dengan ruang tambah untuk jendela streaming berikutnya) kalau
+// instance tidak muat lagi.
+static void reserveInstanceBuffer(PropType& type) {
+    size_t needed = type.instances.size() * (type.lodLevels > 1 ? 2 : 1);
+    type.uploadedInstances.clear(); // Isi buffer tidak dipakai lagi, upload ulang frame berikutnya
+    if (needed <= type.instanceCapacity) return;
+    size_t capacity = type.instanceCapacity == 0 ? needed : needed + needed / 4;
+    glbBindBuffer(GL_ARRAY_BUFFER, type.instanceVbo);
+    glbBufferData(GL_ARRAY_BUFFER, capacity * sizeof(PropInstance), nullptr, GL_DYNAMIC_DRAW);
+    glbBindBuffer(GL_ARRAY_BUFFER, 0);
+    type.instanceCapacity = capacity;
+    type.visibleInstances.reserve(capacity);
+    type.uploadedInstances.reserve(capacity);
+}
+
+static void releasePropType(PropType& type) {
+    if (type.vbo) glbDeleteBuffers(1, &type.vbo);
+    if (type.ibo) glbDeleteBuffers(1, &type.ibo);
+    if (type.instanceVbo) glbDeleteBuffers(1, &type.instanceVbo);
+    type = PropType();
+}
+
+static void buildPropType(PropTypeId id) {
+    PropType& type = propTypes[id];
+    switch (id) {
+        case PROP_TREE: buildTreePrototype(type); break;
+        case PROP_BUSH: buildBushPrototype(type); break;
+        case PROP_ROCK: buildRockPrototype(type); break;
+        default: buildCoinPrototype(type); break;
+    }
+    uploadPropType(type);
+    fillPropInstances(id);
+    reserveInstanceBuffer(type);
+}
+
+void releasePropInstances() {
+    for (auto& type : propTypes) releasePropType(type);
+    if (propProgram) glsDeleteProgram(propProgram);
+    propProgram = 0;
+    propInstancingReady = false;
+}
+
+void buildPropInstances() {
+    releasePropInstances();
+    if (!hasGLBuffers() || !hasGLInstancing()) {
+        std::cout << "Prop instancing unavailable, props baked into arena mesh" << std::endl;
+        return;
+    }
+    propProgram = buildVertexProgram(propVertexShader, propAttribNames, ATTRIB_COUNT);
+    if (!propProgram) return;
+    propBounceAmplitudeLoc = glsGetUniformLocation(propProgram, "bounceAmplitude");
+    propBounceTimeLoc = glsGetUniformLocation(propProgram, "bounceTime");
+    propSpinLoc = glsGetUniformLocation(propProgram, "spinDegrees");
+
+    size_t instances = 0;
+    for (int i = 0; i < PROP_TYPE_COUNT; ++i) {
+        buildPropType((PropTypeId)i);
+        instances += propTypes[i].instances.size();
+    }
+    propInstancingReady = true;
+    std::cout << "Prop instancing: " << PROP_TYPE_COUNT << " types, " << instances << " instances (GLSL)" << std::endl;
+}
+
+int rebuildPropInstances(unsigned changedKinds) {
+    if (!propInstancingReady) return 0;
+    const unsigned typeBits[PROP_TYPE_COUNT] = {1u << CULL_TREE, 1u << CULL_BUSH, 1u << CULL_ROCK, ARENA_CHANGED_COINS};
+    int rebuilt = 0;
+    for (int i = 0; i < PROP_TYPE_COUNT; ++i) {
+        if (!(changedKinds & typeBits[i])) continue;
+        // Prototype tree ikut tree pertama, jadi tipe yang berubah (hot reload) dibangun
+        // ulang utuh. Jendela streaming pindah dan coin cukup mengganti instance.
+        if (i == PROP_COIN || (changedKinds & ARENA_CHANGED_ORIGIN)) {
+            fillPropInstances((PropTypeId)i);
+            reserveInstanceBuffer(propTypes[i]);
+        } else {
+            releasePropType(propTypes[i]);
+            buildPropType((PropTypeId)i);
+        }
+        ++rebuilt;
+    }
+    return rebuilt;
+}
+
+bool propInstancingActive() {
+    return propInstancingReady;
+}
+
+int propInstanceDrawCalls() {
+    return propLastDrawCalls;
+}
+
+static void drawPropType(const PropType& type) {
+    if (type.passStart[ARENA_LOD_PASSES] == 0) return;
+    glbBindBuffer(GL_ARRAY_BUFFER, type.vbo);
+    const char* base = nullptr;
+    GLsizei stride = sizeof(PropVertex);
+    glsVertexAttribPointer(ATTRIB_PROTO_A, 3, GL_FLOAT, GL_FALSE, stride, base + offsetof(PropVertex, ax));
+    glsVertexAttribPointer(ATTRIB_PROTO_B, 3, GL_FLOAT, GL_FALSE, stride, base + offsetof(PropVertex, bx));
+    glsVertexAttribPointer(ATTRIB_PROTO_C, 3, GL_FLOAT, GL_FALSE, stride, base + offsetof(PropVertex, cx));
+    glsVertexAttribPointer(ATTRIB_NORMAL, 3, GL_FLOAT, GL_FALSE, stride, base + offsetof(PropVertex, nx));
+    glsVertexAttribPointer(ATTRIB_COLOR, 3, GL_FLOAT, GL_FALSE, stride, base + offsetof(PropVertex, r));
+    glsVertexAttribPointer(ATTRIB_SPECULAR, 4, GL_FLOAT, GL_FALSE, stride, base + offsetof(PropVertex, sr));
+    glbBindBuffer(GL_ELEMENT_ARRAY_BUFFER, type.ibo);
+    glbBindBuffer(GL_ARRAY_BUFFER, type.instanceVbo);
+    stride = sizeof(PropInstance);
+    // Satu draw per pass LOD yang tidak kosong; instance pass ini mulai di passStart
+    for (int pass = 0; pass < ARENA_LOD_PASSES; ++pass) {
+        GLsizei count = type.passStart[pass + 1] - type.passStart[pass];
+        int level = arenaLodPassLevel(pass), pattern = arenaLodPassPattern(pass);
+        if (count == 0 || type.lodCount[level] == 0) continue;
+        const char* instances = base + type.passStart[pass] * sizeof(PropInstance);
+        glsVertexAttribPointer(ATTRIB_INSTANCE_POS, 4, GL_FLOAT, GL_FALSE, stride, instances + offsetof(PropInstance, x));
+        glsVertexAttribPointer(ATTRIB_INSTANCE_SCALE, 4, GL_FLOAT, GL_FALSE, stride, instances + offsetof(PropInstance, scaleA));
+        beginLodFadePattern(pattern);
+        glsDrawElementsInstanced(GL_TRIANGLES, type.lodCount[level], GL_UNSIGNED_INT,
+                                 base + type.lodFirst[level] * sizeof(GLuint), count);
+        endLodFadePattern(pattern);
+        propLastDrawCalls++;
+    }
+}
+
+static void beginPropDraw() {
+    glsUseProgram(propProgram);
+    glEnable(GL_VERTEX_PROGRAM_TWO_SIDE);
+    for (int i = 0; i < ATTRIB_COUNT; ++i) glsEnableVertexAttribArray(i);
+    glsVertexAttribDivisor(ATTRIB_INSTANCE_POS, 1);
+    glsVertexAttribDivisor(ATTRIB_INSTANCE_SCALE, 1);
+}
+
+static void endPropDraw() {
+    glsVertexAttribDivisor(ATTRIB_INSTANCE_POS, 0);
+    glsVertexAttribDivisor(ATTRIB_INSTANCE_SCALE, 0);
+    for (int i = 0; i < ATTRIB_COUNT; ++i) glsDisableVertexAttribArray(i);
+    glbBindBuffer(GL_ARRAY_BUFFER, 0);
+    glbBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    glDisable(GL_VERTEX_PROGRAM_TWO_SIDE);
+    glsUseProgram(0);
+}
+
+void drawPropInstances() {
+    propLastDrawCalls = 0;
+    if (!propInstancingReady) return;
+    beginPropDraw();
+    glsUniform1f(propBounceAmplitudeLoc, 0.0f);
+    glsUniform1f(propSpinLoc, 0.0f);
+    for (int i = PROP_TREE; i <= PROP_ROCK; ++i) {
+        updateCulledInstances(propTypes[i]);
+        drawPropType(propTypes[i]);
+    }
+    endPropDraw();
+}
+
+void drawCoinInstances() {
+    if (!propInstancingReady) return;
+    PropType& coinType = propTypes[PROP_COIN];
+    updateCoinInstances(coinType);
+    if (coinType.passStart[ARENA_LOD_PASSES] == 0) return;
+    beginPropDraw();
+    glsUniform1f(propBounceAmplitudeLoc, 0.2f);
+    glsUniform1f(propBounceTimeLoc, coinBounceTime);
+    glsUniform1f(propSpinLoc, coinSpinAngle);
+    drawPropType(coinType);
+    endPropDraw();
+}
@@ -0,0 +1,18 @@
+#ifndef PROPINSTANCES_H
+#define PROPINSTANCES_H
+
+// Hardware instancing untuk prop (tree, bush, rock, coin): satu prototype mesh per
+// tipe plus instance buffer (posisi, yaw, skala, variasi warna), digambar dengan
+// satu glDrawElementsInstanced per tipe lewat vertex shader yang meniru lighting
+// fixed-function. Tanpa GL 3.3 / ARB_instanced_arrays tidak aktif; tree/bush/rock
+// lalu ikut di-bake ke arenamesh dan coin digambar lewat drawCoins biasa.
+void buildPropInstances();   // Setelah setupArenaGeometry dan sebelum bakeArenaMesh
+void releasePropInstances();
+// Bangun ulang tipe yang berubah saja (mask ARENA_CHANGED_*), return jumlah tipe
+int rebuildPropInstances(unsigned changedKinds);
+bool propInstancingActive();
+void drawPropInstances();    // Tree, bush, rock
+void drawCoinInstances();    // Coin yang belum diambil, animasi dihitung di shader
+int propInstanceDrawCalls(); // Draw call di drawPropInstances + drawCoinInstances terakhir
+
+#endif // PROPINSTANCES_H
@@ -0,0 +1,43 @@
+#include "simmath.h"
+#include "utils.h"
+#include <cmath>
+
+#ifdef MARBLE_DETERMINISTIC
+
+// Reduksi dalam derajat (fmodf exact) ke [-45, 45] plus kuadran, lalu Taylor
+// orde 9 (sin) / 10 (cos) dengan Horner. Selisih dengan libm < 1e-7, urutan
+// operasi tetap jadi hasilnya sama di mana pun.
+static const float degreesToRadians = 0.0174532925199432957692f;
+
+void simSinCosDegrees(float degrees, float& sinOut, float& cosOut) {
+    float a = fmodf(degrees, 360.0f);                 // (-360, 360), tanda ikut degrees
+    int quadrant = (int)floorf((a + 45.0f) / 90.0f); // -4..4, & 3 = kuadran 0..3
+    float r = (a - (float)quadrant * 90.0f) * degreesToRadians;
+    float r2 = r * r;
+    float s = r + r * r2 * (-1.0f / 6.0f + r2 * (1.0f / 120.0f + r2 * (-1.0f / 5040.0f + r2 * (1.0f / 362880.0f))));
+    float c = 1.0f + r2 * (-0.5f + r2 * (1.0f / 24.0f + r2 * (-1.0f / 720.0f + r2 * (1.0f / 40320.0f + r2 * (-1.0f / 3628800.0f)))));
+    switch (quadrant & 3) {
+        case 0: sinOut = s;  cosOut = c;  break;
+        case 1: sinOut = c;  cosOut = -s; break;
+        case 2: sinOut = -s; cosOut = -c; break;
+        default: sinOut = -c; cosOut = s; break;
+    }
+}
+
+bool isDeterministicMath() {
+    return true;
+}
+
+#else
+
+void simSinCosDegrees(float degrees, float& sinOut, float& cosOut) {
+    float radians = degToRad(degrees);
+    sinOut = sin(radians);
+    cosOut = cos(radians);
+}
+
+bool isDeterministicMath() {
+    return false;
+}
+
+#endif
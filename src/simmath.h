@@ -0,0 +1,37 @@
+#ifndef SIMMATH_H
+#define SIMMATH_H
+
+// Matematika yang hasilnya masuk state simulasi.
+//
+// Build biasa pakai libm dan flag compiler apa adanya, jadi hasil physics bisa
+// beda antar compiler, -O, FMA (a * b + c digabung), atau versi libm.
+// Build deterministik (-DMARBLE_DETERMINISTIC di semua file library): file
+// simulasi meng-include header ini tepat sesudah header-nya sendiri supaya
+//  - contraction ke FMA dimatikan untuk seluruh file,
+//  - float dihitung sebagai float (bukan x87 80-bit) dan tanpa -ffast-math,
+//  - sin/cos dari polinomial sendiri (simSinCosDegrees), bukan libm.
+// sqrt, fabs, floor, fmin tetap dari <cmath>: IEEE 754 mewajibkan hasilnya
+// dibulatkan benar, jadi sudah sama di semua platform. Hasilnya bit-identik antar
+// -O0/-O3 dan FMA on/off (cek: marble_sim --record di satu build, --replay di build lain).
+#ifdef MARBLE_DETERMINISTIC
+#include <cfloat>
+#if defined(__FAST_MATH__)
+#error "MARBLE_DETERMINISTIC tidak bisa dipakai dengan -ffast-math"
+#endif
+#if !defined(FLT_EVAL_METHOD) || FLT_EVAL_METHOD != 0
+#error "MARBLE_DETERMINISTIC butuh float SSE (x86 32-bit: -msse2 -mfpmath=sse)"
+#endif
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#elif defined(_MSC_VER)
+#pragma fp_contract(off)
+#endif
+#endif
+
+// sin dan cos sudut dalam derajat (yaw kamera untuk arah input)
+void simSinCosDegrees(float degrees, float& sinOut, float& cosOut);
+bool isDeterministicMath();
+
+#endif // SIMMATH_H
@@ -0,0 +1,34 @@
+#include "simulation.h"
+#include "globals.h"
+#include "arena.h"
+#include "marble.h"
+#include "physics.h"
+#include "checkpoint.h"
+#include "timer.h"
+#include "level.h"
+
+bool keyStates[256]; 
+
+void initKeyStates() {
+    for (int i = 0; i < 256; ++i) {
+        keyStates[i] = false;
+    }
+}
+
+void initSimulation() {
+    initKeyStates();
+    applyCurrentLevel();
+    resetMarbleInitialState();
+    score = 0; 
+    activeCheckpointIndex = -1;
+    resetMarble();
+    resetTimer();
+    initCountdownTimer(60.0);
+    startTimer();
+}
+
+bool stepSimulation() {
+    updatePhysics();
+    updateTimer();
+    return !isCountdownExpired();
+}
@@ -0,0 +1,11 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+// Bagian game yang tidak butuh OpenGL: geometri arena, physics, checkpoint,
+// finish dan countdown. Dipakai MarbleGame dan marble_sim (headless).
+
+void initKeyStates();
+void initSimulation();
+bool stepSimulation(); // Satu tick physics + timer, false kalau countdown habis
+
+#endif // SIMULATION_H
@@ -1,150 +1,124 @@
 #include "timer.h"
-#include <GL/glut.h>
+#include "globals.h"
+#include <cstdio>
 #include <string>
 #include <vector>
-#include <iomanip>
-#include <sstream>
 #include <chrono>
 
-static std::chrono::time_point<std::chrono::high_resolution_clock> startTime;
-static std::chrono::duration<double> elapsedSeconds = std::chrono::duration<double>::zero();
+// Semua waktu game dihitung dari jumlah tick simulasi (tick * deltaTime), jadi
+// countdown dan split sama persis berapa pun kecepatan simulasi (headless, replay,
+// fast-forward). Jam dinding hanya dipakai kalau diminta untuk tampilan.
+static long long elapsedTicks = 0;
 static bool isRunning = false;
 static char timeString[32];
 static std::vector<double> checkpointTimes;
 
 static double countdownTime = 60.0; 
-static std::chrono::time_point<std::chrono::high_resolution_clock> countdownStartTime;
+static long long countdownTicks = 0;    // Tick sejak countdown (re)start
 static bool countdownRunning = false;
 
+static bool wallClockDisplay = false;
+static std::chrono::steady_clock::time_point countdownWallStart;
+
+static double ticksToSeconds(long long ticks) {
+    return ticks * (double)deltaTime;
+}
+
+static void restartCountdownClock() {
+    countdownTicks = 0;
+    countdownWallStart = std::chrono::steady_clock::now();
+    countdownRunning = true;
+}
+
 void resetTimer() {
-    elapsedSeconds = std::chrono::duration<double>::zero();
+    elapsedTicks = 0;
     isRunning = false;
     checkpointTimes.clear();
     countdownTime = 60.0;
+    countdownTicks = 0;
     countdownRunning = false;
 }
 
 void startTimer() {
-    if (!isRunning) {
-        startTime = std::chrono::high_resolution_clock::now() - std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(elapsedSeconds);
-        isRunning = true;
-    }
+    isRunning = true;
 }
 
 void stopTimer() {
-    if (isRunning) {
-        elapsedSeconds = std::chrono::high_resolution_clock::now() - startTime;
-        isRunning = false;
-    }
+    isRunning = false;
 }
 
 void updateTimer() {
-    if (isRunning) {
-        elapsedSeconds = std::chrono::high_resolution_clock::now() - startTime;
-    }
+    if (isRunning) ++elapsedTicks;
+    if (!countdownRunning) return;
+    ++countdownTicks;
+    if (countdownTime - ticksToSeconds(countdownTicks) <= 0) countdownRunning = false;
+}
+
+double getElapsedTime() {
+    return ticksToSeconds(elapsedTicks);
 }
 
 void recordCheckpointTime() {
-    checkpointTimes.push_back(elapsedSeconds.count());
+    checkpointTimes.push_back(getElapsedTime());
+}
+
+const std::vector<double>& getCheckpointTimes() {
+    return checkpointTimes;
+}
+
+// mm:ss.mmm ke buffer tetap, tanpa stream (getElapsedTimeString dipanggil tiap frame)
+static void formatTime(char* buffer, size_t size, const char* prefix, double timeInSeconds) {
+    int minutes = static_cast<int>(timeInSeconds) / 60;
+    int seconds = static_cast<int>(timeInSeconds) % 60;
+    int milliseconds = static_cast<int>((timeInSeconds - static_cast<int>(timeInSeconds)) * 1000);
+    snprintf(buffer, size, "%s%02d:%02d.%03d", prefix, minutes, seconds, milliseconds);
 }
 
 std::vector<std::string> getFormattedCheckpointTimes() {
     std::vector<std::string> formattedTimes;
     for (double timeInSeconds : checkpointTimes) {
-        int minutes = static_cast<int>(timeInSeconds) / 60;
-        int seconds = static_cast<int>(timeInSeconds) % 60;
-        int milliseconds = static_cast<int>((timeInSeconds - static_cast<int>(timeInSeconds)) * 1000);
-
-        std::ostringstream oss;
-        oss << std::setw(2) << std::setfill('0') << minutes << ":"
-            << std::setw(2) << std::setfill('0') << seconds << "."
-            << std::setw(3) << std::setfill('0') << milliseconds;
-        formattedTimes.push_back(oss.str());
+        char buffer[32];
+        formatTime(buffer, sizeof(buffer), "", timeInSeconds);
+        formattedTimes.push_back(buffer);
     }
     return formattedTimes;
 }
 
 char* getElapsedTimeString() {
-    double totalSeconds = getRemainingTime();
-    int minutes = static_cast<int>(totalSeconds) / 60;
-    int seconds = static_cast<int>(totalSeconds) % 60;
-    int milliseconds = static_cast<int>((totalSeconds - static_cast<int>(totalSeconds)) * 1000);
-
-    std::ostringstream oss;
-    oss << "Time: " << std::setw(2) << std::setfill('0') << minutes << ":"
-        << std::setw(2) << std::setfill('0') << seconds << "."
-        << std::setw(3) << std::setfill('0') << milliseconds;
-    
-    snprintf(timeString, sizeof(timeString), "%s", oss.str().c_str());
+    formatTime(timeString, sizeof(timeString), "Time: ", getDisplayedRemainingTime());
     return timeString;
 }
 
-void displayTimer(int screenWidth, int screenHeight) {
-    glMatrixMode(GL_PROJECTION);
-    glPushMatrix();
-    glLoadIdentity();
-    gluOrtho2D(0, screenWidth, 0, screenHeight);
-
-    glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glLoadIdentity();
-
-    glDisable(GL_LIGHTING);
-    glDisable(GL_DEPTH_TEST);
-
-    glColor3f(1.0f, 1.0f, 1.0f);
-
-    int mainTimerYPosition = screenHeight - 30;
-    glRasterPos2i(10, mainTimerYPosition);
-
-    char* timeStr = getElapsedTimeString();
-    for (char* c = timeStr; *c != '\0'; c++) {
-        glutBitmapCharacter(GLUT_BITMAP_HELVETICA_18, *c);
-    }   
-
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_LIGHTING);
-
-    glMatrixMode(GL_PROJECTION);
-    glPopMatrix();
-    glMatrixMode(GL_MODELVIEW);
-    glPopMatrix();
-}
-
 void initCountdownTimer(double initialSeconds) {
     countdownTime = initialSeconds;
-    countdownStartTime = std::chrono::high_resolution_clock::now();
-    countdownRunning = true;
+    restartCountdownClock();
 }
 
 void addTimeToCountdown(double secondsToAdd) {
     countdownTime += secondsToAdd;
     if (!countdownRunning && countdownTime > 0) {
-        countdownStartTime = std::chrono::high_resolution_clock::now();
-        countdownRunning = true;
+        restartCountdownClock();
     }
 }
 
 bool isCountdownExpired() {
-    if (!countdownRunning) return true;
-    
-    auto now = std::chrono::high_resolution_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(now - countdownStartTime);
-    double remaining = countdownTime - elapsed.count();
-    
-    if (remaining <= 0) {
-        countdownRunning = false;
-        return true;
-    }
-    return false;
+    return !countdownRunning;
 }
 
 double getRemainingTime() {
     if (!countdownRunning) return 0.0;
-    
-    auto now = std::chrono::high_resolution_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(now - countdownStartTime);
-    double remaining = countdownTime - elapsed.count();
-    
+    double remaining = countdownTime - ticksToSeconds(countdownTicks);
+    return remaining > 0 ? remaining : 0.0;
+}
+
+void setTimerWallClockDisplay(bool enabled) {
+    wallClockDisplay = enabled;
+}
+
+double getDisplayedRemainingTime() {
+    if (!wallClockDisplay) return getRemainingTime();
+    if (!countdownRunning) return 0.0;
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - countdownWallStart).count();
+    double remaining = countdownTime - wall;
     return remaining > 0 ? remaining : 0.0;
 }
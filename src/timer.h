@@ -3,6 +3,9 @@
 
 #include <vector> // Required for std::vector
 #include <string> // Required for std::string
+
+// Waktu game (stopwatch, countdown, split checkpoint) maju per tick simulasi lewat
+// updateTimer (dipanggil stepSimulation), bukan dari jam dinding.
 void resetTimer();
 
 void initCountdownTimer(double initialSeconds);
@@ -17,9 +20,13 @@ void startTimer();
 
 void stopTimer();
 
-void updateTimer();
+void updateTimer(); // Satu tick: stopwatch + countdown maju deltaTime
+double getElapsedTime();
 
-void displayTimer(int screenWidth, int screenHeight);
+// Sumber tampilan HUD saja (getElapsedTimeString): false = waktu simulasi (default),
+// true = sisa countdown dihitung dari jam dinding. Tidak mengubah kapan game over.
+void setTimerWallClockDisplay(bool enabled);
+double getDisplayedRemainingTime();
 
 char* getElapsedTimeString();
 
@@ -0,0 +1,204 @@
+#include "trigger.h"
+#include "simmath.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Broadphase: hash cell 2 x 2 di bidang XZ, CSR per bucket. Volume masuk ke semua
+// cell yang tersentuh AABB-nya (hazard besar = banyak cell), query marble hanya
+// membaca cell yang tersentuh bolanya. Dibangun ulang kalau ada volume berubah.
+static const float triggerCellSize = 2.0f;
+
+struct TriggerSlot {
+    TriggerVolume volume;
+    bool enabled;
+    bool inside;
+    unsigned stamp;     // Query terakhir yang sudah mengetes volume ini
+};
+
+struct TriggerRef {
+    int kind, id;
+};
+
+static std::vector<TriggerSlot> triggerSlots[TRIGGER_KIND_COUNT];
+static TriggerHandler triggerHandlers[TRIGGER_KIND_COUNT] = {};
+static std::vector<int> triggerBucketStart;
+static std::vector<TriggerRef> triggerBucketEntries;
+static unsigned triggerBucketMask = 0;
+static bool triggerHashDirty = true;
+static bool triggerBroadphaseEnabled = true;
+static unsigned triggerStamp = 0;
+static std::vector<TriggerRef> insideTriggers, stillInside;
+static std::vector<TriggerEvent> triggerEvents;
+
+static int triggerCell(float v) {
+    return (int)std::floor(v / triggerCellSize);
+}
+
+static unsigned triggerBucket(int cx, int cz) {
+    return ((unsigned)cx * 73856093u ^ (unsigned)cz * 19349663u) & triggerBucketMask;
+}
+
+static void triggerExtent(const TriggerVolume& v, float& halfX, float& halfZ) {
+    halfX = v.shape == TRIGGER_SPHERE ? v.radius : v.halfX;
+    halfZ = v.shape == TRIGGER_SPHERE ? v.radius : v.halfZ;
+}
+
+// Panggil fn(bucket) untuk tiap cell di kotak XZ, bucket yang sama hanya sekali
+// kalau kotaknya kecil (cukup untuk query marble; duplikat volume dicegah stamp)
+template <typename Fn>
+static void forEachTriggerBucket(float minX, float minZ, float maxX, float maxZ, Fn fn) {
+    for (int cz = triggerCell(minZ); cz <= triggerCell(maxZ); ++cz) {
+        for (int cx = triggerCell(minX); cx <= triggerCell(maxX); ++cx) {
+            fn(triggerBucket(cx, cz));
+        }
+    }
+}
+
+static void buildTriggerHash() {
+    unsigned cells = 0;
+    for (int k = 0; k < TRIGGER_KIND_COUNT; ++k) {
+        for (const TriggerSlot& s : triggerSlots[k]) {
+            float hx, hz;
+            triggerExtent(s.volume, hx, hz);
+            cells += (unsigned)(triggerCell(s.volume.x + hx) - triggerCell(s.volume.x - hx) + 1) *
+                     (unsigned)(triggerCell(s.volume.z + hz) - triggerCell(s.volume.z - hz) + 1);
+        }
+    }
+    unsigned buckets = 16;
+    while (buckets < 2 * cells) buckets *= 2;
+    triggerBucketMask = buckets - 1;
+    triggerBucketStart.assign(buckets + 1, 0);
+    triggerBucketEntries.resize(cells);
+    for (int pass = 0; pass < 2; ++pass) {
+        std::vector<int> fill;
+        if (pass == 1) {
+            for (unsigned b = 0; b < buckets; ++b) triggerBucketStart[b + 1] += triggerBucketStart[b];
+            fill.assign(triggerBucketStart.begin(), triggerBucketStart.end() - 1);
+        }
+        for (int k = 0; k < TRIGGER_KIND_COUNT; ++k) {
+            for (int id = 0; id < (int)triggerSlots[k].size(); ++id) {
+                const TriggerVolume& v = triggerSlots[k][id].volume;
+                float hx, hz;
+                triggerExtent(v, hx, hz);
+                forEachTriggerBucket(v.x - hx, v.z - hz, v.x + hx, v.z + hz, [&](unsigned b) {
+                    if (pass == 0) ++triggerBucketStart[b + 1];
+                    else triggerBucketEntries[fill[b]++] = {k, id};
+                });
+            }
+        }
+    }
+    triggerHashDirty = false;
+}
+
+static bool triggerOverlaps(const TriggerVolume& v, float x, float y, float z, float radius) {
+    float dx, dy, dz, reach;
+    if (v.shape == TRIGGER_SPHERE) {
+        dx = x - v.x; dy = y - v.y; dz = z - v.z;
+        reach = v.radius + radius;
+    } else {
+        // Jarak titik pusat bola ke box (0 di dalam box)
+        dx = std::max(std::fabs(x - v.x) - v.halfX, 0.0f);
+        dy = std::max(std::fabs(y - v.y) - v.halfY, 0.0f);
+        dz = std::max(std::fabs(z - v.z) - v.halfZ, 0.0f);
+        reach = radius;
+    }
+    return dx * dx + dy * dy + dz * dz < reach * reach;
+}
+
+int addTrigger(TriggerKind kind, const TriggerVolume& volume) {
+    triggerSlots[kind].push_back({volume, true, false, 0});
+    triggerHashDirty = true;
+    return (int)triggerSlots[kind].size() - 1;
+}
+
+void moveTrigger(TriggerKind kind, int id, float x, float y, float z) {
+    TriggerVolume& v = triggerSlots[kind][id].volume;
+    if (v.x == x && v.y == y && v.z == z) return;
+    // Tinggi saja tidak mengubah cell XZ
+    if (v.x != x || v.z != z) triggerHashDirty = true;
+    v.x = x; v.y = y; v.z = z;
+}
+
+void setTriggerEnabled(TriggerKind kind, int id, bool enabled) {
+    triggerSlots[kind][id].enabled = enabled;
+}
+
+void clearTriggers(TriggerKind kind) {
+    triggerSlots[kind].clear();
+    insideTriggers.erase(std::remove_if(insideTriggers.begin(), insideTriggers.end(),
+                                        [kind](const TriggerRef& r) { return r.kind == kind; }),
+                         insideTriggers.end());
+    triggerHashDirty = true;
+}
+
+int triggerCount(TriggerKind kind) {
+    return (int)triggerSlots[kind].size();
+}
+
+const TriggerVolume& triggerVolume(TriggerKind kind, int id) {
+    return triggerSlots[kind][id].volume;
+}
+
+void setTriggerHandler(TriggerKind kind, TriggerHandler handler) {
+    triggerHandlers[kind] = handler;
+}
+
+void setTriggerBroadphaseEnabled(bool enabled) {
+    triggerBroadphaseEnabled = enabled;
+}
+
+static void testTrigger(int kind, int id, float x, float y, float z, float radius) {
+    TriggerSlot& s = triggerSlots[kind][id];
+    if (s.stamp == triggerStamp) return;
+    s.stamp = triggerStamp;
+    if (!s.enabled || s.inside || !triggerOverlaps(s.volume, x, y, z, radius)) return;
+    s.inside = true;
+    insideTriggers.push_back({kind, id});
+    triggerEvents.push_back({(TriggerKind)kind, id, true});
+}
+
+void updateTriggers(float x, float y, float z, float radius) {
+    triggerEvents.clear();
+    // Exit dulu: volume yang tadinya dimasuki tapi sudah tidak overlap/nonaktif
+    stillInside.clear();
+    for (const TriggerRef& r : insideTriggers) {
+        TriggerSlot& s = triggerSlots[r.kind][r.id];
+        if (s.enabled && triggerOverlaps(s.volume, x, y, z, radius)) {
+            stillInside.push_back(r);
+        } else {
+            s.inside = false;
+            triggerEvents.push_back({(TriggerKind)r.kind, r.id, false});
+        }
+    }
+    insideTriggers.swap(stillInside);
+
+    ++triggerStamp;
+    if (!triggerBroadphaseEnabled) {
+        for (int k = 0; k < TRIGGER_KIND_COUNT; ++k) {
+            for (int id = 0; id < (int)triggerSlots[k].size(); ++id) testTrigger(k, id, x, y, z, radius);
+        }
+    } else {
+        if (triggerHashDirty) buildTriggerHash();
+        forEachTriggerBucket(x - radius, z - radius, x + radius, z + radius, [&](unsigned b) {
+            for (int e = triggerBucketStart[b]; e < triggerBucketStart[b + 1]; ++e) {
+                testTrigger(triggerBucketEntries[e].kind, triggerBucketEntries[e].id, x, y, z, radius);
+            }
+        });
+    }
+    if (triggerEvents.empty()) return;
+
+    std::sort(triggerEvents.begin(), triggerEvents.end(), [](const TriggerEvent& a, const TriggerEvent& b) {
+        if (a.kind != b.kind) return a.kind < b.kind;
+        if (a.id != b.id) return a.id < b.id;
+        return !a.entered && b.entered;
+    });
+    size_t begin = 0;
+    while (begin < triggerEvents.size()) {
+        size_t end = begin;
+        while (end < triggerEvents.size() && triggerEvents[end].kind == triggerEvents[begin].kind) ++end;
+        TriggerHandler handler = triggerHandlers[triggerEvents[begin].kind];
+        if (handler) handler(&triggerEvents[begin], (int)(end - begin));
+        begin = end;
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef TRIGGER_H
+#define TRIGGER_H
+
+// Volume trigger gameplay (checkpoint, finish, coin, hazard): sphere atau box di
+// satu broadphase spatial hash. updateTriggers dipanggil sekali per tick dengan
+// bola marble; volume yang baru dimasuki/ditinggalkan jadi event enter/exit, lalu
+// dikirim per jenis dalam satu batch ke handler jenis itu (urut jenis, lalu id).
+// Objek gameplay baru cukup menambah TriggerKind + handler, tanpa scan sendiri.
+enum TriggerKind { TRIGGER_CHECKPOINT, TRIGGER_FINISH, TRIGGER_COIN, TRIGGER_HAZARD, TRIGGER_KIND_COUNT };
+enum TriggerShape { TRIGGER_SPHERE, TRIGGER_BOX };
+
+struct TriggerVolume {
+    TriggerShape shape;
+    float x, y, z;              // Pusat
+    float radius;               // TRIGGER_SPHERE
+    float halfX, halfY, halfZ;  // TRIGGER_BOX
+};
+
+struct TriggerEvent {
+    TriggerKind kind;
+    int id;        // Index volume di jenisnya (= index objek pemiliknya)
+    bool entered;  // false = exit
+};
+
+typedef void (*TriggerHandler)(const TriggerEvent* events, int count);
+
+// Volume disimpan per jenis; id = urutan addTrigger sejak clearTriggers jenis itu.
+// Volume yang dihapus/dipindah tidak memicu event, status di dalamnya direset
+// hanya oleh clearTriggers.
+int addTrigger(TriggerKind kind, const TriggerVolume& volume);
+void moveTrigger(TriggerKind kind, int id, float x, float y, float z);
+// Volume nonaktif tidak dites; kalau marble sedang di dalamnya keluar event exit
+void setTriggerEnabled(TriggerKind kind, int id, bool enabled);
+void clearTriggers(TriggerKind kind);
+int triggerCount(TriggerKind kind);
+const TriggerVolume& triggerVolume(TriggerKind kind, int id);
+void setTriggerHandler(TriggerKind kind, TriggerHandler handler);
+
+// Handler boleh mengubah state game (mis. respawn marble), tapi perubahan volume
+// dari handler baru terlihat tick berikutnya
+void updateTriggers(float x, float y, float z, float radius);
+void setTriggerBroadphaseEnabled(bool enabled); // false = tes semua volume (untuk benchmark)
+
+#endif // TRIGGER_H
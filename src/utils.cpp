@@ -1,4 +1,5 @@
 #include "utils.h"
+#include "simmath.h"
 #include "globals.h" 
 #include <cmath>     
 